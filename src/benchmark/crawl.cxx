@@ -0,0 +1,358 @@
+/**
+ *  \file
+ *  \brief  End-to-end crawl benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "http_server.hxx"
+
+#include "libfastcrawl/fastcrawl.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+
+/** Process CPU time (user + system) [s] */
+static double cpu_time() {
+    struct ::rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    return
+        usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+
+/** Remove all files in current directory */
+static void clean_cwd() {
+    auto * dir = ::opendir(".");
+    if (nullptr == dir) return;
+
+    while (auto * entry = ::readdir(dir))
+        if (DT_REG == entry->d_type) ::unlink(entry->d_name);
+
+    ::closedir(dir);
+}
+
+
+/** Crawl iteration result */
+struct result {
+    size_t   objects;       /**< Downloaded objects          */
+    size_t   failed;        /**< Failed downloads            */
+    uint64_t bytes;         /**< Received bytes              */
+    uint64_t transferred;   /**< Transferred (encoded) bytes */
+    double   time;          /**< Wall-clock time [s]         */
+    double   cpu;           /**< CPU time [s]                */
+    uint64_t latency_p50;   /**< Object latency median [us]  */
+    uint64_t latency_p99;   /**< Object latency p99 [us]     */
+
+};  // end of struct result
+
+
+/**
+ *  \brief  Crawl the benchmark server page
+ *
+ *  \param  uri       Page URI
+ *  \param  tlimit    Download threads limit
+ *  \param  pipeline  Data processors
+ *  \param  policy    Download policy
+ *
+ *  \return Iteration result
+ */
+static result crawl(
+    const fastcrawl::uri &              uri,
+    size_t                              tlimit,
+    const fastcrawl::pipeline_builder & pipeline,
+    const fastcrawl::download_policy &  policy)
+{
+    auto & metrics = fastcrawl::metrics::global();
+    const auto values_before = metrics.values();
+    const double cpu_before = cpu_time();
+    const auto start = std::chrono::steady_clock::now();
+
+    result res;
+    {
+        fastcrawl::html_crawler html_crawler(uri, tlimit);
+        html_crawler.pipeline(pipeline);
+        html_crawler.policy(policy);
+
+        fastcrawl::download download(uri, "./index.html");
+        download.policy(&policy);
+        download(html_crawler);
+        html_crawler.wait();
+
+        const std::chrono::duration<double> time_s =
+            std::chrono::steady_clock::now() - start;
+
+        const auto timings = html_crawler.timings();
+        const auto & total =
+            timings.all().phases[fastcrawl::timing_report::TOTAL];
+
+        res.time        = time_s.count();
+        res.latency_p50 = total.percentile(50);
+        res.latency_p99 = total.percentile(99);
+    }
+
+    const auto values_after = metrics.values();
+
+    res.cpu     = cpu_time() - cpu_before;
+    res.objects = values_after.completed - values_before.completed;
+    res.failed  = values_after.failed - values_before.failed;
+    res.bytes   = values_after.bytes_received - values_before.bytes_received;
+    res.transferred =
+        values_after.bytes_transferred - values_before.bytes_transferred;
+
+    clean_cwd();
+
+    return res;
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    fastcrawl::http_server::config conf;
+    size_t      iterations   = 5;
+    size_t      tlimit       = SIZE_MAX;
+    std::string pipeline_str = "adler32,size";
+    fastcrawl::download_policy policy;
+
+    // Usage
+    auto usage = [&argv, &conf, &iterations](std::ostream & out) {
+        out << "Usage: " << argv[0] << " [OPTIONS]" << std::endl
+            << std::endl
+            << "Crawls a page served by a local synthetic HTTP/1.1 server"    << std::endl
+            << "(running in a child process) and reports throughput, object" << std::endl
+            << "latency and CPU time per GB received."                        << std::endl
+            << std::endl
+            << "OPTIONS:" << std::endl
+            << "    -h or --help                show this help and exit"      << std::endl
+            << "    -b or --bandwidth <B/s>     per-response bandwidth cap"   << std::endl
+            << "    -c or --chunked             chunked transfer encoding"    << std::endl
+            << "    -D or --distribution <d>    object size distribution"     << std::endl
+            << "                                (fixed, uniform, lognormal)"  << std::endl
+            << "    -i or --iterations <n>      crawl iterations"             << std::endl
+            << "    -l or --latency <ms>        response latency"             << std::endl
+            << "    -n or --references <n>      references on the page"       << std::endl
+            << "    -p or --pipeline <list>     content data processors"      << std::endl
+            << "    -r or --trickle-rate <B/s>  trickled responses rate"      << std::endl
+            << "    -s or --size <B>            mean object size"             << std::endl
+            << "    -t or --thread-limit <n>    limit the number of threads"  << std::endl
+            << "    -T or --trickle <ratio>     ratio of trickled responses"  << std::endl
+            << "    -z or --gzip                gzip-compressed transfers"    << std::endl
+            << "                                (decoded by the crawler)"     << std::endl
+            << std::endl
+            << "Defaults: " << conf.references << " references of "
+            << conf.object_size << " B, " << iterations << " iterations"
+            << std::endl;
+    };
+
+    static const struct option long_opts[] {
+        { "help",         no_argument,       nullptr, 'h' },
+        { "bandwidth",    required_argument, nullptr, 'b' },
+        { "chunked",      no_argument,       nullptr, 'c' },
+        { "distribution", required_argument, nullptr, 'D' },
+        { "iterations",   required_argument, nullptr, 'i' },
+        { "latency",      required_argument, nullptr, 'l' },
+        { "references",   required_argument, nullptr, 'n' },
+        { "pipeline",     required_argument, nullptr, 'p' },
+        { "trickle-rate", required_argument, nullptr, 'r' },
+        { "size",         required_argument, nullptr, 's' },
+        { "thread-limit", required_argument, nullptr, 't' },
+        { "trickle",      required_argument, nullptr, 'T' },
+        { "gzip",         no_argument,       nullptr, 'z' },
+
+        { nullptr,        0,                 nullptr, '\0' }  // terminator
+    };
+
+    for (;;) {
+        int long_opt_ix;
+        int opt = ::getopt_long(argc, argv, "hb:cD:i:l:n:p:r:s:t:T:z",
+            long_opts, &long_opt_ix);
+        if (-1 == opt) break;  // no more options
+
+        switch (opt) {
+            case 'h': usage(std::cout); return 0;
+            case 'b': conf.bandwidth     = ::atol(::optarg); break;
+            case 'c': conf.chunked       = true;             break;
+            case 'i': iterations         = ::atol(::optarg); break;
+            case 'l': conf.latency_ms    = ::atoi(::optarg); break;
+            case 'n': conf.references    = ::atol(::optarg); break;
+            case 'p': pipeline_str       = ::optarg;         break;
+            case 'r': conf.trickle_rate  = ::atol(::optarg); break;
+            case 's': conf.object_size   = ::atol(::optarg); break;
+            case 't': tlimit             = ::atol(::optarg); break;
+            case 'T': conf.trickle_ratio = ::atof(::optarg); break;
+
+            case 'z':   // compressed transfers (decoded by the crawler)
+                conf.gzip          = true;
+                policy.compression = fastcrawl::download_policy::DECODE;
+                break;
+
+            case 'D':   // size distribution
+                if      (0 == std::strcmp(::optarg, "fixed"))
+                    conf.distribution = fastcrawl::http_server::FIXED;
+                else if (0 == std::strcmp(::optarg, "uniform"))
+                    conf.distribution = fastcrawl::http_server::UNIFORM;
+                else if (0 == std::strcmp(::optarg, "lognormal"))
+                    conf.distribution = fastcrawl::http_server::LOGNORMAL;
+                else {
+                    std::cerr
+                        << "Unknown distribution: " << ::optarg << std::endl
+                        << std::endl;
+
+                    usage(std::cerr);
+                    return 1;
+                }
+
+                break;
+
+            default:    // invalid option
+                usage(std::cerr);
+                return 1;
+        }
+    }
+
+    const auto pipeline = fastcrawl::pipeline_builder(pipeline_str);
+
+    // Work in a temporary directory
+    char dir[] = "/tmp/fcrawl_bench.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    // Server runs in a child process (so that its CPU time isn't measured)
+    fastcrawl::http_server server(conf);
+
+    const ::pid_t server_pid = ::fork();
+    if (server_pid < 0) throw std::runtime_error("fork failed");
+
+    if (0 == server_pid) {
+        server.run();
+        ::_exit(0);
+    }
+
+    const auto uri = fastcrawl::uri::parse(server.base_uri() + "index.html");
+
+    std::cout
+        << "Crawling " << static_cast<std::string>(uri) << ": "
+        << conf.references << " references, mean size "
+        << conf.object_size << " B" << std::endl;
+
+    double time = 0, cpu = 0;
+    uint64_t bytes = 0, transferred = 0;
+    size_t objects = 0;
+    uint64_t p99_max = 0;
+
+    for (size_t i = 1; i <= iterations; ++i) {
+        const auto res = crawl(uri, tlimit, pipeline, policy);
+
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << "Iteration " << i << ": "
+            << res.objects << " objects (" << res.failed << " failed), "
+            << res.bytes / 1e6 / res.time << " MB/s ("
+            << res.transferred / 1e6 / res.time << " MB/s on wire), "
+            << res.objects / res.time << " objects/s, latency p50 "
+            << res.latency_p50 / 1000.0 << " ms, p99 "
+            << res.latency_p99 / 1000.0 << " ms, CPU "
+            << (res.bytes ? res.cpu / (res.bytes / 1e9) : 0) << " s/GB"
+            << std::endl;
+
+        time    += res.time;
+        cpu     += res.cpu;
+        bytes   += res.bytes;
+        transferred += res.transferred;
+        objects += res.objects;
+        p99_max  = std::max(p99_max, res.latency_p99);
+    }
+
+    ::kill(server_pid, SIGTERM);
+    ::waitpid(server_pid, nullptr, 0);
+
+    ::rmdir(dir);
+
+    std::cout
+        << std::fixed << std::setprecision(2)
+        << "Total: " << bytes / 1e6 / time << " MB/s ("
+        << transferred / 1e6 / time << " MB/s on wire), "
+        << objects / time << " objects/s, max. latency p99 "
+        << p99_max / 1000.0 << " ms, CPU "
+        << (bytes ? cpu / (bytes / 1e9) : 0) << " s/GB"
+        << std::endl;
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,191 @@
+/**
+ *  \file
+ *  \brief  Content digests benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/online_data_processor.hxx"
+#include "libfastcrawl/adler32.hxx"
+#include "libfastcrawl/crc32c.hxx"
+#include "libfastcrawl/xxh3.hxx"
+#include "libfastcrawl/sha256.hxx"
+#include "libfastcrawl/multi_hash.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+
+/**
+ *  \brief  Measure data processor throughput
+ *
+ *  \param  proc        Data processor
+ *  \param  data        Data
+ *  \param  chunk_size  Data chunk size
+ *  \param  rounds      Number of rounds over the data
+ *
+ *  \return Throughput [MiB/s]
+ */
+static double throughput(
+    fastcrawl::online_data_processor & proc,
+    std::vector<unsigned char> &       data,
+    size_t                             chunk_size,
+    size_t                             rounds)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t round = 0; round < rounds; ++round)
+        for (size_t off = 0; off < data.size(); off += chunk_size)
+            proc(data.data() + off, std::min(chunk_size, data.size() - off));
+
+    const std::chrono::duration<double> time_s =
+        std::chrono::steady_clock::now() - start;
+
+    return (double)(data.size() * rounds) / (1024 * 1024) / time_s.count();
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const size_t data_size = (argc > 1 ? ::atoi(argv[1]) : 64) << 20;
+
+    std::vector<unsigned char> data(data_size);
+    for (size_t i = 0; i < data_size; ++i)
+        data[i] = (unsigned char)(i * 2654435761u >> 13);
+
+    static const size_t chunk_sizes[] = {
+        16 << 10,   // typical cURL write callback chunk
+        1  << 20,
+        16 << 20,
+    };
+
+    std::cout
+        << "Digests over " << (data_size >> 20) << " MiB, CRC32C "
+        << (fastcrawl::crc32c::hardware() ? "hardware" : "software")
+        << std::endl;
+
+    for (auto with_sha256: { false, true }) {
+        std::cout
+            << (with_sha256
+                ? "Adler32, CRC32C, XXH3, SHA-256:"
+                : "Adler32, CRC32C, XXH3:")
+            << std::endl;
+
+        for (auto chunk_size: chunk_sizes) {
+            uint32_t                    adler32_res, crc32c_res;
+            uint64_t                    xxh3_res;
+            fastcrawl::sha256::digest_t sha256_res;
+            fastcrawl::content_digests  digests;
+
+            // Chained separate processors
+            double chained;
+            if (with_sha256) {
+                auto proc = fastcrawl::data_processor(
+                    fastcrawl::adler32(adler32_res),
+                    fastcrawl::crc32c(crc32c_res),
+                    fastcrawl::xxh3(xxh3_res),
+                    fastcrawl::sha256(sha256_res));
+
+                chained = throughput(proc, data, chunk_size, 2);
+            }
+            else {
+                auto proc = fastcrawl::data_processor(
+                    fastcrawl::adler32(adler32_res),
+                    fastcrawl::crc32c(crc32c_res),
+                    fastcrawl::xxh3(xxh3_res));
+
+                chained = throughput(proc, data, chunk_size, 2);
+            }
+
+            // Fused processor
+            double fused;
+            {
+                fastcrawl::multi_hash proc(
+                    fastcrawl::content_digests::ADLER32 |
+                    fastcrawl::content_digests::CRC32C  |
+                    fastcrawl::content_digests::XXH3    |
+                    (with_sha256 ? fastcrawl::content_digests::SHA256 : 0),
+                    digests);
+
+                fused = throughput(proc, data, chunk_size, 2);
+            }
+
+            if (digests.crc32c != crc32c_res || digests.xxh3 != xxh3_res) {
+                std::cerr << "Digests mismatch" << std::endl;
+                return 1;
+            }
+
+            std::cout
+                << "    chunk " << std::setw(6) << (chunk_size >> 10) << " KiB: "
+                << std::fixed << std::setprecision(1)
+                << "chained " << std::setw(8) << chained << " MiB/s, "
+                << "fused "   << std::setw(8) << fused   << " MiB/s, "
+                << "speedup " << std::setprecision(2) << fused / chained
+                << std::endl;
+        }
+    }
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,578 @@
+/**
+ *  \file
+ *  \brief  Synthetic HTTP content server
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "http_server.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+}
+
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cerrno>
+
+extern "C" {
+#include <zlib.h>
+}
+
+
+namespace fastcrawl {
+
+/** Throw system error */
+[[noreturn]] static void error(const std::string & what) {
+    throw std::runtime_error("HTTP server: " + what + ": " + std::strerror(errno));
+}
+
+
+/** SplitMix64 hash (deterministic pseudo-random values) */
+inline static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+
+/** Uniform pseudo-random value on [0, 1) */
+inline static double uniform(uint64_t seed, uint64_t index, uint64_t stream) {
+    return (splitmix64(splitmix64(seed ^ stream) + index) >> 11) / 9007199254740992.0;
+}
+
+
+/** Object body data (repeated pattern) */
+static const char * object_data() {
+    static const std::string data = []() {
+        std::string str(65536, '\0');
+        for (size_t i = 0; i < str.size(); ++i)
+            str[i] = 'a' + (i * 7 + i / 26) % 26;
+
+        return str;
+    }();
+
+    return data.data();
+}
+
+static const size_t object_data_size = 65536;  /**< Object data size */
+
+
+/** Gzip-compress data */
+static std::string gzip_compress(const std::string & data) {
+    ::z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+
+    // Window bits 15 + 16 means gzip wrapper
+    if (Z_OK != ::deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+        15 + 16, 8, Z_DEFAULT_STRATEGY))
+    {
+        throw std::runtime_error("HTTP server: deflateInit2 failed");
+    }
+
+    std::string out(::deflateBound(&zs, data.size()), '\0');
+
+    zs.next_in   = (Bytef *)data.data();
+    zs.avail_in  = data.size();
+    zs.next_out  = (Bytef *)&out[0];
+    zs.avail_out = out.size();
+
+    const int res = ::deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    ::deflateEnd(&zs);
+
+    if (Z_STREAM_END != res)
+        throw std::runtime_error("HTTP server: deflate failed");
+
+    return out;
+}
+
+
+http_server::http_server(const config & conf, uint16_t port):
+    m_config(conf),
+    m_stop_fd{-1, -1},
+    m_port(port),
+    m_stop(false),
+    m_connections(0),
+    m_requests(0)
+{
+    try {
+        if (::pipe(m_stop_fd)) error("pipe");
+
+        if (m_config.hosts < 1 || m_config.hosts > 254)
+            throw std::runtime_error("HTTP server: 1 to 254 hosts supported");
+
+        // 127.0.0.1 (gets the port), 127.0.0.2... (on the same port)
+        for (unsigned host = 0; host < m_config.hosts; ++host) {
+            const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) error("socket");
+
+            m_listen_fds.push_back(fd);
+
+            const int reuse = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+            struct ::sockaddr_in addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sin_family      = AF_INET;
+            addr.sin_port        = htons(m_port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK + host);
+
+            if (::bind(fd, (struct ::sockaddr *)&addr, sizeof(addr)))
+                error("bind to port " + std::to_string(m_port));
+
+            if (::listen(fd, 1024)) error("listen");
+
+            ::socklen_t addr_len = sizeof(addr);
+            if (::getsockname(fd, (struct ::sockaddr *)&addr, &addr_len))
+                error("getsockname");
+
+            m_port = ntohs(addr.sin_port);
+        }
+    }
+    catch (...) {
+        close();
+        throw;
+    }
+}
+
+
+std::string http_server::base_uri(unsigned host) const {
+    return "http://127.0.0." + std::to_string(1 + host) + ":" +
+        std::to_string(m_port) + "/";
+}
+
+
+size_t http_server::object_size(size_t index) const {
+    const double mean = m_config.object_size;
+
+    switch (m_config.distribution) {
+        case UNIFORM:
+            return (size_t)(2 * mean * uniform(m_config.seed, index, 1));
+
+        case LOGNORMAL: {
+            // Box-Muller standard normal; mu set so that the mean fits
+            const double u1 = 1 - uniform(m_config.seed, index, 1);
+            const double u2 = uniform(m_config.seed, index, 2);
+            const double z  = std::sqrt(-2 * std::log(u1)) * std::cos(2 * M_PI * u2);
+
+            return (size_t)std::exp(std::log(mean) - 0.5 + z);
+        }
+
+        case FIXED:
+        default:
+            return m_config.object_size;
+    }
+}
+
+
+bool http_server::trickled(size_t index) const {
+    return uniform(m_config.seed, index, 3) < m_config.trickle_ratio;
+}
+
+
+std::string http_server::page() const {
+    static const char * const refs[] = {
+        "<img src=\"/obj/%zu\" alt=\"image %zu\">",
+        "<script src=\"/obj/%zu\" type=\"text/javascript\"></script><!-- %zu -->",
+        "<a href=\"/obj/%zu\">link %zu</a>",
+        "<iframe src=\"/obj/%zu\" title=\"frame %zu\"></iframe>",
+    };
+
+    std::stringstream html;
+    html
+        << "<!DOCTYPE html>\n"
+        << "<html>\n<head><title>Benchmark page</title>";
+
+    if (m_config.css_references)
+        html << "<link rel=\"stylesheet\" href=\"/style\">";
+
+    html << "</head>\n<body>\n";
+
+    // Multiple hosts: absolute references (to the "/obj/" path)
+    std::vector<std::string> hosts;
+    if (m_config.hosts > 1)
+        for (unsigned host = 0; host < m_config.hosts; ++host) {
+            hosts.push_back(base_uri(host));
+            hosts.back().pop_back();
+        }
+
+    char line[256];
+    for (size_t i = 0; i < m_config.references; ++i) {
+        std::snprintf(line, sizeof(line), refs[i % 4], i, i);
+
+        std::string ref = line;
+        if (!hosts.empty()) {
+            const size_t pos = ref.find("\"/obj/") + 1;
+            ref.insert(pos, hosts[i % hosts.size()]);
+        }
+
+        html << "<p>Paragraph " << i << ": " << ref << "</p>\n";
+    }
+
+    html << "</body>\n</html>\n";
+
+    return html.str();
+}
+
+
+std::string http_server::stylesheet() const {
+    static const char * const refs[] = {
+        ".c%zu { background: url(/obj/%zu); }",
+        ".c%zu { background-image: URL( \"../img/./../obj/%zu\" ); }",
+        "@font-face { font-family: f%zu; src: url('/obj/%zu') format(\"woff\"); }",
+        ".c%zu::after { content: \"url(x)\"; background: url(obj/%zu); }",
+        "@import \"/obj/%zu\"; /* url(/obj/%zu) */",
+    };
+
+    std::stringstream css;
+    css << "/* Benchmark stylesheet: url(/ignored) */\n";
+
+    char line[256];
+    for (size_t i = 0; i < m_config.css_references; ++i) {
+        const size_t index = m_config.references + i;
+
+        if (4 == i % 5)  // comment after import (same reference)
+            std::snprintf(line, sizeof(line), refs[4], index, index);
+        else
+            std::snprintf(line, sizeof(line), refs[i % 5], i, index);
+
+        css << line << '\n';
+    }
+
+    return css.str();
+}
+
+
+bool http_server::readable(int fd) {
+    struct ::pollfd fds[2];
+    fds[0].fd = fd;           fds[0].events = POLLIN;
+    fds[1].fd = m_stop_fd[0]; fds[1].events = POLLIN;
+
+    for (;;) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (EINTR == errno) continue;
+            return false;
+        }
+
+        return !fds[1].revents && fds[0].revents;
+    }
+}
+
+
+bool http_server::send(int fd, const char * data, size_t size) {
+    for (size_t sent = 0; sent < size; ) {
+        const ssize_t len = ::send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (len <= 0) return false;
+
+        sent += len;
+    }
+
+    return true;
+}
+
+
+bool http_server::respond(
+    int                 fd,
+    const char *        status,
+    const char *        type,
+    const char *        body,
+    size_t              size,
+    size_t              rate,
+    bool                keep_alive,
+    bool                gzip)
+{
+    if (m_config.latency_ms)
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_config.latency_ms));
+
+    // Body pieces (paced to the rate)
+    const size_t piece = rate
+        ? std::max<size_t>(256, std::min<size_t>(16384, rate / 100))
+        : 16384;
+
+    // Compressed body is sent as a whole
+    const bool encoded = gzip && size;
+
+    std::string gzip_body;
+    if (encoded) {
+        if (body) {
+            gzip_body = gzip_compress(std::string(body, size));
+            body = gzip_body.data();
+            size = gzip_body.size();
+        }
+        else {
+            const auto & object = gzip_object(size, piece);
+            body = object.data();
+            size = object.size();
+        }
+    }
+
+    std::stringstream head;
+    head << "HTTP/1.1 " << status << "\r\n"
+         << "Content-Type: " << type << "\r\n";
+
+    if (encoded) head << "Content-Encoding: gzip\r\n";
+
+    if (m_config.chunked)
+        head << "Transfer-Encoding: chunked\r\n";
+    else
+        head << "Content-Length: " << size << "\r\n";
+
+    if (!keep_alive) head << "Connection: close\r\n";
+    head << "\r\n";
+
+    const std::string head_str = head.str();
+    if (!send(fd, head_str.data(), head_str.size())) return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < size; ) {
+        if (m_stop.load(std::memory_order_relaxed)) return false;
+
+        const size_t len = std::min(piece, size - offset);
+        const char * data = body
+            ? body + offset
+            : object_data() + offset % (object_data_size - piece);
+
+        if (m_config.chunked) {
+            char chunk_head[24];
+            const int head_len = std::snprintf(chunk_head, sizeof(chunk_head), "%zx\r\n", len);
+            if (!send(fd, chunk_head, head_len)) return false;
+        }
+
+        if (!send(fd, data, len)) return false;
+        if (m_config.chunked && !send(fd, "\r\n", 2)) return false;
+
+        offset += len;
+
+        if (rate)
+            std::this_thread::sleep_until(start +
+                std::chrono::microseconds((uint64_t)offset * 1000000 / rate));
+    }
+
+    if (m_config.chunked && !send(fd, "0\r\n\r\n", 5)) return false;
+
+    return true;
+}
+
+
+const std::string & http_server::gzip_object(size_t size, size_t piece) {
+    std::lock_guard<std::mutex> lock(m_gzip_mutex);
+
+    auto & object = m_gzip_cache[std::make_pair(size, piece)];
+    if (object.empty()) {
+        // Same data as sent uncompressed
+        std::string data;
+        data.reserve(size);
+        for (size_t offset = 0; offset < size; offset += piece)
+            data.append(object_data() + offset % (object_data_size - piece),
+                std::min(piece, size - offset));
+
+        object = gzip_compress(data);
+    }
+
+    return object;
+}
+
+
+void http_server::serve(int fd) {
+    const int nodelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    const std::string page_str = page();
+    const std::string css_str  = stylesheet();
+
+    std::string request;
+    char buffer[4096];
+    for (bool keep_alive = true; keep_alive; ) {
+        // Read request head
+        size_t head_end;
+        while (std::string::npos == (head_end = request.find("\r\n\r\n"))) {
+            if (!readable(fd)) return;
+
+            const ssize_t len = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (len <= 0) return;
+
+            request.append(buffer, len);
+            if (request.size() > 65536) return;  // nonsense
+        }
+
+        const std::string head = request.substr(0, head_end);
+        request.erase(0, head_end + 4);  // GET requests have no body
+        ++m_requests;
+
+        keep_alive =
+            std::string::npos == head.find("\r\nConnection: close") &&
+            std::string::npos == head.find("\r\nconnection: close");
+
+        // Compressed response (only gzip is supported)
+        bool gzip = false;
+        if (m_config.gzip) {
+            size_t accept = head.find("\r\nAccept-Encoding:");
+            if (std::string::npos == accept)
+                accept = head.find("\r\naccept-encoding:");
+
+            if (std::string::npos != accept) {
+                const size_t eol = head.find("\r\n", accept + 2);
+                gzip = std::string::npos != head.substr(accept, eol - accept).find("gzip");
+            }
+        }
+
+        // Request target
+        const size_t path_begin = head.find(' ') + 1;
+        const size_t path_end   = head.find(' ', path_begin);
+        const std::string path  = head.substr(path_begin, path_end - path_begin);
+
+        bool ok;
+        if (0 != head.compare(0, 4, "GET "))
+            ok = respond(fd, "405 Method Not Allowed", "text/plain",
+                "", 0, 0, false);
+
+        else if ("/" == path || "/index.html" == path)
+            ok = respond(fd, "200 OK", "text/html",
+                page_str.data(), page_str.size(), m_config.bandwidth, keep_alive,
+                gzip);
+
+        else if ("/style" == path && m_config.css_references)
+            ok = respond(fd, "200 OK", "text/css",
+                css_str.data(), css_str.size(), m_config.bandwidth, keep_alive,
+                gzip);
+
+        else if (0 == path.compare(0, 5, "/obj/")) {
+            const size_t index = std::strtoul(path.c_str() + 5, nullptr, 10);
+
+            ok = respond(fd, "200 OK", "application/octet-stream",
+                nullptr, object_size(index),
+                trickled(index) ? m_config.trickle_rate : m_config.bandwidth,
+                keep_alive, gzip);
+        }
+
+        else
+            ok = respond(fd, "404 Not Found", "text/plain", "", 0, 0, keep_alive);
+
+        if (!ok) return;
+    }
+}
+
+
+void http_server::run() {
+    // Stop pipe first, then the listening sockets
+    std::vector<struct ::pollfd> fds(1 + m_listen_fds.size());
+    fds[0].fd = m_stop_fd[0]; fds[0].events = POLLIN;
+    for (size_t i = 0; i < m_listen_fds.size(); ++i) {
+        fds[1 + i].fd     = m_listen_fds[i];
+        fds[1 + i].events = POLLIN;
+    }
+
+    for (;;) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (EINTR == errno) continue;
+            break;
+        }
+
+        if (fds[0].revents) break;  // stop
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (!(fds[i].revents & POLLIN)) continue;
+
+            const int fd = ::accept4(fds[i].fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_connections;
+            }
+
+            std::thread([this, fd]() {
+                serve(fd);
+                ::close(fd);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_connections;
+                m_closed.notify_all();
+            }).detach();
+        }
+    }
+}
+
+
+void http_server::start() {
+    m_thread = std::thread(&http_server::run, this);
+}
+
+
+void http_server::stop() {
+    if (m_stop.exchange(true)) return;  // stopped already
+
+    const char stop = 0;
+    if (::write(m_stop_fd[1], &stop, 1) < 0) {}  // can't fail (pipe is empty)
+
+    if (m_thread.joinable()) m_thread.join();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_closed.wait(lock, [this]() { return 0 == m_connections; });
+}
+
+
+void http_server::close() {
+    for (const int fd: m_listen_fds) ::close(fd);
+    m_listen_fds.clear();
+
+    if (m_stop_fd[0] >= 0) ::close(m_stop_fd[0]);
+    if (m_stop_fd[1] >= 0) ::close(m_stop_fd[1]);
+
+    m_stop_fd[0] = m_stop_fd[1] = -1;
+}
+
+
+http_server::~http_server() {
+    stop();
+    close();
+}
+
+}  // end of namespace fastcrawl
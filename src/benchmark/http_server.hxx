@@ -0,0 +1,246 @@
+#ifndef fastcrawl__http_server_hxx
+#define fastcrawl__http_server_hxx
+
+/**
+ *  \file
+ *  \brief  Synthetic HTTP content server
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Synthetic HTTP/1.1 content server
+ *
+ *  Local stand-in for real web servers, for reproducible crawl benchmarks.
+ *  Serves a generated HTML page (on \c / and \c /index.html) with
+ *  a configurable number of content references (\c /obj/<n>) and
+ *  the referenced objects.
+ *  Object sizes follow a configurable distribution (deterministic for
+ *  a given seed); responses may be delayed, bandwidth-capped, chunked
+ *  or trickled slowly.
+ *  The page may link a stylesheet (\c /style, \c text/css without
+ *  the \c .css suffix) with further references (\c url() values,
+ *  some with dot segments; objects indexed after the page ones).
+ *  Responses may be gzip-compressed (if the client accepts it); note that
+ *  the generated content is a repeated pattern, so it compresses well.
+ *
+ *  The content may be spread over several hosts: loopback addresses
+ *  \c 127.0.0.1, \c 127.0.0.2 etc. (the references are absolute then).
+ *
+ *  Connections are served by threads (one per connection, keep-alive
+ *  is supported).
+ *  The server is started by \ref start (in a background thread)
+ *  or \ref run (in the current thread, e.g. in a forked process).
+ */
+class http_server {
+    public:
+
+    /** Object size distribution */
+    enum size_distribution {
+        FIXED = 0,  /**< All objects have the mean size         */
+        UNIFORM,    /**< Uniform on [0, 2 * mean size]          */
+        LOGNORMAL,  /**< Log-normal (sigma 1) with the mean size */
+    };
+
+    /** Server configuration */
+    struct config {
+        size_t            references;       /**< References on the page     */
+        size_t            object_size;      /**< Mean object size [B]       */
+        size_distribution distribution;     /**< Object size distribution   */
+        unsigned          latency_ms;       /**< Response latency [ms]      */
+        size_t            bandwidth;        /**< Per-response cap [B/s]     */
+        bool              chunked;          /**< Chunked transfer encoding  */
+        double            trickle_ratio;    /**< Trickled objects ratio     */
+        size_t            trickle_rate;     /**< Trickle rate [B/s]         */
+        uint64_t          seed;             /**< Object sizes seed          */
+        unsigned          hosts;            /**< Content hosts (loopback)   */
+        bool              gzip;             /**< Gzip if accepted           */
+        size_t            css_references;   /**< Stylesheet references      */
+
+        /** Default configuration */
+        config():
+            references(100),
+            object_size(16384),
+            distribution(FIXED),
+            latency_ms(0),
+            bandwidth(0),
+            chunked(false),
+            trickle_ratio(0),
+            trickle_rate(16384),
+            seed(1),
+            hosts(1),
+            gzip(false),
+            css_references(0)
+        {}
+
+    };  // end of struct config
+
+    private:
+
+    const config            m_config;       /**< Configuration           */
+    std::vector<int>        m_listen_fds;   /**< Listening sockets       */
+    int                     m_stop_fd[2];   /**< Stop pipe (read, write) */
+    uint16_t                m_port;         /**< Listening port          */
+    std::atomic<bool>       m_stop;         /**< Stop flag               */
+    size_t                  m_connections;  /**< Open connections        */
+    std::atomic<size_t>     m_requests;     /**< Requests received       */
+    std::mutex              m_mutex;        /**< Connections mutex       */
+    std::condition_variable m_closed;       /**< Connection closed       */
+    std::thread             m_thread;       /**< Server thread           */
+
+    /** Compressed object bodies (by size and rate) */
+    std::map<std::pair<size_t, size_t>, std::string> m_gzip_cache;
+    std::mutex              m_gzip_mutex;   /**< Compressed bodies mutex */
+
+    /** Serve connection */
+    void serve(int fd);
+
+    /**
+     *  \brief  Send response
+     *
+     *  \param  fd          Connection
+     *  \param  status      Status line
+     *  \param  type        Content type
+     *  \param  body        Body (or \c nullptr for generated object body)
+     *  \param  size        Body size
+     *  \param  rate        Rate limit [B/s] (0 means no limit)
+     *  \param  keep_alive  Keep connection alive
+     *  \param  gzip        Compress the body (gzip content encoding)
+     *
+     *  \return \c true iff the response was sent
+     */
+    bool respond(
+        int                 fd,
+        const char *        status,
+        const char *        type,
+        const char *        body,
+        size_t              size,
+        size_t              rate,
+        bool                keep_alive,
+        bool                gzip = false);
+
+    /** Compressed generated object body (cached) */
+    const std::string & gzip_object(size_t size, size_t piece);
+
+    /**
+     *  \brief  Send data (paced by rate limit)
+     *
+     *  \return \c true iff the data were sent
+     */
+    bool send(int fd, const char * data, size_t size);
+
+    /** Wait for connection readability (or stop) */
+    bool readable(int fd);
+
+    /** Release resources */
+    void close();
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Binds the listening socket(s) (on the loopback interface).
+     *
+     *  \param  conf  Configuration
+     *  \param  port  Listening port (0 means any free port)
+     *
+     *  \throw  std::runtime_error if the socket can't be bound
+     */
+    http_server(const config & conf = config(), uint16_t port = 0);
+
+    http_server(const http_server & ) = delete;
+    http_server & operator = (const http_server & ) = delete;
+
+    /** Configuration */
+    const config & get_config() const { return m_config; }
+
+    /** Listening port */
+    uint16_t port() const { return m_port; }
+
+    /**
+     *  \brief  Base URI of the server
+     *
+     *  \param  host  Host index (see \ref config::hosts)
+     */
+    std::string base_uri(unsigned host = 0) const;
+
+    /** Object size */
+    size_t object_size(size_t index) const;
+
+    /** Object is trickled */
+    bool trickled(size_t index) const;
+
+    /** Generated HTML page */
+    std::string page() const;
+
+    /** Generated stylesheet */
+    std::string stylesheet() const;
+
+    /** Number of requests received */
+    size_t requests() const { return m_requests; }
+
+    /** Serve requests in current thread (till \ref stop) */
+    void run();
+
+    /** Serve requests in background thread */
+    void start();
+
+    /** Stop serving (and wait for connections to close) */
+    void stop();
+
+    /** Destructor (stops the server) */
+    ~http_server();
+
+};  // end of class http_server
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__http_server_hxx
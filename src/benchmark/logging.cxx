@@ -0,0 +1,208 @@
+/**
+ *  \file
+ *  \brief  Logging overhead benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/logger.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdio>
+
+#include <unistd.h>
+
+
+/** Former logging macro expansion (direct \c stderr streaming) */
+#define DIRECT_LOG std::cerr
+
+
+/** Logging thread body */
+class log_source: public fastcrawl::logger {
+    public:
+
+    enum mode_t {
+        DIRECT = 0,  /**< Direct \c std::cerr streaming */
+        ASYNC,       /**< Asynchronous backend (LOG)    */
+        DISABLED,    /**< Verbose level disabled (VLOG) */
+    };  // end of enum mode_t
+
+    /** Log lines, typical download record */
+    static void run(mode_t mode, unsigned thread, size_t lines) {
+        log_source src;  // m_vlog is false
+
+        for (size_t i = 0; i < lines; ++i) {
+            switch (mode) {
+                case DIRECT:
+                    DIRECT_LOG
+                        << "http://127.0.0.1:8765/obj/" << thread << '/' << i
+                        << " 200 4096 B in " << 0.0125 << " s" << std::endl;
+                    break;
+
+                case ASYNC:
+                    LOG
+                        << "http://127.0.0.1:8765/obj/" << thread << '/' << i
+                        << " 200 4096 B in " << 0.0125 << " s" << std::endl;
+                    break;
+
+                case DISABLED:
+                    src.vlog(thread, i);
+                    break;
+            }
+        }
+    }
+
+    private:
+
+    void vlog(unsigned thread, size_t i) {
+        VLOG
+            << "http://127.0.0.1:8765/obj/" << thread << '/' << i
+            << " 200 4096 B in " << 0.0125 << " s" << std::endl;
+    }
+
+};  // end of class log_source
+
+
+/**
+ *  \brief  Measure logging
+ *
+ *  \param  mode     Logging mode
+ *  \param  threads  Number of logging threads
+ *  \param  lines    Lines per thread
+ *  \param  drain_s  Time to drain after logging threads finish [s]
+ *
+ *  \return Logging thread time per line [ns]
+ */
+static double measure(
+    log_source::mode_t mode,
+    unsigned           threads,
+    size_t             lines,
+    double &           drain_s)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i)
+        workers.emplace_back(&log_source::run, mode, i, lines);
+
+    for (auto & worker: workers) worker.join();
+
+    const auto done = std::chrono::steady_clock::now();
+
+    fastcrawl::log_flush();
+
+    const std::chrono::duration<double> log_time_s   = done - start;
+    const std::chrono::duration<double> drain_time_s =
+        std::chrono::steady_clock::now() - done;
+
+    drain_s = drain_time_s.count();
+    return log_time_s.count() * 1e9 / (threads * lines);
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const size_t      lines  = argc > 1 ? ::atoi(argv[1]) : 100000;
+    const std::string output = argc > 2 ? argv[2] : "/tmp/bench_logging.log";
+
+    // Redirect stderr to the output file
+    std::FILE * out = std::fopen(output.c_str(), "w");
+    if (nullptr == out)
+        throw std::runtime_error("bench_logging: failed to open " + output);
+
+    const int stderr_fd = ::dup(2);
+    ::dup2(::fileno(out), 2);
+    std::fclose(out);
+
+    std::cout
+        << "Log overhead [ns/line] (" << lines << " lines per thread to "
+        << output << "), " << std::thread::hardware_concurrency() << " CPUs"
+        << std::endl;
+
+    for (unsigned threads = 1; threads <= 8; threads *= 2) {
+        double drain_s, async_drain_s;
+        const double direct   = measure(log_source::DIRECT,   threads, lines, drain_s);
+        const double async    = measure(log_source::ASYNC,    threads, lines, async_drain_s);
+        const double disabled = measure(log_source::DISABLED, threads, lines, drain_s);
+
+        std::cout
+            << threads << " threads: "
+            << std::fixed << std::setprecision(1)
+            << "direct " << direct
+            << ", async " << async
+            << " (+" << std::setprecision(3) << async_drain_s << " s drain)"
+            << std::setprecision(1)
+            << ", disabled " << disabled
+            << ", speedup " << std::setprecision(2) << direct / async
+            << std::endl;
+    }
+
+    ::dup2(stderr_fd, 2);
+    ::close(stderr_fd);
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
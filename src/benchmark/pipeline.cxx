@@ -0,0 +1,207 @@
+/**
+ *  \file
+ *  \brief  Data processor pipeline benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/online_data_processor.hxx"
+#include "libfastcrawl/processor_pipeline.hxx"
+#include "libfastcrawl/content_size.hxx"
+#include "libfastcrawl/adler32.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+
+/**
+ *  \brief  Virtual call chain (for comparison)
+ *
+ *  Calls each processor via \ref online_data_processor interface.
+ */
+class virtual_chain: public fastcrawl::online_data_processor {
+    private:
+
+    std::vector<std::unique_ptr<fastcrawl::online_data_processor> > m_procs;
+
+    public:
+
+    void add(fastcrawl::online_data_processor * proc) {
+        m_procs.emplace_back(proc);
+    }
+
+    void operator () (unsigned char * data, size_t size) {
+        for (auto & proc: m_procs)
+            (*proc)(data, size);
+    }
+
+};  // end of class virtual_chain
+
+
+/**
+ *  \brief  Measure per-chunk processing time
+ *
+ *  The processor is called via \ref online_data_processor interface
+ *  (as it is during download).
+ *
+ *  \param  proc        Data processor
+ *  \param  data        Data
+ *  \param  chunk_size  Data chunk size
+ *  \param  chunks      Number of chunks to process
+ *
+ *  \return Time per chunk [ns]
+ */
+static double chunk_time(
+    fastcrawl::online_data_processor & proc,
+    std::vector<unsigned char> &       data,
+    size_t                             chunk_size,
+    size_t                             chunks)
+{
+    const size_t data_chunks = data.size() / chunk_size;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < chunks; ++i)
+        proc(data.data() + (i % data_chunks) * chunk_size, chunk_size);
+
+    const std::chrono::duration<double, std::nano> time_ns =
+        std::chrono::steady_clock::now() - start;
+
+    return time_ns.count() / chunks;
+}
+
+
+/** Print benchmark result line */
+static void report(const char * name, double compound, double pipeline, double chain) {
+    std::cout
+        << std::setw(28) << std::left << name << std::right
+        << std::fixed << std::setprecision(2)
+        << "compound "          << std::setw(8) << compound << " ns, "
+        << "runtime pipeline "  << std::setw(8) << pipeline << " ns, "
+        << "virtual chain "     << std::setw(8) << chain    << " ns"
+        << std::endl;
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const size_t chunks = argc > 1 ? ::atoi(argv[1]) : 20000000;
+
+    std::vector<unsigned char> data(1 << 20);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (unsigned char)(i * 2654435761u >> 13);
+
+    fastcrawl::uri_record record;
+    size_t   size1, size2, size3, size4;
+    uint32_t checksum;
+
+    std::cout << "Per-chunk processing time:" << std::endl;
+
+    // Dispatch overhead (4 trivial processors, tiny chunks)
+    {
+        auto compound = fastcrawl::data_processor(
+            fastcrawl::content_size(size1),
+            fastcrawl::content_size(size2),
+            fastcrawl::content_size(size3),
+            fastcrawl::content_size(size4));
+
+        fastcrawl::processor_pipeline pipeline;
+        fastcrawl::pipeline_builder("size,size,size,size")
+            .build(pipeline, record);
+
+        virtual_chain chain;
+        chain.add(new fastcrawl::content_size(size1));
+        chain.add(new fastcrawl::content_size(size2));
+        chain.add(new fastcrawl::content_size(size3));
+        chain.add(new fastcrawl::content_size(size4));
+
+        report("4 x size, 64 B chunk",
+            chunk_time(compound, data, 64, chunks),
+            chunk_time(pipeline, data, 64, chunks),
+            chunk_time(chain,    data, 64, chunks));
+    }
+
+    // Default download pipeline, typical cURL chunk size
+    {
+        auto compound = fastcrawl::data_processor(
+            fastcrawl::adler32(checksum),
+            fastcrawl::content_size(size1));
+
+        fastcrawl::processor_pipeline pipeline;
+        fastcrawl::pipeline_builder("adler32,size")
+            .build(pipeline, record);
+
+        virtual_chain chain;
+        chain.add(new fastcrawl::adler32(checksum));
+        chain.add(new fastcrawl::content_size(size1));
+
+        report("adler32,size, 16 KiB chunk",
+            chunk_time(compound, data, 16 << 10, chunks / 1000),
+            chunk_time(pipeline, data, 16 << 10, chunks / 1000),
+            chunk_time(chain,    data, 16 << 10, chunks / 1000));
+    }
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,293 @@
+/**
+ *  \file
+ *  \brief  HTML segmenter benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/html_crawler.hxx"
+#include "libfastcrawl/html_segmenter.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+
+
+/** Synthetic page (resembling real-world markup) */
+static std::string synthetic_page(size_t paragraphs) {
+    std::stringstream html;
+
+    html
+        << "<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n"
+        << "  <meta charset=\"utf-8\">\n"
+        << "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n"
+        << "  <title>Synthetic benchmark page</title>\n"
+        << "  <link rel=\"stylesheet\" href=\"/css/main.css\">\n"
+        << "  <script src=\"/js/vendor.js\" async></script>\n"
+        << "  <script>\n    if (a < b && c > d) { document.title = '<x>'; }\n  </script>\n"
+        << "</head>\n<body class=\"page\">\n";
+
+    for (size_t i = 0; i < paragraphs; ++i) {
+        html
+            << "  <!-- section " << i << " -->\n"
+            << "  <div class=\"section\" id=\"s" << i << "\" data-index='" << i << "'>\n"
+            << "    <h2>Section " << i << "</h2>\n"
+            << "    <p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do\n"
+            << "    eiusmod tempor incididunt ut labore et dolore magna aliqua &amp; more.\n"
+            << "    <a href=\"/articles/" << i << "?ref=home&amp;page=" << i % 7
+            << "\" title=\"Article " << i << "\">Read more</a></p>\n"
+            << "    <img src=\"/img/photo_" << i << ".jpg\" alt=\"Photo " << i
+            << "\" width=\"640\" height=\"480\" loading=\"lazy\">\n";
+
+        if (0 == i % 10)
+            html
+                << "    <iframe src=\"https://video.example.com/embed/" << i
+                << "\" allowfullscreen></iframe>\n";
+
+        html << "  </div>\n";
+    }
+
+    html << "</body>\n</html>\n";
+
+    return html.str();
+}
+
+
+/** Read file */
+static std::string read_file(const char * filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) throw std::runtime_error(std::string("failed to read ") + filename);
+
+    std::stringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+
+/** Reference counting sink */
+struct counting_sink {
+    size_t * refs;  /**< Found references counter */
+
+    void operator () (
+        const std::string & , const std::string & , const std::string & ,
+        size_t , size_t ) const
+    {
+        ++*refs;
+    }
+
+};  // end of struct counting_sink
+
+
+/**
+ *  \brief  Segment corpus by the crawler (default instantiation)
+ *
+ *  \param  corpus  Pages
+ *  \param  chunk   Chunk size
+ *  \param  refs    Found references counter
+ */
+static void segment_crawler(
+    std::vector<std::vector<unsigned char> > & corpus,
+    size_t                                     chunk,
+    size_t &                                   refs)
+{
+    for (auto & page: corpus) {
+        fastcrawl::html_crawler crawler("localhost", 1);
+        crawler.on_reference([&refs](
+            const std::string & , const std::string & , const std::string & ,
+            size_t , size_t )
+        {
+            ++refs;  // URI processing stubbed out
+        });
+
+        for (size_t offset = 0; offset < page.size(); offset += chunk)
+            crawler(page.data() + offset, std::min(chunk, page.size() - offset));
+    }
+}
+
+
+/**
+ *  \brief  Segment corpus by policy-specialised segmenter
+ *
+ *  \tparam  Segmenter  \ref fastcrawl::html_segmenter instantiation
+ *
+ *  \param  corpus  Pages
+ *  \param  chunk   Chunk size
+ *  \param  refs    Found references counter
+ */
+template <class Segmenter>
+static void segment(
+    std::vector<std::vector<unsigned char> > & corpus,
+    size_t                                     chunk,
+    size_t &                                   refs)
+{
+    for (auto & page: corpus) {
+        Segmenter segmenter(counting_sink{&refs});
+
+        for (size_t offset = 0; offset < page.size(); offset += chunk)
+            segmenter(page.data() + offset, std::min(chunk, page.size() - offset));
+    }
+}
+
+
+/**
+ *  \brief  Measure segmentation throughput
+ *
+ *  \param  corpus       Pages
+ *  \param  corpus_size  Pages total size
+ *  \param  chunk        Chunk size
+ *  \param  fn           Segmenting function
+ *  \param  refs         References found per round
+ *
+ *  \return Throughput [MB/s]
+ */
+template <class Fn>
+static double measure(
+    std::vector<std::vector<unsigned char> > & corpus,
+    size_t                                     corpus_size,
+    size_t                                     chunk,
+    Fn                                         fn,
+    size_t &                                   refs)
+{
+    size_t found  = 0;
+    size_t rounds = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> time_s(0);
+
+    // Repeat for at least 0.25 s
+    do {
+        fn(corpus, chunk, found);
+        ++rounds;
+
+        time_s = std::chrono::steady_clock::now() - start;
+    } while (time_s.count() < 0.25);
+
+    refs = found / rounds;
+    return rounds * corpus_size / 1e6 / time_s.count();
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    using segmenter_t = fastcrawl::html_segmenter<counting_sink>;
+
+    using no_position_t = fastcrawl::html_segmenter<
+        counting_sink, fastcrawl::no_position>;
+
+    using links_t = fastcrawl::html_segmenter<
+        counting_sink, fastcrawl::no_position, fastcrawl::html_link_rules>;
+
+    // Corpus (files given as arguments or a synthetic page)
+    std::vector<std::vector<unsigned char> > corpus;
+    size_t corpus_size = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto page = read_file(argv[i]);
+        corpus.emplace_back(page.begin(), page.end());
+    }
+
+    if (corpus.empty()) {
+        const auto page = synthetic_page(10000);
+        corpus.emplace_back(page.begin(), page.end());
+    }
+
+    for (auto & page: corpus) corpus_size += page.size();
+
+    std::cout
+        << "Segmenting " << corpus.size() << " page(s), "
+        << corpus_size << " B [MB/s]: crawler (default instantiation), "
+        << "segmenter (own sink), no positions, links only (no positions)"
+        << std::endl;
+
+    for (size_t chunk = 1; chunk <= (1 << 20); chunk *= 4) {
+        size_t refs, seg_refs, nopos_refs, link_refs;
+
+        const double crawler = measure(corpus, corpus_size, chunk,
+            segment_crawler, refs);
+        const double seg = measure(corpus, corpus_size, chunk,
+            segment<segmenter_t>, seg_refs);
+        const double nopos = measure(corpus, corpus_size, chunk,
+            segment<no_position_t>, nopos_refs);
+        const double links = measure(corpus, corpus_size, chunk,
+            segment<links_t>, link_refs);
+
+        std::cout
+            << "Chunk size " << std::setw(7) << chunk << " B: "
+            << std::fixed << std::setprecision(2)
+            << std::setw(8) << crawler << " (" << refs << " references), "
+            << std::setw(8) << seg     << " (x" << seg / crawler << "), "
+            << std::setw(8) << nopos   << " (x" << nopos / crawler << "), "
+            << std::setw(8) << links   << " (x" << links / crawler
+            << ", " << link_refs << " references)"
+            << std::endl;
+
+        if (seg_refs != refs || nopos_refs != refs)
+            throw std::logic_error("segmenter variants disagree");
+    }
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
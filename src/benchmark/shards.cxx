@@ -0,0 +1,286 @@
+/**
+ *  \file
+ *  \brief  Shard-per-core crawl runtime scaling benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "http_server.hxx"
+
+#include "libfastcrawl/fastcrawl.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+
+
+/** Remove all files in current directory */
+static void clean_cwd() {
+    auto * dir = ::opendir(".");
+    if (nullptr == dir) return;
+
+    while (auto * entry = ::readdir(dir))
+        if (DT_REG == entry->d_type) ::unlink(entry->d_name);
+
+    ::closedir(dir);
+}
+
+
+/**
+ *  \brief  Crawl the benchmark server page on shards
+ *
+ *  \param  uri       Page URI
+ *  \param  shards    Number of shards
+ *  \param  pin       Pin shards to CPUs
+ *  \param  pipeline  Data processors
+ *  \param  objects   Downloaded objects (output)
+ *  \param  bytes     Received bytes (output)
+ *
+ *  \return Wall-clock time [s]
+ */
+static double crawl(
+    const fastcrawl::uri &              uri,
+    size_t                              shards,
+    bool                                pin,
+    const fastcrawl::pipeline_builder & pipeline,
+    size_t &                            objects,
+    uint64_t &                          bytes)
+{
+    auto & metrics = fastcrawl::metrics::global();
+    const auto values_before = metrics.values();
+
+    fastcrawl::shard_runtime runtime(shards, pin);
+    runtime.pipeline(pipeline);
+
+    const auto start = std::chrono::steady_clock::now();
+    runtime.crawl(uri);
+    const std::chrono::duration<double> time_s =
+        std::chrono::steady_clock::now() - start;
+
+    const auto values_after = metrics.values();
+
+    objects = values_after.completed - values_before.completed - 1;  // page
+    bytes   = values_after.bytes_received - values_before.bytes_received;
+
+    clean_cwd();
+
+    return time_s.count();
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    fastcrawl::http_server::config conf;
+    conf.references  = 10000;
+    conf.object_size = 4096;
+    conf.hosts       = 64;
+
+    size_t      iterations   = 3;
+    size_t      max_shards   = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    bool        pin          = true;
+    std::string pipeline_str = "adler32,size";
+
+    // Usage
+    auto usage = [&argv, &conf, &iterations, &max_shards](std::ostream & out) {
+        out << "Usage: " << argv[0] << " [OPTIONS]" << std::endl
+            << std::endl
+            << "Crawls a page referring content on many hosts (loopback"      << std::endl
+            << "addresses of a local synthetic HTTP/1.1 server running in"    << std::endl
+            << "a child process) by the shard-per-core runtime with 1, 2, 4"  << std::endl
+            << "... shards and reports throughput and scaling."               << std::endl
+            << "Note that the server competes for the CPUs; for meaningful"   << std::endl
+            << "scaling, limit the crawler CPUs (e.g. by taskset) or run it"  << std::endl
+            << "on a machine with spare cores."                               << std::endl
+            << std::endl
+            << "OPTIONS:" << std::endl
+            << "    -h or --help                show this help and exit"      << std::endl
+            << "    -H or --hosts <n>           content hosts (max. 254)"     << std::endl
+            << "    -i or --iterations <n>      crawl iterations per step"    << std::endl
+            << "    -l or --latency <ms>        response latency"             << std::endl
+            << "    -n or --references <n>      references on the page"       << std::endl
+            << "    -N or --no-pin              don't pin shards to CPUs"     << std::endl
+            << "    -p or --pipeline <list>     content data processors"      << std::endl
+            << "    -S or --max-shards <n>      max. number of shards"        << std::endl
+            << "    -s or --size <B>            mean object size"             << std::endl
+            << std::endl
+            << "Defaults: " << conf.references << " references of "
+            << conf.object_size << " B on " << conf.hosts << " hosts, "
+            << iterations << " iterations, up to " << max_shards << " shards"
+            << std::endl;
+    };
+
+    static const struct option long_opts[] {
+        { "help",         no_argument,       nullptr, 'h' },
+        { "hosts",        required_argument, nullptr, 'H' },
+        { "iterations",   required_argument, nullptr, 'i' },
+        { "latency",      required_argument, nullptr, 'l' },
+        { "references",   required_argument, nullptr, 'n' },
+        { "no-pin",       no_argument,       nullptr, 'N' },
+        { "pipeline",     required_argument, nullptr, 'p' },
+        { "max-shards",   required_argument, nullptr, 'S' },
+        { "size",         required_argument, nullptr, 's' },
+
+        { nullptr,        0,                 nullptr, '\0' }  // terminator
+    };
+
+    for (;;) {
+        int long_opt_ix;
+        int opt = ::getopt_long(argc, argv, "hH:i:l:n:Np:S:s:",
+            long_opts, &long_opt_ix);
+        if (-1 == opt) break;  // no more options
+
+        switch (opt) {
+            case 'h': usage(std::cout); return 0;
+            case 'H': conf.hosts       = ::atoi(::optarg); break;
+            case 'i': iterations       = ::atol(::optarg); break;
+            case 'l': conf.latency_ms  = ::atoi(::optarg); break;
+            case 'n': conf.references  = ::atol(::optarg); break;
+            case 'N': pin              = false;            break;
+            case 'p': pipeline_str     = ::optarg;         break;
+            case 'S': max_shards       = ::atol(::optarg); break;
+            case 's': conf.object_size = ::atol(::optarg); break;
+
+            default:    // invalid option
+                usage(std::cerr);
+                return 1;
+        }
+    }
+
+    const auto pipeline = fastcrawl::pipeline_builder(pipeline_str);
+
+    // Work in a temporary directory
+    char dir[] = "/tmp/bench_shards.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    // Server runs in a child process (so that it has its own threads)
+    fastcrawl::http_server server(conf);
+
+    const ::pid_t server_pid = ::fork();
+    if (server_pid < 0) throw std::runtime_error("fork failed");
+
+    if (0 == server_pid) {
+        server.run();
+        ::_exit(0);
+    }
+
+    const auto uri = fastcrawl::uri::parse(server.base_uri() + "index.html");
+
+    std::cout
+        << "Crawling " << static_cast<std::string>(uri) << ": "
+        << conf.references << " references on " << conf.hosts
+        << " hosts, mean size " << conf.object_size << " B" << std::endl;
+
+    // 1, 2, 4... shards (and the max.)
+    std::vector<size_t> steps;
+    for (size_t shards = 1; shards < max_shards; shards *= 2)
+        steps.push_back(shards);
+    steps.push_back(max_shards);
+
+    double base_rate = 0;
+    for (const size_t shards: steps) {
+        double   time    = 0;
+        size_t   objects = 0;
+        uint64_t bytes   = 0;
+
+        for (size_t i = 0; i < iterations; ++i) {
+            size_t   it_objects;
+            uint64_t it_bytes;
+
+            time    += crawl(uri, shards, pin, pipeline, it_objects, it_bytes);
+            objects += it_objects;
+            bytes   += it_bytes;
+        }
+
+        const double rate = objects / time;
+        if (!base_rate) base_rate = rate;
+
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << std::setw(4) << shards << " shards: "
+            << bytes / 1e6 / time << " MB/s, "
+            << rate << " objects/s, speedup "
+            << rate / base_rate << " (efficiency "
+            << 100 * rate / base_rate / shards << " %)"
+            << std::endl;
+    }
+
+    ::kill(server_pid, SIGTERM);
+    ::waitpid(server_pid, nullptr, 0);
+
+    ::rmdir(dir);
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
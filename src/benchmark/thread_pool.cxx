@@ -0,0 +1,194 @@
+/**
+ *  \file
+ *  \brief  Thread pools benchmark
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/thread_pool.hxx"
+#include "libfastcrawl/work_stealing_pool.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+
+/** Wait until all jobs are done */
+static void wait_for(const std::atomic<size_t> & done, size_t jobs) {
+    while (done.load(std::memory_order_acquire) < jobs)
+        std::this_thread::yield();
+}
+
+
+/**
+ *  \brief  Flat submission: all jobs are submitted by the main thread
+ *
+ *  \param  pool  Thread pool
+ *  \param  jobs  Number of jobs
+ *
+ *  \return Throughput [jobs/s]
+ */
+template <class Pool>
+static double flat(Pool & pool, size_t jobs) {
+    std::atomic<size_t> done(0);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < jobs; ++i)
+        pool.run([&done]() { done.fetch_add(1, std::memory_order_release); });
+
+    wait_for(done, jobs);
+
+    const std::chrono::duration<double> time_s =
+        std::chrono::steady_clock::now() - start;
+
+    return jobs / time_s.count();
+}
+
+
+/** Recursive fan-out job */
+template <class Pool>
+struct fan_out {
+    Pool &                pool;     /**< Thread pool     */
+    std::atomic<size_t> & done;     /**< Finished jobs   */
+    unsigned              depth;    /**< Remaining depth */
+
+    void operator () () const {
+        if (depth) {
+            pool.run(fan_out{pool, done, depth - 1});
+            pool.run(fan_out{pool, done, depth - 1});
+        }
+
+        done.fetch_add(1, std::memory_order_release);
+    }
+
+};  // end of template struct fan_out
+
+
+/**
+ *  \brief  Nested submission: jobs submit 2 child jobs each (binary tree)
+ *
+ *  \param  pool   Thread pool
+ *  \param  depth  Tree depth
+ *
+ *  \return Throughput [jobs/s]
+ */
+template <class Pool>
+static double nested(Pool & pool, unsigned depth) {
+    std::atomic<size_t> done(0);
+    const size_t jobs = (2 << depth) - 1;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pool.run(fan_out<Pool>{pool, done, depth});
+
+    wait_for(done, jobs);
+
+    const std::chrono::duration<double> time_s =
+        std::chrono::steady_clock::now() - start;
+
+    return jobs / time_s.count();
+}
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const size_t   jobs  = argc > 1 ? ::atoi(argv[1]) : 1000000;
+    const unsigned depth = argc > 2 ? ::atoi(argv[2]) : 19;
+
+    std::cout
+        << "Jobs/s (" << jobs << " flat jobs, "
+        << ((2 << depth) - 1) << " nested jobs), "
+        << std::thread::hardware_concurrency() << " CPUs"
+        << std::endl;
+
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        double tp_flat, tp_nested, wsp_flat, wsp_nested;
+        size_t steals;
+
+        {
+            fastcrawl::thread_pool pool(threads, threads);
+            tp_flat   = flat(pool, jobs);
+            tp_nested = nested(pool, depth);
+        }
+
+        {
+            fastcrawl::work_stealing_pool pool(threads);
+            wsp_flat   = flat(pool, jobs);
+            wsp_nested = nested(pool, depth);
+            steals     = pool.steals();
+        }
+
+        std::cout
+            << std::setw(2) << threads << " threads: "
+            << std::scientific << std::setprecision(2)
+            << "thread_pool flat " << tp_flat
+            << " nested " << tp_nested
+            << ", work_stealing_pool flat " << wsp_flat
+            << " nested " << wsp_nested
+            << " (" << steals << " steals)"
+            << std::endl;
+    }
+
+    return 0;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
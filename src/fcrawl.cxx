@@ -41,13 +41,318 @@
 #include "libfastcrawl/fastcrawl.hxx"
 
 #include <iostream>
+#include <iomanip>
+#include <fstream>
 #include <chrono>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <string>
+#include <algorithm>
 #include <exception>
 #include <stdexcept>
+#include <cstring>
 #include <cstdint>
 
 extern "C" {
 #include <getopt.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+}
+
+
+/** List regular files (directories are listed recursively) */
+static void list_files(const std::string & path, std::vector<std::string> & files) {
+    struct ::stat st;
+    if (::stat(path.c_str(), &st))
+        throw std::runtime_error("no such file or directory: " + path);
+
+    if (S_ISREG(st.st_mode)) {
+        files.push_back(path);
+        return;
+    }
+
+    if (!S_ISDIR(st.st_mode)) return;
+
+    auto * dir = ::opendir(path.c_str());
+    if (nullptr == dir) throw std::runtime_error("failed to read " + path);
+
+    std::vector<std::string> entries;
+    while (auto * entry = ::readdir(dir)) {
+        const std::string name = entry->d_name;
+        if ("." != name && ".." != name) entries.push_back(name);
+    }
+
+    ::closedir(dir);
+
+    std::sort(entries.begin(), entries.end());  // deterministic order
+    for (auto & name: entries)
+        list_files(path + (path.back() == '/' ? "" : "/") + name, files);
+}
+
+
+/**
+ *  \brief  Offline crawl of local files
+ *
+ *  The files are memory-mapped and segmented in parallel (in batches).
+ *  The found references are either listed or downloaded.
+ *
+ *  \param  paths         Files and directories
+ *  \param  html_crawler  Downloading crawler (or \c nullptr for listing)
+ *  \param  verbose       Verbose logging
+ */
+static void offline_crawl(
+    const std::vector<std::string> & paths,
+    fastcrawl::html_crawler *        html_crawler,
+    bool                             verbose)
+{
+    static const size_t batch_files = 1024;         // max. files per batch
+    static const size_t batch_size  = 1ull << 30;   // max. batch size
+
+    std::vector<std::string> files;
+    for (auto & path: paths) list_files(path, files);
+
+    fastcrawl::work_stealing_pool pool;
+    fastcrawl::parallel_segmenter segmenter(pool);
+
+    size_t total_size = 0;
+    size_t references = 0;
+
+    for (size_t begin = 0; begin < files.size(); ) {
+        // Map batch of files
+        std::vector<fastcrawl::mapped_file>                   mapped;
+        std::vector<fastcrawl::parallel_segmenter::document>  docs;
+        size_t size = 0;
+
+        size_t end = begin;
+        for (; end < files.size() && end - begin < batch_files && size < batch_size; ++end) {
+            mapped.emplace_back(files[end]);
+            docs.push_back({mapped.back().data(), mapped.back().size()});
+            size += mapped.back().size();
+        }
+
+        segmenter(docs, [&](
+            size_t              doc,
+            const std::string & element,
+            const std::string & attribute,
+            const std::string & value,
+            size_t              line,
+            size_t              column)
+        {
+            ++references;
+
+            if (html_crawler)
+                html_crawler->reference(element, attribute, value, line, column);
+            else
+                std::cout
+                    << files[begin + doc] << ':' << line << ':' << column
+                    << ' ' << element << ' ' << attribute
+                    << " \"" << value << '"' << std::endl;
+        });
+
+        total_size += size;
+        begin = end;
+    }
+
+    if (verbose)
+        std::cerr
+            << "Segmented " << files.size() << " files, " << total_size
+            << " B in " << segmenter.chunks() << " chunks ("
+            << segmenter.fixups() << " seam fix-ups), "
+            << references << " references" << std::endl;
+}
+
+
+/**
+ *  \brief  Batch crawl
+ *
+ *  Prints seed reports as the seeds are crawled and the totals.
+ *
+ *  \param  seeds  Seed URIs (one per line)
+ *  \param  batch  Batch crawler
+ */
+static void batch_crawl(std::istream & seeds, fastcrawl::batch_crawler & batch) {
+    size_t   crawled    = 0;
+    size_t   failed     = 0;
+    size_t   repeated   = 0;
+    size_t   similar    = 0;
+    size_t   references = 0;
+    size_t   downloaded = 0;
+    size_t   duplicates = 0;
+    uint64_t bytes      = 0;
+
+    const size_t seed_cnt = batch(seeds, [&](
+        const fastcrawl::batch_crawler::seed_report & report)
+    {
+        std::cout << "Seed #" << report.index << " \"" << report.seed << "\" ";
+
+        if (report.duplicate) {
+            ++repeated;
+            std::cout << "repeated" << std::endl;
+            return;
+        }
+
+        if (report.near_duplicate) {
+            ++similar;
+            std::cout
+                << "near-duplicate (SimHash " << std::hex << std::setw(16)
+                << std::setfill('0') << report.fingerprint
+                << std::dec << std::setfill(' ')
+                << "), references not crawled" << std::endl;
+            return;
+        }
+
+        const auto & sum = report.summary;
+
+        if (report.success) ++crawled;
+        else                ++failed;
+
+        references += sum.references;
+        downloaded += sum.downloaded;
+        duplicates += sum.duplicates;
+        bytes      += sum.bytes;
+
+        std::cout
+            << (report.success ? "OK" : "FAILED") << ": "
+            << sum.references << " references ("
+            << sum.downloaded << " downloaded, "
+            << sum.failed     << " failed, "
+            << sum.skipped    << " skipped, "
+            << sum.duplicates << " shared), "
+            << sum.bytes << " B in " << report.time << " s"
+            << std::endl;
+    });
+
+    std::cout
+        << "Seeds: " << seed_cnt
+        << " (" << crawled << " crawled, " << failed << " failed, "
+        << repeated << " repeated, " << similar << " near-duplicates); "
+        << "references: " << references
+        << " (" << downloaded << " downloaded, " << duplicates << " shared), "
+        << bytes << " B" << std::endl;
+
+    batch.timings().text(std::cout);
+}
+
+
+/** Live metrics (periodic stats line and/or Prometheus endpoint) */
+struct live_metrics {
+    std::unique_ptr<fastcrawl::metrics_server>   server;    /**< Endpoint   */
+    std::unique_ptr<fastcrawl::metrics_reporter> reporter;  /**< Stats line */
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  port      Prometheus endpoint port (0 means none)
+     *  \param  interval  Stats line interval [s] (0 means none)
+     *  \param  sample    Metrics sampler
+     */
+    live_metrics(
+        unsigned                                     port,
+        double                                       interval,
+        const fastcrawl::metrics_server::sampler_t & sample)
+    {
+        if (port) {
+            server.reset(new fastcrawl::metrics_server(port, sample));
+
+            std::cerr
+                << "Metrics: http://127.0.0.1:" << server->port()
+                << "/metrics" << std::endl;
+        }
+
+        if (interval > 0)
+            reporter.reset(new fastcrawl::metrics_reporter(
+                std::chrono::duration_cast<fastcrawl::metrics_reporter::duration>(
+                    std::chrono::duration<double>(interval)),
+                std::cerr, sample));
+    }
+
+};  // end of struct live_metrics
+
+
+/**
+ *  \brief  Shard-per-core crawl
+ *
+ *  Prints the download records as the downloads finish and the shard
+ *  statistics.
+ *
+ *  \param  page     Page URI
+ *  \param  runtime  Shard runtime
+ *  \param  shm      Shared memory sink (optional)
+ *
+ *  \return \c true iff the page was downloaded
+ */
+static bool shard_crawl(
+    const fastcrawl::uri &     page,
+    fastcrawl::shard_runtime & runtime,
+    fastcrawl::shm_sink *      shm)
+{
+    fastcrawl::completion_queue completions;
+    runtime.on_completion(completions.callback());
+
+    std::thread printer([&completions, shm]() {
+        fastcrawl::completion c;
+        while (completions.pop(c)) {
+            if (shm) shm->completion(c.uri, c.record);
+
+            std::cout
+                << "URI \"" << c.uri << "\" stored in " << c.record
+                << std::endl;
+        }
+    });
+
+    const bool ok = runtime.crawl(page);
+
+    completions.close();
+    printer.join();
+
+    const auto stats = runtime.stats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << "Shard #" << i;
+
+        if (stats[i].cpu < 0) std::cout << " (not pinned): ";
+        else                  std::cout << " (CPU " << stats[i].cpu << "): ";
+
+        std::cout
+            << stats[i].downloads  << " downloads ("
+            << stats[i].failed     << " failed, "
+            << stats[i].skipped    << " skipped), "
+            << stats[i].duplicates << " repeated references"
+            << std::endl;
+    }
+
+    return ok;
+}
+
+
+/**
+ *  \brief  Write JSON timing report and activity trace (if required)
+ *
+ *  \param  json_file   JSON timing report file (or empty)
+ *  \param  timings     Timing report
+ *  \param  trace_file  Activity trace file (or empty)
+ */
+static void write_reports(
+    const std::string &              json_file,
+    const fastcrawl::timing_report & timings,
+    const std::string &              trace_file)
+{
+    if (!json_file.empty()) {
+        std::ofstream json(json_file);
+        if (!json)
+            throw std::runtime_error("failed to open " + json_file);
+
+        timings.json(json);
+    }
+
+    if (!trace_file.empty()) {
+        std::ofstream trace(trace_file);
+        if (!trace)
+            throw std::runtime_error("failed to open " + trace_file);
+
+        fastcrawl::trace::dump(trace);
+    }
 }
 
 
@@ -59,18 +364,108 @@ static int main_impl(int argc, char * const argv[]) {
     // Options & arguments
     bool        verbose = false;
     size_t      tlimit  = SIZE_MAX;
+    unsigned    digests = 0;
+    std::string pipeline_str = "adler32,size";
+    std::string json_file;
+    std::string trace_file;
+    double      stats_interval = 0;
+    unsigned    metrics_port = 0;
     std::string uri_str = "www.meetangee.com";
+    std::vector<std::string> offline_paths;
+    std::string batch_file;
+    size_t      seed_limit = 16;
+    size_t      queue_limit = 16384;
+    std::string preconnect_str;
+    size_t      shards = SIZE_MAX;
+    std::string shm_name;
+    unsigned    shm_timeout = 0;
+    int         near_duplicates = -1;
+
+    fastcrawl::download_policy policy;
+    policy.connect_timeout   = 10000;
+    policy.low_speed_time    = 30;
+    policy.retries           = 2;
+    policy.breaker_threshold = 5;
+    policy.compression       = fastcrawl::download_policy::DECODE;
 
     // Usage
-    auto usage = [&argv, &uri_str](std::ostream & out) {
+    auto usage = [&argv, &uri_str, &pipeline_str](std::ostream & out) {
         out << "Usage: " << argv[0] << " [OPTIONS] [URI]" << std::endl
             << std::endl
             << "OPTIONS:" << std::endl
             << "    -h or --help                show this help and exit"     << std::endl
+            << "    -b or --batch <file>        crawl seed URIs listed in"   << std::endl
+            << "                                file (one per line, - for"   << std::endl
+            << "                                stdin) concurrently"         << std::endl
+            << "    -c or --seed-limit <n>      max. seeds crawled at once"  << std::endl
+            << "                                in batch mode (default 16)"  << std::endl
+            << "    -d or --digest <list>       compute additional digests"  << std::endl
+            << "                                (comma-separated list of"    << std::endl
+            << "                                crc32c, xxh3 and sha256)"    << std::endl
+            << "    -f or --file <path>         crawl local file(s) offline" << std::endl
+            << "                                (directories recursively)"   << std::endl
+            << "    -j or --json <file>         write transfer timing"       << std::endl
+            << "                                report to file (JSON)"       << std::endl
+            << "    -m or --metrics-port <port> serve Prometheus metrics"    << std::endl
+            << "                                on localhost:<port>/metrics" << std::endl
+            << "    -p or --pipeline <list>     content data processors"     << std::endl
+            << "                                (comma-separated list)"      << std::endl
+            << "    -q or --queue-limit <n>     max. queued downloads; the"  << std::endl
+            << "                                page download is paused"     << std::endl
+            << "                                when reached (def. 16384)"   << std::endl
+            << "    -s or --stats <seconds>     periodic stats to stderr"    << std::endl
             << "    -t or --thread-limit <n>    limit the number of threads" << std::endl
+            << "    -T or --trace <file>        write activity timeline"     << std::endl
+            << "                                (Chrome trace-event JSON)"   << std::endl
             << "    -v or --verbose             verbose logging to stderr"   << std::endl
+            << "        --connect-timeout <s>   connection timeout (def. 10)"<< std::endl
+            << "        --timeout <s>           transfer timeout (def. none)"<< std::endl
+            << "        --stall-timeout <s>     stalled transfer timeout"    << std::endl
+            << "                                (default 30)"                << std::endl
+            << "        --retries <n>           failed download retries"     << std::endl
+            << "                                (default 2)"                 << std::endl
+            << "        --hedge <percentile>    duplicate requests slower"   << std::endl
+            << "                                than latency percentile"     << std::endl
+            << "        --breaker <n>           fail fast on host after n"   << std::endl
+            << "                                failures in row (default 5)" << std::endl
+            << "        --preconnect <mode>     warm up newly seen hosts:"   << std::endl
+            << "                                dns (DNS cache) or connect"  << std::endl
+            << "                                (TCP & TLS handshake)"       << std::endl
+            << "        --shards <n>            crawl on n shards pinned to" << std::endl
+            << "                                CPUs (0 means one per CPU)"  << std::endl
+            << "        --shm <name>            publish content to shared"   << std::endl
+            << "                                memory ring (e.g. /fcrawl)"  << std::endl
+            << "        --shm-timeout <s>       drop content the ring reader"<< std::endl
+            << "                                doesn't take in time (def."  << std::endl
+            << "                                none, wait for the reader)"  << std::endl
+            << "        --compression <mode>    transfer compression: none,"  << std::endl
+            << "                                decode (default) or encoded" << std::endl
+            << "                                (content stored compressed)" << std::endl
+            << "        --accept <types>        download content of types"  << std::endl
+            << "                                (comma-separated prefixes)"  << std::endl
+            << "        --max-size <bytes>      skip larger content"         << std::endl
+            << "        --skip-errors           skip error responses' body"  << std::endl
+            << "        --near-duplicates <n>   don't crawl seed pages with" << std::endl
+            << "                                SimHash within n bits of"    << std::endl
+            << "                                a crawled one (batch mode)"  << std::endl
             << std::endl
             << "Default URI: " << uri_str << std::endl
+            << "Default pipeline: " << pipeline_str << std::endl
+            << "Available data processors:";
+
+        for (auto & name: fastcrawl::processor_registry::global().names())
+            out << ' ' << name;
+
+        out << std::endl
+            << std::endl
+            << "In offline mode (see --file), the references found in the files"  << std::endl
+            << "are listed; if URI is specified, the references are downloaded"  << std::endl
+            << "(the URI is the base for relative references)."                  << std::endl
+            << std::endl
+            << "In batch mode (see --batch), the seeds share download threads"   << std::endl
+            << "(see --thread-limit), DNS & connection cache and each content"   << std::endl
+            << "URI is downloaded once; n-th seed content is stored in NNNNNN"   << std::endl
+            << "directory (the seed page as index.html)."                        << std::endl
             << std::endl
             << "Note that the content is downloaded into the current directory" << std::endl
             << "to files named to indicate the content URI position"            << std::endl
@@ -81,17 +476,61 @@ static int main_impl(int argc, char * const argv[]) {
     };
 
     // Options handling
+    enum {  // long-only options
+        OPT_CONNECT_TIMEOUT = 256,
+        OPT_TIMEOUT,
+        OPT_STALL_TIMEOUT,
+        OPT_RETRIES,
+        OPT_HEDGE,
+        OPT_BREAKER,
+        OPT_PRECONNECT,
+        OPT_SHARDS,
+        OPT_SHM,
+        OPT_SHM_TIMEOUT,
+        OPT_COMPRESSION,
+        OPT_ACCEPT,
+        OPT_MAX_SIZE,
+        OPT_SKIP_ERRORS,
+        OPT_NEAR_DUPLICATES,
+    };
+
     static const struct option long_opts[] {
         { "help",         no_argument,       nullptr, 'h' },
+        { "batch",        required_argument, nullptr, 'b' },
+        { "seed-limit",   required_argument, nullptr, 'c' },
+        { "json",         required_argument, nullptr, 'j' },
+        { "digest",       required_argument, nullptr, 'd' },
+        { "file",         required_argument, nullptr, 'f' },
+        { "metrics-port", required_argument, nullptr, 'm' },
+        { "pipeline",     required_argument, nullptr, 'p' },
+        { "queue-limit",  required_argument, nullptr, 'q' },
+        { "stats",        required_argument, nullptr, 's' },
         { "thread-limit", required_argument, nullptr, 't' },
+        { "trace",        required_argument, nullptr, 'T' },
         { "verbose",      no_argument,       nullptr, 'v' },
 
+        { "connect-timeout", required_argument, nullptr, OPT_CONNECT_TIMEOUT },
+        { "timeout",         required_argument, nullptr, OPT_TIMEOUT         },
+        { "stall-timeout",   required_argument, nullptr, OPT_STALL_TIMEOUT   },
+        { "retries",         required_argument, nullptr, OPT_RETRIES         },
+        { "hedge",           required_argument, nullptr, OPT_HEDGE           },
+        { "breaker",         required_argument, nullptr, OPT_BREAKER         },
+        { "preconnect",      required_argument, nullptr, OPT_PRECONNECT      },
+        { "shards",          required_argument, nullptr, OPT_SHARDS          },
+        { "shm",             required_argument, nullptr, OPT_SHM             },
+        { "shm-timeout",     required_argument, nullptr, OPT_SHM_TIMEOUT     },
+        { "compression",     required_argument, nullptr, OPT_COMPRESSION     },
+        { "accept",          required_argument, nullptr, OPT_ACCEPT          },
+        { "max-size",        required_argument, nullptr, OPT_MAX_SIZE        },
+        { "skip-errors",     no_argument,       nullptr, OPT_SKIP_ERRORS     },
+        { "near-duplicates", required_argument, nullptr, OPT_NEAR_DUPLICATES },
+
         { nullptr,        0,                 nullptr, '\0' }  // terminator
     };
 
     for (;;) {
         int long_opt_ix;
-        int opt = ::getopt_long(argc, argv, "htv", long_opts, &long_opt_ix);
+        int opt = ::getopt_long(argc, argv, "hb:c:j:d:f:m:p:q:s:t:T:v", long_opts, &long_opt_ix);
         if (-1 == opt) break;  // no more options
 
         switch (opt) {
@@ -99,21 +538,144 @@ static int main_impl(int argc, char * const argv[]) {
                 usage(std::cout);
                 return 0;
 
+            case 'b':   // batch crawl
+                batch_file = ::optarg;
+                break;
+
+            case 'c':   // seeds crawled at once
+                seed_limit = ::atoi(::optarg);
+                break;
+
+            case 'f':   // offline crawl
+                offline_paths.push_back(::optarg);
+                break;
+
+            case 'j':   // JSON timing report
+                json_file = ::optarg;
+                break;
+
+            case 'd':   // digests
+                try {
+                    digests |= fastcrawl::content_digests::parse(::optarg);
+                }
+                catch (const std::invalid_argument & ex) {
+                    std::cerr << ex.what() << std::endl << std::endl;
+                    usage(std::cerr);
+                    return 1;
+                }
+                break;
+
+            case 'p':   // data processors pipeline
+                pipeline_str = ::optarg;
+                break;
+
+            case 'q':   // download queue limit
+                queue_limit = ::atoi(::optarg);
+                break;
+
+            case 'm':   // metrics endpoint port
+                metrics_port = ::atoi(::optarg);
+                break;
+
+            case 's':   // stats interval
+                stats_interval = ::atof(::optarg);
+                break;
+
             case 't':   // thread limit
                 tlimit = ::atoi(::optarg);
                 break;
 
+            case 'T':   // activity trace
+                trace_file = ::optarg;
+                fastcrawl::trace::enable();
+                break;
+
             case 'v':   // verbose logging
                 verbose = true;
                 break;
 
+            case OPT_CONNECT_TIMEOUT:
+                policy.connect_timeout = (unsigned)(::atof(::optarg) * 1000);
+                break;
+
+            case OPT_TIMEOUT:
+                policy.timeout = (unsigned)(::atof(::optarg) * 1000);
+                break;
+
+            case OPT_STALL_TIMEOUT:
+                policy.low_speed_time = ::atoi(::optarg);
+                break;
+
+            case OPT_RETRIES:
+                policy.retries = ::atoi(::optarg);
+                break;
+
+            case OPT_HEDGE:
+                policy.hedge_percentile = ::atof(::optarg);
+                break;
+
+            case OPT_BREAKER:
+                policy.breaker_threshold = ::atoi(::optarg);
+                break;
+
+            case OPT_PRECONNECT:
+                preconnect_str = ::optarg;
+                break;
+
+            case OPT_SHARDS:
+                shards = ::atoi(::optarg);
+                break;
+
+            case OPT_SHM:
+                shm_name = ::optarg;
+                break;
+
+            case OPT_SHM_TIMEOUT:
+                shm_timeout = (unsigned)(::atof(::optarg) * 1000);
+                break;
+
+            case OPT_COMPRESSION:
+                if      (0 == std::strcmp(::optarg, "none"))
+                    policy.compression = fastcrawl::download_policy::IDENTITY;
+                else if (0 == std::strcmp(::optarg, "decode"))
+                    policy.compression = fastcrawl::download_policy::DECODE;
+                else if (0 == std::strcmp(::optarg, "encoded"))
+                    policy.compression = fastcrawl::download_policy::ENCODED;
+                else {
+                    std::cerr
+                        << "Unknown compression mode: " << ::optarg << std::endl
+                        << std::endl;
+
+                    usage(std::cerr);
+                    return 1;
+                }
+
+                break;
+
+            case OPT_ACCEPT:
+                policy.accept_types = ::optarg;
+                break;
+
+            case OPT_MAX_SIZE:
+                policy.max_size = ::strtoull(::optarg, nullptr, 10);
+                break;
+
+            case OPT_SKIP_ERRORS:
+                policy.skip_errors = true;
+                break;
+
+            case OPT_NEAR_DUPLICATES:
+                near_duplicates = ::atoi(::optarg);
+                break;
+
             default:    // internal error (option handing faulty)
                 throw std::logic_error("INTERNAL ERROR: option handling fault");
         }
     }
 
     // URI argument
-    if (::optind < argc) uri_str = argv[::optind++];
+    const bool uri_arg = ::optind < argc;
+    if (uri_arg) uri_str = argv[::optind++];
 
     // Unexpected argument
     if (::optind < argc) {
@@ -125,29 +687,267 @@ static int main_impl(int argc, char * const argv[]) {
         return 1;
     }
 
+    // Shared memory content sink (publishes via the shm processor)
+    std::unique_ptr<fastcrawl::shm_sink> shm;
+    if (!shm_name.empty()) {
+        shm.reset(new fastcrawl::shm_sink(shm_name,
+            fastcrawl::shm_ring::default_capacity,
+            std::chrono::milliseconds(shm_timeout)));
+        shm->add_to();
+    }
+
+    // Data processors pipeline
+    fastcrawl::pipeline_builder pipeline;
+    try {
+        pipeline = fastcrawl::pipeline_builder(pipeline_str);
+        pipeline.add_digests(digests);
+
+        // Completions carry Adler32 checksum
+        if (shm) {
+            pipeline.add_digests(fastcrawl::content_digests::ADLER32);
+            pipeline.add("shm");
+        }
+    }
+    catch (const std::invalid_argument & ex) {
+        std::cerr << ex.what() << std::endl << std::endl;
+        usage(std::cerr);
+        return 1;
+    }
+
+    // Speculative preconnect
+    const bool preconnect = !preconnect_str.empty();
+    const auto preconnect_mode = "connect" == preconnect_str
+        ? fastcrawl::preconnector::CONNECT
+        : fastcrawl::preconnector::DNS;
+
+    if (preconnect && "dns" != preconnect_str && "connect" != preconnect_str) {
+        std::cerr
+            << "Unknown preconnect mode: " << preconnect_str << std::endl
+            << std::endl;
+
+        usage(std::cerr);
+        return 1;
+    }
+
+    // Batch crawl
+    if (!batch_file.empty()) {
+        if (uri_arg || !offline_paths.empty()) {
+            std::cerr
+                << "Batch mode doesn't take URI argument nor --file" << std::endl
+                << std::endl;
+
+            usage(std::cerr);
+            return 1;
+        }
+
+        std::ifstream seeds_file;
+        if ("-" != batch_file) {
+            seeds_file.open(batch_file);
+            if (!seeds_file)
+                throw std::runtime_error("failed to open " + batch_file);
+        }
+
+        fastcrawl::crawl_context context(tlimit);
+        context.download_pool().queue_limit(queue_limit);
+        context.governor().policy(policy);
+        if (preconnect) context.preconnect(preconnect_mode);
+        if (near_duplicates >= 0) context.near_duplicates(near_duplicates);
+        fastcrawl::batch_crawler batch(context, seed_limit);
+
+        batch.verbose_log(verbose);
+        batch.setup([&pipeline, &shm](fastcrawl::html_crawler & html_crawler) {
+            html_crawler.pipeline(pipeline);
+
+            if (shm) {
+                auto * sink = shm.get();
+                html_crawler.on_completion([sink](
+                    const std::string & uri, const fastcrawl::uri_record & record)
+                {
+                    sink->completion(uri, record);
+                });
+            }
+        });
+
+        live_metrics live(metrics_port, stats_interval,
+            [&context]() { context.sample_metrics(); });
+
+        const auto download_start_tstmp = std::chrono::system_clock::now();
+
+        batch_crawl("-" == batch_file ? std::cin : seeds_file, batch);
+
+        std::chrono::duration<double> download_time_s =
+            std::chrono::system_clock::now() - download_start_tstmp;
+
+        write_reports(json_file, batch.timings(), trace_file);
+
+        std::cout
+            << "Total download time: " << download_time_s.count() << " s"
+            << std::endl;
+
+        return 0;
+    }
+
+    // Shard-per-core crawl
+    if (SIZE_MAX != shards) {
+        if (!offline_paths.empty()) {
+            std::cerr
+                << "Shard mode doesn't take --file" << std::endl
+                << std::endl;
+
+            usage(std::cerr);
+            return 1;
+        }
+
+        fastcrawl::shard_runtime runtime(shards);
+        runtime.verbose_log(verbose);
+        runtime.pipeline(pipeline);
+        runtime.policy(policy);
+        runtime.queue_limit(queue_limit);
+
+        live_metrics live(metrics_port, stats_interval,
+            fastcrawl::metrics_server::sampler_t());
+
+        const auto download_start_tstmp = std::chrono::system_clock::now();
+
+        if (!shard_crawl(fastcrawl::uri::parse(uri_str), runtime, shm.get()))
+            std::cerr << "Page download FAILED" << std::endl;
+
+        std::chrono::duration<double> download_time_s =
+            std::chrono::system_clock::now() - download_start_tstmp;
+
+        fastcrawl::timing_report timings;
+        runtime.timings(timings);
+        if (timings.all().transfers()) timings.text(std::cout);
+
+        write_reports(json_file, timings, trace_file);
+
+        std::cout
+            << "Total download time: " << download_time_s.count() << " s"
+            << std::endl;
+
+        return 0;
+    }
+
+    // Offline references listing
+    if (!offline_paths.empty() && !uri_arg) {
+        offline_crawl(offline_paths, nullptr, verbose);
+        return 0;
+    }
+
     // Download (nested scope forcing destructors execution before timestamp)
     {
         // Initialisation
         const auto uri = fastcrawl::uri::parse(uri_str);
 
+        // The context share lets downloads reuse connections (incl. warm ones);
+        // the only crawler needn't claim the content URIs
+        fastcrawl::crawl_context context(tlimit);
+        context.claims(false);
+        if (preconnect) context.preconnect(preconnect_mode);
+
+        const auto page_policy = policy.page();  // the page is parsed
+
         fastcrawl::download     download(uri, "./index.html");
-        fastcrawl::html_crawler html_crawler(uri.host, tlimit);
+        fastcrawl::html_crawler html_crawler(context, uri);
 
         // Set logging
         download.verbose_log(verbose);
+        download.policy(&page_policy);
+        download.share(context.share());
         html_crawler.verbose_log(verbose);
 
+        html_crawler.pipeline(pipeline);
+        html_crawler.queue_limit(queue_limit);
+        html_crawler.policy(policy);
+
+        // Live metrics
+        live_metrics live(metrics_port, stats_interval,
+            [&html_crawler]() { html_crawler.sample_metrics(); });
+
         // Download startup timestamp
         const auto download_start_tstmp = std::chrono::system_clock::now();
 
-        download(html_crawler);  // crawl the index page during download
+        // Print the results as the downloads finish
+        fastcrawl::completion_queue completions;
+        html_crawler.on_completion(completions.callback());
+
+        std::chrono::duration<double> first_result_s(0);
+        std::thread printer([&completions, &first_result_s, download_start_tstmp, &shm]() {
+            fastcrawl::completion c;
+            for (bool first = true; completions.pop(c); first = false) {
+                if (first)
+                    first_result_s =
+                        std::chrono::system_clock::now() - download_start_tstmp;
+
+                if (shm) shm->completion(c.uri, c.record);
+
+                std::cout
+                    << "URI \"" << c.uri << "\" stored in " << c.record
+                    << std::endl;
+            }
+        });
+
+        // Crawl the index page during download (or local files)
+        if (offline_paths.empty())
+            download(html_crawler);
+        else
+            offline_crawl(offline_paths, &html_crawler, verbose);
+
         html_crawler.wait();     // wait for all refs to be downloaded
 
         // Download duration
         std::chrono::duration<double> download_time_s =
             std::chrono::system_clock::now() - download_start_tstmp;
 
-        html_crawler.report();   // report the result
+        completions.close();
+        printer.join();
+
+        html_crawler.report(false);  // report the result summary
+
+        write_reports(json_file, html_crawler.timings(), trace_file);
+
+        fastcrawl::log_flush();  // keep verbose log before the summary
+
+        if (verbose)
+            std::cerr
+                << "First result after: " << first_result_s.count() << " s"
+                << std::endl;
+
+        if (verbose) {
+            const auto stats = html_crawler.download_pool_stats();
+            const std::chrono::duration<double> queue_wait_s = stats.queue_wait;
+
+            std::cerr
+                << "Download threads: peak " << stats.peak
+                << ", spawned " << stats.spawned
+                << ", retired " << stats.retired
+                << "; jobs: " << stats.executed
+                << ", total queue wait " << queue_wait_s.count() << " s"
+                << ", throttled " << stats.throttled << " times"
+                << std::endl;
+
+            const auto values = fastcrawl::metrics::global().values();
+            std::cerr
+                << "Content: received " << values.bytes_received
+                << " B, transferred " << values.bytes_transferred << " B"
+                << std::endl;
+
+            if (shm)
+                std::cerr
+                    << "Shared memory ring: " << shm->ring().stalls()
+                    << " waits for consumer, " << shm->ring().drops()
+                    << " records dropped" << std::endl;
+
+            if (context.preconnect()) {
+                const auto pstats = context.preconnect()->stats();
+
+                std::cerr
+                    << "Preconnect: " << pstats.origins << " hosts"
+                    << ", warmed " << pstats.warmed
+                    << ", failed " << pstats.failed
+                    << std::endl;
+            }
+        }
 
         std::cout
             << "Total download time: " << download_time_s.count() << " s"
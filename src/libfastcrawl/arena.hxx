@@ -0,0 +1,194 @@
+#ifndef fastcrawl__arena_hxx
+#define fastcrawl__arena_hxx
+
+/**
+ *  \file
+ *  \brief  Monotonic memory arena
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Monotonic memory arena
+ *
+ *  Allocates memory from large blocks by bumping a pointer; the memory
+ *  is only released all at once (when the arena is destroyed).
+ *  Suitable for objects that live as long as the owner (e.g. per-crawl
+ *  download records), making their allocation practically free.
+ *
+ *  The arena isn't thread-safe.
+ */
+class arena {
+    public:
+
+    static const size_t default_block_size = 64 << 10;  /**< Default block size */
+
+    private:
+
+    /** Memory block header (the block memory follows) */
+    struct block {
+        block * next;  /**< Next block in list */
+
+    };  // end of struct block
+
+    const size_t m_block_size;  /**< Block size                */
+    block *      m_blocks;      /**< Allocated blocks          */
+    char *       m_ptr;         /**< Current block free memory */
+    char *       m_end;         /**< Current block end         */
+    size_t       m_block_cnt;   /**< Allocated blocks count    */
+
+    /** Allocate new block for at least \c size bytes aligned to \c align */
+    void grow(size_t size, size_t align);
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  block_size  Block size
+     */
+    arena(size_t block_size = default_block_size):
+        m_block_size(block_size),
+        m_blocks(nullptr),
+        m_ptr(nullptr),
+        m_end(nullptr),
+        m_block_cnt(0)
+    {}
+
+    arena(const arena & ) = delete;
+    arena & operator = (const arena & ) = delete;
+
+    /**
+     *  \brief  Allocate memory
+     *
+     *  \param  size   Size
+     *  \param  align  Alignment (power of 2)
+     *
+     *  \return Allocated memory
+     */
+    void * allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        char * ptr = (char *)(((uintptr_t)m_ptr + align - 1) & ~(uintptr_t)(align - 1));
+        if (ptr + size > m_end || nullptr == m_ptr) {
+            grow(size, align);
+            ptr = (char *)(((uintptr_t)m_ptr + align - 1) & ~(uintptr_t)(align - 1));
+        }
+
+        m_ptr = ptr + size;
+        return ptr;
+    }
+
+    /**
+     *  \brief  Copy string to the arena
+     *
+     *  \param  str   String
+     *  \param  size  String size
+     *
+     *  \return Arena copy (zero-terminated)
+     */
+    const char * copy(const char * str, size_t size) {
+        char * copy = (char *)allocate(size + 1, 1);
+        std::memcpy(copy, str, size);
+        copy[size] = '\0';
+
+        return copy;
+    }
+
+    /** Number of allocated blocks */
+    size_t blocks() const { return m_block_cnt; }
+
+    /** Destructor (releases all memory) */
+    ~arena();
+
+};  // end of class arena
+
+
+/**
+ *  \brief  Arena allocator
+ *
+ *  Standard allocator adapter for \ref arena (allows for arena-backed
+ *  standard containers).
+ *  Deallocation is no-op; the memory is released with the arena.
+ *
+ *  \tparam  T  Value type
+ */
+template <class T>
+class arena_allocator {
+    template <class U> friend class arena_allocator;
+
+    private:
+
+    arena * m_arena;  /**< Arena */
+
+    public:
+
+    using value_type = T;
+
+    /** Constructor */
+    arena_allocator(arena & arena_): m_arena(&arena_) {}
+
+    /** Rebinding constructor */
+    template <class U>
+    arena_allocator(const arena_allocator<U> & orig): m_arena(orig.m_arena) {}
+
+    T * allocate(size_t n) {
+        return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T * , size_t ) {}
+
+    template <class U>
+    bool operator == (const arena_allocator<U> & arg) const {
+        return m_arena == arg.m_arena;
+    }
+
+    template <class U>
+    bool operator != (const arena_allocator<U> & arg) const {
+        return m_arena != arg.m_arena;
+    }
+
+};  // end of template class arena_allocator
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__arena_hxx
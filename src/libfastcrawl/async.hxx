@@ -0,0 +1,395 @@
+#ifndef fastcrawl__async_hxx
+#define fastcrawl__async_hxx
+
+/**
+ *  \file
+ *  \brief  Coroutine-based asynchronous download API
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download.hxx"
+#include "download_loop.hxx"
+#include "online_data_processor.hxx"
+
+/*
+ *  The coroutine API requires C++20; the rest of the library is C++14,
+ *  so the header is empty for older language standards.
+ */
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <string>
+
+
+namespace fastcrawl {
+
+template <class T = void> class task;
+
+
+/** \ref task promise common part */
+class task_promise_base {
+    private:
+
+    /** Final awaiter (resumes the awaiting coroutine) */
+    struct final_awaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<Promise> coro) noexcept
+        {
+            auto continuation = coro.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+
+    };  // end of struct final_awaiter
+
+    std::coroutine_handle<> m_continuation;  /**< Awaiting coroutine */
+
+    protected:
+
+    std::exception_ptr      m_exception;     /**< Unhandled exception */
+
+    public:
+
+    /** Tasks are lazy */
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    final_awaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { m_exception = std::current_exception(); }
+
+    /** Set awaiting coroutine */
+    void continuation(std::coroutine_handle<> coro) { m_continuation = coro; }
+
+};  // end of class task_promise_base
+
+
+/** \ref task promise */
+template <class T>
+class task_promise: public task_promise_base {
+    private:
+
+    std::optional<T> m_value;  /**< Result */
+
+    public:
+
+    task<T> get_return_object();
+
+    template <class U>
+    void return_value(U && value) { m_value.emplace(std::forward<U>(value)); }
+
+    /** Get result (or rethrow unhandled exception) */
+    T result() {
+        if (m_exception) std::rethrow_exception(m_exception);
+        return std::move(*m_value);
+    }
+
+};  // end of template class task_promise
+
+
+/** \ref task promise (no result) */
+template <>
+class task_promise<void>: public task_promise_base {
+    public:
+
+    task<void> get_return_object();
+
+    void return_void() {}
+
+    /** Rethrow unhandled exception (if any) */
+    void result() {
+        if (m_exception) std::rethrow_exception(m_exception);
+    }
+
+};  // end of class task_promise<void>
+
+
+/**
+ *  \brief  Asynchronous task
+ *
+ *  Lazily started coroutine; it starts when awaited (\c co_await)
+ *  and the awaiting coroutine is resumed when the task finishes
+ *  (symmetric transfer, so long chains don't grow the stack).
+ *  Top-level tasks are started by \ref spawn.
+ *
+ *  \tparam  T  Result type
+ */
+template <class T>
+class task {
+    public:
+
+    using promise_type = task_promise<T>;
+    using handle_t     = std::coroutine_handle<promise_type>;
+
+    private:
+
+    handle_t m_coro;  /**< Coroutine */
+
+    /** Task awaiter */
+    struct awaiter {
+        handle_t coro;  /**< Awaited coroutine */
+
+        bool await_ready() noexcept { return !coro || coro.done(); }
+
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<> awaiting) noexcept
+        {
+            coro.promise().continuation(awaiting);
+            return coro;
+        }
+
+        T await_resume() { return coro.promise().result(); }
+
+    };  // end of struct awaiter
+
+    public:
+
+    explicit task(handle_t coro): m_coro(coro) {}
+
+    task(task && orig) noexcept: m_coro(std::exchange(orig.m_coro, nullptr)) {}
+
+    task & operator = (task && orig) noexcept {
+        if (this != &orig) {
+            if (m_coro) m_coro.destroy();
+            m_coro = std::exchange(orig.m_coro, nullptr);
+        }
+
+        return *this;
+    }
+
+    task(const task & ) = delete;
+    task & operator = (const task & ) = delete;
+
+    awaiter operator co_await () const noexcept { return awaiter{m_coro}; }
+
+    ~task() { if (m_coro) m_coro.destroy(); }
+
+};  // end of template class task
+
+
+template <class T>
+inline task<T> task_promise<T>::get_return_object() {
+    return task<T>(std::coroutine_handle<task_promise<T> >::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() {
+    return task<void>(std::coroutine_handle<task_promise<void> >::from_promise(*this));
+}
+
+
+/** Detached coroutine (see \ref spawn) */
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() noexcept { return {}; }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept { std::terminate(); }
+
+    };  // end of struct promise_type
+
+};  // end of struct detached_task
+
+
+/**
+ *  \brief  Start top-level task
+ *
+ *  The task runs in the current thread till its first suspension;
+ *  then it goes on wherever it's resumed (e.g. in \ref download_loop thread).
+ *  The task frame is released when it finishes.
+ *  The task must handle its exceptions (unhandled exception terminates).
+ *
+ *  \param  t  Task
+ */
+inline detached_task spawn(task<void> t) { co_await t; }
+
+
+/**
+ *  \brief  Download awaiter
+ *
+ *  Submits the download to \ref download_loop; the awaiting coroutine
+ *  is resumed (in the loop thread) when the download completes.
+ *  The result of \c co_await is the download status.
+ */
+class download_awaiter {
+    private:
+
+    download_loop &         m_loop;         /**< Download loop          */
+    download                m_download;     /**< Download               */
+    online_data_processor * m_processor;    /**< Online data processor  */
+    bool                    m_success;      /**< Download status        */
+
+    public:
+
+    download_awaiter(
+        download_loop &         loop,
+        const download &        dl,
+        online_data_processor * processor)
+    :
+        m_loop(loop),
+        m_download(dl),
+        m_processor(processor),
+        m_success(false)
+    {}
+
+    bool await_ready() noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        m_loop.submit(m_download, m_processor, [this, awaiting](bool success) {
+            m_success = success;
+            awaiting.resume();
+        });
+    }
+
+    bool await_resume() noexcept { return m_success; }
+
+};  // end of class download_awaiter
+
+
+/**
+ *  \brief  Asynchronous download
+ *
+ *  \code
+ *      bool ok = co_await download_async(loop, uri, filename, processor);
+ *  \endcode
+ *
+ *  \param  loop       Download loop
+ *  \param  uri        Content URI
+ *  \param  filename   Content storage file name
+ *  \param  processor  Online data processor injection
+ *
+ *  \return Awaitable download (see \ref download_awaiter)
+ */
+inline download_awaiter download_async(
+    download_loop &         loop,
+    const uri &             uri,
+    const std::string &     filename,
+    online_data_processor & processor)
+{
+    return download_awaiter(loop, download(uri, filename), &processor);
+}
+
+
+/**
+ *  \brief  Asynchronous download (no data processor)
+ *
+ *  \param  loop       Download loop
+ *  \param  uri        Content URI
+ *  \param  filename   Content storage file name
+ *
+ *  \return Awaitable download (see \ref download_awaiter)
+ */
+inline download_awaiter download_async(
+    download_loop &         loop,
+    const uri &             uri,
+    const std::string &     filename)
+{
+    return download_awaiter(loop, download(uri, filename), nullptr);
+}
+
+
+/**
+ *  \brief  Scheduler switch awaiter
+ *
+ *  Resumes the awaiting coroutine by an executor: \ref download_loop
+ *  (cheap work, e.g. parsing small pages) or a thread pool
+ *  (\ref thread_pool or \ref work_stealing_pool; CPU-heavy work).
+ *
+ *  \tparam  Executor  Executor type
+ */
+template <class Executor>
+class resume_on_awaiter {
+    private:
+
+    Executor & m_executor;  /**< Executor */
+
+    /** Executor submission */
+    static bool submit(download_loop & loop, job j) {
+        loop.post(std::move(j));
+        return true;
+    }
+
+    /** Executor submission (thread pools) */
+    template <class Pool>
+    static bool submit(Pool & pool, job j) { return pool.run(std::move(j)); }
+
+    public:
+
+    resume_on_awaiter(Executor & executor): m_executor(executor) {}
+
+    bool await_ready() noexcept { return false; }
+
+    /** Resumes inline if the executor rejected the job */
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        return submit(m_executor, [awaiting]() { awaiting.resume(); });
+    }
+
+    void await_resume() noexcept {}
+
+};  // end of template class resume_on_awaiter
+
+
+/**
+ *  \brief  Continue the coroutine by an executor
+ *
+ *  \code
+ *      co_await resume_on(pool);
+ *  \endcode
+ *
+ *  \param  executor  Executor (download loop or thread pool)
+ *
+ *  \return Awaitable switch (see \ref resume_on_awaiter)
+ */
+template <class Executor>
+inline resume_on_awaiter<Executor> resume_on(Executor & executor) {
+    return resume_on_awaiter<Executor>(executor);
+}
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #if C++20 coroutines
+
+#endif  // end of #ifndef fastcrawl__async_hxx
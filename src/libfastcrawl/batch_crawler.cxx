@@ -0,0 +1,236 @@
+/**
+ *  \file
+ *  \brief  Multi-seed batch crawler
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "batch_crawler.hxx"
+#include "download.hxx"
+#include "thread_pool.hxx"
+#include "simhash.hxx"
+#include "mapped_file.hxx"
+#include "uri.hxx"
+
+extern "C" {
+#include <sys/stat.h>
+#include <sys/types.h>
+}
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include <cerrno>
+
+
+namespace fastcrawl {
+
+/** Seed crawl */
+struct batch_crawler::seed {
+    using clock_t = std::chrono::steady_clock;  /**< Crawl clock */
+
+    seed_report                   report;       /**< Seed report          */
+    std::string                   directory;    /**< Storage directory    */
+    std::unique_ptr<html_crawler> crawler;      /**< Seed crawler         */
+    bool                          page_done;    /**< Seed page downloaded */
+    clock_t::time_point           start;        /**< Crawl start          */
+
+    seed(): page_done(false), start(clock_t::now()) {}
+
+    /**
+     *  \brief  Download the page, crawl it unless it's a near-duplicate
+     *
+     *  \param  dl            Page download
+     *  \param  fingerprints  Crawled pages fingerprints
+     *
+     *  \return \c true iff the page was downloaded
+     */
+    bool crawl_unique(const download & dl, fingerprint_index & fingerprints);
+
+};  // end of struct batch_crawler::seed
+
+
+bool batch_crawler::seed::crawl_unique(
+    const download &    dl,
+    fingerprint_index & fingerprints)
+{
+    {
+        simhash fingerprint(report.fingerprint);
+        if (!dl(fingerprint)) return false;
+    }  // fingerprint assigned
+
+    if (!fingerprints.insert(report.fingerprint)) {
+        report.near_duplicate = true;
+        return true;
+    }
+
+    // Segment the stored page; chunks are fed as the download queue
+    // allows (just like the downloaded ones)
+    static const size_t chunk_size = 1 << 16;
+
+    try {
+        mapped_file page(directory + "/index.html");
+
+        for (size_t offset = 0; offset < page.size(); offset += chunk_size) {
+            while (crawler->congested())
+                crawler->wait_ready(std::chrono::milliseconds(100));
+
+            (*crawler)(page.data() + offset,
+                std::min(chunk_size, page.size() - offset));
+        }
+    }
+    catch (const std::exception & x) {
+        LOG << "Seed page crawl failed: " << x.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+size_t batch_crawler::operator () (
+    std::istream &            seeds,
+    const report_callback_t & report)
+{
+    std::deque<std::unique_ptr<seed> > in_flight;  // in seeds order
+
+    // Seed pages are downloaded by own threads; these may be paused
+    // by the shared download queue backpressure, so they must not
+    // hold the download threads
+    thread_pool seed_tp(0, m_seed_limit);
+    std::mutex                         mutex;
+    std::condition_variable            page_done;
+
+    // Wait for the oldest seed crawl & report it
+    auto finish = [&]() {
+        auto & s = *in_flight.front();
+
+        if (s.crawler) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                page_done.wait(lock, [&s]() { return s.page_done; });
+            }
+
+            s.crawler->wait();
+            s.report.summary = s.crawler->summary();
+            s.crawler->timings(m_timings);
+        }
+
+        const std::chrono::duration<double> time = seed::clock_t::now() - s.start;
+        s.report.time = time.count();
+
+        if (report) report(s.report);
+
+        in_flight.pop_front();
+    };
+
+    size_t index = 0;
+    for (std::string line; std::getline(seeds, line); ) {
+        // Trim & skip empty lines and comments
+        const auto begin = line.find_first_not_of(" \t\r");
+        if (std::string::npos == begin || '#' == line[begin]) continue;
+
+        const auto end = line.find_last_not_of(" \t\r");
+
+        if (in_flight.size() >= m_seed_limit) finish();
+
+        in_flight.emplace_back(new seed);
+        auto * s = in_flight.back().get();
+
+        s->report.index     = ++index;
+        s->report.seed      = line.substr(begin, end - begin + 1);
+        s->report.success   = false;
+        s->report.duplicate = false;
+        s->report.near_duplicate = false;
+        s->report.fingerprint    = 0;
+        s->report.summary   = html_crawler::summary_t{ 0, 0, 0, 0, 0, 0 };
+        s->report.time      = 0;
+
+        const auto uri = uri::parse(s->report.seed);
+
+        // Repeated seed (or a content URI crawled already)
+        if (!m_context.claim(uri)) {
+            s->report.duplicate = true;
+            continue;
+        }
+
+        char dir[16];
+        std::snprintf(dir, sizeof(dir), "./%06zu", index);
+        s->directory = dir;
+
+        if (::mkdir(dir, 0755) && EEXIST != errno) {
+            LOG << "Failed to create directory " << dir << std::endl;
+            continue;
+        }
+
+        s->crawler.reset(new html_crawler(m_context, uri));
+        s->crawler->verbose_log(verbose_log());
+        s->crawler->directory(s->directory);
+        if (m_setup) m_setup(*s->crawler);
+
+        // Crawl the seed page during download (by a seed thread)
+        auto crawl = [this, s, &mutex, &page_done]() {
+            download dl(s->crawler->base(), s->directory + "/index.html");
+            dl.verbose_log(verbose_log());
+            dl.share(m_context.share());
+            const auto policy = m_context.governor().policy().page();
+            dl.policy(&policy);
+
+            auto * fingerprints = m_context.near_duplicates();
+            const bool success  = fingerprints
+                ? s->crawl_unique(dl, *fingerprints)
+                : dl(*s->crawler);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            s->report.success = success;
+            s->page_done      = true;
+            page_done.notify_all();
+        };
+
+        if (!seed_tp.run(crawl)) crawl();  // shut down
+    }
+
+    while (!in_flight.empty()) finish();
+
+    return index;
+}
+
+}  // end of namespace fastcrawl
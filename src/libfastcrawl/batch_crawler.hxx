@@ -0,0 +1,161 @@
+#ifndef fastcrawl__batch_crawler_hxx
+#define fastcrawl__batch_crawler_hxx
+
+/**
+ *  \file
+ *  \brief  Multi-seed batch crawler
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "crawl_context.hxx"
+#include "html_crawler.hxx"
+#include "timing_report.hxx"
+#include "logger.hxx"
+
+#include <string>
+#include <iostream>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Batch crawler
+ *
+ *  Crawls many seed pages concurrently in one process.
+ *  Each seed page is crawled by its own \ref html_crawler; all the crawlers
+ *  share the \ref crawl_context (download threads, DNS & connection cache
+ *  and the set of downloaded URIs).
+ *
+ *  The seeds are read line by line (empty lines and lines beginning with
+ *  \c '#' are skipped).
+ *  At most \c seed_limit seeds are crawled at once; the seed reports
+ *  are passed to the report callback in the order of the seeds.
+ *  The seed pages are downloaded by separate threads (one per seed
+ *  crawled at once).
+ *
+ *  Content of the n-th seed is stored in directory named \c NNNNNN
+ *  (created in the current directory); the seed page is stored there
+ *  as \c index.html.
+ *
+ *  If the context detects near-duplicate pages (see
+ *  \ref crawl_context::near_duplicates), the seed page is fingerprinted
+ *  while it's downloaded and segmented when it's complete (from the stored
+ *  file); references of near-duplicates of pages crawled before aren't
+ *  extracted at all.
+ *  Note that the referenced content downloads don't overlap with the page
+ *  download then.
+ */
+class batch_crawler: public logger {
+    public:
+
+    /** Seed crawl report */
+    struct seed_report {
+        size_t                  index;          /**< Seed index (from 1)      */
+        std::string             seed;           /**< Seed URI                 */
+        bool                    success;        /**< Seed page downloaded     */
+        bool                    duplicate;      /**< Repeated seed (not
+                                                     crawled)                 */
+        bool                    near_duplicate; /**< Near-duplicate page
+                                                     (references not crawled) */
+        uint64_t                fingerprint;    /**< Page SimHash (or 0)      */
+        html_crawler::summary_t summary;        /**< Referenced content
+                                                     summary                  */
+        double                  time;           /**< Seed crawl time [s]      */
+
+    };  // end of struct seed_report
+
+    /** Seed report callback (called from the \ref operator() thread) */
+    using report_callback_t = std::function<void (const seed_report &)>;
+
+    /** Crawler setup callback (pipeline, logging etc.) */
+    using setup_callback_t = std::function<void (html_crawler &)>;
+
+    private:
+
+    struct seed;  // seed crawl (see batch_crawler.cxx)
+
+    crawl_context &  m_context;     /**< Shared crawl context        */
+    const size_t     m_seed_limit;  /**< Max. seeds crawled at once  */
+    setup_callback_t m_setup;       /**< Crawler setup               */
+    timing_report    m_timings;     /**< Transfer timings (all)      */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  context     Shared crawl context
+     *  \param  seed_limit  Max. number of seeds crawled at once
+     */
+    batch_crawler(crawl_context & context, size_t seed_limit = 16):
+        m_context(context),
+        m_seed_limit(seed_limit ? seed_limit : 1)
+    {}
+
+    /**
+     *  \brief  Set crawler setup callback
+     *
+     *  The callback is called for each seed crawler before the crawling
+     *  starts.
+     *
+     *  \param  setup  Setup callback
+     */
+    void setup(setup_callback_t setup) { m_setup = setup; }
+
+    /**
+     *  \brief  Crawl seeds
+     *
+     *  Returns when all the seeds are crawled.
+     *
+     *  \param  seeds   Seed URIs (one per line)
+     *  \param  report  Seed report callback
+     *
+     *  \return Number of seeds
+     */
+    size_t operator () (std::istream & seeds, const report_callback_t & report);
+
+    /** Transfer timings of all the crawled content */
+    const timing_report & timings() const { return m_timings; }
+
+};  // end of class batch_crawler
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__batch_crawler_hxx
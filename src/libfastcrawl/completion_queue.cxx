@@ -0,0 +1,91 @@
+/**
+ *  \file
+ *  \brief  Download completion queue
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "completion_queue.hxx"
+
+#include <utility>
+
+
+namespace fastcrawl {
+
+void completion_queue::push(const std::string & uri, const uri_record & record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_queue.push_back(completion{uri, record});
+    m_ready.notify_one();
+}
+
+
+bool completion_queue::pop(completion & c) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_queue.empty()) {
+        if (m_closed) return false;  // nothing more to come
+
+        m_ready.wait(lock);
+    }
+
+    c = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    return true;
+}
+
+
+bool completion_queue::try_pop(completion & c) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_queue.empty()) return false;
+
+    c = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    return true;
+}
+
+
+void completion_queue::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_closed = true;
+    m_ready.notify_all();
+}
+
+}  // end of namespace fastcrawl
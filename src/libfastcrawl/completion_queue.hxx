@@ -0,0 +1,142 @@
+#ifndef fastcrawl__completion_queue_hxx
+#define fastcrawl__completion_queue_hxx
+
+/**
+ *  \file
+ *  \brief  Download completion queue
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "uri_record.hxx"
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Download completion callback
+ *
+ *  Called (from the download thread) as soon as a content download
+ *  finished, with the content URI and the (final) download record.
+ *  The callback must be thread-safe, as downloads finish concurrently.
+ */
+using completion_callback_t =
+    std::function<void (const std::string & uri, const uri_record & record)>;
+
+
+/** Download completion */
+struct completion {
+    std::string uri;        /**< Content URI     */
+    uri_record  record;     /**< Download record */
+
+};  // end of struct completion
+
+
+/**
+ *  \brief  Download completion queue
+ *
+ *  Thread-safe queue of download completions.
+ *  Downloads push the completions (see \ref callback) as they finish;
+ *  consumers may pop them concurrently with ongoing downloads.
+ *  The producer closes the queue when there's nothing more to come.
+ */
+class completion_queue {
+    private:
+
+    std::deque<completion>          m_queue;    /**< Completions      */
+    bool                            m_closed;   /**< Queue closed     */
+    mutable std::mutex              m_mutex;    /**< Queue mutex      */
+    std::condition_variable         m_ready;    /**< Completion ready */
+
+    public:
+
+    completion_queue(): m_closed(false) {}
+
+    /**
+     *  \brief  Push completion
+     *
+     *  \param  uri     Content URI
+     *  \param  record  Download record
+     */
+    void push(const std::string & uri, const uri_record & record);
+
+    /**
+     *  \brief  Pop completion
+     *
+     *  Blocks until a completion is available or the queue is closed.
+     *
+     *  \param  c  Completion
+     *
+     *  \return \c false iff the queue is closed and empty
+     */
+    bool pop(completion & c);
+
+    /**
+     *  \brief  Pop completion (non-blocking)
+     *
+     *  \param  c  Completion
+     *
+     *  \return \c true iff a completion was popped
+     */
+    bool try_pop(completion & c);
+
+    /** Close the queue (pending completions may still be popped) */
+    void close();
+
+    /** Queue is closed */
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_closed;
+    }
+
+    /** Completion callback pushing to the queue */
+    completion_callback_t callback() {
+        return [this](const std::string & uri, const uri_record & record) {
+            push(uri, record);
+        };
+    }
+
+};  // end of class completion_queue
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__completion_queue_hxx
@@ -0,0 +1,121 @@
+/**
+ *  \file
+ *  \brief  Shared crawl context
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "crawl_context.hxx"
+#include "metrics.hxx"
+
+extern "C" {
+#include <curl/curl.h>
+}
+
+
+namespace fastcrawl {
+
+static_assert(CURL_LOCK_DATA_LAST <= 16, "cURL share lock count too low");
+
+
+/** cURL share lock callback (the user data are the locks) */
+static void share_lock(CURL * , curl_lock_data data, curl_lock_access , void * locks) {
+    reinterpret_cast<std::mutex *>(locks)[data].lock();
+}
+
+
+/** cURL share unlock callback (the user data are the locks) */
+static void share_unlock(CURL * , curl_lock_data data, void * locks) {
+    reinterpret_cast<std::mutex *>(locks)[data].unlock();
+}
+
+
+crawl_context::crawl_context(size_t parallel_download_limit):
+    m_download_tp(20, parallel_download_limit),
+    m_share(::curl_share_init()),
+    m_duplicates(0),
+    m_claims(true)
+{
+    if (nullptr == m_share) return;  // no sharing (downloads work anyway)
+
+    auto * share = (CURLSH *)m_share;
+
+    ::curl_share_setopt(share, CURLSHOPT_LOCKFUNC,   &share_lock);
+    ::curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &share_unlock);
+    ::curl_share_setopt(share, CURLSHOPT_USERDATA,   m_share_locks.data());
+
+    ::curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    ::curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    ::curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+
+bool crawl_context::preconnect(preconnector::mode_t mode) {
+    if (nullptr == m_share) return false;
+
+    m_preconnector.reset(new preconnector(m_share, mode));
+    return true;
+}
+
+
+bool crawl_context::claim(const std::string & uri) {
+    std::lock_guard<std::mutex> lock(m_claimed_mutex);
+
+    if (m_claimed.insert(uri).second) return true;
+
+    ++m_duplicates;
+    return false;
+}
+
+
+void crawl_context::sample_metrics() const {
+    const auto stats = m_download_tp.stats();
+    auto & gauges = metrics::global();
+
+    gauges.queue_depth.set(stats.queued);
+    gauges.pool_size.set(stats.size);
+    gauges.busy_threads.set(stats.busy);
+}
+
+
+crawl_context::~crawl_context() {
+    m_download_tp.shutdown();  // transfers (easy handles) must go first
+    m_preconnector.reset();
+
+    if (m_share) ::curl_share_cleanup((CURLSH *)m_share);
+}
+
+}  // end of namespace fastcrawl
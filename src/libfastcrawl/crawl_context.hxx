@@ -0,0 +1,210 @@
+#ifndef fastcrawl__crawl_context_hxx
+#define fastcrawl__crawl_context_hxx
+
+/**
+ *  \file
+ *  \brief  Shared crawl context
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "thread_pool.hxx"
+#include "download_governor.hxx"
+#include "preconnector.hxx"
+#include "fingerprint_index.hxx"
+#include "uri.hxx"
+
+#include <string>
+#include <unordered_set>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Shared crawl context
+ *
+ *  Resources shared by many \ref html_crawler instances crawling
+ *  concurrently in one process (see \ref batch_crawler):
+ *
+ *  * download thread pool (its thread limit is the global concurrency
+ *    budget),
+ *  * cURL share handle (DNS cache, connection cache and TLS sessions,
+ *    so that connections are reused across crawlers),
+ *  * global set of claimed content URIs (each URI is only downloaded once
+ *    by the crawlers of the context),
+ *  * download governor (latency observations, host circuit breakers),
+ *  * preconnector (optional, warms up the share for new hosts as soon
+ *    as they are discovered, see \ref preconnect),
+ *  * index of crawled pages fingerprints (optional, near-duplicate pages
+ *    aren't crawled, see \ref near_duplicates).
+ *
+ *  The context must outlive the crawlers using it.
+ */
+class crawl_context {
+    private:
+
+    /** cURL share locks (indexed by \c curl_lock_data) */
+    using share_locks_t = std::array<std::mutex, 16>;
+
+    thread_pool                     m_download_tp;      /**< Download threads     */
+    void *                          m_share;            /**< cURL share handle    */
+    share_locks_t                   m_share_locks;      /**< cURL share locks     */
+    std::unordered_set<std::string> m_claimed;          /**< Claimed URIs         */
+    size_t                          m_duplicates;       /**< Refused claims count */
+    bool                            m_claims;           /**< Claim content URIs   */
+    mutable std::mutex              m_claimed_mutex;    /**< Claimed URIs mutex   */
+    download_governor               m_governor;         /**< Download governor    */
+    std::unique_ptr<preconnector>   m_preconnector;     /**< Preconnector         */
+    std::unique_ptr<fingerprint_index> m_fingerprints;  /**< Pages fingerprints   */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  parallel_download_limit  Max. amount of download threads
+     *                                   (for all the crawlers together)
+     */
+    crawl_context(size_t parallel_download_limit = SIZE_MAX);
+
+    crawl_context(const crawl_context & ) = delete;
+    crawl_context & operator = (const crawl_context & ) = delete;
+
+    /** Shared download thread pool */
+    thread_pool & download_pool() { return m_download_tp; }
+
+    /** Shared download governor */
+    download_governor & governor() { return m_governor; }
+
+    /** cURL share handle (or \c nullptr if sharing isn't available) */
+    void * share() const { return m_share; }
+
+    /**
+     *  \brief  Enable speculative preconnect (see \ref preconnector)
+     *
+     *  Must be set before the crawl starts.
+     *
+     *  \param  mode  Preconnect mode
+     *
+     *  \return \c true iff enabled (i.e. sharing is available)
+     */
+    bool preconnect(preconnector::mode_t mode);
+
+    /** Preconnector (or \c nullptr if preconnect isn't enabled) */
+    preconnector * preconnect() const { return m_preconnector.get(); }
+
+    /**
+     *  \brief  Enable near-duplicate pages detection
+     *
+     *  Pages with \ref simhash fingerprint within the Hamming distance
+     *  of a crawled page fingerprint are near-duplicates; their references
+     *  aren't extracted (see \ref batch_crawler).
+     *  Must be set before the crawl starts.
+     *
+     *  \param  max_distance  Max. fingerprint distance of near-duplicates
+     */
+    void near_duplicates(unsigned max_distance) {
+        m_fingerprints.reset(new fingerprint_index(max_distance));
+    }
+
+    /** Pages fingerprint index (or \c nullptr if detection isn't enabled) */
+    fingerprint_index * near_duplicates() const { return m_fingerprints.get(); }
+
+    /**
+     *  \brief  Warm up content URI origin (if preconnect is enabled)
+     *
+     *  \param  uri_  Absolute content URI
+     */
+    void warm_up(const uri & uri_) {
+        if (m_preconnector) m_preconnector->warm(uri_);
+    }
+
+    /**
+     *  \brief  Enable/disable content URI claims
+     *
+     *  The claims are enabled by default.
+     *  A context used by a single crawler (e.g. just for its connection
+     *  cache) needn't claim the URIs (the crawler doesn't download
+     *  a URI twice anyway); the crawler then doesn't have to resolve
+     *  every found reference (unless it's needed for preconnect).
+     *  Must be set before the crawl starts.
+     */
+    void claims(bool enable) { m_claims = enable; }
+
+    /** Content URI claims are enabled */
+    bool claims() const { return m_claims; }
+
+    /**
+     *  \brief  Claim content URI
+     *
+     *  \param  uri  Absolute content URI
+     *
+     *  \return \c true iff the URI wasn't claimed before
+     */
+    bool claim(const std::string & uri);
+
+    /** Number of claimed URIs */
+    size_t claimed() const {
+        std::lock_guard<std::mutex> lock(m_claimed_mutex);
+        return m_claimed.size();
+    }
+
+    /** Number of refused (repeated) claims */
+    size_t duplicates() const {
+        std::lock_guard<std::mutex> lock(m_claimed_mutex);
+        return m_duplicates;
+    }
+
+    /**
+     *  \brief  Sample download pool gauges
+     *
+     *  Same as \ref html_crawler::sample_metrics for the shared pool.
+     */
+    void sample_metrics() const;
+
+    /** Destructor (waits for the downloads, then releases the share) */
+    ~crawl_context();
+
+};  // end of class crawl_context
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__crawl_context_hxx
@@ -0,0 +1,182 @@
+/**
+ *  \file
+ *  \brief  CRC32C online checksum
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "crc32c.hxx"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FASTCRAWL_CRC32C_X86
+#include <nmmintrin.h>
+#endif
+
+
+namespace fastcrawl {
+
+/** CRC32C polynomial (reflected) */
+static const uint32_t crc32c_poly = 0x82f63b78;
+
+
+/**
+ *  \brief  Slicing-by-8 lookup tables
+ *
+ *  \c table[k][b] is CRC of byte \c b followed by \c k zero bytes.
+ */
+struct crc32c_tables {
+    uint32_t table[8][256];
+
+    crc32c_tables() {
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t crc = b;
+            for (int i = 0; i < 8; ++i)
+                crc = (crc >> 1) ^ ((crc & 1) ? crc32c_poly : 0);
+
+            table[0][b] = crc;
+        }
+
+        for (uint32_t b = 0; b < 256; ++b)
+            for (int k = 1; k < 8; ++k)
+                table[k][b] = (table[k - 1][b] >> 8)
+                    ^ table[0][table[k - 1][b] & 0xff];
+    }
+
+};  // end of struct crc32c_tables
+
+
+/** Software implementation (slicing-by-8) */
+static uint32_t crc32c_sw(uint32_t crc, const unsigned char * data, size_t size) {
+    static const crc32c_tables tables;
+    const auto & t = tables.table;
+
+    crc = ~crc;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; size && ((uintptr_t)data & 7); --size, ++data)
+        crc = t[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        word ^= crc;
+
+        crc = t[7][ word        & 0xff] ^ t[6][(word >>  8) & 0xff]
+            ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff]
+            ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff]
+            ^ t[1][(word >> 48) & 0xff] ^ t[0][ word >> 56        ];
+    }
+#endif
+
+    for (; size; --size, ++data)
+        crc = t[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+
+#ifdef FASTCRAWL_CRC32C_X86
+
+/** Hardware implementation (SSE4.2 \c crc32 instruction) */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw(uint32_t crc, const unsigned char * data, size_t size) {
+    uint32_t crc32 = ~crc;
+
+    for (; size && ((uintptr_t)data & 7); --size, ++data)
+        crc32 = _mm_crc32_u8(crc32, *data);
+
+#ifdef __x86_64__
+    uint64_t crc64 = crc32;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc32 = (uint32_t)crc64;
+#else
+    for (; size >= 4; size -= 4, data += 4) {
+        uint32_t word;
+        std::memcpy(&word, data, 4);
+        crc32 = _mm_crc32_u32(crc32, word);
+    }
+#endif
+
+    for (; size; --size, ++data)
+        crc32 = _mm_crc32_u8(crc32, *data);
+
+    return ~crc32;
+}
+
+#endif  // end of #ifdef FASTCRAWL_CRC32C_X86
+
+
+/** Implementation function type */
+using crc32c_impl_t = uint32_t (*)(uint32_t, const unsigned char *, size_t);
+
+/** Select implementation (once) */
+static crc32c_impl_t crc32c_impl() {
+#ifdef FASTCRAWL_CRC32C_X86
+    static const crc32c_impl_t impl =
+        __builtin_cpu_supports("sse4.2") ? &crc32c_hw : &crc32c_sw;
+#else
+    static const crc32c_impl_t impl = &crc32c_sw;
+#endif
+
+    return impl;
+}
+
+
+uint32_t crc32c::update(uint32_t crc, const unsigned char * data, size_t size) {
+    return crc32c_impl()(crc, data, size);
+}
+
+
+bool crc32c::hardware() {
+#ifdef FASTCRAWL_CRC32C_X86
+    return &crc32c_hw == crc32c_impl();
+#else
+    return false;
+#endif
+}
+
+
+void crc32c::operator () (unsigned char * data, size_t size) {
+    m_checksum = update(m_checksum, data, size);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,98 @@
+#ifndef fastcrawl__crc32c_hxx
+#define fastcrawl__crc32c_hxx
+
+/**
+ *  \file
+ *  \brief  CRC32C online checksum
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Online data checksum based on CRC32C (Castagnoli) algorithm
+ *
+ *  On x86 CPUs supporting SSE4.2, the hardware \c crc32 instruction
+ *  is used (detected at runtime).
+ *  Otherwise, table-driven slicing-by-8 software implementation is used.
+ *
+ *  See https://tools.ietf.org/html/rfc3720#appendix-B.4
+ */
+class crc32c: public online_data_processor {
+    private:
+
+    uint32_t   m_checksum;  /**< Online checksum */
+    uint32_t & m_result;    /**< Final result    */
+
+    public:
+
+    /** Constructor, takes reference to the result */
+    crc32c(uint32_t & result): m_checksum(0), m_result(result) {}
+
+    void operator () (unsigned char * data, size_t size);
+
+    /** Destructor assigns the result */
+    ~crc32c() { m_result = m_checksum; }
+
+    /**
+     *  \brief  Update checksum
+     *
+     *  Same semantics as Zlib \c crc32 function: the initial checksum is 0
+     *  and the function may be called on subsequent data chunks.
+     *
+     *  \param  crc   Checksum of the preceding data
+     *  \param  data  Data chunk
+     *  \param  size  Data chunk size
+     *
+     *  \return Checksum including the data chunk
+     */
+    static uint32_t update(uint32_t crc, const unsigned char * data, size_t size);
+
+    /** \c true iff hardware implementation is used */
+    static bool hardware();
+
+};  // end of class crc32c
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__crc32c_hxx
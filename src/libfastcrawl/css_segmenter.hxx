@@ -0,0 +1,435 @@
+#ifndef fastcrawl__css_segmenter_hxx
+#define fastcrawl__css_segmenter_hxx
+
+/**
+ *  \file
+ *  \brief  Online CSS reference segmenter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Online CSS reference segmenter
+ *
+ *  Finds content references in stylesheets: \c url(...) function
+ *  values (quoted or not) and \c @import rule targets (strings
+ *  or \c url(...)).
+ *  Comments are skipped, so are strings (but the \c @import ones),
+ *  i.e. \c url( text in a comment or string isn't a reference.
+ *
+ *  Same as \ref html_segmenter, the segmenter is a simple character-level
+ *  Finite State Automaton; at any point, the processing may be interrupted
+ *  and continued (when further data become available), so references
+ *  crossing data chunk boundaries are found.
+ *  Values longer than \ref max_value (e.g. inlined \c data: URIs) are
+ *  dropped as soon as they exceed the limit.
+ *
+ *  The \c Sink gets the references; it's called as <tt>sink(rule, value)</tt>
+ *  where \c rule is \c "url" or \c "@import" (C string) and \c value
+ *  is the reference (\c std::string, escapes removed).
+ *
+ *  \tparam  Sink  Reference sink
+ */
+template <class Sink>
+class css_segmenter {
+    public:
+
+    /** Max. reference length */
+    static const size_t max_value = 4096;
+
+    private:
+
+    /** FSA node */
+    enum node_t {
+        DOC = 0,        /**< Outside of comments, strings and references */
+        SLASH,          /**< Possible comment begin                      */
+        COMMENT,        /**< Comment                                     */
+        COMMENT_STAR,   /**< Possible comment end                        */
+        STRING,         /**< String                                      */
+        STRING_ESCAPE,  /**< Escaped character in string                 */
+        AT_KEYWORD,     /**< At-rule keyword                             */
+        IMPORT,         /**< Import rule (before the reference)          */
+        URL_MATCH,      /**< Matching "url(" function name               */
+        URL_OPEN,       /**< Function opened (before the value)          */
+        URL_VALUE,      /**< Unquoted value                              */
+        URL_ESCAPE,     /**< Escaped character in unquoted value         */
+        URL_CLOSE,      /**< Value done, function closing expected       */
+    };  // end of enum node_t
+
+    Sink          m_sink;       /**< Reference sink                        */
+    node_t        m_node;       /**< Current FSA node                      */
+    node_t        m_after;      /**< Node after string (DOC or URL_CLOSE)  */
+    unsigned char m_quote;      /**< String quote character                */
+    bool          m_capture;    /**< Capture string (it's a reference)     */
+    bool          m_import;     /**< Reference of import rule              */
+    bool          m_ident;      /**< Last character was an identifier one  */
+    size_t        m_match;      /**< Matched "url(" characters             */
+    std::string   m_keyword;    /**< At-rule keyword                       */
+    std::string   m_value;      /**< Collected reference                   */
+
+    /** Identifier character check */
+    static bool ident_char(unsigned char ch) {
+        if ('a' <= ch && ch <= 'z') return true;
+        if ('A' <= ch && ch <= 'Z') return true;
+        if ('0' <= ch && ch <= '9') return true;
+        if ('-' == ch || '_' == ch || 0x80 <= ch) return true;
+
+        return false;
+    }
+
+    /** Whitespace check */
+    static bool space(unsigned char ch) {
+        return ' ' == ch || '\t' == ch || '\n' == ch || '\r' == ch || '\f' == ch;
+    }
+
+    /** ASCII case folding */
+    static unsigned char fold(unsigned char ch) {
+        return 'A' <= ch && ch <= 'Z' ? ch | 0x20 : ch;
+    }
+
+    /** Switch to document level */
+    void ascend() {
+        m_node    = DOC;
+        m_import  = false;
+        m_capture = false;
+        m_ident   = false;
+    }
+
+    /** Collect reference character (drop overlong reference) */
+    void collect(unsigned char ch) {
+        if (m_value.size() < max_value) m_value += ch;
+        else ascend();
+    }
+
+    /** Pass collected reference to the sink */
+    void emit() {
+        if (!m_value.empty()) m_sink(m_import ? "@import" : "url", m_value);
+        ascend();
+    }
+
+    /** Open string */
+    void open_string(unsigned char quote, bool capture, node_t after) {
+        m_quote   = quote;
+        m_capture = capture;
+        m_after   = after;
+        m_node    = STRING;
+        m_value.clear();
+    }
+
+    /** Start "url(" matching (1st character matched) */
+    void match_url() {
+        m_match = 1;
+        m_node  = URL_MATCH;
+    }
+
+    /** Document level: seeking comments, strings and references */
+    void crawl_doc(unsigned char * data, size_t size, size_t & offset);
+
+    /**
+     *  \brief  Process character (out of the document level)
+     *
+     *  \param  ch  Character
+     *
+     *  \return \c false iff the character must be processed again
+     *          (in the new FSA node)
+     */
+    bool process(unsigned char ch);
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  sink  Reference sink
+     */
+    css_segmenter(Sink sink = Sink()):
+        m_sink(sink),
+        m_node(DOC),
+        m_after(DOC),
+        m_quote('\0'),
+        m_capture(false),
+        m_import(false),
+        m_ident(false),
+        m_match(0)
+    {
+        m_keyword.reserve(16);
+        m_value.reserve(256);  // reasonable reference length
+    }
+
+    /**
+     *  \brief  Segment (next) data chunk
+     *
+     *  \param  data  Data chunk
+     *  \param  size  Data chunk size
+     */
+    void operator () (unsigned char * data, size_t size) {
+        size_t offset = 0;
+        while (offset < size) {
+            if (DOC == m_node)
+                crawl_doc(data, size, offset);
+
+            else if (process(data[offset]))
+                ++offset;
+        }
+    }
+
+    /** Reference sink */
+    Sink & sink() { return m_sink; }
+
+    /**
+     *  \brief  Segmenter is at document level
+     *
+     *  I.e. not within a comment, string, at-rule or reference.
+     */
+    bool at_document_level() const { return DOC == m_node; }
+
+};  // end of template class css_segmenter
+
+
+// css_segmenter template members
+
+template <class Sink>
+void css_segmenter<Sink>::crawl_doc(
+    unsigned char * data,
+    size_t          size,
+    size_t        & offset)
+{
+    while (offset < size) {
+        const unsigned char ch = data[offset++];
+
+        switch (ch) {
+            case '/':
+                m_node = SLASH;
+                return;
+
+            case '"':
+            case '\'':
+                open_string(ch, false, DOC);
+                return;
+
+            case '@':
+                m_keyword.clear();
+                m_node = AT_KEYWORD;
+                return;
+
+            case 'u':
+            case 'U':
+                if (m_ident) break;  // e.g. "menu(" isn't a reference
+
+                match_url();
+                return;
+
+            default:
+                break;
+        }
+
+        m_ident = ident_char(ch);
+    }
+}
+
+
+template <class Sink>
+bool css_segmenter<Sink>::process(unsigned char ch) {
+    switch (m_node) {
+        case DOC:  // not here (see crawl_doc)
+            break;
+
+        case SLASH:
+            if ('*' == ch) {
+                m_node = COMMENT;
+                return true;
+            }
+
+            ascend();
+            return false;
+
+        case COMMENT:
+            if ('*' == ch) m_node = COMMENT_STAR;
+            return true;
+
+        case COMMENT_STAR:
+            if ('/' == ch) {
+                // Comments may be placed between import and its target
+                if (m_import) m_node = IMPORT;
+                else          ascend();
+            }
+            else if ('*' != ch) m_node = COMMENT;
+
+            return true;
+
+        case STRING:
+            if (m_quote == ch) {
+                if (DOC == m_after) {
+                    if (m_capture) emit();
+                    else           ascend();
+                }
+                else m_node = m_after;
+
+                return true;
+            }
+
+            if ('\\' == ch)
+                m_node = STRING_ESCAPE;
+            else if ('\n' == ch)  // unterminated string
+                ascend();
+            else if (m_capture)
+                collect(ch);
+
+            return true;
+
+        case STRING_ESCAPE:
+            m_node = STRING;
+            if (m_capture && '\n' != ch) collect(ch);
+            return true;
+
+        case AT_KEYWORD:
+            if (ident_char(ch)) {
+                if (m_keyword.size() < 16) m_keyword += fold(ch);
+                return true;
+            }
+
+            if ("import" == m_keyword) {
+                m_import = true;
+                m_node   = IMPORT;
+            }
+            else ascend();
+
+            return false;
+
+        case IMPORT:
+            if (space(ch)) return true;
+
+            switch (ch) {
+                case '"':
+                case '\'':
+                    open_string(ch, true, DOC);
+                    return true;
+
+                case 'u':
+                case 'U':
+                    match_url();
+                    return true;
+
+                case '/':
+                    m_node = SLASH;
+                    return true;
+
+                default:
+                    ascend();
+                    return false;
+            }
+
+        case URL_MATCH:
+            if ("url("[m_match] == fold(ch)) {
+                if (4 == ++m_match) {
+                    m_value.clear();
+                    m_node = URL_OPEN;
+                }
+
+                return true;
+            }
+
+            ascend();
+            m_ident = true;  // the matched characters
+            return false;
+
+        case URL_OPEN:
+            if (space(ch)) return true;
+
+            switch (ch) {
+                case '"':
+                case '\'':
+                    open_string(ch, true, URL_CLOSE);
+                    return true;
+
+                case ')':  // empty
+                    ascend();
+                    return true;
+
+                default:
+                    m_node = URL_VALUE;
+                    return false;
+            }
+
+        case URL_VALUE:
+            switch (ch) {
+                case ')':
+                    emit();
+                    return true;
+
+                case '\\':
+                    m_node = URL_ESCAPE;
+                    return true;
+
+                case '"':
+                case '\'':
+                case '(':  // bad URL
+                    ascend();
+                    return true;
+
+                default:
+                    if (space(ch)) m_node = URL_CLOSE;
+                    else           collect(ch);
+
+                    return true;
+            }
+
+        case URL_ESCAPE:
+            m_node = URL_VALUE;
+            collect(ch);
+            return true;
+
+        case URL_CLOSE:
+            if (space(ch)) return true;
+
+            if (')' == ch) emit();
+            else           ascend();  // bad URL
+
+            return true;
+    }
+
+    return true;
+}
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__css_segmenter_hxx
@@ -39,103 +39,321 @@
  */
 
 #include "download.hxx"
-#include "utility.hxx"
+#include "metrics.hxx"
 
 extern "C" {
 #include <curl/curl.h>
 }
 
 #include <iostream>
+#include <chrono>
 #include <cassert>
+#include <cstring>
+#include <cstdlib>
 
+#include <strings.h>
 
-namespace fastcrawl {
 
-/** cURL user data */
-struct curl_userdata {
-    online_data_processor * processor;  /**< Online data processor */
-    std::FILE             * file;       /**< Output file handle    */
+namespace fastcrawl {
 
-};  // end of struct curl_userdata
+download::transfer::~transfer() {
+    if (m_curl)    ::curl_easy_cleanup(m_curl);
+    if (m_headers) ::curl_slist_free_all((struct ::curl_slist *)m_headers);
+    if (m_file)    std::fclose(m_file);
+}
 
 
-/**
- *  \brief  cURL write callback
- *
- *  Callback for online data processor injection execution.
- *
- *  \param  ptr       Data chunk member array
- *  \param  size      Data chunk member size
- *  \param  nmemb     Number of members in the array
- *  \param  userdata  Callback data (see \ref curl_userdata)
- *
- *  \return Size of data appended to the output file
- */
-static size_t curl_write(
+size_t download::write(
     void * ptr,
     size_t size,
     size_t nmemb,
     void * userdata)
 {
-    auto * udata = reinterpret_cast<curl_userdata *>(userdata);
-    assert(udata && udata->processor && udata->file);
+    auto * xfer = reinterpret_cast<transfer *>(userdata);
+    assert(xfer);
+
+    // Backpressure
+    if (xfer->m_processor && xfer->m_processor->congested()) {
+        // Blocking transfer just waits (the connection is stalled meanwhile)
+        if (xfer->m_blocking) {
+            const std::chrono::milliseconds timeout(100);
+            while (!xfer->m_processor->wait_ready(timeout)) {}
+        }
+
+        // Pause (the chunk will be passed again when resumed)
+        else {
+            xfer->m_paused = true;
+            return CURL_WRITEFUNC_PAUSE;
+        }
+    }
+
+    // Content size limit (content length may be unknown)
+    xfer->m_size += size * nmemb;
+    if (xfer->m_admission && xfer->m_admission->max_size &&
+        xfer->m_size > xfer->m_admission->max_size)
+    {
+        xfer->m_skipped = SKIP_SIZE;
+        return 0;  // abort
+    }
+
+    // Content admitted, create storage file
+    if (nullptr == xfer->m_file) {
+        xfer->m_file = std::fopen(xfer->m_filename, "wb");
+        if (nullptr == xfer->m_file) return 0;  // abort
+    }
+
+    metrics::global().bytes_received.add(size * nmemb);
+
+    if (xfer->m_processor)
+        (*xfer->m_processor)((unsigned char *)ptr, size * nmemb);
+
+    return std::fwrite(ptr, size, nmemb, xfer->m_file);
+}
+
+
+/** Header field value (or \c nullptr if the line isn't the field) */
+static const char * header_field(
+    const char * line,
+    size_t       size,
+    const char * name,
+    size_t       name_len)
+{
+    if (size <= name_len || 0 != ::strncasecmp(line, name, name_len))
+        return nullptr;
+
+    const char * value = line + name_len;
+    while (' ' == *value || '\t' == *value) ++value;
+
+    return value;
+}
+
+
+size_t download::header(char * ptr, size_t size, size_t nmemb, void * userdata) {
+    auto * xfer = reinterpret_cast<transfer *>(userdata);
+    const size_t len = size * nmemb;
+
+    // Status line (new response head, e.g. after redirect)
+    if (len > 5 && 0 == std::strncmp(ptr, "HTTP/", 5)) {
+        const char * status = static_cast<const char *>(std::memchr(ptr, ' ', len));
+        xfer->m_status   = status ? std::strtol(status, nullptr, 10) : 0;
+        xfer->m_length   = UINT64_MAX;
+        xfer->m_encoded  = false;
+        xfer->m_location = false;
+        xfer->m_type.clear();
+
+        return len;
+    }
+
+    // End of head
+    if ('\r' == ptr[0] || '\n' == ptr[0]) {
+        if (1 == xfer->m_status / 100) return len;  // interim response
+        if (3 == xfer->m_status / 100 && xfer->m_location) return len;  // redirect
+
+        if (nullptr != xfer->m_admission) {
+            xfer->m_skipped = admit(*xfer);
+            if (NOT_SKIPPED != xfer->m_skipped) return 0;  // abort
+        }
 
-    (*udata->processor)((unsigned char *)ptr, size * nmemb);
-    return std::fwrite(ptr, size, nmemb, udata->file);
+        if (xfer->m_processor) xfer->m_processor->content_type(xfer->m_type);
+
+        return len;
+    }
+
+    const char * value;
+    if (nullptr != (value = header_field(ptr, len, "content-type:", 13))) {
+        const char * end = value;
+        while (end < ptr + len && ';' != *end && '\r' != *end && '\n' != *end &&
+            ' ' != *end) ++end;
+
+        xfer->m_type.assign(value, end - value);
+    }
+    else if (nullptr != (value = header_field(ptr, len, "content-length:", 15)))
+        xfer->m_length = std::strtoull(value, nullptr, 10);
+
+    else if (nullptr != (value = header_field(ptr, len, "content-encoding:", 17)))
+        xfer->m_encoded = 0 != ::strncasecmp(value, "identity", 8);
+
+    else if (nullptr != header_field(ptr, len, "location:", 9))
+        xfer->m_location = true;
+
+    return len;
+}
+
+
+skip_reason download::admit(const transfer & xfer) {
+    const auto & policy = *xfer.m_admission;
+
+    if (policy.skip_errors && xfer.m_status >= 400)
+        return SKIP_STATUS;
+
+    if (!policy.accepted(xfer.m_type))
+        return SKIP_TYPE;
+
+    // Content-Length is the encoded size; if the content is decoded,
+    // the (decoded) size is only checked as it's received
+    const bool decoded =
+        xfer.m_encoded && download_policy::DECODE == policy.compression;
+
+    if (policy.max_size && UINT64_MAX != xfer.m_length && !decoded &&
+        xfer.m_length > policy.max_size)
+    {
+        return SKIP_LENGTH;
+    }
+
+    return NOT_SKIPPED;
+}
+
+
+void download::resume(transfer & xfer) {
+    if (xfer.m_paused && !xfer.m_processor->congested()) {
+        xfer.m_paused = false;
+        ::curl_easy_pause(xfer.m_curl, CURLPAUSE_CONT);
+    }
+}
+
+
+int download::progress(void * userdata, int64_t, int64_t, int64_t, int64_t) {
+    resume(*reinterpret_cast<transfer *>(userdata));
+
+    return 0;
 }
 
 
-bool download::run(online_data_processor * processor) const {
+bool download::prepare(
+    transfer &              xfer,
+    online_data_processor * processor) const
+{
+    auto & stats = metrics::global();
+
     // Initialise curl
     auto * curl = ::curl_easy_init();
-    if (nullptr == curl) return false;  // failed to create CURL handle
-    run_at_eos([curl]() { ::curl_easy_cleanup(curl); });
+    if (nullptr == curl) {  // failed to create CURL handle
+        stats.failed.add();
+        return false;
+    }
+    xfer.m_curl = curl;
 
-    // Prepare file stream
-    std::FILE * file = std::fopen(m_filename.c_str(), "wb");
-    if (nullptr == file) return false;
-    run_at_eos([file]() { std::fclose(file); });
+    // The file is created with the first content chunk (if admitted)
+    xfer.m_filename = m_filename.c_str();
 
     // Prepare URI
-    std::string uri_str = m_uri;
-    ::curl_easy_setopt(curl, CURLOPT_URL, uri_str.c_str());
+    xfer.m_uri_str = m_uri;
+    ::curl_easy_setopt(curl, CURLOPT_URL, xfer.m_uri_str.c_str());
 
     // Prepare headers
-    struct ::curl_slist * headers = nullptr;
-    run_at_eos([headers]() { if (headers) ::curl_slist_free_all(headers); });
-
-    headers = ::curl_slist_append(headers, ("Host: " + m_uri.host).c_str());
+    auto * headers = ::curl_slist_append(nullptr,
+        ("Host: " + m_uri.host).c_str());
 
-    if (nullptr != headers)
+    if (nullptr != headers) {
+        xfer.m_headers = headers;
         ::curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    }
 
     // Other cURL options
     ::curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);  // follow redirects
 
-    // Set response data callback
-    if (nullptr != processor) {
-        curl_userdata userdata = {processor, file};
+    if (nullptr != m_share)  // shared DNS cache, connections...
+        ::curl_easy_setopt(curl, CURLOPT_SHARE, m_share);
+
+    // Timeouts
+    if (nullptr != m_policy) {
+        ::curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);  // MT-safe timeouts
+
+        if (m_policy->connect_timeout)
+            ::curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS,
+                (long)m_policy->connect_timeout);
+
+        if (m_policy->timeout)
+            ::curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long)m_policy->timeout);
 
-        ::curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &curl_write);
-        ::curl_easy_setopt(curl, CURLOPT_WRITEDATA,     &userdata);
+        if (m_policy->low_speed_time) {
+            ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT,
+                (long)m_policy->low_speed_limit);
+            ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME,
+                (long)m_policy->low_speed_time);
+        }
+
+        // Compression
+        if (download_policy::IDENTITY != m_policy->compression) {
+            ::curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");  // all supported
+
+            if (download_policy::ENCODED == m_policy->compression)
+                ::curl_easy_setopt(curl, CURLOPT_HTTP_CONTENT_DECODING, 0L);
+        }
+
+        // Content admission (checked at the end of response head)
+        if (m_policy->admission()) xfer.m_admission = m_policy;
     }
-    else {
-        ::curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &std::fwrite);
-        ::curl_easy_setopt(curl, CURLOPT_WRITEDATA,     file);
+
+    // Response head (content admission and type)
+    ::curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &download::header);
+    ::curl_easy_setopt(curl, CURLOPT_HEADERDATA,     &xfer);
+
+    // Set response data callback
+    xfer.m_processor = processor;
+
+    ::curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &download::write);
+    ::curl_easy_setopt(curl, CURLOPT_WRITEDATA,     &xfer);
+
+    // Resume paused transfer (see write)
+    if (nullptr != processor) {
+        ::curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, &download::progress);
+        ::curl_easy_setopt(curl, CURLOPT_XFERINFODATA,     &xfer);
+        ::curl_easy_setopt(curl, CURLOPT_NOPROGRESS,       0L);
     }
 
-    // Run download
     VLOG
-        << "Downloading URI \"" << uri_str
+        << "Downloading URI \"" << xfer.m_uri_str
         << "\", Host: \"" << m_uri.host
         << "\", storing as " << m_filename
         << std::endl;
 
-    const auto curl_res = ::curl_easy_perform(curl);
+    stats.in_flight.add();
+
+    return true;
+}
+
+
+bool download::finish(transfer & xfer, int result) const {
+    const auto curl_res = (CURLcode)result;
+
+    auto & stats = metrics::global();
+    stats.in_flight.sub();
+
+    // Bytes on the wire (i.e. before content decoding)
+    curl_off_t transferred = 0;
+    if (CURLE_OK == ::curl_easy_getinfo(xfer.m_curl,
+        CURLINFO_SIZE_DOWNLOAD_T, &transferred) && transferred > 0)
+    {
+        stats.bytes_transferred.add((uint64_t)transferred);
+    }
+
+    // Skipped content (partially stored if cut off)
+    if (NOT_SKIPPED != xfer.m_skipped) {
+        stats.skipped.add();
+
+        if (nullptr != xfer.m_file) {
+            std::fclose(xfer.m_file);
+            xfer.m_file = nullptr;
+            std::remove(m_filename.c_str());
+        }
+
+        VLOG
+            << "Download skipped: URI \"" << xfer.m_uri_str
+            << "\", Host: \"" << m_uri.host
+            << "\": " << skip_reason_str(xfer.m_skipped)
+            << " (status " << xfer.m_status
+            << ", type \"" << xfer.m_type << "\")"
+            << std::endl;
+
+        return false;
+    }
 
     if (CURLE_OK != curl_res) {
+        stats.failed.add();
+
         LOG
-            << "Download FAILED: URI \"" << uri_str
+            << "Download FAILED: URI \"" << xfer.m_uri_str
             << "\", Host: \"" << m_uri.host
             << "\" (stored as " << m_filename
             << "): " << curl_res
@@ -145,7 +363,88 @@ bool download::run(online_data_processor * processor) const {
         return false;
     }
 
+    // Empty content (never written)
+    if (nullptr == xfer.m_file) {
+        xfer.m_file = std::fopen(m_filename.c_str(), "wb");
+        if (nullptr == xfer.m_file) {
+            stats.failed.add();
+            return false;
+        }
+    }
+
+    stats.completed.add();
+
     return true;  // all OK :-)
-};
+}
+
+
+void download::cancel(const transfer & xfer) const {
+    metrics::global().in_flight.sub();
+
+    VLOG
+        << "Download cancelled: URI \"" << xfer.m_uri_str
+        << "\" (stored as " << m_filename << ")"
+        << std::endl;
+}
+
+
+size_t download::collect(void * multi, const finished_callback_t & finished) {
+    size_t finished_cnt = 0;
+
+    int msgs;
+    while (auto * msg = ::curl_multi_info_read((CURLM *)multi, &msgs)) {
+        if (CURLMSG_DONE != msg->msg) continue;
+
+        auto * const   curl   = msg->easy_handle;
+        const CURLcode result = msg->data.result;
+
+        ::curl_multi_remove_handle((CURLM *)multi, curl);
+        ++finished_cnt;
+
+        finished(curl, result);
+    }
+
+    return finished_cnt;
+}
+
+
+void download::timing(const transfer & xfer, transfer_timing & timing) {
+    auto * curl = xfer.m_curl;
+    if (nullptr == curl) return;
+
+    auto get = [curl](CURLINFO info, uint64_t & value) {
+        curl_off_t val = 0;
+        if (CURLE_OK == ::curl_easy_getinfo(curl, info, &val) && val > 0)
+            value = (uint64_t)val;
+    };
+
+    get(CURLINFO_NAMELOOKUP_TIME_T,    timing.namelookup);
+    get(CURLINFO_CONNECT_TIME_T,       timing.connect);
+    get(CURLINFO_APPCONNECT_TIME_T,    timing.appconnect);
+    get(CURLINFO_PRETRANSFER_TIME_T,   timing.pretransfer);
+    get(CURLINFO_STARTTRANSFER_TIME_T, timing.starttransfer);
+    get(CURLINFO_TOTAL_TIME_T,         timing.total);
+    get(CURLINFO_SPEED_DOWNLOAD_T,     timing.speed);
+}
+
+
+bool download::run(
+    online_data_processor * processor,
+    transfer_timing *       timing,
+    skip_reason *           skipped) const
+{
+    transfer xfer;
+    if (!prepare(xfer, processor)) return false;
+
+    xfer.m_blocking = true;
+
+    // Run download
+    const bool ok = finish(xfer, ::curl_easy_perform(xfer.handle()));
+
+    if (nullptr != timing)  download::timing(xfer, *timing);
+    if (nullptr != skipped) *skipped = xfer.m_skipped;
+
+    return ok;
+}
 
 }  // end of namespace fastcrawl
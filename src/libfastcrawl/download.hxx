@@ -42,12 +42,17 @@
  */
 
 #include "online_data_processor.hxx"
+#include "transfer_timing.hxx"
+#include "download_policy.hxx"
 #include "uri.hxx"
 #include "logger.hxx"
 
 #include <string>
 #include <list>
+#include <functional>
+#include <cstdio>
 #include <cstddef>
+#include <cstdint>
 
 
 namespace fastcrawl {
@@ -59,13 +64,101 @@ namespace fastcrawl {
  *  It may execute \ref fastcrawl::online_data_processor injection
  *  on each data chunk received.
  *
+ *  The download may be executed in the current thread (blocking,
+ *  see \ref operator()) or by a \ref download_loop (non-blocking).
+ *
+ *  If the processor is congested (see \ref online_data_processor::congested),
+ *  blocking downloads wait in the write callback till it's ready again
+ *  (the connection is stalled meanwhile); non-blocking ones are paused
+ *  (\c CURL_WRITEFUNC_PAUSE) and resumed from cURL progress callback.
+ *  Note that cURL calls the progress callback about once per second
+ *  while paused, so the waiting is preferred where possible.
+ *
+ *  If the policy sets content admission (see \ref download_policy),
+ *  the response head is checked before any content is received;
+ *  unwanted content is skipped (the transfer is aborted).
+ *  The storage file is only created when the content is admitted.
+ *  The processor is notified of the content type at the end of the response
+ *  head (see \ref online_data_processor::content_type).
+ *
  *  See https://curl.haxx.se/
  */
 class download: public logger {
+    public:
+
+    /**
+     *  \brief  Download transfer
+     *
+     *  cURL easy handle with the transfer resources (output file,
+     *  request headers, write callback data).
+     *  The resources are released upon destruction.
+     */
+    class transfer {
+        friend class download;
+
+        private:
+
+        void *                  m_curl;         /**< cURL easy handle       */
+        std::FILE *             m_file;         /**< Output file handle     */
+        const char *            m_filename;     /**< Output file name       */
+        void *                  m_headers;      /**< Request headers        */
+        online_data_processor * m_processor;    /**< Online data processor  */
+        std::string             m_uri_str;      /**< URI                    */
+        bool                    m_paused;       /**< Paused by backpressure */
+        bool                    m_blocking;     /**< Blocking transfer      */
+
+        // Content admission
+        const download_policy * m_admission;    /**< Policy (if set)        */
+        skip_reason             m_skipped;      /**< Content skipped        */
+        long                    m_status;       /**< Response status        */
+        uint64_t                m_length;       /**< Content-Length         */
+        bool                    m_encoded;      /**< Content-Encoding set   */
+        bool                    m_location;     /**< Redirect location set  */
+        std::string             m_type;         /**< Content-Type           */
+        uint64_t                m_size;         /**< Content received       */
+
+        public:
+
+        transfer():
+            m_curl(nullptr),
+            m_file(nullptr),
+            m_filename(nullptr),
+            m_headers(nullptr),
+            m_processor(nullptr),
+            m_paused(false),
+            m_blocking(false),
+            m_admission(nullptr),
+            m_skipped(NOT_SKIPPED),
+            m_status(0),
+            m_length(UINT64_MAX),
+            m_encoded(false),
+            m_location(false),
+            m_size(0)
+        {}
+
+        transfer(const transfer & ) = delete;
+        transfer & operator = (const transfer & ) = delete;
+
+        /** cURL easy handle */
+        void * handle() const { return m_curl; }
+
+        /** Content skipped by admission (why) */
+        skip_reason skipped() const { return m_skipped; }
+
+        /** Content-Type media type (empty if not set) */
+        const std::string & content_type() const { return m_type; }
+
+        /** Destructor (releases the resources) */
+        ~transfer();
+
+    };  // end of class transfer
+
     private:
 
-    const uri         m_uri;        /**< URI                          */
-    const std::string m_filename;   /**< Name of content storage file */
+    const uri               m_uri;        /**< URI                          */
+    const std::string       m_filename;   /**< Name of content storage file */
+    void *                  m_share;      /**< cURL share handle (optional) */
+    const download_policy * m_policy;     /**< Timeouts (optional)          */
 
     public:
 
@@ -80,15 +173,42 @@ class download: public logger {
         const std::string & filename)
     :
         m_uri(uri_),
-        m_filename(filename)
+        m_filename(filename),
+        m_share(nullptr),
+        m_policy(nullptr)
     {}
 
+    /** Content URI */
+    const uri & get_uri() const { return m_uri; }
+
+    /** Content storage file name */
+    const std::string & filename() const { return m_filename; }
+
+    /**
+     *  \brief  Set cURL share handle
+     *
+     *  Shared DNS cache, connections etc. (see \ref crawl_context).
+     *
+     *  \param  handle  cURL share handle
+     */
+    void share(void * handle) { m_share = handle; }
+
+    /**
+     *  \brief  Set timeouts
+     *
+     *  Connection, transfer and stalled transfer timeouts are applied
+     *  (the rest of the policy is up to \ref download_governor).
+     *
+     *  \param  policy  Download policy (must exist during the download)
+     */
+    void policy(const download_policy * policy) { m_policy = policy; }
+
     /**
      *  \brief  Download execution
      *
      *  \return \c true iff the content was downloaded
      */
-    bool operator () () const { return run(nullptr); }
+    bool operator () () const { return run(nullptr, nullptr); }
 
     /**
      *  \brief  Download execution
@@ -98,23 +218,188 @@ class download: public logger {
      *  \return \c true iff the content was downloaded
      */
     bool operator () (online_data_processor & processor) const {
-        return run(&processor);
+        return run(&processor, nullptr);
+    }
+
+    /**
+     *  \brief  Download execution
+     *
+     *  \param  processor  Online data processor injection
+     *  \param  timing     Transfer timing (output)
+     *
+     *  \return \c true iff the content was downloaded
+     */
+    bool operator () (
+        online_data_processor & processor,
+        transfer_timing &       timing) const
+    {
+        return run(&processor, &timing);
     }
 
+    /**
+     *  \brief  Download execution
+     *
+     *  \param  processor  Online data processor injection
+     *  \param  timing     Transfer timing (output)
+     *  \param  skipped    Content skipped by admission (output)
+     *
+     *  \return \c true iff the content was downloaded
+     */
+    bool operator () (
+        online_data_processor & processor,
+        transfer_timing &       timing,
+        skip_reason &           skipped) const
+    {
+        return run(&processor, &timing, &skipped);
+    }
+
+    /**
+     *  \brief  Prepare transfer
+     *
+     *  Instantiates cURL session and assembles required HTTP request
+     *  fields (the storage file is created with the first content chunk).
+     *
+     *  \param  xfer       Transfer
+     *  \param  processor  Online data processor injection (optional)
+     *
+     *  \return \c true iff the transfer is ready
+     */
+    bool prepare(transfer & xfer, online_data_processor * processor) const;
+
+    /**
+     *  \brief  Finish transfer
+     *
+     *  Logs the transfer result.
+     *  The storage file is created for empty content; partially stored
+     *  skipped content is removed.
+     *
+     *  \param  xfer    Transfer
+     *  \param  result  cURL result code
+     *
+     *  \return \c true iff the content was downloaded
+     */
+    bool finish(transfer & xfer, int result) const;
+
+    /**
+     *  \brief  Cancel transfer
+     *
+     *  For prepared transfers that won't be finished (e.g. a hedged
+     *  request loser).
+     *
+     *  \param  xfer  Transfer
+     */
+    void cancel(const transfer & xfer) const;
+
+    /**
+     *  \brief  Get transfer timing
+     *
+     *  Only meaningful after the transfer has finished.
+     *
+     *  \param  xfer    Transfer
+     *  \param  timing  Transfer timing (output)
+     */
+    static void timing(const transfer & xfer, transfer_timing & timing);
+
+    /**
+     *  \brief  Resume transfer paused by backpressure
+     *
+     *  The transfer is resumed if its processor isn't congested anymore.
+     *  Called from the progress callback; event loops may call it
+     *  as soon as they know the backpressure is gone (the progress
+     *  callback is only called about once per second while paused).
+     *
+     *  \param  xfer  Transfer
+     */
+    static void resume(transfer & xfer);
+
+    /** Finished transfer callback (cURL easy handle, cURL result code) */
+    using finished_callback_t = std::function<void (void *, int)>;
+
+    /**
+     *  \brief  Collect finished transfers of cURL multi handle
+     *
+     *  Drains the multi handle messages; each finished transfer is removed
+     *  from the multi handle and passed to the callback (typically,
+     *  to \ref finish it).
+     *  Note that the cURL message is invalid once the handle is removed,
+     *  so its content is copied first.
+     *
+     *  \param  multi     cURL multi handle
+     *  \param  finished  Finished transfer callback
+     *
+     *  \return Number of finished transfers
+     */
+    static size_t collect(void * multi, const finished_callback_t & finished);
+
     private:
 
+    /**
+     *  \brief  cURL write callback
+     *
+     *  Callback for online data processor injection execution.
+     *
+     *  \param  ptr       Data chunk member array
+     *  \param  size      Data chunk member size
+     *  \param  nmemb     Number of members in the array
+     *  \param  userdata  Callback data (see \ref transfer)
+     *
+     *  \return Size of data appended to the output file
+     */
+    static size_t write(void * ptr, size_t size, size_t nmemb, void * userdata);
+
+    /**
+     *  \brief  cURL header callback
+     *
+     *  Collects response head fields needed for content admission;
+     *  the content is admitted (or not) at the end of the final head
+     *  (i.e. not of an interim or followed redirect response) and
+     *  the processor is notified of the content type.
+     *
+     *  \param  ptr       Header line
+     *  \param  size      Header line member size
+     *  \param  nmemb     Number of members
+     *  \param  userdata  Callback data (see \ref transfer)
+     *
+     *  \return Header line size (0 aborts the transfer)
+     */
+    static size_t header(char * ptr, size_t size, size_t nmemb, void * userdata);
+
+    /**
+     *  \brief  Content admission
+     *
+     *  \param  xfer  Transfer (with the response head fields)
+     *
+     *  \return Skip reason (or \ref NOT_SKIPPED)
+     */
+    static skip_reason admit(const transfer & xfer);
+
+    /**
+     *  \brief  cURL progress callback
+     *
+     *  Resumes transfer paused by processor backpressure.
+     *
+     *  \param  userdata  Callback data (see \ref transfer)
+     *
+     *  \return 0 (continue transfer)
+     */
+    static int progress(void * userdata, int64_t, int64_t, int64_t, int64_t);
+
     /**
      *  \brief  Download execution implementation
      *
-     *  Instantiates cURL session, assembles required HTTP request fields
-     *  and requests the content.
+     *  Prepares the transfer and requests the content.
      *  The download is executed in the current thread (blocking reads).
      *
      *  \param  processor  Online data processor injection
+     *  \param  timing     Transfer timing (output, optional)
+     *  \param  skipped    Content skipped by admission (output, optional)
      *
      *  \return \c true iff the content was downloaded
      */
-    bool run(online_data_processor * processor) const;
+    bool run(
+        online_data_processor * processor,
+        transfer_timing *       timing,
+        skip_reason *           skipped = nullptr) const;
 
 };  // end of class download
 
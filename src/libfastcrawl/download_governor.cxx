@@ -0,0 +1,354 @@
+/**
+ *  \file
+ *  \brief  Download governor (timeouts, retries, hedging, circuit breaking)
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download_governor.hxx"
+#include "download.hxx"
+#include "metrics.hxx"
+
+extern "C" {
+#include <curl/curl.h>
+#include <unistd.h>
+}
+
+#include <memory>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+
+
+namespace fastcrawl {
+
+bool download_governor::admit(const std::string & host) {
+    if (!m_policy.breaker_threshold) return true;
+
+    std::lock_guard<std::mutex> lock(m_circuits_mutex);
+    auto & c = m_circuits[host];
+
+    if (c.failures < m_policy.breaker_threshold) return true;  // closed
+
+    // Open; after cooldown, a single trial is admitted (half-open)
+    if (c.probing || clock_t::now() < c.open_until) return false;
+
+    c.probing = true;
+    return true;
+}
+
+
+void download_governor::report(const std::string & host, bool success) {
+    if (!m_policy.breaker_threshold) return;
+
+    std::lock_guard<std::mutex> lock(m_circuits_mutex);
+    auto & c = m_circuits[host];
+
+    c.probing = false;
+
+    if (success) {
+        c.failures = 0;
+        return;
+    }
+
+    if (++c.failures >= m_policy.breaker_threshold)  // (re)open
+        c.open_until = clock_t::now() +
+            std::chrono::milliseconds(m_policy.breaker_cooldown);
+}
+
+
+void download_governor::latency(uint64_t latency) {
+    std::lock_guard<std::mutex> lock(m_latency_mutex);
+    m_latency.record(latency);
+}
+
+
+uint64_t download_governor::hedge_delay() const {
+    if (!(m_policy.hedge_percentile > 0)) return 0;
+
+    std::lock_guard<std::mutex> lock(m_latency_mutex);
+    if (m_latency.count() < m_policy.hedge_samples) return 0;
+
+    return std::max<uint64_t>(m_policy.hedge_min * 1000,
+        m_latency.percentile(m_policy.hedge_percentile));
+}
+
+
+std::chrono::milliseconds download_governor::backoff(unsigned attempt) const {
+    thread_local std::mt19937 rng(std::random_device{}());
+
+    uint64_t cap = m_policy.backoff;
+    for (unsigned i = 0; i < attempt && cap < m_policy.backoff_max; ++i) cap *= 2;
+    cap = std::min<uint64_t>(cap, m_policy.backoff_max);
+
+    std::uniform_int_distribution<uint64_t> jitter(0, cap / 2);
+    return std::chrono::milliseconds(cap - cap / 2 + jitter(rng));
+}
+
+
+bool download_governor::fetch(
+    const uri &              uri_,
+    uri_record &             record,
+    const pipeline_builder & pipeline,
+    void *                   share,
+    bool                     verbose)
+{
+    auto & stats = metrics::global();
+
+    for (unsigned attempt_cnt = 0; ; ++attempt_cnt) {
+        // Host is down, fail fast
+        if (!admit(uri_.host)) {
+            stats.short_circuited.add();
+            return false;
+        }
+
+        const uint64_t delay = hedge_delay();
+        const bool     ok    = delay
+            ? attempt_hedged(uri_, record, pipeline, share, verbose, delay)
+            : attempt(uri_, record, pipeline, share, verbose);
+
+        // Skipped content is the host's proper answer, not a failure
+        report(uri_.host, ok || record.skipped);
+
+        if (ok) {
+            latency(record.timing.total);
+            return true;
+        }
+
+        if (record.skipped) return false;  // retry would be skipped, too
+
+        if (attempt_cnt >= m_policy.retries) return false;
+
+        stats.retries.add();
+        std::this_thread::sleep_for(backoff(attempt_cnt));
+    }
+}
+
+
+bool download_governor::attempt(
+    const uri &              uri_,
+    uri_record &             record,
+    const pipeline_builder & pipeline,
+    void *                   share,
+    bool                     verbose)
+{
+    record.timing  = transfer_timing();  // no leftovers of failed attempt
+    record.skipped = NOT_SKIPPED;
+
+    // The data processors assign results when destroyed
+    processor_pipeline dproc;
+    pipeline.build(dproc, record);
+
+    download dl(uri_, record.filename);
+    dl.verbose_log(verbose);
+    dl.share(share);
+    dl.policy(&m_policy);
+
+    return dl(dproc, record.timing, record.skipped);
+}
+
+
+/** Hedged download request */
+struct hedged_request {
+    download           dl;          /**< Download           */
+    download::transfer xfer;        /**< Transfer           */
+    bool               running;     /**< Transfer running   */
+
+    hedged_request(const uri & uri_, const std::string & filename):
+        dl(uri_, filename),
+        running(false)
+    {}
+
+};  // end of struct hedged_request
+
+
+/** Per-thread cURL multi handle (for hedged downloads) */
+struct hedge_multi {
+    CURLM * const multi;  /**< cURL multi handle (or \c nullptr) */
+
+    hedge_multi(): multi(::curl_multi_init()) {}
+
+    ~hedge_multi() { if (multi) ::curl_multi_cleanup(multi); }
+
+};  // end of struct hedge_multi
+
+
+/**
+ *  \brief  Pass stored content to data processors
+ *
+ *  Backpressure is applied just like during a blocking download.
+ *
+ *  \param  filename  Content file name
+ *  \param  proc      Data processors
+ */
+static void replay(const char * filename, online_data_processor & proc) {
+    std::FILE * file = std::fopen(filename, "rb");
+    if (nullptr == file) return;
+
+    const std::chrono::milliseconds timeout(100);
+
+    unsigned char buffer[16384];
+    size_t len;
+    while (0 < (len = std::fread(buffer, 1, sizeof(buffer), file))) {
+        if (proc.congested())
+            while (!proc.wait_ready(timeout)) {}
+
+        proc(buffer, len);
+    }
+
+    std::fclose(file);
+}
+
+
+bool download_governor::attempt_hedged(
+    const uri &              uri_,
+    uri_record &             record,
+    const pipeline_builder & pipeline,
+    void *                   share,
+    bool                     verbose,
+    uint64_t                 hedge_delay)
+{
+    static thread_local hedge_multi t_multi;
+
+    auto * multi = t_multi.multi;
+    if (nullptr == multi) return attempt(uri_, record, pipeline, share, verbose);
+
+    const std::string hedge_filename = std::string(record.filename) + '~';
+
+    std::unique_ptr<hedged_request> requests[2];
+    size_t running = 0;
+
+    // The requests only store the content; the data processors
+    // (possibly with side effects) only process the winner's content
+    auto start = [&](size_t i, const std::string & filename) {
+        auto * req = new hedged_request(uri_, filename);
+        requests[i].reset(req);
+
+        req->dl.verbose_log(verbose);
+        req->dl.share(share);
+        req->dl.policy(&m_policy);
+
+        if (!req->dl.prepare(req->xfer, nullptr)) return;
+
+        ::curl_multi_add_handle(multi, req->xfer.handle());
+        req->running = true;
+        ++running;
+    };
+
+    start(0, record.filename);
+
+    const auto hedge_time = clock_t::now() + std::chrono::microseconds(hedge_delay);
+    int winner = -1;
+    skip_reason skipped = NOT_SKIPPED;
+
+    while (running && winner < 0 && !skipped) {
+        int still_running;
+        ::curl_multi_perform(multi, &still_running);
+
+        // Finished transfers
+        running -= download::collect(multi, [&](void * curl, int result) {
+            const size_t i = requests[0]->xfer.handle() == curl ? 0 : 1;
+            auto & req = *requests[i];
+
+            req.running = false;
+
+            if (req.dl.finish(req.xfer, result) && winner < 0)
+                winner = i;
+            else if (req.xfer.skipped())
+                skipped = req.xfer.skipped();  // the other one is skipped, too
+        });
+
+        if (winner >= 0 || skipped || !running) break;
+
+        // Straggler, issue duplicate request
+        const auto now = clock_t::now();
+        if (!requests[1] && now >= hedge_time) {
+            start(1, hedge_filename);
+            if (requests[1]->running) metrics::global().hedged.add();
+        }
+
+        int timeout_ms = 100;
+        if (!requests[1])
+            timeout_ms = std::min<int>(timeout_ms, 1 +
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    hedge_time - now).count());
+
+        ::curl_multi_poll(multi, nullptr, 0, timeout_ms, nullptr);
+    }
+
+    // Cancel the loser (the multi handle is left empty for reuse)
+    for (auto & req: requests) {
+        if (!req || !req->running) continue;
+
+        ::curl_multi_remove_handle(multi, req->xfer.handle());
+        req->dl.cancel(req->xfer);
+    }
+
+    record.timing  = transfer_timing();
+    record.skipped = skipped;
+
+    std::string type;
+    if (winner >= 0) {
+        download::timing(requests[winner]->xfer, record.timing);
+        type = requests[winner]->xfer.content_type();
+    }
+
+    // Close the files
+    const bool hedged = !!requests[1];
+    requests[0].reset();
+    requests[1].reset();
+
+    if (hedged) {
+        if (1 == winner)
+            std::rename(hedge_filename.c_str(), record.filename);
+        else
+            ::unlink(hedge_filename.c_str());
+    }
+
+    // The data processors process the winner's content
+    // (and assign results when destroyed)
+    if (winner >= 0) {
+        processor_pipeline dproc;
+        pipeline.build(dproc, record);
+        dproc.content_type(type);
+        replay(record.filename, dproc);
+    }
+
+    return winner >= 0;
+}
+
+}  // end of namespace fastcrawl
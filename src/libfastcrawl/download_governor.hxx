@@ -0,0 +1,237 @@
+#ifndef fastcrawl__download_governor_hxx
+#define fastcrawl__download_governor_hxx
+
+/**
+ *  \file
+ *  \brief  Download governor (timeouts, retries, hedging, circuit breaking)
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download_policy.hxx"
+#include "latency_histogram.hxx"
+#include "processor_pipeline.hxx"
+#include "uri_record.hxx"
+#include "uri.hxx"
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Download governor
+ *
+ *  Executes downloads according to \ref download_policy, so that crawl
+ *  time is governed by typical latency rather than by the stragglers:
+ *
+ *  * timeouts (connection, transfer, stalled transfer),
+ *  * retries of failed downloads with jittered exponential backoff,
+ *  * hedging: once a download takes longer than the policy percentile
+ *    of the observed download latencies, a duplicate request is issued;
+ *    the first to finish wins, the other one is cancelled,
+ *  * per-host circuit breaker: after a number of failures in row,
+ *    downloads from the host fail fast for the cooldown time; then
+ *    a single trial download decides whether the circuit closes again.
+ *
+ *  The governor is thread-safe (the latency observations and host
+ *  circuits are shared by all the downloads).
+ */
+class download_governor {
+    public:
+
+    using clock_t = std::chrono::steady_clock;  /**< Governor clock */
+
+    private:
+
+    /** Host circuit */
+    struct circuit {
+        unsigned            failures;   /**< Failures in row            */
+        bool                probing;    /**< Trial download in progress */
+        clock_t::time_point open_until; /**< Open circuit cooldown end  */
+
+        circuit(): failures(0), probing(false) {}
+
+    };  // end of struct circuit
+
+    download_policy                          m_policy;          /**< Policy          */
+    latency_histogram                        m_latency;         /**< Latencies [us]  */
+    mutable std::mutex                       m_latency_mutex;   /**< Latencies mutex */
+    std::unordered_map<std::string, circuit> m_circuits;        /**< Host circuits   */
+    std::mutex                               m_circuits_mutex;  /**< Circuits mutex  */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  policy  Download policy
+     */
+    download_governor(const download_policy & policy = download_policy()):
+        m_policy(policy)
+    {}
+
+    download_governor(const download_governor & ) = delete;
+    download_governor & operator = (const download_governor & ) = delete;
+
+    /** Download policy getter */
+    const download_policy & policy() const { return m_policy; }
+
+    /**
+     *  \brief  Download policy setter
+     *
+     *  Must be set before the downloads start.
+     *
+     *  \param  policy  Download policy
+     */
+    void policy(const download_policy & policy) { m_policy = policy; }
+
+    /**
+     *  \brief  Circuit breaker admission
+     *
+     *  The caller must \ref report the result of admitted download.
+     *
+     *  \param  host  Host
+     *
+     *  \return \c true iff download from the host may be attempted
+     */
+    bool admit(const std::string & host);
+
+    /**
+     *  \brief  Report download result (to the host circuit breaker)
+     *
+     *  \param  host     Host
+     *  \param  success  Download status
+     */
+    void report(const std::string & host, bool success);
+
+    /**
+     *  \brief  Record observed download latency
+     *
+     *  \param  latency  Total download time [us]
+     */
+    void latency(uint64_t latency);
+
+    /**
+     *  \brief  Current hedge delay
+     *
+     *  \return Hedge delay [us] (0 means no hedging, e.g. too few
+     *          latency observations so far)
+     */
+    uint64_t hedge_delay() const;
+
+    /**
+     *  \brief  Retry backoff
+     *
+     *  Exponential, capped, with "equal jitter" (i.e. random in the upper
+     *  half), so that retries of failures at the same time don't come
+     *  in bursts.
+     *
+     *  \param  attempt  Failed attempt number (from 0)
+     *
+     *  \return Backoff
+     */
+    std::chrono::milliseconds backoff(unsigned attempt) const;
+
+    /**
+     *  \brief  Download content
+     *
+     *  Executes the download (and its retries, hedged requests) according
+     *  to the policy.
+     *  The content is stored to \c record.filename; the \c pipeline
+     *  results and transfer timing (of the successful attempt) are stored
+     *  in the \c record.
+     *
+     *  \param  uri_      Content URI
+     *  \param  record    Download record
+     *  \param  pipeline  Download data processors
+     *  \param  share     cURL share handle (optional)
+     *  \param  verbose   Verbose logging
+     *
+     *  \return \c true iff the content was downloaded
+     */
+    bool fetch(
+        const uri &              uri_,
+        uri_record &             record,
+        const pipeline_builder & pipeline,
+        void *                   share   = nullptr,
+        bool                     verbose = false);
+
+    private:
+
+    /** Single download attempt (see \ref fetch) */
+    bool attempt(
+        const uri &              uri_,
+        uri_record &             record,
+        const pipeline_builder & pipeline,
+        void *                   share,
+        bool                     verbose);
+
+    /**
+     *  \brief  Single hedged download attempt
+     *
+     *  The duplicate request content is stored to \c record.filename
+     *  with \c '~' suffix (and renamed if it wins).
+     *  The requests only store the content; the data processors process
+     *  the winner's stored content once it's decided, so processors with
+     *  side effects (e.g. \ref shm_sink streams, stylesheet segmentation)
+     *  see the content exactly once.
+     *  The transfers are driven by a per-thread cURL multi handle.
+     *
+     *  \param  uri_         Content URI
+     *  \param  record       Download record
+     *  \param  pipeline     Download data processors
+     *  \param  share        cURL share handle (optional)
+     *  \param  verbose      Verbose logging
+     *  \param  hedge_delay  Hedge delay [us]
+     */
+    bool attempt_hedged(
+        const uri &              uri_,
+        uri_record &             record,
+        const pipeline_builder & pipeline,
+        void *                   share,
+        bool                     verbose,
+        uint64_t                 hedge_delay);
+
+};  // end of class download_governor
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__download_governor_hxx
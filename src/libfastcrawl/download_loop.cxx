@@ -0,0 +1,191 @@
+/**
+ *  \file
+ *  \brief  Non-blocking download event loop
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download_loop.hxx"
+
+extern "C" {
+#include <curl/curl.h>
+}
+
+#include <utility>
+#include <stdexcept>
+
+
+namespace fastcrawl {
+
+download_loop::download_loop():
+    m_multi(::curl_multi_init()),
+    m_running(0),
+    m_stop(false)
+{
+    if (nullptr == m_multi)
+        throw std::runtime_error("download_loop: failed to create cURL multi handle");
+}
+
+
+void download_loop::submit(
+    const download &        dl,
+    online_data_processor * processor,
+    completion_t            done)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(new request(dl, processor, done));
+    }
+
+    wakeup();
+}
+
+
+void download_loop::post(job j) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(j));
+    }
+
+    wakeup();
+}
+
+
+void download_loop::wakeup() {
+    ::curl_multi_wakeup(m_multi);
+}
+
+
+bool download_loop::dispatch() {
+    std::vector<request *> requests;
+    std::vector<job>       jobs;
+    bool                   stop;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        requests.swap(m_requests);
+        jobs.swap(m_jobs);
+        stop = m_stop;
+    }
+
+    for (auto & j: jobs) j();
+
+    for (auto * req: requests) {
+        if (!req->dl.prepare(req->xfer, req->processor)) {
+            req->done(false);
+            delete req;
+            continue;
+        }
+
+        ::curl_easy_setopt(req->xfer.handle(), CURLOPT_PRIVATE, req);
+        ::curl_multi_add_handle(m_multi, req->xfer.handle());
+        ++m_running;
+    }
+
+    // Nothing to do & stop requested (jobs may have submitted more)
+    if (!stop || m_running || !jobs.empty() || !requests.empty())
+        return true;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_requests.empty() || !m_jobs.empty();
+}
+
+
+void download_loop::complete() {
+    m_running -= download::collect(m_multi, [](void * curl, int result) {
+        request * req = nullptr;
+        ::curl_easy_getinfo((CURL *)curl, CURLINFO_PRIVATE, &req);
+
+        const bool success = req->dl.finish(req->xfer, result);
+
+        // Release transfer resources (closes the file) before completion
+        completion_t done = std::move(req->done);
+        delete req;
+
+        done(success);
+    });
+}
+
+
+void download_loop::run() {
+    while (dispatch()) {
+        int running;
+        ::curl_multi_perform(m_multi, &running);
+
+        complete();
+
+        // Wait for transfers progress or submissions
+        // (unless stopped with nothing running; dispatch decides then)
+        if (!m_running) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) continue;
+        }
+
+        ::curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
+    }
+}
+
+
+void download_loop::start() {
+    m_thread = std::thread(&download_loop::run, this);
+}
+
+
+void download_loop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    wakeup();
+
+    // Note that stop may be called from the loop thread (by a callback)
+    if (m_thread.joinable() && std::this_thread::get_id() != m_thread.get_id())
+        m_thread.join();
+}
+
+
+download_loop::~download_loop() {
+    stop();
+
+    // Unfinished requests (if the loop never ran)
+    for (auto * req: m_requests) delete req;
+
+    ::curl_multi_cleanup(m_multi);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,177 @@
+#ifndef fastcrawl__download_loop_hxx
+#define fastcrawl__download_loop_hxx
+
+/**
+ *  \file
+ *  \brief  Non-blocking download event loop
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download.hxx"
+#include "online_data_processor.hxx"
+#include "job.hxx"
+#include "logger.hxx"
+
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Non-blocking download event loop
+ *
+ *  Executes any number of downloads concurrently in a single thread
+ *  (using cURL multi interface).
+ *  Downloads are submitted from any thread; their completion callbacks
+ *  are called from the loop thread (and so are the data processors).
+ *  Callbacks shouldn't block; they may submit further downloads
+ *  or post jobs to the loop (see \ref post).
+ *
+ *  The loop runs either in its own thread (see \ref start) or in the
+ *  caller's thread (see \ref run).
+ */
+class download_loop: public logger {
+    public:
+
+    /** Download completion callback (gets the download status) */
+    using completion_t = std::function<void (bool success)>;
+
+    private:
+
+    /** Submitted download */
+    struct request {
+        download                dl;         /**< Download               */
+        online_data_processor * processor;  /**< Online data processor  */
+        completion_t            done;       /**< Completion callback    */
+        download::transfer      xfer;       /**< Transfer               */
+
+        request(
+            const download &        dl_,
+            online_data_processor * processor_,
+            completion_t            done_)
+        :
+            dl(dl_),
+            processor(processor_),
+            done(done_)
+        {}
+
+    };  // end of struct request
+
+    void *                  m_multi;        /**< cURL multi handle          */
+    size_t                  m_running;      /**< Running transfers (loop)   */
+    bool                    m_stop;         /**< Stop flag                  */
+    std::vector<request *>  m_requests;     /**< Submitted requests         */
+    std::vector<job>        m_jobs;         /**< Posted jobs                */
+    std::mutex              m_mutex;        /**< Submission mutex           */
+    std::thread             m_thread;       /**< Loop thread                */
+
+    public:
+
+    /** Constructor */
+    download_loop();
+
+    download_loop(const download_loop & ) = delete;
+    download_loop & operator = (const download_loop & ) = delete;
+
+    /**
+     *  \brief  Submit download
+     *
+     *  The download starts at the next loop iteration.
+     *
+     *  \param  dl         Download
+     *  \param  processor  Online data processor injection (optional;
+     *                     must exist until the download completes)
+     *  \param  done       Completion callback
+     */
+    void submit(
+        const download &        dl,
+        online_data_processor * processor,
+        completion_t            done);
+
+    /**
+     *  \brief  Post job to the loop
+     *
+     *  The job is executed in the loop thread at the next iteration.
+     *
+     *  \param  j  Job
+     */
+    void post(job j);
+
+    /**
+     *  \brief  Run the loop in current thread
+     *
+     *  Returns when \ref stop was called and there are no more downloads
+     *  running or pending.
+     */
+    void run();
+
+    /** Run the loop in a new thread */
+    void start();
+
+    /**
+     *  \brief  Stop the loop
+     *
+     *  The loop finishes the running and pending downloads (including
+     *  downloads submitted by their completion callbacks) and returns.
+     *  If the loop runs in its own thread (see \ref start), the function
+     *  joins it.
+     */
+    void stop();
+
+    /** Destructor (stops the loop, see \ref stop) */
+    ~download_loop();
+
+    private:
+
+    /** Wake the loop up (from another thread) */
+    void wakeup();
+
+    /** Start submitted downloads, execute posted jobs */
+    bool dispatch();
+
+    /** Process finished downloads */
+    void complete();
+
+};  // end of class download_loop
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__download_loop_hxx
@@ -0,0 +1,205 @@
+#ifndef fastcrawl__download_policy_hxx
+#define fastcrawl__download_policy_hxx
+
+/**
+ *  \file
+ *  \brief  Download tail-latency control policy
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/** Reason of content skipped by download admission (see \ref download_policy) */
+enum skip_reason {
+    NOT_SKIPPED = 0,    /**< Content wasn't skipped                */
+    SKIP_STATUS,        /**< Error response status (4xx or 5xx)    */
+    SKIP_TYPE,          /**< Content type not accepted             */
+    SKIP_LENGTH,        /**< Content length over the size limit    */
+    SKIP_SIZE,          /**< Content cut off at the size limit     */
+};  // end of enum skip_reason
+
+
+/** Skip reason name */
+inline const char * skip_reason_str(skip_reason reason) {
+    switch (reason) {
+        case NOT_SKIPPED: return "not skipped";
+        case SKIP_STATUS: return "error status";
+        case SKIP_TYPE:   return "content type";
+        case SKIP_LENGTH: return "content length";
+        case SKIP_SIZE:   return "size limit";
+    }
+
+    return "unknown";
+}
+
+
+/**
+ *  \brief  Download tail-latency control policy
+ *
+ *  Timeouts, retries, hedging and host circuit breaking
+ *  (see \ref download_governor), transfer compression and content
+ *  admission.
+ *  The defaults keep it all off (no timeouts, no retries...).
+ *
+ *  Content admission is decided as soon as the response head is received,
+ *  i.e. before any content is transferred or stored: responses with error
+ *  status, unaccepted content type or content length over the size limit
+ *  are aborted.
+ *  The size limit applies to the content as stored, i.e. the decoded
+ *  size when the transfer is decoded (see \ref compression): that's what
+ *  takes the disk space.
+ *  Content-Length of an encoded transfer is the encoded size, so decoded
+ *  content is (like content without known length) cut off as soon as it
+ *  exceeds the limit.
+ *  Skipped content isn't stored (nor retried); the reason is recorded
+ *  (see \ref uri_record::skipped).
+ */
+struct download_policy {
+    /**
+     *  \brief  Transfer compression
+     *
+     *  Compressed transfers are negotiated with all the encodings cURL
+     *  supports (gzip, deflate and possibly brotli and zstd).
+     *  The content is decoded online (chunk by chunk), so the processors
+     *  and the stored file see the decoded content, unless the encoded
+     *  form is required.
+     *  HTML pages are always decoded (see \ref page).
+     */
+    enum compression_t {
+        IDENTITY = 0,   /**< No compression (identity encoding only)  */
+        DECODE,         /**< Compressed transfer, decoded content      */
+        ENCODED,        /**< Compressed transfer, content kept encoded */
+    };
+
+    unsigned connect_timeout;   /**< Connection timeout [ms] (0 means none)  */
+    unsigned timeout;           /**< Transfer timeout [ms] (0 means none)    */
+    unsigned low_speed_limit;   /**< Stalled transfer speed [B/s]            */
+    unsigned low_speed_time;    /**< Stalled transfer timeout [s] (0: none)  */
+    unsigned retries;           /**< Max. retries of failed download         */
+    unsigned backoff;           /**< Retry backoff base [ms]                 */
+    unsigned backoff_max;       /**< Retry backoff cap [ms]                  */
+    double   hedge_percentile;  /**< Hedge after latency percentile (0: no)  */
+    unsigned hedge_min;         /**< Min. hedge delay [ms]                   */
+    size_t   hedge_samples;     /**< Min. latency samples for hedging        */
+    unsigned breaker_threshold; /**< Failures in row opening host circuit    */
+    unsigned breaker_cooldown;  /**< Open host circuit cooldown [ms]         */
+    compression_t compression;  /**< Transfer compression                    */
+    bool     skip_errors;       /**< Skip error responses content            */
+    std::string accept_types;   /**< Accepted content types (comma-separated
+                                     prefixes, e.g. "text/,image/"; empty
+                                     means any)                              */
+    uint64_t max_size;          /**< Max. stored content size [B]
+                                     (0 means any)                           */
+
+    download_policy():
+        connect_timeout(0),
+        timeout(0),
+        low_speed_limit(1),
+        low_speed_time(0),
+        retries(0),
+        backoff(100),
+        backoff_max(5000),
+        hedge_percentile(0),
+        hedge_min(10),
+        hedge_samples(20),
+        breaker_threshold(0),
+        breaker_cooldown(5000),
+        compression(IDENTITY),
+        skip_errors(false),
+        max_size(0)
+    {}
+
+    /** Content admission is set */
+    bool admission() const {
+        return skip_errors || !accept_types.empty() || max_size;
+    }
+
+    /**
+     *  \brief  Content type is accepted
+     *
+     *  \param  type  Content type (unknown if empty)
+     *
+     *  \return \c true iff the type is accepted (unknown type is)
+     */
+    bool accepted(const std::string & type) const {
+        if (accept_types.empty() || type.empty()) return true;
+
+        // Case-insensitive prefix match
+        for (size_t begin = 0; begin < accept_types.size(); ) {
+            size_t end = accept_types.find(',', begin);
+            if (std::string::npos == end) end = accept_types.size();
+
+            while (begin < end && ' ' == accept_types[begin]) ++begin;
+
+            size_t i = 0;
+            while (begin + i < end && i < type.size() &&
+                (accept_types[begin + i] | 0x20) == (type[i] | 0x20)) ++i;
+
+            if (begin + i == end && end > begin) return true;
+
+            begin = end + 1;
+        }
+
+        return false;
+    }
+
+    /**
+     *  \brief  Policy of HTML page download
+     *
+     *  The page is always admitted (but error responses, if set) and decoded
+     *  (it must be parsed).
+     */
+    download_policy page() const {
+        download_policy policy(*this);
+        if (ENCODED == policy.compression) policy.compression = DECODE;
+
+        policy.accept_types.clear();
+        policy.max_size = 0;
+
+        return policy;
+    }
+
+};  // end of struct download_policy
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__download_policy_hxx
@@ -42,8 +42,32 @@
  */
 
 #include "config.hxx"
+#include "completion_queue.hxx"
 #include "download.hxx"
+#include "download_loop.hxx"
+#include "download_governor.hxx"
+#include "async.hxx"
+#include "html_segmenter.hxx"
+#include "css_segmenter.hxx"
 #include "html_crawler.hxx"
+#include "crawl_context.hxx"
+#include "preconnector.hxx"
+#include "batch_crawler.hxx"
+#include "shard_runtime.hxx"
+#include "mpsc_queue.hxx"
+#include "parallel_segmenter.hxx"
+#include "mapped_file.hxx"
+#include "metrics.hxx"
+#include "metrics_reporter.hxx"
+#include "metrics_server.hxx"
+#include "processor_pipeline.hxx"
+#include "simhash.hxx"
+#include "fingerprint_index.hxx"
+#include "shm_ring.hxx"
+#include "shm_sink.hxx"
+#include "timing_report.hxx"
+#include "trace.hxx"
+#include "work_stealing_pool.hxx"
 #include "uri.hxx"
 
 
@@ -0,0 +1,99 @@
+/**
+ *  \file
+ *  \brief  Near-duplicate fingerprint index
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fingerprint_index.hxx"
+#include "simhash.hxx"
+
+#include <algorithm>
+
+
+namespace fastcrawl {
+
+fingerprint_index::fingerprint_index(unsigned max_distance):
+    m_max_distance(std::min(max_distance, simhash::bits - 1)),
+    m_size(0)
+{
+    // Blocks of (about) the same width
+    const unsigned blocks = m_max_distance + 1;
+    unsigned begin = 0;
+
+    for (unsigned i = 0; i < blocks; ++i) {
+        const unsigned end = (i + 1) * simhash::bits / blocks;
+
+        m_masks.push_back((end - begin < 64
+            ? ((uint64_t)1 << (end - begin)) - 1 : ~(uint64_t)0) << begin);
+
+        begin = end;
+    }
+
+    m_tables.resize(blocks);
+}
+
+
+bool fingerprint_index::find_impl(uint64_t fp, uint64_t * match) const {
+    for (size_t i = 0; i < m_tables.size(); ++i) {
+        const auto range = m_tables[i].equal_range(fp & m_masks[i]);
+
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (simhash::distance(fp, iter->second) > m_max_distance) continue;
+
+            if (match) *match = iter->second;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool fingerprint_index::insert(uint64_t fp, uint64_t * match) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (find_impl(fp, match)) return false;
+
+    for (size_t i = 0; i < m_tables.size(); ++i)
+        m_tables[i].emplace(fp & m_masks[i], fp);
+
+    ++m_size;
+
+    return true;
+}
+
+}  // end of namespace fastcrawl
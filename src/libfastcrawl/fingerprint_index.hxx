@@ -0,0 +1,135 @@
+#ifndef fastcrawl__fingerprint_index_hxx
+#define fastcrawl__fingerprint_index_hxx
+
+/**
+ *  \file
+ *  \brief  Near-duplicate fingerprint index
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Near-duplicate fingerprint index
+ *
+ *  Set of 64-bit fingerprints (see \ref simhash) answering whether
+ *  a fingerprint within Hamming distance \c k of a given one is present.
+ *
+ *  The fingerprint bits are split to \c k+1 blocks; fingerprints
+ *  differing in at most \c k bits match exactly in at least one block
+ *  (pigeonhole principle).
+ *  So, each block has its own hash table (keyed by the block bits)
+ *  and only the fingerprints sharing a block with the queried one
+ *  are checked.
+ *
+ *  The index is thread-safe.
+ */
+class fingerprint_index {
+    private:
+
+    /** Block table (block bits -> fingerprints) */
+    using table_t = std::unordered_multimap<uint64_t, uint64_t>;
+
+    const unsigned          m_max_distance; /**< Max. near-duplicate distance */
+    std::vector<uint64_t>   m_masks;        /**< Block masks                  */
+    std::vector<table_t>    m_tables;       /**< Block tables                 */
+    size_t                  m_size;         /**< Number of fingerprints       */
+    mutable std::mutex      m_mutex;        /**< Index mutex                  */
+
+    /** Find near-duplicate (the index must be locked) */
+    bool find_impl(uint64_t fp, uint64_t * match) const;
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  max_distance  Max. Hamming distance of near-duplicates
+     *                        (0 means exact duplicates, max. 63)
+     */
+    fingerprint_index(unsigned max_distance = 3);
+
+    fingerprint_index(const fingerprint_index & ) = delete;
+    fingerprint_index & operator = (const fingerprint_index & ) = delete;
+
+    /** Max. Hamming distance of near-duplicates */
+    unsigned max_distance() const { return m_max_distance; }
+
+    /**
+     *  \brief  Find near-duplicate
+     *
+     *  \param  fp     Fingerprint
+     *  \param  match  Near-duplicate fingerprint (output, optional)
+     *
+     *  \return \c true iff a near-duplicate fingerprint is indexed
+     */
+    bool find(uint64_t fp, uint64_t * match = nullptr) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return find_impl(fp, match);
+    }
+
+    /**
+     *  \brief  Insert fingerprint (unless it has a near-duplicate)
+     *
+     *  The check and the insertion are atomic, so only one of concurrently
+     *  inserted near-duplicates gets indexed.
+     *
+     *  \param  fp     Fingerprint
+     *  \param  match  Near-duplicate fingerprint (output, optional)
+     *
+     *  \return \c true iff the fingerprint was inserted
+     */
+    bool insert(uint64_t fp, uint64_t * match = nullptr);
+
+    /** Number of indexed fingerprints */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_size;
+    }
+
+};  // end of class fingerprint_index
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__fingerprint_index_hxx
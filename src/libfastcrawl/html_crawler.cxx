@@ -39,68 +39,165 @@
  */
 
 #include "html_crawler.hxx"
-#include "adler32.hxx"
-#include "content_size.hxx"
+#include "processor_pipeline.hxx"
 #include "download.hxx"
-#include "utility.hxx"
+#include "metrics.hxx"
+#include "trace.hxx"
 #include "uri.hxx"
 
 #include <iostream>
 #include <iomanip>
 #include <functional>
-#include <sstream>
-#include <cctype>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+
+#include <strings.h>
 
 
 namespace fastcrawl {
 
-html_crawler::attribute_map::attribute_map() {
-    emplace("a",      "href");
-    emplace("img",    "src");
-    emplace("script", "src");
-    emplace("iframe", "src");
-}
+void html_crawler::stylesheet_processor::operator () (
+    unsigned char * data,
+    size_t          size)
+{
+    if (!m_css) return;
 
-const html_crawler::attribute_map html_crawler::s_attribute_map;
+    metrics::global().bytes_parsed.add(size);
 
+    m_segmenter(data, size);
+}
 
-/** Token character check */
-inline static bool token_char(unsigned char ch) {
-    if ('a' <= ch && ch <= 'z') return true;
-    if ('A' <= ch && ch <= 'Z') return true;
-    if ('0' <= ch && ch <= '9') return true;
-    if ('-' == ch || ':' == ch) return true;
 
-    return false;
+void html_crawler::stylesheet_processor::content_type(const std::string & type) {
+    m_css = 0 == ::strcasecmp(type.c_str(), "text/css");
 }
 
 
 void html_crawler::download(
-    const std::string &        uri_str,
-    size_t                     line,
-    size_t                     column,
-    html_crawler::uri_record & record)
+    const string_ref &  uri_ref,
+    size_t              line,
+    size_t              column,
+    uri_record &        record,
+    uint64_t            trace_id)
 {
-    std::stringstream filename_ss; filename_ss
-        << "./"
-        << std::setw(8) << std::setfill('0') << line << '_'
-        << std::setw(8) << std::setfill('0') << column;
+    const bool tracing = 0 != trace_id;
+    if (tracing) trace::record(trace::ASYNC_END, "queued", trace_id);
+
+    std::snprintf(record.filename, uri_record::filename_size,
+        "%s/%08zu_%08zu", m_directory.c_str(), line, column);
+
+    if (m_dry_run) {  // discovery only
+        if (m_on_completion) m_on_completion(uri_ref.str(), record);
+        return;
+    }
+
+    const std::string uri_str = uri_ref.str();
+    const auto        uri     = resolve(uri_str);
+
+    const int64_t start_ts = tracing ? trace::now() : 0;
+    if (tracing) trace::record(trace::BEGIN, "download", trace_id, start_ts);
 
-    record.filename = filename_ss.str();
+    // Stylesheet is segmented during download
+    const pipeline_builder * pipeline = &m_pipeline;
+    pipeline_builder         css_pipeline;
+    if (m_stylesheets) {
+        css_pipeline = m_pipeline;
+        css_pipeline.add([this, uri](processor_pipeline & dproc, uri_record & ) {
+            dproc.emplace<stylesheet_processor>(*this, uri);
+        });
 
+        pipeline = &css_pipeline;
+    }
+
+    // Download (with timeouts, retries etc. as per the policy)
+    record.success = m_governor.fetch(uri, record, *pipeline,
+        m_context ? m_context->share() : nullptr, verbose_log());
+
+    if (tracing) {
+        if (record.timing.starttransfer)
+            trace::instant("first byte", trace_id,
+                start_ts + (int64_t)record.timing.starttransfer * 1000);
+
+        trace::record(trace::END, "download", trace_id);
+    }
+
+    if (m_on_completion) m_on_completion(uri_str, record);
+}
+
+
+uri html_crawler::resolve(const std::string & uri_str) const {
     auto uri = uri::parse(uri_str);
-    if (uri.host.empty()) uri.host = m_host;  // fix relative URIs
+    if (uri.host.empty()) {  // fix relative URIs
+        uri.scheme = m_base.scheme;
+        uri.host   = m_base.host;
+        uri.port   = m_base.port;
+    }
+
+    return uri;
+}
+
+
+void html_crawler::stylesheet_reference(
+    const char *        rule,
+    const std::string & value,
+    const uri &         stylesheet)
+{
+    if (value.empty() || '#' == value[0]) return;   // no or local reference
+    if (0 == value.compare(0, 5, "data:")) return;  // inlined content
+
+    // Absolute URI
+    if (std::string::npos != value.find("://")) {
+        process_uri(rule, std::string(), value, 0, 0);
+        return;
+    }
+
+    // Network-path reference
+    if (0 == value.compare(0, 2, "//")) {
+        process_uri(rule, std::string(), stylesheet.scheme + ':' + value, 0, 0);
+        return;
+    }
+
+    // Relative to the stylesheet (host and path)
+    auto ref = stylesheet;
+    ref.query.clear();
+    ref.fragment.clear();
+
+    // Merge paths (the query and fragment are kept with the path)
+    const size_t path_end = std::min(value.find('?'), value.find('#'));
+    std::string  path     = value.substr(0, path_end);
+
+    if (path.empty())  // same path, other query
+        path = stylesheet.path;
+    else if ('/' != path[0]) {
+        const size_t dir = stylesheet.path.rfind('/');
+        path = std::string::npos == dir
+            ? '/' + path
+            : stylesheet.path.substr(0, dir + 1) + path;
+    }
+
+    ref.path = uri::remove_dot_segments(path);
+    if (std::string::npos != path_end)
+        ref.path.append(value, path_end, std::string::npos);
 
-    // Data processors
-    auto dproc = data_processor(
-        adler32(record.adler32),
-        content_size(record.size));
+    process_uri(rule, std::string(), ref, 0, 0);
+}
+
+
+void html_crawler::download_done() {
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    if (0 == --m_pending) m_pending_done.notify_all();
+}
 
-    fastcrawl::download dl(uri, filename_ss.str());
 
-    dl.verbose_log(verbose_log());  // set logging
+void html_crawler::wait() {
+    // Downloads may add downloads (stylesheets), so they're tracked
+    {
+        std::unique_lock<std::mutex> lock(m_pending_mutex);
+        m_pending_done.wait(lock, [this]() { return 0 == m_pending; });
+    }
 
-    record.success = dl(dproc);  // sub-download with Adler32 checksum
+    if (m_own_tp) m_own_tp->shutdown();
 }
 
 
@@ -118,44 +215,86 @@ void html_crawler::process_uri(
        << " at position " << line  << ":" << column
        << std::endl;
 
+    // Segmenter output only
+    if (m_on_reference) {
+        m_on_reference(element_name, attribute_name, uri_str, line, column);
+        return;
+    }
+
     // Ommit local fragment ref
     if (!uri_str.empty() && '#' == uri_str[0]) return;
 
-    const auto iter_new = m_uri_records.emplace(uri_str, uri_record());
-    if (iter_new.second) {
-        m_download_tp.run(std::bind(&html_crawler::download,
-            this, uri_str, line, column, std::ref(iter_new.first->second)));
+    std::unique_lock<std::mutex> records_lock(m_records_mutex);
+
+    // Known URI (lookup by reference, no copy)
+    if (m_uri_records.end() != m_uri_records.find(uri_str)) return;
+
+    // Absolute URI is only needed for the claim & preconnect
+    if (m_context && (m_context->claims() || m_context->preconnect())) {
+        const auto abs_uri = resolve(uri_str);
+
+        // Claimed by another crawler (of the shared context)
+        if (m_context->claims() && !m_context->claim(abs_uri)) {
+            ++m_duplicates;
+            return;
+        }
+
+        // Resolve & connect while the download job waits
+        m_context->warm_up(abs_uri);
     }
-}
 
+    // Intern the URI in the arena
+    const string_ref key(m_arena.copy(uri_str.data(), uri_str.size()), uri_str.size());
+    const auto iter_new = m_uri_records.emplace(key, uri_record());
+    metrics::global().references.add();
 
-std::ostream & operator << (
-    std::ostream &                   out,
-    const html_crawler::uri_record & rec)
-{
-    const auto cout_flags = out.flags();
+    // The record key is stable, so the job fits in place (see job)
+    const string_ref & uri = iter_new.first->first;
+    uri_record &       rec = iter_new.first->second;
 
-    out << rec.filename
-        << " size: " << std::dec << rec.size
-        << ", Adler32 checksum: "
-        << std::hex << std::setw(8) << std::setfill('0')
-        << rec.adler32;
+    if (0 == line) column = ++m_css_refs;  // stylesheet reference
 
-    out.flags(cout_flags);
+    records_lock.unlock();
+
+    uint64_t trace_id = 0;  // not traced
+    if (trace::enabled()) {
+        const int64_t ts = trace::now();
+        trace_id = trace::unique_id();
+
+        trace::record(trace::INSTANT, "discovered", trace_id, ts,
+            uri.data(), uri.size());
+        trace::record(trace::ASYNC_BEGIN, "queued", trace_id, ts);
+    }
 
-    return out;
+    // Track the crawler's pending downloads
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        ++m_pending;
+    }
+
+    const bool queued = m_download_tp.run(
+        [this, &uri, line, column, &rec, trace_id]()
+    {
+        download(uri, line, column, rec, trace_id);
+        download_done();
+    });
+
+    if (!queued) download_done();  // shut down
 }
 
 
-void html_crawler::report() const {
+void html_crawler::report(bool list_records) const {
     const uri_record * min_size_rec = nullptr;
     const uri_record * max_size_rec = nullptr;
 
+    std::unique_lock<std::mutex> records_lock(m_records_mutex);
+
     for (auto & uri_record: m_uri_records) {
         const auto & uri = uri_record.first;
         const auto & rec = uri_record.second;
 
-        std::cout << "URI \"" << uri << "\" stored in " << rec << std::endl;
+        if (list_records)
+            std::cout << "URI \"" << uri << "\" stored in " << rec << std::endl;
 
         if (!min_size_rec || min_size_rec->size > rec.size)
             min_size_rec = &rec;
@@ -169,247 +308,70 @@ void html_crawler::report() const {
 
     if (max_size_rec)
         std::cout << "Maximal size: " << *max_size_rec << std::endl;
+
+    records_lock.unlock();  // timings lock
+
+    const auto timing = timings();
+    if (timing.all().transfers()) timing.text(std::cout);
 }
 
 
-void html_crawler::operator () (unsigned char * data, size_t size) {
-    size_t offset = 0;
-    while (offset < size)
-        m_current_node->crawl(data, size, offset);
+timing_report html_crawler::timings() const {
+    timing_report report;
+    timings(report);
+
+    return report;
 }
 
 
-void html_crawler::html_doc::crawl(
-    unsigned char * data,
-    size_t          size,
-    size_t        & offset)
-{
-    while (offset < size) {
-        const unsigned ch = data[offset++];
-        crawler.update_position(ch);
-
-        switch (ch) {
-            // Element begin
-            case '<':
-                descend();
-                return;
-
-            // Not interesting
-            default:
-                break;
-        }
+void html_crawler::timings(timing_report & report) const {
+    std::lock_guard<std::mutex> lock(m_records_mutex);
+
+    for (auto & uri_record: m_uri_records) {
+        const auto & rec = uri_record.second;
+        if (!rec.timing.valid()) continue;
+
+        auto host = uri::parse(uri_record.first.str()).host;
+        if (host.empty()) host = m_base.host;  // relative URI
+
+        report.add(host, rec.timing);
     }
 }
 
 
-void html_crawler::html_tag::crawl(
-    unsigned char * data,
-    size_t          size,
-    size_t        & offset)
-{
-    if (skipped)
-        crawl_skipped(data, size, offset);
-    else
-        crawl_attrs(data, size, offset);
-}
+html_crawler::summary_t html_crawler::summary() const {
+    std::lock_guard<std::mutex> lock(m_records_mutex);
 
+    summary_t sum = { m_uri_records.size(), 0, 0, 0, m_duplicates, 0 };
 
-void html_crawler::html_tag::crawl_skipped(
-    unsigned char * data,
-    size_t          size,
-    size_t        & offset)
-{
-    while (offset < size) {
-        const unsigned ch = data[offset++];
-        crawler.update_position(ch);
-
-        run_at_eos(([ch, this]() { last_ch = ch; }));
-
-        switch (ch) {
-            // End of tag
-            case '>':
-                if (!comment || comment_end) {
-                    ascend();
-                    return;
-                }
-
-                break;
-
-            case '-':
-                if (comment_begin) {
-                    if ('-' == last_ch) comment = true;
-                }
-                else if (comment) {
-                    if ('-' == last_ch) comment_end = true;
-                }
-
-                break;
-
-            default:
-                comment_begin = false;
-                break;
-        }
+    for (auto & uri_record: m_uri_records) {
+        const auto & rec = uri_record.second;
+
+        if      (rec.success) ++sum.downloaded;
+        else if (rec.skipped) ++sum.skipped;
+        else                  ++sum.failed;
+
+        sum.bytes += rec.size;
     }
+
+    return sum;
 }
 
 
-void html_crawler::html_tag::crawl_attrs(
-    unsigned char * data,
-    size_t          size,
-    size_t        & offset)
-{
-    while (offset < size) {
-        const unsigned ch = data[offset++];
-        crawler.update_position(ch);
-
-        run_at_eos(([ch, this]() { last_ch = ch; }));
-
-        switch (ch) {
-            // Element ends
-            case '>':
-                ascend();
-                return;
-
-            // Comment or metadata (or syntax error)
-            case '!':
-                comment_begin = name.empty();
-                // Intentional fall through
-
-            case '?':
-                skipped = true;
-                return;
-
-            // Closed
-            case '/':
-                close = true;
-                break;
-
-            // Whitespace
-            case ' ':
-            case '\r':
-            case '\n':
-            case '\t':
-                if (!name.empty()) {
-                    name_done = true;
-
-                    // Got element name, check if it's interesting
-                    seek_attr = crawler.s_attribute_map.find(name);
-                    if (crawler.s_attribute_map.end() == seek_attr) {
-                        skipped = true;  // not an interesting element
-                        return;
-                    }
-                }
-
-                break;
-
-            // Dash might be part of the name
-            case '-':
-                if (!name_done && !name.empty()) name += std::tolower(ch);
-
-                // Syntax error
-                else {
-                    skipped = true;
-                    return;
-                }
-
-                break;
-
-            // Name or attribute definition
-            default:
-                if (token_char(ch)) {
-                    // Part of the name
-                    if (!name_done) name += std::tolower(ch);
-
-                    // Attribute begins
-                    else {
-                        descend(ch);
-                        return;
-                    }
-                }
-
-                // Syntax error
-                else {
-                    skipped = true;
-                    return;
-                }
-
-                break;
-        }
-    }
+void html_crawler::sample_metrics() const {
+    const auto stats = m_download_tp.stats();
+    auto & gauges = metrics::global();
+
+    gauges.queue_depth.set(stats.queued);
+    gauges.pool_size.set(stats.size);
+    gauges.busy_threads.set(stats.busy);
 }
 
 
-void html_crawler::html_element_attribute::crawl(
-    unsigned char * data,
-    size_t          size,
-    size_t        & offset)
-{
-    while (offset < size) {
-        const unsigned ch = data[offset++];
-        crawler.update_position(ch);
-
-        switch (ch) {
-            // Element ends
-            case '/':
-                if ('\0' == quote) {
-                    crawler.m_tag.close = true;
-                    ascend();
-                    return;
-                }
-                else value += ch;  // part of value
-
-                break;
-
-            // Element ends
-            case '>':
-                process();
-                ascend();
-                crawler.m_tag.ascend();
-                return;
-
-            // Value assignment
-            case '=':
-                has_value = true;
-                break;
-
-            // Value begin/end
-            case '\'':
-            case '"':
-                // Value begins
-                if ('\0' == quote) {
-                    quote  = ch;
-                    line   = crawler.m_line;
-                    column = crawler.m_column;
-                }
-
-                // We're done
-                else if (quote == ch) {
-                    process();
-                    ascend();
-                    return;
-                }
-
-                else value += ch;  // part of value
-
-                break;
-
-            // Whitespace
-            case ' ':
-            case '\r':
-            case '\n':
-            case '\t':
-                if ('\0' != quote) value += ch;  // part of value
-
-                break;
-
-            // Accumulate name or value
-            default:
-                if ('\0' != quote) value += ch;
-                else               name  += std::tolower(ch);
-
-                break;
-        }
-    }
+void html_crawler::operator () (unsigned char * data, size_t size) {
+    metrics::global().bytes_parsed.add(size);
+
+    m_segmenter(data, size);
 }
 
 }  // end of namespace fastcrawl
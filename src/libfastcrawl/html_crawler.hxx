@@ -42,11 +42,27 @@
  */
 
 #include "online_data_processor.hxx"
+#include "processor_pipeline.hxx"
+#include "uri_record.hxx"
+#include "completion_queue.hxx"
+#include "timing_report.hxx"
 #include "thread_pool.hxx"
+#include "crawl_context.hxx"
+#include "download_governor.hxx"
+#include "html_segmenter.hxx"
+#include "css_segmenter.hxx"
+#include "arena.hxx"
+#include "string_ref.hxx"
+#include "uri.hxx"
 #include "logger.hxx"
 
 #include <unordered_map>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <iostream>
+#include <stdexcept>
 #include <cassert>
 #include <cstdint>
 
@@ -56,23 +72,35 @@ namespace fastcrawl {
 /**
  *  \brief  HTML contengt reference attribute crawler
  *
- *  This is a simple, speed-optimised, online HTML doc|tag|attribute segmenter.
- *  It's used to seek registered element attributes and provide their values.
- *
- *  Basically, the crawler is a simple Finite State Automaton with 3 top-level
- *  nodes in line (document <-> tag <-> attribute).
- *  Within these nodes, further parsing goes character by character
- *  (with minimal rule set).
- *  It also supports faster skipping of uninteresting element tags
- *  (their attributes are not parsed).
+ *  The crawler uses a simple, speed-optimised, online HTML doc|tag|attribute
+ *  segmenter to seek registered element attributes and provide their values.
+ *  It's the default instantiation of \ref html_segmenter (content position
+ *  tracking, \ref html_reference_rules and the crawler URI processing
+ *  as the sink); use \ref html_segmenter directly with stripped-down
+ *  policies if just the references are needed.
  *  At any point, the processing may be interrupted and continued (when
  *  further data become available).
  *
  *  When a registered element attribute is found (content URI), it's downloaded.
  *  The crawler executes the download in separate thread from a thread pool.
- *  The download also computes Adler32 checksum and collects the total content
- *  size online.
- *  The results are stored in a record and may be reported eventually.
+ *  That's the elastic \ref thread_pool, not \ref work_stealing_pool:
+ *  downloads block on network I/O, so the crawler needs the pool to grow
+ *  and shrink, to bound its job queue and to report its saturation
+ *  (see \ref queue_limit and \ref congested); the fixed-size
+ *  work-stealing pool does none of that.  Job dispatch cost doesn't
+ *  matter at download rates (hundreds to thousands of jobs per second,
+ *  while \ref thread_pool dispatches about a million per second).
+ *  The download executes a \ref processor_pipeline on the content;
+ *  by default, it computes Adler32 checksum (and optionally other digests,
+ *  see \ref multi_hash) and collects the total content size online.
+ *  The results are stored in a record and may be reported eventually;
+ *  each record is also passed to the completion callback (if set) as soon
+ *  as the download finishes (see \ref on_completion).
+ *
+ *  Stylesheets (\c text/css content) are segmented
+ *  by \ref css_segmenter while they're downloaded; the references they
+ *  contain (fonts, background images...) are downloaded just like those
+ *  found in the page (see \ref stylesheets).
  *
  *  NOTE: The implementation is far from being perfect.
  *  It should be considered more a draft or proof of concept.
@@ -80,312 +108,539 @@ namespace fastcrawl {
  *  for serious applications.
  */
 class html_crawler: public online_data_processor, public logger {
+    public:
+
+    /**
+     *  \brief  Reference callback (see \ref on_reference)
+     *
+     *  Arguments: element name, attribute name, attribute value, and value
+     *  position (line, column).
+     */
+    using reference_callback_t = std::function<void (
+        const std::string &, const std::string &, const std::string &,
+        size_t, size_t)>;
+
+    /** Crawl summary (see \ref summary) */
+    struct summary_t {
+        size_t   references;    /**< Content references (records)        */
+        size_t   downloaded;    /**< Successful downloads                */
+        size_t   failed;        /**< Failed downloads                    */
+        size_t   skipped;       /**< Skipped downloads (not admitted)    */
+        size_t   duplicates;    /**< References claimed by other crawler */
+        uint64_t bytes;         /**< Downloaded content size             */
+
+    };  // end of struct summary_t
+
     private:
 
-    /** Content download record */
-    struct uri_record {
-        std::string filename;   /**< Content storage file name */
-        uint32_t    adler32;    /**< Content Adler32 checksum  */
-        size_t      size;       /**< Content size              */
-        bool        success;    /**< Content download status   */
-
-        uri_record():
-            adler32(0),
-            size(0),
-            success(false)
-        {}
+    /**
+     *  \brief  Map of URI -> content download records
+     *
+     *  The URIs are interned in and the map nodes allocated from
+     *  the crawler arena (records are kept for the whole crawl anyway).
+     */
+    using uri_records_t = std::unordered_map<
+        string_ref, uri_record, string_ref::hash, std::equal_to<string_ref>,
+        arena_allocator<std::pair<const string_ref, uri_record> > >;
+
+    /** Segmenter sink (processes the found content URIs) */
+    struct uri_sink {
+        html_crawler * crawler;  /**< Crawler */
+
+        void operator () (
+            const std::string & element_name,
+            const std::string & attribute_name,
+            const std::string & uri_str,
+            size_t              line,
+            size_t              column) const
+        {
+            crawler->process_uri(element_name, attribute_name, uri_str, line, column);
+        }
 
-    };  // end of struct uri_record
+    };  // end of struct uri_sink
 
-    /** Map of URI -> content download records */
-    using uri_records_t = std::unordered_map<std::string, uri_record>;
+    /** Segmenter (default instantiation) */
+    using segmenter_t = html_segmenter<uri_sink>;
 
-    /** Map of registered element attributes bearing content URI */
-    class attribute_map: public std::unordered_map<std::string, std::string> {
-        public:
+    /** Stylesheet segmenter sink (processes the found references) */
+    struct css_sink {
+        html_crawler * crawler;     /**< Crawler        */
+        const uri *    stylesheet;  /**< Stylesheet URI */
 
-        attribute_map();
+        void operator () (const char * rule, const std::string & value) const {
+            crawler->stylesheet_reference(rule, value, *stylesheet);
+        }
 
-    };  // end of class attribute_map
+    };  // end of struct css_sink
 
     /**
-     *  \brief  Crawler FSA node
+     *  \brief  Stylesheet reference extractor (download data processor)
      *
-     *  Abstract ancestor of the doc|tag|attribute FSA nodes.
+     *  The content is only segmented if it's a stylesheet (as per
+     *  the response Content-Type).
+     *  The references found are queued for download, so the stylesheet
+     *  download is throttled just like the page one (see \ref congested).
      */
-    struct html_node {
-        html_crawler & crawler;     /**< Crawler reference */
-        bool           done;        /**< Parsing done flag */
+    class stylesheet_processor: public online_data_processor {
+        private:
 
-        html_node(html_crawler & crawler_):
-            crawler(crawler_),
-            done(false)
+        html_crawler &           m_crawler;     /**< Crawler        */
+        const uri                m_uri;         /**< Stylesheet URI */
+        css_segmenter<css_sink>  m_segmenter;   /**< CSS segmenter  */
+        bool                     m_css;         /**< Is stylesheet  */
+
+        public:
+
+        stylesheet_processor(html_crawler & crawler, const uri & content):
+            m_crawler(crawler),
+            m_uri(content),
+            m_segmenter(css_sink{&crawler, &m_uri}),
+            m_css(false)
         {}
 
-        /**
-         *  \brief  Parsing entrypoint
-         *
-         *  When entering the respective FSA node, this function implements
-         *  parsing of the \c data chunk (beginning at \c offset).
-         *
-         *  \param  data    Data chunk
-         *  \param  size    Data chunk size
-         *  \param  offset  Current offset in data chunk
-         */
-        virtual void crawl(unsigned char * data, size_t size, size_t & offset) = 0;
+        stylesheet_processor(const stylesheet_processor & ) = delete;
+        stylesheet_processor & operator = (const stylesheet_processor & ) = delete;
+
+        void operator () (unsigned char * data, size_t size);
+
+        void content_type(const std::string & type);
 
-        virtual ~html_node() {}
+        bool congested() const { return m_css && m_crawler.congested(); }
 
-    };  // end of struct html_node
+        bool wait_ready(std::chrono::milliseconds timeout) const {
+            return m_crawler.wait_ready(timeout);
+        }
+
+    };  // end of class stylesheet_processor
+
+    const uri         m_base;       /**< Base URI (for non-absolute URIs)  */
+    std::string       m_directory;  /**< Content storage directory         */
+    pipeline_builder  m_pipeline;   /**< Download data processors          */
+
+    completion_callback_t m_on_completion;  /**< Download completion callback */
+    reference_callback_t  m_on_reference;   /**< Reference callback           */
+
+    bool              m_dry_run;    /**< Discovery only (no downloads)     */
+    bool              m_stylesheets;  /**< Segment stylesheets           */
+
+    segmenter_t       m_segmenter;  /**< HTML segmenter                    */
+
+    // URI records
+    arena         m_arena;          /**< Records & URIs memory      */
+    uri_records_t m_uri_records;    /**< Collected download records */
+    size_t        m_css_refs;       /**< Stylesheet references      */
+    mutable std::mutex m_records_mutex;  /**< Records mutex (stylesheet
+                                              references are processed
+                                              by download threads)       */
+
+    // Downloads
+    crawl_context *                    m_context;       /**< Shared context (optional) */
+    std::unique_ptr<thread_pool>       m_own_tp;        /**< Own download thread pool  */
+    thread_pool &                      m_download_tp;   /**< Download thread pool      */
+    std::unique_ptr<download_governor> m_own_governor;  /**< Own governor              */
+    download_governor &                m_governor;      /**< Download governor         */
+    size_t                             m_duplicates;    /**< Refused URI claims count  */
+    size_t                             m_pending;       /**< Pending downloads         */
+    std::mutex                         m_pending_mutex; /**< Pending downloads mutex   */
+    std::condition_variable            m_pending_done;  /**< No pending downloads      */
 
     /**
-     *  \brief  Crawler FSA document-level node
+     *  \brief  Constructor implementation
      *
-     *  Implements crawling outside of a tag.
+     *  \param  base     Base URI
+     *  \param  context  Shared crawl context (or \c nullptr)
+     *  \param  own_tp   Own download thread pool (iff no \c context)
      */
-    struct html_doc: public html_node {
-        html_doc(html_crawler & crawler):
-            html_node(crawler)
-        {}
+    html_crawler(
+        const uri &     base,
+        crawl_context * context,
+        thread_pool *   own_tp)
+    :
+        m_base(base),
+        m_directory("."),
+        m_pipeline("adler32,size"),
+        m_dry_run(false),
+        m_stylesheets(true),
+        m_segmenter(uri_sink{this}),
+        m_uri_records(1024, string_ref::hash(), std::equal_to<string_ref>(),
+            uri_records_t::allocator_type(m_arena)),
+        m_css_refs(0),
+        m_context(context),
+        m_own_tp(own_tp),
+        m_download_tp(context ? context->download_pool() : *own_tp),
+        m_own_governor(context ? nullptr : new download_governor),
+        m_governor(context ? context->governor() : *m_own_governor),
+        m_duplicates(0),
+        m_pending(0)
+    {}
 
-        /** Switch to FSA tag-level node */
-        void descend() {
-            crawler.m_current_node = &crawler.m_tag;
-        }
+    public:
 
-        /** Implements \ref html_node::crawl */
-        void crawl(unsigned char * data, size_t size, size_t & offset);
+    /**
+     *  \brief  Constructor
+     *
+     *  Non-absolute URIs get scheme, host and port of the base URI.
+     *
+     *  \param  base                     Base URI (of the crawled page)
+     *  \param  parallel_download_limit  Max. amount of download threads
+     */
+    html_crawler(
+        const uri & base,
+        size_t      parallel_download_limit = SIZE_MAX)
+    :
+        html_crawler(base, nullptr, new thread_pool(20, parallel_download_limit))
+    {}
 
-    };  // end of struct html_doc
+    /**
+     *  \brief  Constructor
+     *
+     *  The crawler uses the shared context resources (download threads,
+     *  cURL share); the content URIs it claims in the context are only
+     *  downloaded once (by the first claiming crawler).
+     *  Non-absolute URIs get scheme, host and port of the base URI.
+     *
+     *  \param  context  Shared crawl context
+     *  \param  base     Base URI (of the crawled page)
+     */
+    html_crawler(
+        crawl_context & context,
+        const uri &     base)
+    :
+        html_crawler(base, &context, nullptr)
+    {}
 
     /**
-     *  \brief  Crawler FSA tag-level node
+     *  \brief  Constructor
      *
-     *  Implements crawling within an element tag (opening or closing)
-     *  or indeed other tag-syntax metadata (like comments etc).
+     *  \param  host                     HTTP Host (for non-absolute URIs)
+     *  \param  parallel_download_limit  Max. amount of download threads
+     */
+    html_crawler(
+        const std::string & host,
+        size_t              parallel_download_limit = SIZE_MAX)
+    :
+        html_crawler(uri(std::string(), std::string(), std::string(), host, 0,
+            std::string(), std::string(), std::string()), parallel_download_limit)
+    {}
+
+    /** Computed content digests getter */
+    unsigned digests() const { return m_pipeline.digests(); }
+
+    /**
+     *  \brief  Add computed content digests
      *
-     *  The tag parsing is as permissive as possible.
+     *  The digests are computed in one pass (see \ref multi_hash).
      *
-     *  NOTE: This part is the fishier; probably needs much more work.
+     *  \param  algorithms  Digest algorithms (see \ref content_digests)
      */
-    struct html_tag: public html_node {
-        bool          close;            /**< Closing tag flag                 */
-        bool          skipped;          /**< Skipped tag (simplified parsing) */
-        bool          name_done;        /**< Element name parsing done        */
-        bool          comment;          /**< Comment tag (implies skipped)    */
-        bool          comment_begin;    /**< Comment beginning state          */
-        bool          comment_end;      /**< Comment ending state             */
-        unsigned char last_ch;          /**< Last character cache             */
-        std::string   name;             /**< Element name                     */
-
-        /**
-         *  In case the tag is an opeining of a registered element,
-         *  \c seek_attr points to the registered attribute.
-         */
-        attribute_map::const_iterator seek_attr;
-
-        html_tag(html_crawler & crawler):
-            html_node(crawler),
-            close(false),
-            skipped(false),
-            name_done(false),
-            comment(false),
-            comment_begin(false),
-            comment_end(false),
-            last_ch('\0'),
-            seek_attr(crawler.s_attribute_map.end())
-        {
-            name.reserve(64);  // reasonable element name length
-        }
+    void digests(unsigned algorithms) { m_pipeline.add_digests(algorithms); }
 
-        /** Switch back to document-level FSA node */
-        void ascend() {
-            close         = false;
-            skipped       = false;
-            name_done     = false;
-            comment       = false;
-            comment_begin = false;
-            comment_end   = false;
-            last_ch       = '\0';
-            seek_attr     = crawler.s_attribute_map.end();
-            name.clear();
-
-            crawler.m_current_node = &crawler.m_doc;
-        }
+    /** Base URI */
+    const uri & base() const { return m_base; }
 
-        /** Switch to attribute-level FSA node */
-        void descend(unsigned char ch) {
-            crawler.m_element_attr.name += ch;
+    /** Max. content storage directory path length */
+    static const size_t directory_max = 24;
 
-            crawler.m_current_node = &crawler.m_element_attr;
-        }
+    // Directory, "/", line and column (up to 10 digits each), "_" and NUL
+    static_assert(directory_max + 23 <= uri_record::filename_size,
+        "content file names don't fit in uri_record::filename");
 
-        /** Implements \ref html_node::crawl */
-        void crawl(unsigned char * data, size_t size, size_t & offset);
+    /** Content storage directory getter */
+    const std::string & directory() const { return m_directory; }
 
-        /** Implements \ref html_node::crawl for skipped tags */
-        void crawl_skipped(unsigned char * data, size_t size, size_t & offset);
+    /**
+     *  \brief  Content storage directory setter
+     *
+     *  The content is stored in the (existing) directory; the current
+     *  directory by default.
+     *  Must be set before the crawling starts.
+     *
+     *  \param  dir  Directory path (up to \ref directory_max characters)
+     *
+     *  \throw  std::length_error if the path is too long
+     */
+    void directory(const std::string & dir) {
+        if (dir.size() > directory_max)
+            throw std::length_error("html_crawler: directory path too long: " + dir);
 
-        /** Implements \ref html_node::crawl for non-skipped tags */
-        void crawl_attrs(unsigned char * data, size_t size, size_t & offset);
+        m_directory = dir;
+    }
 
-    };  // end of struct html_tag
+    /** Download policy getter */
+    const download_policy & policy() const { return m_governor.policy(); }
 
     /**
-     *  \brief  Crawler FSA element attribute level node
+     *  \brief  Download policy setter
      *
-     *  Implements crawling within an element tag attribute.
+     *  Timeouts, retries, hedging and host circuit breaking (see
+     *  \ref download_governor).
+     *  Note that with shared context, the policy applies to all the crawlers.
+     *  Must be set before the crawling starts.
      *
-     *  Extracts the value and calls \ref html_crawler::process_uri
-     *  if the attribute is registered.
+     *  \param  policy  Download policy
+     */
+    void policy(const download_policy & policy) { m_governor.policy(policy); }
+
+    /** Download data processors getter */
+    const pipeline_builder & pipeline() const { return m_pipeline; }
+
+    /**
+     *  \brief  Download data processors setter
+     *
+     *  Replaces the default pipeline (\c adler32 and \c size processors).
+     *  Must be set before the crawling starts.
      *
-     *  NOTE: This part is the fishier; probably needs much more work.
+     *  \param  pipeline  Pipeline builder
      */
-    struct html_element_attribute: public html_node {
-        bool          has_value;    /**< Attribute has value              */
-        std::string   name;         /**< Attribute name                   */
-        unsigned char quote;        /**< Quote character used for value   */
-        size_t        line;         /**< Value line position in content   */
-        size_t        column;       /**< Value column position on \c line */
-        std::string   value;        /**< Collected attribute value        */
-
-        html_element_attribute(html_crawler & crawler):
-            html_node(crawler),
-            has_value(false),
-            quote('\0'),
-            line(0),
-            column(0)
-        {
-            name.reserve(128);    // reasonable attribute name length
-            value.reserve(1024);  // reasonable attribute value length
-        }
+    void pipeline(const pipeline_builder & pipeline) { m_pipeline = pipeline; }
 
-        /** Switch back to tag-level FSA node */
-        void ascend() {
-            has_value = false;
-            quote     = '\0';
-            line      = 0;
-            column    = 0;
-            name.clear();
-            value.clear();
+    /**
+     *  \brief  Set download completion callback
+     *
+     *  The callback is called from the download threads as soon as
+     *  the respective download finishes (so it must be thread-safe).
+     *  Use \ref completion_queue to consume the results in another thread.
+     *  Must be set before the crawling starts.
+     *
+     *  \param  callback  Completion callback
+     */
+    void on_completion(completion_callback_t callback) {
+        m_on_completion = callback;
+    }
 
-            crawler.m_current_node = &crawler.m_tag;
-        }
+    /**
+     *  \brief  Set reference callback
+     *
+     *  If set, the segmenter output (found element attribute values)
+     *  is passed to the callback instead of being processed, i.e.
+     *  no records are created and nothing is downloaded.
+     *  Useful for testing and measuring the segmenter itself.
+     *  The callback is called from the crawling thread.
+     *  Must be set before the crawling starts.
+     *
+     *  \param  callback  Reference callback
+     */
+    void on_reference(reference_callback_t callback) {
+        m_on_reference = callback;
+    }
 
-        /** Implements \ref html_node::crawl */
-        void crawl(unsigned char * data, size_t size, size_t & offset);
-
-        /**
-         *  \brief  Process attribute value
-         *
-         *  As soon as the attribute value is collected, this function
-         *  checks if the attribute name matches the attribute registered
-         *  for the current element.
-         *  If so, \ref html_crawler::process_uri is called.
-         */
-        void process() const {
-            assert(crawler.s_attribute_map.end() != crawler.m_tag.seek_attr);
-
-            if (name == crawler.m_tag.seek_attr->second)
-                crawler.process_uri(crawler.m_tag.name, name, value, line, column);
-        }
+    /** Implements \ref online_data_processor::operator() */
+    void operator () (unsigned char * data, size_t size);
 
-    };  // end of struct html_element_attribute
+    /**
+     *  \brief  Implements \ref online_data_processor::congested
+     *
+     *  The crawler is congested while the download job queue is saturated
+     *  (see \ref queue_limit); the crawled page download is paused, so that
+     *  the pending downloads (and memory) are bounded no matter how many
+     *  references the page has.
+     *  So are the stylesheet downloads (they wait in the download threads;
+     *  see \ref thread_pool::wait_drained).
+     */
+    bool congested() const { return m_download_tp.saturated(); }
 
-    /** Map of registered element attributes (tag -> attribute) */
-    static const attribute_map s_attribute_map;
+    /** Implements \ref online_data_processor::wait_ready */
+    bool wait_ready(std::chrono::milliseconds timeout) const {
+        return m_download_tp.wait_drained(timeout);
+    }
 
-    const std::string m_host;   /**< HTTP Host (for non-absolute URIs) */
+    /**
+     *  \brief  Set download job queue limit
+     *
+     *  Note that with shared context, the limit applies to the shared
+     *  download thread pool (i.e. to all the crawlers).
+     *
+     *  \param  limit  Max. number of queued download jobs
+     */
+    void queue_limit(size_t limit) { m_download_tp.queue_limit(limit); }
 
-    // Position in content
-    size_t m_read_cnt;  /**< Read byte counter           */
-    size_t m_line;      /**< Current content line number */
-    size_t m_column;    /**< Current line column number  */
+    /**
+     *  \brief  Process content reference
+     *
+     *  Same as if the segmenter found it (see \ref on_reference);
+     *  allows for references found elsewhere (e.g. by
+     *  \ref parallel_segmenter) to be downloaded.
+     *
+     *  \param  element_name    Element name
+     *  \param  attribute_name  Attribute name
+     *  \param  uri_str         Attribute value (content URI)
+     *  \param  line            Value line position
+     *  \param  column          Value column position on \c line
+     */
+    void reference(
+        const std::string & element_name,
+        const std::string & attribute_name,
+        const std::string & uri_str,
+        size_t              line,
+        size_t              column)
+    {
+        process_uri(element_name, attribute_name, uri_str, line, column);
+    }
 
-    // Segmentation
-    html_doc                 m_doc;             /**< Document-level FSA node  */
-    html_tag                 m_tag;             /**< Tag-level FSA node       */
-    html_element_attribute   m_element_attr;    /**< Attribute-level FSA node */
-    html_node              * m_current_node;    /**< Current FSA node         */
+    /** Current content line number */
+    size_t line() const { return m_segmenter.line(); }
 
-    // URI records
-    uri_records_t m_uri_records;    /**< Collected download records */
+    /** Current line column number */
+    size_t column() const { return m_segmenter.column(); }
 
-    // Downloads
-    thread_pool m_download_tp;  /**< Download thread pool */
+    /**
+     *  \brief  Segmenter is at document level
+     *
+     *  I.e. not within a tag, comment or attribute; the following content
+     *  may be segmented by another crawler from scratch (provided that
+     *  it starts with \c '<' or it's the end of the content).
+     */
+    bool at_document_level() const { return m_segmenter.at_document_level(); }
 
-    public:
+    /**
+     *  \brief  Wait till all downloads have finished
+     *
+     *  The own download thread pool is shut down; with shared context,
+     *  the function waits for the crawler's pending downloads.
+     */
+    void wait();
 
     /**
-     *  \brief  Constructor
+     *  \brief  Discovery-only mode setter
      *
-     *  \param  host                     HTTP Host (for non-absolute URIs)
-     *  \param  parallel_download_limit  Max. amount of download threads
+     *  In the mode, content references are found and recorded (and
+     *  the download jobs are executed), but nothing is downloaded.
+     *  Useful for measuring the discovery itself.
+     *
+     *  \param  dry_run  Discovery-only mode flag
      */
-    html_crawler(
-        const std::string & host,
-        size_t              parallel_download_limit = SIZE_MAX)
-    :
-        m_host(host),
-        m_read_cnt(0),
-        m_line(1),
-        m_column(0),
-        m_doc(*this),
-        m_tag(*this),
-        m_element_attr(*this),
-        m_current_node(&m_doc),
-        m_download_tp(20, parallel_download_limit)
-    {}
+    void dry_run(bool dry_run) { m_dry_run = dry_run; }
 
-    /** Implements \ref online_data_processor::operator() */
-    void operator () (unsigned char * data, size_t size);
+    /**
+     *  \brief  Stylesheet segmentation setter
+     *
+     *  If enabled (the default), stylesheets are segmented as they're
+     *  downloaded and the references found are downloaded as well.
+     *  Content is considered a stylesheet if its Content-Type is
+     *  \c text/css (the data processors are set up before the response
+     *  head is received, so every download gets the stylesheet processor;
+     *  it's only enabled at the end of the head).
+     *  Stylesheet references don't have a position in the page; they're
+     *  stored as \c 00000000_NNNNNNNN (numbered in order of discovery).
+     *  Must be set before the crawling starts.
+     *
+     *  \param  enable  Segment stylesheets
+     */
+    void stylesheets(bool enable) { m_stylesheets = enable; }
+
+    /** Number of content references found (so far) */
+    size_t references() const {
+        std::lock_guard<std::mutex> lock(m_records_mutex);
+        return m_uri_records.size();
+    }
 
-    /** Wait till all downloads have finished */
-    void wait() { m_download_tp.shutdown(); }
+    /** Download thread pool counters */
+    thread_pool::stats_t download_pool_stats() const {
+        return m_download_tp.stats();
+    }
+
+    /**
+     *  \brief  Sample download pool gauges
+     *
+     *  Sets the download queue depth, pool size and busy threads gauges
+     *  of \ref metrics::global (use as the metrics sampler).
+     */
+    void sample_metrics() const;
 
     /**
      *  \brief  Report download results
      *
-     *  Note that the download records are accessed from download treads
-     *  unlocked.
-     *  The download threads don't race on the download records, as each
-     *  has its own.
+     *  The records map is locked (stylesheet downloads add records
+     *  during the crawl), but the records themselves are filled in
+     *  by the download threads without a lock.
+     *  Therefore, the results are only consistent after \ref wait;
+     *  calling this function during the crawl races with the pending
+     *  downloads.
+     *  Use \ref on_completion to get the results as the downloads finish.
      *
-     *  However, calling this function before te downloads have finished
-     *  would indeed be a race condition (not to mention that the data
-     *  would probably not be consistent yet).
-     *  Therefore, this function must only be called after \ref wait.
+     *  The report includes transfer timing summary (see \ref timings).
+     *
+     *  \param  list_records  List all download records (not just extremes)
      */
-    void report() const;
+    void report(bool list_records = true) const;
 
-    private:
+    /**
+     *  \brief  Transfer timing report
+     *
+     *  Aggregates the download records' transfer timings per host.
+     *  Same as for \ref report, this must only be called after \ref wait.
+     *
+     *  \return Timing report
+     */
+    timing_report timings() const;
 
-    /** Update content position */
-    void update_position(unsigned char ch) {
-        if ('\n' == ch) {
-            ++m_line;
-            m_column = 0;
-        }
-        else ++m_column;
+    /**
+     *  \brief  Add transfer timings to report
+     *
+     *  Same as \ref timings, but the timings are added to an existing
+     *  report (e.g. one aggregating many crawlers).
+     *
+     *  \param  report  Timing report
+     */
+    void timings(timing_report & report) const;
 
-        ++m_read_cnt;
-    }
+    /**
+     *  \brief  Crawl summary
+     *
+     *  Same as for \ref report, this must only be called after \ref wait.
+     *
+     *  \return Crawl summary
+     */
+    summary_t summary() const;
+
+    /**
+     *  \brief  Resolve content URI
+     *
+     *  \param  uri_str  Content URI (absolute or relative to the base URI)
+     *
+     *  \return Absolute URI
+     */
+    uri resolve(const std::string & uri_str) const;
+
+    private:
+
+    /** Pending download done */
+    void download_done();
 
     /**
      *  \brief  Download content
      *
      *  The function implements the job for a download thread.
      *
-     *  \param  uri_str  Content URI
-     *  \param  line     URI line position in crawled HTML code
-     *  \param  column   URI column position on \c line
-     *  \param  record   Download record for the job results
+     *  \param  uri_ref   Content URI
+     *  \param  line      URI line position in crawled HTML code
+     *  \param  column    URI column position on \c line
+     *  \param  record    Download record for the job results
+     *  \param  trace_id  Trace ID (if tracing, see \ref trace::unique_id)
      */
     void download(
-        const std::string & uri_str,
+        const string_ref &  uri_ref,
         size_t              line,
         size_t              column,
-        uri_record &        record);
+        uri_record &        record,
+        uint64_t            trace_id);
+
+    /**
+     *  \brief  Process reference found in stylesheet
+     *
+     *  Called by download threads.
+     *  The reference is resolved (relative to the stylesheet URI,
+     *  see RFC 3986, section 5.2) and processed (see \ref process_uri);
+     *  empty and local fragment references are ignored.
+     *
+     *  \param  rule        \c "url" or \c "@import"
+     *  \param  value       Reference
+     *  \param  stylesheet  Stylesheet URI
+     */
+    void stylesheet_reference(
+        const char *        rule,
+        const std::string & value,
+        const uri &         stylesheet);
 
     /**
      *  \brief  Process found content URI reference
@@ -393,11 +648,13 @@ class html_crawler: public online_data_processor, public logger {
      *  Filters out local anchors.
      *  Creates new download record and pushes download job to thread pool
      *  job queue.
+     *  Thread-safe (stylesheet references are processed by download threads).
      *
      *  \param  element_name    Element name
      *  \param  attribute_name  Attribute name
      *  \param  uri_str         Attribute value (content URI)
      *  \param  line            Value line position in crawled HTML code
+     *                          (0 for stylesheet references)
      *  \param  column          Value column position on \c line
      *
      */
@@ -408,11 +665,6 @@ class html_crawler: public online_data_processor, public logger {
         size_t              line,
         size_t              column);
 
-    /** Download record serialisation */
-    friend std::ostream & operator << (
-        std::ostream &     out,
-        const uri_record & rec);
-
 };  // end of class html_crawler
 
 }  // end of namespace fastcrawl
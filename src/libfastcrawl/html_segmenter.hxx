@@ -0,0 +1,608 @@
+#ifndef fastcrawl__html_segmenter_hxx
+#define fastcrawl__html_segmenter_hxx
+
+/**
+ *  \file
+ *  \brief  Policy-based HTML segmenter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utility.hxx"
+
+#include <string>
+#include <cassert>
+#include <cctype>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Segmenter position policy: track content position
+ *
+ *  Attribute values are reported with their line and column position.
+ */
+class track_position {
+    private:
+
+    size_t m_line;      /**< Current content line number */
+    size_t m_column;    /**< Current line column number  */
+
+    public:
+
+    track_position(): m_line(1), m_column(0) {}
+
+    /** Update position by character */
+    void update(unsigned char ch) {
+        if ('\n' == ch) {
+            ++m_line;
+            m_column = 0;
+        }
+        else ++m_column;
+    }
+
+    /** Current content line number */
+    size_t line() const { return m_line; }
+
+    /** Current line column number */
+    size_t column() const { return m_column; }
+
+};  // end of class track_position
+
+
+/**
+ *  \brief  Segmenter position policy: no position tracking
+ *
+ *  Attribute values are reported at position 0:0.
+ */
+class no_position {
+    public:
+
+    /** Position isn't tracked */
+    void update(unsigned char ) {}
+
+    /** Always 0 */
+    size_t line() const { return 0; }
+
+    /** Always 0 */
+    size_t column() const { return 0; }
+
+};  // end of class no_position
+
+
+/**
+ *  \brief  Segmenter extraction rules: content references
+ *
+ *  \c a \c href, \c img \c src, \c script \c src, \c iframe \c src
+ *  and \c link \c href (e.g. stylesheets) attributes; element and attribute names are case-folded by
+ *  \c std::tolower.
+ */
+struct html_reference_rules {
+    /**
+     *  \brief  Registered attribute of element
+     *
+     *  \param  element  Element name (case-folded)
+     *
+     *  \return Attribute name or \c nullptr if the element isn't registered
+     */
+    static const char * attribute(const std::string & element);
+
+    /** Name character case folding */
+    static unsigned char fold(unsigned char ch) { return std::tolower(ch); }
+
+};  // end of struct html_reference_rules
+
+
+/**
+ *  \brief  Segmenter extraction rules: links
+ *
+ *  \c a \c href attributes only (URL list); ASCII case folding.
+ */
+struct html_link_rules {
+    /** Registered attribute of element (see \ref html_reference_rules) */
+    static const char * attribute(const std::string & element) {
+        return 1 == element.size() && 'a' == element[0] ? "href" : nullptr;
+    }
+
+    /** Name character case folding */
+    static unsigned char fold(unsigned char ch) {
+        return 'A' <= ch && ch <= 'Z' ? ch | 0x20 : ch;
+    }
+
+};  // end of struct html_link_rules
+
+
+/**
+ *  \brief  Policy-based online HTML doc|tag|attribute segmenter
+ *
+ *  The segmenter is a simple Finite State Automaton with 3 top-level
+ *  nodes in line (document <-> tag <-> attribute).
+ *  Within these nodes, further parsing goes character by character
+ *  (with minimal rule set).
+ *  Uninteresting element tags are skipped (their attributes are not parsed).
+ *  At any point, the processing may be interrupted and continued (when
+ *  further data become available).
+ *
+ *  The features are chosen at compile time, so that the unused ones
+ *  compile away completely:
+ *  - \c Position policy tracks content position of the attribute values
+ *    (\ref track_position) or doesn't (\ref no_position)
+ *  - \c Rules policy defines the registered element attributes and name
+ *    case folding (\ref html_reference_rules, \ref html_link_rules)
+ *  - \c Sink gets the registered attribute values; it's called as
+ *    <tt>sink(element, attribute, value, line, column)</tt> (all strings
+ *    are \c std::string, positions are \c size_t)
+ *
+ *  \ref html_crawler is the default instantiation (with position tracking,
+ *  content reference rules and its URI processing as the sink).
+ *
+ *  \tparam  Sink      Attribute value sink
+ *  \tparam  Position  Position policy
+ *  \tparam  Rules     Extraction rules
+ */
+template <class Sink, class Position = track_position, class Rules = html_reference_rules>
+class html_segmenter {
+    private:
+
+    /** FSA node */
+    enum node_t {
+        DOC = 0,    /**< Document level (outside of a tag) */
+        TAG,        /**< Tag level                         */
+        ATTRIBUTE,  /**< Element attribute level           */
+    };  // end of enum node_t
+
+    /**
+     *  \brief  Tag-level FSA node state
+     *
+     *  The tag parsing is as permissive as possible.
+     *
+     *  NOTE: This part is the fishier; probably needs much more work.
+     */
+    struct tag_state {
+        bool          close;            /**< Closing tag flag                 */
+        bool          skipped;          /**< Skipped tag (simplified parsing) */
+        bool          name_done;        /**< Element name parsing done        */
+        bool          comment;          /**< Comment tag (implies skipped)    */
+        bool          comment_begin;    /**< Comment beginning state          */
+        bool          comment_end;      /**< Comment ending state             */
+        unsigned char last_ch;          /**< Last character cache             */
+        std::string   name;             /**< Element name                     */
+        const char *  seek_attr;        /**< Registered attribute (if any)    */
+
+        tag_state() {
+            reset();
+            name.reserve(64);  // reasonable element name length
+        }
+
+        /** Reset state */
+        void reset() {
+            close         = false;
+            skipped       = false;
+            name_done     = false;
+            comment       = false;
+            comment_begin = false;
+            comment_end   = false;
+            last_ch       = '\0';
+            seek_attr     = nullptr;
+            name.clear();
+        }
+
+    };  // end of struct tag_state
+
+    /** Attribute-level FSA node state */
+    struct attribute_state {
+        bool          has_value;    /**< Attribute has value              */
+        std::string   name;         /**< Attribute name                   */
+        unsigned char quote;        /**< Quote character used for value   */
+        size_t        line;         /**< Value line position in content   */
+        size_t        column;       /**< Value column position on \c line */
+        std::string   value;        /**< Collected attribute value        */
+
+        attribute_state() {
+            reset();
+            name.reserve(128);    // reasonable attribute name length
+            value.reserve(1024);  // reasonable attribute value length
+        }
+
+        /** Reset state */
+        void reset() {
+            has_value = false;
+            quote     = '\0';
+            line      = 0;
+            column    = 0;
+            name.clear();
+            value.clear();
+        }
+
+    };  // end of struct attribute_state
+
+    Sink            m_sink;         /**< Attribute value sink   */
+    Position        m_position;     /**< Content position       */
+    node_t          m_node;         /**< Current FSA node       */
+    tag_state       m_tag;          /**< Tag-level state        */
+    attribute_state m_attr;         /**< Attribute-level state  */
+
+    /** Token character check */
+    static bool token_char(unsigned char ch) {
+        if ('a' <= ch && ch <= 'z') return true;
+        if ('A' <= ch && ch <= 'Z') return true;
+        if ('0' <= ch && ch <= '9') return true;
+        if ('-' == ch || ':' == ch) return true;
+
+        return false;
+    }
+
+    /** Switch from tag to document-level FSA node */
+    void tag_ascend() {
+        m_tag.reset();
+        m_node = DOC;
+    }
+
+    /** Switch from tag to attribute-level FSA node */
+    void tag_descend(unsigned char ch) {
+        m_attr.name += ch;
+        m_node = ATTRIBUTE;
+    }
+
+    /** Switch from attribute to tag-level FSA node */
+    void attribute_ascend() {
+        m_attr.reset();
+        m_node = TAG;
+    }
+
+    /**
+     *  \brief  Process attribute value
+     *
+     *  As soon as the attribute value is collected, this function
+     *  checks if the attribute name matches the attribute registered
+     *  for the current element; if so, the value is passed to the sink.
+     */
+    void process_attribute() {
+        assert(nullptr != m_tag.seek_attr);
+
+        if (m_attr.name == m_tag.seek_attr)
+            m_sink(m_tag.name, m_attr.name, m_attr.value,
+                m_attr.line, m_attr.column);
+    }
+
+    /** Document-level FSA node: crawling outside of a tag */
+    void crawl_doc(unsigned char * data, size_t size, size_t & offset);
+
+    /** Tag-level FSA node: crawling skipped tags */
+    void crawl_tag_skipped(unsigned char * data, size_t size, size_t & offset);
+
+    /** Tag-level FSA node: crawling non-skipped tags */
+    void crawl_tag_attrs(unsigned char * data, size_t size, size_t & offset);
+
+    /**
+     *  \brief  Attribute-level FSA node
+     *
+     *  Extracts the value and passes it to the sink if the attribute
+     *  is registered.
+     *
+     *  NOTE: This part is the fishier; probably needs much more work.
+     */
+    void crawl_attribute(unsigned char * data, size_t size, size_t & offset);
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  sink  Attribute value sink
+     */
+    html_segmenter(Sink sink = Sink()): m_sink(sink), m_node(DOC) {}
+
+    /**
+     *  \brief  Segment (next) data chunk
+     *
+     *  \param  data  Data chunk
+     *  \param  size  Data chunk size
+     */
+    void operator () (unsigned char * data, size_t size) {
+        size_t offset = 0;
+        while (offset < size) {
+            switch (m_node) {
+                case DOC:
+                    crawl_doc(data, size, offset);
+                    break;
+
+                case TAG:
+                    if (m_tag.skipped)
+                        crawl_tag_skipped(data, size, offset);
+                    else
+                        crawl_tag_attrs(data, size, offset);
+
+                    break;
+
+                case ATTRIBUTE:
+                    crawl_attribute(data, size, offset);
+                    break;
+            }
+        }
+    }
+
+    /** Attribute value sink */
+    Sink & sink() { return m_sink; }
+
+    /** Current content line number (0 if not tracked) */
+    size_t line() const { return m_position.line(); }
+
+    /** Current line column number (0 if not tracked) */
+    size_t column() const { return m_position.column(); }
+
+    /**
+     *  \brief  Segmenter is at document level
+     *
+     *  I.e. not within a tag, comment or attribute.
+     */
+    bool at_document_level() const { return DOC == m_node; }
+
+};  // end of template class html_segmenter
+
+
+// html_segmenter template members
+
+template <class Sink, class Position, class Rules>
+void html_segmenter<Sink, Position, Rules>::crawl_doc(
+    unsigned char * data,
+    size_t          size,
+    size_t        & offset)
+{
+    while (offset < size) {
+        const unsigned ch = data[offset++];
+        m_position.update(ch);
+
+        switch (ch) {
+            // Element begin
+            case '<':
+                m_node = TAG;
+                return;
+
+            // Not interesting
+            default:
+                break;
+        }
+    }
+}
+
+
+template <class Sink, class Position, class Rules>
+void html_segmenter<Sink, Position, Rules>::crawl_tag_skipped(
+    unsigned char * data,
+    size_t          size,
+    size_t        & offset)
+{
+    while (offset < size) {
+        const unsigned ch = data[offset++];
+        m_position.update(ch);
+
+        run_at_eos(([ch, this]() { m_tag.last_ch = ch; }));
+
+        switch (ch) {
+            // End of tag
+            case '>':
+                if (!m_tag.comment || m_tag.comment_end) {
+                    tag_ascend();
+                    return;
+                }
+
+                break;
+
+            case '-':
+                if (m_tag.comment_begin) {
+                    if ('-' == m_tag.last_ch) m_tag.comment = true;
+                }
+                else if (m_tag.comment) {
+                    if ('-' == m_tag.last_ch) m_tag.comment_end = true;
+                }
+
+                break;
+
+            default:
+                m_tag.comment_begin = false;
+                break;
+        }
+    }
+}
+
+
+template <class Sink, class Position, class Rules>
+void html_segmenter<Sink, Position, Rules>::crawl_tag_attrs(
+    unsigned char * data,
+    size_t          size,
+    size_t        & offset)
+{
+    while (offset < size) {
+        const unsigned ch = data[offset++];
+        m_position.update(ch);
+
+        run_at_eos(([ch, this]() { m_tag.last_ch = ch; }));
+
+        switch (ch) {
+            // Element ends
+            case '>':
+                tag_ascend();
+                return;
+
+            // Comment or metadata (or syntax error)
+            case '!':
+                m_tag.comment_begin = m_tag.name.empty();
+                // Intentional fall through
+
+            case '?':
+                m_tag.skipped = true;
+                return;
+
+            // Closed
+            case '/':
+                m_tag.close = true;
+                break;
+
+            // Whitespace
+            case ' ':
+            case '\r':
+            case '\n':
+            case '\t':
+                if (!m_tag.name.empty()) {
+                    m_tag.name_done = true;
+
+                    // Got element name, check if it's interesting
+                    m_tag.seek_attr = Rules::attribute(m_tag.name);
+                    if (nullptr == m_tag.seek_attr) {
+                        m_tag.skipped = true;  // not an interesting element
+                        return;
+                    }
+                }
+
+                break;
+
+            // Dash might be part of the name
+            case '-':
+                if (!m_tag.name_done && !m_tag.name.empty())
+                    m_tag.name += Rules::fold(ch);
+
+                // Syntax error
+                else {
+                    m_tag.skipped = true;
+                    return;
+                }
+
+                break;
+
+            // Name or attribute definition
+            default:
+                if (token_char(ch)) {
+                    // Part of the name
+                    if (!m_tag.name_done) m_tag.name += Rules::fold(ch);
+
+                    // Attribute begins
+                    else {
+                        tag_descend(ch);
+                        return;
+                    }
+                }
+
+                // Syntax error
+                else {
+                    m_tag.skipped = true;
+                    return;
+                }
+
+                break;
+        }
+    }
+}
+
+
+template <class Sink, class Position, class Rules>
+void html_segmenter<Sink, Position, Rules>::crawl_attribute(
+    unsigned char * data,
+    size_t          size,
+    size_t        & offset)
+{
+    while (offset < size) {
+        const unsigned ch = data[offset++];
+        m_position.update(ch);
+
+        switch (ch) {
+            // Element ends
+            case '/':
+                if ('\0' == m_attr.quote) {
+                    m_tag.close = true;
+                    attribute_ascend();
+                    return;
+                }
+                else m_attr.value += ch;  // part of value
+
+                break;
+
+            // Element ends
+            case '>':
+                process_attribute();
+                attribute_ascend();
+                tag_ascend();
+                return;
+
+            // Value assignment
+            case '=':
+                m_attr.has_value = true;
+                break;
+
+            // Value begin/end
+            case '\'':
+            case '"':
+                // Value begins
+                if ('\0' == m_attr.quote) {
+                    m_attr.quote  = ch;
+                    m_attr.line   = m_position.line();
+                    m_attr.column = m_position.column();
+                }
+
+                // We're done
+                else if (m_attr.quote == ch) {
+                    process_attribute();
+                    attribute_ascend();
+                    return;
+                }
+
+                else m_attr.value += ch;  // part of value
+
+                break;
+
+            // Whitespace
+            case ' ':
+            case '\r':
+            case '\n':
+            case '\t':
+                if ('\0' != m_attr.quote) m_attr.value += ch;  // part of value
+
+                break;
+
+            // Accumulate name or value
+            default:
+                if ('\0' != m_attr.quote) m_attr.value += ch;
+                else                      m_attr.name  += Rules::fold(ch);
+
+                break;
+        }
+    }
+}
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__html_segmenter_hxx
@@ -0,0 +1,214 @@
+#ifndef fastcrawl__job_hxx
+#define fastcrawl__job_hxx
+
+/**
+ *  \file
+ *  \brief  Move-only thread job
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Move-only thread job
+ *
+ *  Type-erased callable without arguments and return value
+ *  (a replacement of \c std::function<void ()> for thread pool jobs).
+ *
+ *  Unlike \c std::function, the job is move-only (so it may capture
+ *  move-only objects and it's never copied on its way through a job queue)
+ *  and it stores callables of up to \ref capacity bytes in place
+ *  (small buffer optimisation); larger callables are allocated on the heap.
+ *  The object size is one cache line.
+ */
+class job {
+    public:
+
+    /** In-place storage capacity */
+    static const size_t capacity = 64 - sizeof(void *);
+
+    private:
+
+    /** Callable operations */
+    struct operations {
+        void (* invoke)(void *);            /**< Call callable           */
+        void (* move)(void *, void *);      /**< Move-construct to dest. */
+        void (* destroy)(void *);           /**< Destroy callable        */
+
+    };  // end of struct operations
+
+    /** Stored in place */
+    template <class Fn>
+    struct local {
+        static void invoke(void * fn) { (*static_cast<Fn *>(fn))(); }
+
+        static void move(void * src, void * dest) {
+            new (dest) Fn(std::move(*static_cast<Fn *>(src)));
+            static_cast<Fn *>(src)->~Fn();
+        }
+
+        static void destroy(void * fn) { static_cast<Fn *>(fn)->~Fn(); }
+
+        static const operations ops;
+
+    };  // end of template struct local
+
+    /** Stored on heap (the buffer holds pointer to the callable) */
+    template <class Fn>
+    struct remote {
+        static Fn *& ptr(void * buff) { return *static_cast<Fn **>(buff); }
+
+        static void invoke(void * fn) { (*ptr(fn))(); }
+
+        static void move(void * src, void * dest) {
+            new (dest) Fn *(ptr(src));
+        }
+
+        static void destroy(void * fn) { delete ptr(fn); }
+
+        static const operations ops;
+
+    };  // end of template struct remote
+
+    /** Callable may be stored in place */
+    template <class Fn>
+    using fits = std::integral_constant<bool,
+        sizeof(Fn)  <= capacity                     &&
+        alignof(Fn) <= alignof(std::max_align_t)    &&
+        std::is_nothrow_move_constructible<Fn>::value>;
+
+    alignas(std::max_align_t)
+    unsigned char       m_buff[capacity];  /**< Callable storage          */
+    const operations *  m_ops;             /**< Operations (or \c nullptr) */
+
+    /** Store callable in place */
+    template <class Fn>
+    void store(Fn && fn, std::true_type) {
+        using fn_t = typename std::decay<Fn>::type;
+
+        new (m_buff) fn_t(std::forward<Fn>(fn));
+        m_ops = &local<fn_t>::ops;
+    }
+
+    /** Store callable on heap */
+    template <class Fn>
+    void store(Fn && fn, std::false_type) {
+        using fn_t = typename std::decay<Fn>::type;
+
+        new (m_buff) fn_t *(new fn_t(std::forward<Fn>(fn)));
+        m_ops = &remote<fn_t>::ops;
+    }
+
+    public:
+
+    /** Empty job */
+    job(): m_ops(nullptr) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  fn  Callable (taking no arguments)
+     */
+    template <class Fn, class = typename std::enable_if<
+        !std::is_same<typename std::decay<Fn>::type, job>::value>::type>
+    job(Fn && fn) {
+        store(std::forward<Fn>(fn), fits<typename std::decay<Fn>::type>());
+    }
+
+    /** Move constructor */
+    job(job && orig) noexcept: m_ops(orig.m_ops) {
+        if (m_ops) m_ops->move(orig.m_buff, m_buff);
+        orig.m_ops = nullptr;
+    }
+
+    /** Move assignment */
+    job & operator = (job && orig) noexcept {
+        if (this != &orig) {
+            reset();
+
+            m_ops = orig.m_ops;
+            if (m_ops) m_ops->move(orig.m_buff, m_buff);
+            orig.m_ops = nullptr;
+        }
+
+        return *this;
+    }
+
+    job(const job & ) = delete;
+    job & operator = (const job & ) = delete;
+
+    /** Job is set */
+    explicit operator bool () const { return nullptr != m_ops; }
+
+    /** Execute job */
+    void operator () () { m_ops->invoke(m_buff); }
+
+    /** Drop the callable (job becomes empty) */
+    void reset() {
+        if (m_ops) m_ops->destroy(m_buff);
+        m_ops = nullptr;
+    }
+
+    /** Destructor */
+    ~job() { reset(); }
+
+};  // end of class job
+
+
+template <class Fn>
+const job::operations job::local<Fn>::ops = {
+    &job::local<Fn>::invoke,
+    &job::local<Fn>::move,
+    &job::local<Fn>::destroy,
+};
+
+template <class Fn>
+const job::operations job::remote<Fn>::ops = {
+    &job::remote<Fn>::invoke,
+    &job::remote<Fn>::move,
+    &job::remote<Fn>::destroy,
+};
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__job_hxx
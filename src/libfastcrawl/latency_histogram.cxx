@@ -0,0 +1,115 @@
+/**
+ *  \file
+ *  \brief  HDR-style latency histogram
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "latency_histogram.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace fastcrawl {
+
+size_t latency_histogram::index(uint64_t value) {
+    if (value < 2 * half) return (size_t)value;
+
+    const unsigned msb = 63 - __builtin_clzll(value);
+    const unsigned mag = msb - (precision - 1);
+
+    return mag * half + (size_t)(value >> mag);
+}
+
+
+uint64_t latency_histogram::upper(size_t index) {
+    if (index < 2 * half) return index;
+
+    const unsigned mag = index / half - 1;
+    const uint64_t sub = index - mag * half;
+
+    return ((sub + 1) << mag) - 1;
+}
+
+
+void latency_histogram::record(uint64_t value) {
+    const size_t i = index(value);
+    if (i >= m_counts.size()) m_counts.resize(i + 1, 0);
+
+    ++m_counts[i];
+
+    m_min  = m_count ? std::min(m_min, value) : value;
+    m_max  = std::max(m_max, value);
+    m_sum += value;
+    ++m_count;
+}
+
+
+void latency_histogram::merge(const latency_histogram & hist) {
+    if (!hist.m_count) return;
+
+    if (hist.m_counts.size() > m_counts.size())
+        m_counts.resize(hist.m_counts.size(), 0);
+
+    for (size_t i = 0; i < hist.m_counts.size(); ++i)
+        m_counts[i] += hist.m_counts[i];
+
+    m_min    = m_count ? std::min(m_min, hist.m_min) : hist.m_min;
+    m_max    = std::max(m_max, hist.m_max);
+    m_sum   += hist.m_sum;
+    m_count += hist.m_count;
+}
+
+
+uint64_t latency_histogram::percentile(double percentile) const {
+    if (!m_count) return 0;
+
+    // Rank of the value (1-based)
+    uint64_t rank = (uint64_t)std::ceil(percentile / 100 * m_count);
+    rank = std::max<uint64_t>(1, std::min(rank, m_count));
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+        cumulative += m_counts[i];
+        if (cumulative >= rank)
+            return std::max(m_min, std::min(upper(i), m_max));
+    }
+
+    return m_max;
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,122 @@
+#ifndef fastcrawl__latency_histogram_hxx
+#define fastcrawl__latency_histogram_hxx
+
+/**
+ *  \file
+ *  \brief  HDR-style latency histogram
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Latency histogram
+ *
+ *  HDR-style (log-linear) histogram of non-negative integer values
+ *  (e.g. durations in microseconds).
+ *  Each power of 2 range is split to 2^(precision - 1) linear buckets,
+ *  so the relative error of reported values is below 2^(1 - precision)
+ *  over the whole value range.
+ *  Recording a value is O(1) and the memory is bounded (less than 2000
+ *  counters for 64-bit values).
+ */
+class latency_histogram {
+    public:
+
+    static const unsigned precision = 6;  /**< Significant bits */
+
+    private:
+
+    static const size_t half = 1 << (precision - 1);  /**< Buckets per power of 2 */
+
+    std::vector<uint64_t> m_counts;  /**< Bucket counters */
+    uint64_t              m_count;   /**< Values count    */
+    uint64_t              m_min;     /**< Min. value      */
+    uint64_t              m_max;     /**< Max. value      */
+    double                m_sum;     /**< Values sum      */
+
+    /** Value bucket index */
+    static size_t index(uint64_t value);
+
+    /** Highest value equivalent to bucket */
+    static uint64_t upper(size_t index);
+
+    public:
+
+    latency_histogram(): m_count(0), m_min(0), m_max(0), m_sum(0) {}
+
+    /** Record value */
+    void record(uint64_t value);
+
+    /** Add another histogram values */
+    void merge(const latency_histogram & hist);
+
+    /** Values count */
+    uint64_t count() const { return m_count; }
+
+    /** Min. value */
+    uint64_t min() const { return m_min; }
+
+    /** Max. value */
+    uint64_t max() const { return m_max; }
+
+    /** Mean value */
+    double mean() const { return m_count ? m_sum / m_count : 0; }
+
+    /**
+     *  \brief  Value at percentile
+     *
+     *  The highest value equivalent to the percentile bucket is returned
+     *  (i.e. an upper estimate within the histogram precision; but never
+     *  above the max. value).
+     *
+     *  \param  percentile  Percentile (0 to 100)
+     *
+     *  \return Value at percentile (0 if the histogram is empty)
+     */
+    uint64_t percentile(double percentile) const;
+
+};  // end of class latency_histogram
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__latency_histogram_hxx
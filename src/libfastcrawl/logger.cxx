@@ -0,0 +1,489 @@
+/**
+ *  \file
+ *  \brief  Asynchronous logging backend
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "logger.hxx"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <streambuf>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <ctime>
+
+#include <unistd.h>
+
+
+namespace fastcrawl {
+
+/** Record text buffer (appends to a reusable string) */
+class log_buffer: public std::streambuf {
+    private:
+
+    std::string m_text;  /**< Record text */
+
+    protected:
+
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            m_text.push_back(traits_type::to_char_type(ch));
+
+        return ch;
+    }
+
+    std::streamsize xsputn(const char * s, std::streamsize n) override {
+        m_text.append(s, n);
+        return n;
+    }
+
+    public:
+
+    /** Record text */
+    std::string & text() { return m_text; }
+
+};  // end of class log_buffer
+
+
+/** Record text stream */
+class log_stream: public std::ostream {
+    private:
+
+    log_buffer               m_buffer;  /**< Text buffer          */
+    const std::ios::fmtflags m_flags;   /**< Default format flags */
+
+    public:
+
+    log_stream(): std::ostream(nullptr), m_flags(flags()) {
+        rdbuf(&m_buffer);
+    }
+
+    /** Reset stream for next record */
+    void reset() {
+        m_buffer.text().clear();
+        clear();
+        flags(m_flags);
+        precision(6);
+        width(0);
+        fill(' ');
+    }
+
+    /** Record text */
+    std::string & text() { return m_buffer.text(); }
+
+};  // end of class log_stream
+
+
+namespace {
+
+/** Record header (in ring) */
+struct log_record {
+    int64_t  timestamp;  /**< Wall-clock time [us]       */
+    uint32_t thread;     /**< Sequential thread number   */
+    uint32_t level;      /**< Level                      */
+    uint32_t length;     /**< Text length                */
+    uint32_t reserved;   /**< Alignment                  */
+};  // end of struct log_record
+
+
+/**
+ *  \brief  Per-thread record ring
+ *
+ *  Single producer (the owner thread), single consumer (the drainer).
+ *  Records are 8-byte aligned; they may wrap around the ring end.
+ */
+class log_ring {
+    public:
+
+    static const size_t capacity = 1 << 16;  /**< Ring size [B] */
+
+    private:
+
+    std::unique_ptr<char[]> m_data;       /**< Ring storage                */
+    const uint32_t          m_thread;     /**< Owner thread number         */
+    std::atomic<uint64_t>   m_head;       /**< Written position (producer) */
+    char                    m_pad[64];    /**< False sharing guard         */
+    std::atomic<uint64_t>   m_tail;       /**< Read position (consumer)    */
+    std::atomic<bool>       m_closed;     /**< Owner thread has exited     */
+
+    /** Record size in ring */
+    static size_t record_size(size_t length) {
+        return (sizeof(log_record) + length + 7) & ~(size_t)7;
+    }
+
+    /** Copy data to ring */
+    void put(uint64_t pos, const void * data, size_t size) {
+        const size_t off   = pos % capacity;
+        const size_t first = std::min(size, capacity - off);
+        ::memcpy(m_data.get() + off, data, first);
+        ::memcpy(m_data.get(), (const char *)data + first, size - first);
+    }
+
+    /** Copy data from ring */
+    void get(uint64_t pos, void * data, size_t size) const {
+        const size_t off   = pos % capacity;
+        const size_t first = std::min(size, capacity - off);
+        ::memcpy(data, m_data.get() + off, first);
+        ::memcpy((char *)data + first, m_data.get(), size - first);
+    }
+
+    public:
+
+    /** Maximal record text length */
+    static const size_t max_length = capacity / 4;
+
+    log_ring(uint32_t thread):
+        m_data(new char[capacity]),
+        m_thread(thread),
+        m_head(0),
+        m_tail(0),
+        m_closed(false)
+    {}
+
+    /** Owner thread number */
+    uint32_t thread() const { return m_thread; }
+
+    /**
+     *  \brief  Push record (producer)
+     *
+     *  \param  level  Level
+     *  \param  text   Text (at most \ref max_length)
+     *  \param  fill   Ring fill after push [B]
+     *
+     *  \return \c true iff pushed (\c false means the ring is full)
+     */
+    bool push(uint32_t level, const std::string & text, size_t & fill) {
+        const size_t   size = record_size(text.size());
+        const uint64_t head = m_head.load(std::memory_order_relaxed);
+        const uint64_t tail = m_tail.load(std::memory_order_acquire);
+        if (capacity - (head - tail) < size) return false;
+
+        const log_record rec = {
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count(),
+            m_thread, level, (uint32_t)text.size(), 0
+        };
+        put(head, &rec, sizeof(rec));
+        put(head + sizeof(rec), text.data(), text.size());
+        m_head.store(head + size, std::memory_order_release);
+
+        fill = head + size - tail;
+        return true;
+    }
+
+    /**
+     *  \brief  Pop all records (consumer)
+     *
+     *  \param  fn  Record handler (\c log_record, \c std::string)
+     */
+    template <class Fn>
+    void drain(Fn fn) {
+        uint64_t       tail = m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+
+        while (tail < head) {
+            log_record rec;
+            get(tail, &rec, sizeof(rec));
+            std::string text(rec.length, '\0');
+            get(tail + sizeof(rec), &text[0], rec.length);
+            fn(rec, std::move(text));
+            tail += record_size(rec.length);
+        }
+
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    /** Mark owner thread exited */
+    void close() { m_closed.store(true, std::memory_order_release); }
+
+    /** Owner thread exited */
+    bool closed() const { return m_closed.load(std::memory_order_acquire); }
+
+};  // end of class log_ring
+
+
+/**
+ *  \brief  Logging backend
+ *
+ *  Keeps registry of per-thread rings and runs the drainer.
+ *  The instance is never destroyed (threads may log during process exit);
+ *  it's shut down (and flushed) by an \c atexit handler instead.
+ */
+class log_backend {
+    private:
+
+    /** Drained record */
+    struct entry {
+        log_record  rec;   /**< Record header */
+        std::string text;  /**< Record text   */
+    };  // end of struct entry
+
+    std::mutex                 m_mutex;       /**< Registry mutex        */
+    std::condition_variable    m_wakeup;      /**< Drainer wake-up       */
+    std::vector<log_ring *>    m_rings;       /**< Per-thread rings      */
+    uint32_t                   m_thread_cnt;  /**< Threads registered    */
+    bool                       m_stop;        /**< Drainer stop flag     */
+    std::atomic<bool>          m_running;     /**< Drainer runs          */
+    std::mutex                 m_drain_mx;    /**< Single drain at time  */
+    std::vector<entry>         m_batch;       /**< Drained batch         */
+    std::string                m_out;         /**< Formatted batch       */
+    int64_t                    m_second;      /**< Cached time second    */
+    char                       m_hms[16];     /**< Cached \c HH:MM:SS    */
+    const ::pid_t              m_pid;         /**< Drainer process       */
+    std::thread                m_drainer;     /**< Drainer thread        */
+
+    /** Drainer period [ms] */
+    static const unsigned period = 20;
+
+    log_backend():
+        m_thread_cnt(0),
+        m_stop(false),
+        m_running(true),
+        m_second(-1),
+        m_pid(::getpid())
+    {
+        m_drainer = std::thread(&log_backend::run, this);
+        std::atexit(&log_backend::at_exit);
+    }
+
+    static void at_exit() { instance().shutdown(); }
+
+    /** Write data to \c stderr */
+    static void write_out(const char * data, size_t size) {
+        while (size) {
+            const ssize_t w = ::write(2, data, size);
+            if (w < 0) {
+                if (EINTR == errno) continue;
+                return;  // nothing sensible to do
+            }
+            data += w; size -= (size_t)w;
+        }
+    }
+
+    /** Format record to output */
+    void format(const log_record & rec, const std::string & text) {
+        const int64_t sec = rec.timestamp / 1000000;
+        if (sec != m_second) {
+            const time_t t = (time_t)sec;
+            struct tm tm;
+            ::localtime_r(&t, &tm);
+            ::strftime(m_hms, sizeof(m_hms), "%H:%M:%S", &tm);
+            m_second = sec;
+        }
+
+        char prefix[64];
+        const int len = ::snprintf(prefix, sizeof(prefix), "%s.%06u T%u %c ",
+            m_hms, (unsigned)(rec.timestamp % 1000000), rec.thread,
+            log_line::ERROR == rec.level ? 'E' : 'V');
+
+        m_out.append(prefix, len);
+        m_out.append(text);
+        m_out.push_back('\n');
+    }
+
+    /** Drain all rings and write the batch */
+    void drain() {
+        std::lock_guard<std::mutex> drain_lock(m_drain_mx);
+
+        std::vector<log_ring *> rings;
+        std::vector<bool>       closed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            rings = m_rings;
+        }
+
+        // Closed flag is checked first, so the ring is empty after drain
+        for (auto ring: rings) {
+            closed.push_back(ring->closed());
+            ring->drain([this](const log_record & rec, std::string && text) {
+                m_batch.push_back(entry{rec, std::move(text)});
+            });
+        }
+
+        if (!m_batch.empty()) {
+            std::stable_sort(m_batch.begin(), m_batch.end(),
+            [](const entry & e1, const entry & e2) {
+                return e1.rec.timestamp < e2.rec.timestamp;
+            });
+
+            for (const auto & e: m_batch) format(e.rec, e.text);
+            write_out(m_out.data(), m_out.size());
+
+            m_batch.clear();
+            m_out.clear();
+        }
+
+        // Release rings of exited threads
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < rings.size(); ++i) {
+            if (!closed[i]) continue;
+            m_rings.erase(std::find(m_rings.begin(), m_rings.end(), rings[i]));
+            delete rings[i];
+        }
+    }
+
+    /** Drainer routine */
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop) {
+            m_wakeup.wait_for(lock, std::chrono::milliseconds(period));
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    public:
+
+    /** Backend instance */
+    static log_backend & instance() {
+        static log_backend * backend = new log_backend;
+        return *backend;
+    }
+
+    /** Register calling thread */
+    log_ring * attach() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(new log_ring(++m_thread_cnt));
+        return m_rings.back();
+    }
+
+    /** Commit record */
+    void commit(log_ring * ring, uint32_t level, const std::string & text) {
+        size_t fill;
+        while (m_running.load(std::memory_order_acquire)) {
+            if (ring->push(level, text, fill)) {
+                if (fill > log_ring::capacity / 2) m_wakeup.notify_one();
+                return;
+            }
+
+            m_wakeup.notify_one();  // ring is full
+            std::this_thread::yield();
+        }
+
+        // Backend shut down, write synchronously
+        std::lock_guard<std::mutex> drain_lock(m_drain_mx);
+        const log_record rec = {
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count(),
+            ring->thread(), level, (uint32_t)text.size(), 0
+        };
+        format(rec, text);
+        write_out(m_out.data(), m_out.size());
+        m_out.clear();
+    }
+
+    /** Write out records committed so far */
+    void flush() { drain(); }
+
+    /** Stop drainer and flush */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) return;
+            m_stop = true;
+        }
+        m_wakeup.notify_one();
+
+        // Forked child doesn't have the drainer (the instance is leaked)
+        if (::getpid() == m_pid) m_drainer.join();
+
+        m_running.store(false, std::memory_order_release);
+        drain();
+    }
+
+};  // end of class log_backend
+
+
+/** Thread logging state */
+struct thread_log {
+    log_ring * ring;    /**< Thread ring (attached lazily) */
+    log_stream stream;  /**< Record text stream            */
+    unsigned   depth;   /**< Records being built           */
+
+    thread_log(): ring(nullptr), depth(0) {}
+
+    ~thread_log() { if (ring) ring->close(); }
+
+};  // end of struct thread_log
+
+thread_local thread_log t_log;
+
+}  // end of anonymous namespace
+
+
+// log_line members
+
+std::ostream & log_line::begin() {
+    if (t_log.depth++) {  // record built while building another one
+        m_nested.reset(new log_stream);
+        return *m_nested;
+    }
+
+    t_log.stream.reset();
+    return t_log.stream;
+}
+
+
+log_line::log_line(level_t level): m_level(level), m_stream(begin()) {}
+
+
+log_line::~log_line() {
+    std::string & text = m_nested ? m_nested->text() : t_log.stream.text();
+    while (!text.empty() && '\n' == text.back()) text.pop_back();
+    if (text.size() > log_ring::max_length) text.resize(log_ring::max_length);
+
+    auto & backend = log_backend::instance();
+    if (!t_log.ring) t_log.ring = backend.attach();
+    backend.commit(t_log.ring, m_level, text);
+
+    --t_log.depth;
+}
+
+
+void log_flush() { log_backend::instance().flush(); }
+
+}  // end of namespace fastcrawl
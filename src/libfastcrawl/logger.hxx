@@ -41,11 +41,26 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <iostream>
+#include <ostream>
+#include <memory>
+
+
+/**
+ *  \brief  Compile-time log level
+ *
+ *  Log statements above the level are removed by the compiler entirely:
+ *  \c -1 disables logging, \c 0 keeps \ref LOG only and \c 1 (default)
+ *  keeps \ref VLOG as well.
+ */
+#ifndef FASTCRAWL_LOG_LEVEL
+#define FASTCRAWL_LOG_LEVEL 1
+#endif
 
 
 /** Log stream for \ref logger instances (log always level) */
-#define LOG std::cerr
+#define LOG \
+    if (FASTCRAWL_LOG_LEVEL < 0); \
+    else fastcrawl::log_line(fastcrawl::log_line::ERROR).stream()
 
 
 /**
@@ -53,11 +68,77 @@
  *
  *  Using this macro, logging will only be done if verbose level is set.
  */
-#define VLOG if (!m_vlog); else std::cerr
+#define VLOG \
+    if (FASTCRAWL_LOG_LEVEL < 1 || !m_vlog); \
+    else fastcrawl::log_line(fastcrawl::log_line::VERBOSE).stream()
 
 
 namespace fastcrawl {
 
+class log_stream;  // forward, see logger.cxx
+
+
+/**
+ *  \brief  Log record builder
+ *
+ *  The record text is streamed to a thread-local buffer; on destruction,
+ *  the record (timestamp, thread, level and text) is committed to
+ *  the calling thread's lock-free ring.
+ *  A background drainer writes the records to \c stderr in batches,
+ *  ordered by timestamp.
+ *  The trailing new line (e.g. \c std::endl) is optional.
+ *
+ *  Should the ring get full, the committing thread waits for the drainer.
+ *  After process exit starts, records are written synchronously.
+ */
+class log_line {
+    public:
+
+    /** Log level */
+    enum level_t {
+        ERROR = 0,  /**< Log always  */
+        VERBOSE,    /**< Verbose log */
+    };  // end of enum level_t
+
+    private:
+
+    const level_t               m_level;   /**< Record level                */
+    std::unique_ptr<log_stream> m_nested;  /**< Own stream (nested records) */
+    std::ostream &              m_stream;  /**< Record text stream          */
+
+    /** Get record stream */
+    std::ostream & begin();
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  level  Record level
+     */
+    log_line(level_t level);
+
+    log_line(const log_line & ) = delete;
+    log_line & operator = (const log_line & ) = delete;
+
+    /** Record text stream */
+    std::ostream & stream() { return m_stream; }
+
+    /** Commit the record */
+    ~log_line();
+
+};  // end of class log_line
+
+
+/**
+ *  \brief  Write out all committed log records
+ *
+ *  Blocks until records committed so far (by any thread) are written.
+ *  Useful before writing to \c stderr directly.
+ */
+void log_flush();
+
+
 /**
  *  \brief  Simple logger
  *
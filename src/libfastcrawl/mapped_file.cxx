@@ -0,0 +1,100 @@
+/**
+ *  \file
+ *  \brief  Memory-mapped file
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mapped_file.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+}
+
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+
+namespace fastcrawl {
+
+mapped_file::mapped_file(const std::string & filename):
+    m_data(nullptr),
+    m_size(0)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("failed to open " + filename + ": " +
+            std::strerror(errno));
+
+    struct ::stat st;
+    if (::fstat(fd, &st)) {
+        const int err = errno;
+        ::close(fd);
+        throw std::runtime_error("failed to stat " + filename + ": " +
+            std::strerror(err));
+    }
+
+    m_size = st.st_size;
+
+    if (m_size) {  // empty files can't be mapped
+        void * addr = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE, fd, 0);
+
+        if (MAP_FAILED == addr) {
+            const int err = errno;
+            ::close(fd);
+            throw std::runtime_error("failed to map " + filename + ": " +
+                std::strerror(err));
+        }
+
+        m_data = (unsigned char *)addr;
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+
+    ::close(fd);  // the mapping keeps the file
+}
+
+
+mapped_file::~mapped_file() {
+    if (m_data) ::munmap(m_data, m_size);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,96 @@
+#ifndef fastcrawl__mapped_file_hxx
+#define fastcrawl__mapped_file_hxx
+
+/**
+ *  \file
+ *  \brief  Memory-mapped file
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Memory-mapped file
+ *
+ *  Maps a file (privately, copy-on-write) to memory, so that it may be
+ *  fed to online data processors without copying.
+ *  The mapping is released upon destruction.
+ */
+class mapped_file {
+    private:
+
+    unsigned char * m_data;  /**< Mapped data */
+    size_t          m_size;  /**< Data size   */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  filename  File name
+     *
+     *  \throw  std::runtime_error if the file can't be mapped
+     */
+    mapped_file(const std::string & filename);
+
+    mapped_file(const mapped_file & ) = delete;
+    mapped_file & operator = (const mapped_file & ) = delete;
+
+    /** Move constructor */
+    mapped_file(mapped_file && orig): m_data(orig.m_data), m_size(orig.m_size) {
+        orig.m_data = nullptr;
+        orig.m_size = 0;
+    }
+
+    /** Mapped data */
+    unsigned char * data() const { return m_data; }
+
+    /** Data size */
+    size_t size() const { return m_size; }
+
+    /** Destructor (unmaps the file) */
+    ~mapped_file();
+
+};  // end of class mapped_file
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__mapped_file_hxx
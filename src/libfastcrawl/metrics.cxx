@@ -0,0 +1,126 @@
+/**
+ *  \file
+ *  \brief  Crawl metrics
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics.hxx"
+
+
+namespace fastcrawl {
+
+metrics & metrics::global() {
+    static metrics instance;
+    return instance;
+}
+
+
+metrics::snapshot metrics::values() const {
+    snapshot values;
+
+    values.bytes_received    = bytes_received.value();
+    values.bytes_transferred = bytes_transferred.value();
+    values.bytes_parsed      = bytes_parsed.value();
+    values.references        = references.value();
+    values.completed         = completed.value();
+    values.failed            = failed.value();
+    values.skipped           = skipped.value();
+    values.retries           = retries.value();
+    values.hedged            = hedged.value();
+    values.short_circuited   = short_circuited.value();
+    values.in_flight         = in_flight.value();
+    values.queue_depth       = queue_depth.value();
+    values.pool_size         = pool_size.value();
+    values.busy_threads      = busy_threads.value();
+
+    return values;
+}
+
+
+/** Write Prometheus metric */
+template <typename T>
+static void metric(
+    std::ostream & out,
+    const char *   name,
+    const char *   type,
+    const char *   help,
+    T              value)
+{
+    out << "# HELP fastcrawl_" << name << ' ' << help << '\n'
+        << "# TYPE fastcrawl_" << name << ' ' << type << '\n'
+        << "fastcrawl_" << name << ' ' << value << '\n';
+}
+
+
+void metrics::prometheus(std::ostream & out, const snapshot & values) {
+    const auto out_flags = out.flags();
+    out << std::dec;
+
+    metric(out, "bytes_received_total", "counter",
+        "Content bytes received.", values.bytes_received);
+    metric(out, "bytes_transferred_total", "counter",
+        "Content bytes transferred (before content decoding).",
+        values.bytes_transferred);
+    metric(out, "bytes_parsed_total", "counter",
+        "HTML bytes parsed.", values.bytes_parsed);
+    metric(out, "references_total", "counter",
+        "Content references found.", values.references);
+    metric(out, "downloads_completed_total", "counter",
+        "Downloads completed.", values.completed);
+    metric(out, "downloads_failed_total", "counter",
+        "Downloads failed.", values.failed);
+    metric(out, "downloads_skipped_total", "counter",
+        "Downloads skipped (content not admitted).", values.skipped);
+    metric(out, "download_retries_total", "counter",
+        "Download retries.", values.retries);
+    metric(out, "downloads_hedged_total", "counter",
+        "Hedged (duplicate) requests.", values.hedged);
+    metric(out, "downloads_short_circuited_total", "counter",
+        "Downloads failed fast (host circuit open).", values.short_circuited);
+    metric(out, "downloads_in_flight", "gauge",
+        "Transfers in progress.", values.in_flight);
+    metric(out, "download_queue_depth", "gauge",
+        "Queued download jobs.", values.queue_depth);
+    metric(out, "download_threads", "gauge",
+        "Download threads.", values.pool_size);
+    metric(out, "download_threads_busy", "gauge",
+        "Busy download threads.", values.busy_threads);
+
+    out.flags(out_flags);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,174 @@
+#ifndef fastcrawl__metrics_hxx
+#define fastcrawl__metrics_hxx
+
+/**
+ *  \file
+ *  \brief  Crawl metrics
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Crawl metrics
+ *
+ *  Lock-free counters and gauges updated by the library as it runs.
+ *  Updates are single relaxed atomic operations (each metric has its own
+ *  cache line, so updates of different metrics don't contend).
+ *
+ *  The library updates the \ref global instance.
+ *  Values are read by taking a \ref snapshot (e.g. periodically,
+ *  see \ref metrics_reporter and \ref metrics_server).
+ *  The snapshot is not atomic as a whole (the metrics are read one by one).
+ */
+class metrics {
+    public:
+
+    /** Monotonic counter */
+    class alignas(64) counter {
+        private:
+
+        std::atomic<uint64_t> m_value;  /**< Counter value */
+
+        public:
+
+        counter(): m_value(0) {}
+
+        /** Increment */
+        void add(uint64_t n = 1) {
+            m_value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        /** Value */
+        uint64_t value() const {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    };  // end of class counter
+
+    /** Gauge (current value) */
+    class alignas(64) gauge {
+        private:
+
+        std::atomic<int64_t> m_value;  /**< Gauge value */
+
+        public:
+
+        gauge(): m_value(0) {}
+
+        /** Increment */
+        void add(int64_t n = 1) {
+            m_value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        /** Decrement */
+        void sub(int64_t n = 1) {
+            m_value.fetch_sub(n, std::memory_order_relaxed);
+        }
+
+        /** Set value */
+        void set(int64_t value) {
+            m_value.store(value, std::memory_order_relaxed);
+        }
+
+        /** Value */
+        int64_t value() const {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    };  // end of class gauge
+
+    /** Metrics values */
+    struct snapshot {
+        uint64_t bytes_received;    /**< Content bytes received     */
+        uint64_t bytes_transferred; /**< Content bytes on the wire  */
+        uint64_t bytes_parsed;      /**< HTML bytes parsed          */
+        uint64_t references;        /**< Content references found   */
+        uint64_t completed;         /**< Downloads completed        */
+        uint64_t failed;            /**< Downloads failed           */
+        uint64_t skipped;           /**< Downloads skipped          */
+        uint64_t retries;           /**< Download retries           */
+        uint64_t hedged;            /**< Hedged requests            */
+        uint64_t short_circuited;   /**< Downloads failed fast      */
+        int64_t  in_flight;         /**< Transfers in progress      */
+        int64_t  queue_depth;       /**< Queued download jobs       */
+        int64_t  pool_size;         /**< Download threads           */
+        int64_t  busy_threads;      /**< Busy download threads      */
+
+    };  // end of struct snapshot
+
+    counter bytes_received;     /**< Content bytes received     */
+    counter bytes_transferred;  /**< Content bytes on the wire  */
+    counter bytes_parsed;       /**< HTML bytes parsed          */
+    counter references;         /**< Content references found   */
+    counter completed;          /**< Downloads completed        */
+    counter failed;             /**< Downloads failed           */
+    counter skipped;            /**< Downloads skipped          */
+    counter retries;            /**< Download retries           */
+    counter hedged;             /**< Hedged requests            */
+    counter short_circuited;    /**< Downloads failed fast      */
+    gauge   in_flight;          /**< Transfers in progress      */
+    gauge   queue_depth;        /**< Queued download jobs       */
+    gauge   pool_size;          /**< Download threads           */
+    gauge   busy_threads;       /**< Busy download threads      */
+
+    /** Global metrics (updated by the library) */
+    static metrics & global();
+
+    /** Take snapshot */
+    snapshot values() const;
+
+    /**
+     *  \brief  Write metrics in Prometheus text exposition format
+     *
+     *  See https://prometheus.io/docs/instrumenting/exposition_formats/
+     *
+     *  \param  out     Output stream
+     *  \param  values  Metrics values
+     */
+    static void prometheus(std::ostream & out, const snapshot & values);
+
+};  // end of class metrics
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__metrics_hxx
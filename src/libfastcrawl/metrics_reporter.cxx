@@ -0,0 +1,149 @@
+/**
+ *  \file
+ *  \brief  Periodic metrics reporter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics_reporter.hxx"
+
+#include <sstream>
+#include <iomanip>
+
+
+namespace fastcrawl {
+
+metrics_reporter::metrics_reporter(
+    duration          interval,
+    std::ostream &    out,
+    const sampler_t & sample,
+    const metrics &   metrics_)
+:
+    m_interval(interval),
+    m_out(out),
+    m_sample(sample),
+    m_metrics(metrics_),
+    m_stop(false),
+    m_thread(&metrics_reporter::routine, this)
+{}
+
+
+void metrics_reporter::routine() {
+    const auto start = std::chrono::steady_clock::now();
+
+    auto last = start;
+    if (m_sample) m_sample();
+    auto prev = m_metrics.values();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop_cond.wait_for(lock, m_interval, [this]() { return m_stop; })) {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (m_sample) m_sample();
+        const auto values = m_metrics.values();
+
+        const std::chrono::duration<double> period  = now - last;
+        const std::chrono::duration<double> elapsed = now - start;
+
+        // Format the line first, so that it's written at once
+        std::stringstream ss;
+        line(ss, values, prev, period.count(), elapsed.count());
+        m_out << ss.str() << std::flush;
+
+        last = now;
+        prev = values;
+    }
+}
+
+
+/** Write byte amount (in human-readable units) */
+static void bytes(std::ostream & out, double amount) {
+    static const char * const units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+
+    size_t unit = 0;
+    for (; amount >= 1024 && unit < 4; ++unit) amount /= 1024;
+
+    out << amount << ' ' << units[unit];
+}
+
+
+void metrics_reporter::line(
+    std::ostream &            out,
+    const metrics::snapshot & values,
+    const metrics::snapshot & prev,
+    double                    period,
+    double                    elapsed)
+{
+    const auto out_flags = out.flags();
+    const auto out_precision = out.precision();
+
+    const double rate = period > 0 ? 1 / period : 0;
+
+    out << std::fixed << std::setprecision(1)
+        << "Stats " << elapsed << " s: received ";
+    bytes(out, values.bytes_received);
+    out << " (";
+    bytes(out, (values.bytes_received - prev.bytes_received) * rate);
+    out << "/s), parsed ";
+    bytes(out, values.bytes_parsed);
+    out << " (";
+    bytes(out, (values.bytes_parsed - prev.bytes_parsed) * rate);
+    out << "/s), refs " << values.references
+        << ", done " << values.completed
+        << " (" << (values.completed - prev.completed) * rate << "/s)"
+        << ", failed " << values.failed
+        << ", skipped " << values.skipped
+        << ", in-flight " << values.in_flight
+        << ", queued " << values.queue_depth
+        << ", threads " << values.busy_threads << '/' << values.pool_size
+        << " busy" << std::endl;
+
+    out.flags(out_flags);
+    out.precision(out_precision);
+}
+
+
+metrics_reporter::~metrics_reporter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_stop_cond.notify_one();
+    m_thread.join();
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,127 @@
+#ifndef fastcrawl__metrics_reporter_hxx
+#define fastcrawl__metrics_reporter_hxx
+
+/**
+ *  \file
+ *  \brief  Periodic metrics reporter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics.hxx"
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <iostream>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Periodic metrics reporter
+ *
+ *  Writes a stats line (counters with rates since the previous line,
+ *  and gauges) periodically, by a background thread.
+ *  The reporting starts upon construction and stops upon destruction.
+ */
+class metrics_reporter {
+    public:
+
+    /** Sampler (updates sampled gauges before a snapshot is taken) */
+    using sampler_t = std::function<void ()>;
+
+    using duration = std::chrono::steady_clock::duration;  /**< Duration */
+
+    private:
+
+    const duration          m_interval;     /**< Reporting interval     */
+    std::ostream &          m_out;          /**< Output stream          */
+    const sampler_t         m_sample;       /**< Gauges sampler         */
+    const metrics &         m_metrics;      /**< Reported metrics       */
+    bool                    m_stop;         /**< Stop flag              */
+    std::mutex              m_mutex;        /**< Stop flag mutex        */
+    std::condition_variable m_stop_cond;    /**< Stop condition         */
+    std::thread             m_thread;       /**< Reporting thread       */
+
+    /** Reporting thread routine */
+    void routine();
+
+    public:
+
+    /**
+     *  \brief  Constructor (starts reporting)
+     *
+     *  \param  interval  Reporting interval
+     *  \param  out       Output stream
+     *  \param  sample    Gauges sampler (optional)
+     *  \param  metrics_  Reported metrics
+     */
+    metrics_reporter(
+        duration          interval,
+        std::ostream &    out      = std::cerr,
+        const sampler_t & sample   = sampler_t(),
+        const metrics &   metrics_ = metrics::global());
+
+    metrics_reporter(const metrics_reporter & ) = delete;
+    metrics_reporter & operator = (const metrics_reporter & ) = delete;
+
+    /**
+     *  \brief  Write stats line
+     *
+     *  \param  out      Output stream
+     *  \param  values   Current metrics values
+     *  \param  prev     Previous metrics values (for rates)
+     *  \param  period   Time since the previous values [s]
+     *  \param  elapsed  Time since start [s]
+     */
+    static void line(
+        std::ostream &            out,
+        const metrics::snapshot & values,
+        const metrics::snapshot & prev,
+        double                    period,
+        double                    elapsed);
+
+    /** Destructor (stops reporting) */
+    ~metrics_reporter();
+
+};  // end of class metrics_reporter
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__metrics_reporter_hxx
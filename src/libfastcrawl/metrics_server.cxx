@@ -0,0 +1,213 @@
+/**
+ *  \file
+ *  \brief  Metrics HTTP endpoint
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics_server.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+}
+
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+
+namespace fastcrawl {
+
+/** Throw system error */
+[[noreturn]] static void error(const std::string & what) {
+    throw std::runtime_error("metrics server: " + what + ": " + std::strerror(errno));
+}
+
+
+metrics_server::metrics_server(
+    uint16_t          port,
+    const sampler_t & sample,
+    const metrics &   metrics_)
+:
+    m_sample(sample),
+    m_metrics(metrics_),
+    m_listen_fd(-1),
+    m_stop_fd{-1, -1},
+    m_port(port)
+{
+    try {
+        if (::pipe(m_stop_fd)) error("pipe");
+
+        m_listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (m_listen_fd < 0) error("socket");
+
+        const int reuse = 1;
+        ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        struct ::sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::bind(m_listen_fd, (struct ::sockaddr *)&addr, sizeof(addr)))
+            error("bind to port " + std::to_string(port));
+
+        if (::listen(m_listen_fd, 16)) error("listen");
+
+        // Actual port
+        ::socklen_t addr_len = sizeof(addr);
+        if (::getsockname(m_listen_fd, (struct ::sockaddr *)&addr, &addr_len))
+            error("getsockname");
+
+        m_port = ntohs(addr.sin_port);
+
+        m_thread = std::thread(&metrics_server::routine, this);
+    }
+    catch (...) {
+        close();
+        throw;
+    }
+}
+
+
+void metrics_server::routine() {
+    struct ::pollfd fds[2];
+    fds[0].fd = m_listen_fd;  fds[0].events = POLLIN;
+    fds[1].fd = m_stop_fd[0]; fds[1].events = POLLIN;
+
+    for (;;) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (EINTR == errno) continue;
+            break;
+        }
+
+        if (fds[1].revents) break;  // stop
+
+        if (fds[0].revents & POLLIN) {
+            const int fd = ::accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+
+            serve(fd);
+            ::close(fd);
+        }
+    }
+}
+
+
+void metrics_server::serve(int fd) {
+    // Don't let a stuck client block the server
+    struct ::timeval timeout = { 1, 0 };
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Read request head
+    std::string request;
+    char buffer[1024];
+    while (std::string::npos == request.find("\r\n\r\n")) {
+        const ssize_t len = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (len <= 0) return;
+
+        request.append(buffer, len);
+        if (request.size() > 8192) return;  // nonsense
+    }
+
+    std::stringstream response;
+    const bool found =
+        0 == request.compare(0, 13, "GET /metrics ") ||
+        0 == request.compare(0, 6,  "GET / ");
+
+    if (found) {
+        if (m_sample) m_sample();
+
+        std::stringstream body;
+        metrics::prometheus(body, m_metrics.values());
+        const std::string content = body.str();
+
+        response
+            << "HTTP/1.1 200 OK\r\n"
+            << "Content-Type: text/plain; version=0.0.4\r\n"
+            << "Content-Length: " << content.size() << "\r\n"
+            << "Connection: close\r\n"
+            << "\r\n"
+            << content;
+    }
+    else {
+        response
+            << "HTTP/1.1 404 Not Found\r\n"
+            << "Content-Length: 0\r\n"
+            << "Connection: close\r\n"
+            << "\r\n";
+    }
+
+    const std::string data = response.str();
+    for (size_t sent = 0; sent < data.size(); ) {
+        const ssize_t len = ::send(fd, data.data() + sent, data.size() - sent,
+            MSG_NOSIGNAL);
+        if (len <= 0) return;
+
+        sent += len;
+    }
+}
+
+
+void metrics_server::close() {
+    if (m_listen_fd >= 0) ::close(m_listen_fd);
+    if (m_stop_fd[0] >= 0) ::close(m_stop_fd[0]);
+    if (m_stop_fd[1] >= 0) ::close(m_stop_fd[1]);
+
+    m_listen_fd = m_stop_fd[0] = m_stop_fd[1] = -1;
+}
+
+
+metrics_server::~metrics_server() {
+    if (m_thread.joinable()) {
+        const char stop = 0;
+        if (::write(m_stop_fd[1], &stop, 1) < 0) {}  // can't fail (pipe is empty)
+        m_thread.join();
+    }
+
+    close();
+}
+
+}  // end of namespace fastcrawl
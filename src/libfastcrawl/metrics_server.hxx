@@ -0,0 +1,115 @@
+#ifndef fastcrawl__metrics_server_hxx
+#define fastcrawl__metrics_server_hxx
+
+/**
+ *  \file
+ *  \brief  Metrics HTTP endpoint
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics.hxx"
+
+#include <functional>
+#include <thread>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Metrics HTTP endpoint
+ *
+ *  Minimal HTTP server (on the loopback interface) providing
+ *  the metrics in Prometheus text format on \c GET \c /metrics.
+ *  Requests are served one by one by a background thread; the server
+ *  is meant for periodic scraping, not for load.
+ *  The server runs from construction till destruction.
+ */
+class metrics_server {
+    public:
+
+    /** Sampler (updates sampled gauges before a snapshot is taken) */
+    using sampler_t = std::function<void ()>;
+
+    private:
+
+    const sampler_t m_sample;       /**< Gauges sampler             */
+    const metrics & m_metrics;      /**< Served metrics             */
+    int             m_listen_fd;    /**< Listening socket           */
+    int             m_stop_fd[2];   /**< Stop pipe (read, write)    */
+    uint16_t        m_port;         /**< Listening port             */
+    std::thread     m_thread;       /**< Server thread              */
+
+    /** Server thread routine */
+    void routine();
+
+    /** Serve connection */
+    void serve(int fd);
+
+    /** Release resources */
+    void close();
+
+    public:
+
+    /**
+     *  \brief  Constructor (starts the server)
+     *
+     *  \param  port      Listening port (0 means any free port)
+     *  \param  sample    Gauges sampler (optional)
+     *  \param  metrics_  Served metrics
+     *
+     *  \throw  std::runtime_error if the server can't be started
+     */
+    metrics_server(
+        uint16_t          port,
+        const sampler_t & sample   = sampler_t(),
+        const metrics &   metrics_ = metrics::global());
+
+    metrics_server(const metrics_server & ) = delete;
+    metrics_server & operator = (const metrics_server & ) = delete;
+
+    /** Listening port */
+    uint16_t port() const { return m_port; }
+
+    /** Destructor (stops the server) */
+    ~metrics_server();
+
+};  // end of class metrics_server
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__metrics_server_hxx
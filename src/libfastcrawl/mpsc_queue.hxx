@@ -0,0 +1,142 @@
+#ifndef fastcrawl__mpsc_queue_hxx
+#define fastcrawl__mpsc_queue_hxx
+
+/**
+ *  \file
+ *  \brief  Lock-free MPSC queue
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <utility>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Lock-free MPSC queue
+ *
+ *  Unbounded multi-producer single-consumer queue (D. Vyukov's
+ *  algorithm): a producer enqueues by a single atomic exchange (so
+ *  the push is wait-free), the consumer dequeues without any atomic
+ *  read-modify-write.
+ *  The queue always holds a dummy node (the last popped one).
+ *
+ *  Note that \ref pop may see the queue empty while a push is
+ *  in progress; producers should signal the consumer after push
+ *  if it may be waiting.
+ *
+ *  \tparam  T  Item type (default-constructible, movable)
+ */
+template <typename T>
+class mpsc_queue {
+    private:
+
+    /** Queue node */
+    struct node {
+        std::atomic<node *> next;   /**< Next node */
+        T                   item;   /**< Item      */
+
+        node(): next(nullptr) {}
+
+        node(T && item_): next(nullptr), item(std::move(item_)) {}
+
+    };  // end of struct node
+
+    std::atomic<node *> m_head;     /**< Last pushed node (producers)  */
+    char                m_pad[64];  /**< False sharing guard           */
+    node *              m_tail;     /**< Dummy node (consumer)         */
+
+    public:
+
+    /** Constructor */
+    mpsc_queue(): m_tail(new node) {
+        m_head.store(m_tail, std::memory_order_relaxed);
+    }
+
+    mpsc_queue(const mpsc_queue & ) = delete;
+    mpsc_queue & operator = (const mpsc_queue & ) = delete;
+
+    /**
+     *  \brief  Push item (any thread)
+     *
+     *  \param  item  Item
+     */
+    void push(T item) {
+        auto * n    = new node(std::move(item));
+        auto * prev = m_head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    /**
+     *  \brief  Pop item (consumer only)
+     *
+     *  \param  item  Popped item
+     *
+     *  \return \c true iff an item was popped
+     */
+    bool pop(T & item) {
+        auto * next = m_tail->next.load(std::memory_order_acquire);
+        if (nullptr == next) return false;
+
+        item = std::move(next->item);  // next becomes the dummy
+
+        delete m_tail;
+        m_tail = next;
+
+        return true;
+    }
+
+    /** Queue seems empty (consumer only) */
+    bool empty() const {
+        return nullptr == m_tail->next.load(std::memory_order_acquire);
+    }
+
+    /** Destructor (drops remaining items) */
+    ~mpsc_queue() {
+        while (m_tail) {
+            auto * next = m_tail->next.load(std::memory_order_relaxed);
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+};  // end of template class mpsc_queue
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__mpsc_queue_hxx
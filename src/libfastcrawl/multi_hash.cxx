@@ -0,0 +1,122 @@
+/**
+ *  \file
+ *  \brief  Fused multi-hash online data processor
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "multi_hash.hxx"
+#include "crc32c.hxx"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace fastcrawl {
+
+unsigned content_digests::parse(const std::string & list) {
+    unsigned algorithms = 0;
+
+    std::stringstream list_ss(list);
+    std::string name;
+    while (std::getline(list_ss, name, ',')) {
+        if      ("adler32" == name) algorithms |= ADLER32;
+        else if ("crc32c"  == name) algorithms |= CRC32C;
+        else if ("xxh3"    == name) algorithms |= XXH3;
+        else if ("sha256"  == name) algorithms |= SHA256;
+        else throw std::invalid_argument("unknown digest: " + name);
+    }
+
+    return algorithms;
+}
+
+
+multi_hash::multi_hash(
+    unsigned          algorithms,
+    content_digests & result,
+    size_t            block_size)
+:
+    m_algorithms(algorithms),
+    m_block_size(block_size),
+    m_adler32(::adler32(0L, Z_NULL, 0)),
+    m_crc32c(0),
+    m_result(result)
+{
+    if (0 == m_block_size)
+        throw std::invalid_argument("multi_hash: zero block size");
+}
+
+
+void multi_hash::operator () (unsigned char * data, size_t size) {
+    while (size) {
+        const size_t block = std::min(size, m_block_size);
+
+        if (m_algorithms & content_digests::ADLER32)
+            m_adler32 = ::adler32(m_adler32, data, block);
+
+        if (m_algorithms & content_digests::CRC32C)
+            m_crc32c = crc32c::update(m_crc32c, data, block);
+
+        if (m_algorithms & content_digests::XXH3)
+            m_xxh3.update(data, block);
+
+        if (m_algorithms & content_digests::SHA256)
+            m_sha256.update(data, block);
+
+        data += block;
+        size -= block;
+    }
+}
+
+
+multi_hash::~multi_hash() {
+    m_result.algorithms = m_algorithms;
+
+    if (m_algorithms & content_digests::ADLER32)
+        m_result.adler32 = m_adler32;
+
+    if (m_algorithms & content_digests::CRC32C)
+        m_result.crc32c = m_crc32c;
+
+    if (m_algorithms & content_digests::XXH3)
+        m_result.xxh3 = m_xxh3.digest();
+
+    if (m_algorithms & content_digests::SHA256)
+        m_result.sha256 = m_sha256.digest();
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,151 @@
+#ifndef fastcrawl__multi_hash_hxx
+#define fastcrawl__multi_hash_hxx
+
+/**
+ *  \file
+ *  \brief  Fused multi-hash online data processor
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+#include "xxh3.hxx"
+#include "sha256.hxx"
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+extern "C" {
+#include <zlib.h>
+}
+
+
+namespace fastcrawl {
+
+/** Content digests (results of \ref multi_hash) */
+struct content_digests {
+    /** Digest algorithms */
+    enum algorithm {
+        ADLER32 = 1 << 0,   /**< Adler32 (Zlib)          */
+        CRC32C  = 1 << 1,   /**< CRC32C (Castagnoli)     */
+        XXH3    = 1 << 2,   /**< XXH3 64-bit             */
+        SHA256  = 1 << 3,   /**< SHA-256                 */
+    };
+
+    unsigned                    algorithms;     /**< Computed digests   */
+    uint32_t                    adler32;        /**< Adler32 checksum   */
+    uint32_t                    crc32c;         /**< CRC32C checksum    */
+    uint64_t                    xxh3;           /**< XXH3 hash          */
+    fastcrawl::sha256::digest_t sha256;         /**< SHA-256 digest     */
+
+    content_digests():
+        algorithms(0),
+        adler32(0),
+        crc32c(0),
+        xxh3(0),
+        sha256()
+    {}
+
+    /**
+     *  \brief  Parse algorithm list
+     *
+     *  The list is comma-separated, algorithm names are
+     *  \c adler32, \c crc32c, \c xxh3 and \c sha256.
+     *
+     *  \param  list  Algorithm list
+     *
+     *  \return Algorithms bit mask
+     *
+     *  \throw  std::invalid_argument on unknown algorithm
+     */
+    static unsigned parse(const std::string & list);
+
+};  // end of struct content_digests
+
+
+/**
+ *  \brief  Fused multi-hash online data processor
+ *
+ *  Computes several digests of the content in one pass.
+ *  Each data chunk is processed in cache-sized blocks; all the selected
+ *  algorithms are run on a block before moving to the next one, so that
+ *  the data is read from memory only once (further reads hit L1 cache).
+ *
+ *  This is faster than chaining the respective separate processors using
+ *  \ref compound_data_processor, which walks each chunk for every processor.
+ */
+class multi_hash: public online_data_processor {
+    public:
+
+    static const size_t default_block_size = 4096;  /**< Default block size */
+
+    private:
+
+    const unsigned      m_algorithms;   /**< Selected algorithms    */
+    const size_t        m_block_size;   /**< Processing block size  */
+    ::uLong             m_adler32;      /**< Adler32 checksum       */
+    uint32_t            m_crc32c;       /**< CRC32C checksum        */
+    xxh3::context       m_xxh3;         /**< XXH3 hash context      */
+    sha256::context     m_sha256;       /**< SHA-256 digest context */
+    content_digests &   m_result;       /**< Final result           */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  algorithms  Selected algorithms (see \ref content_digests)
+     *  \param  result      Result
+     *  \param  block_size  Processing block size
+     *
+     *  \throw  std::invalid_argument if the block size is 0
+     */
+    multi_hash(
+        unsigned          algorithms,
+        content_digests & result,
+        size_t            block_size = default_block_size);
+
+    void operator () (unsigned char * data, size_t size);
+
+    /** Destructor assigns the result */
+    ~multi_hash();
+
+};  // end of class multi_hash
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__multi_hash_hxx
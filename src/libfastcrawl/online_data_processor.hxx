@@ -41,7 +41,9 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string>
 #include <utility>
+#include <chrono>
 #include <cstddef>
 
 
@@ -66,6 +68,37 @@ class online_data_processor {
      */
     virtual void operator () (unsigned char * data, size_t size) = 0;
 
+    /**
+     *  \brief  Content type notification
+     *
+     *  Called once the (final) response head is received, before any
+     *  data chunk is provided.
+     *
+     *  \param  type  Content-Type media type (empty if not set)
+     */
+    virtual void content_type(const std::string & type) {}
+
+    /**
+     *  \brief  Backpressure check
+     *
+     *  While the processor is congested, the download is paused (no data
+     *  chunks are provided) and resumed as soon as it's not.
+     *
+     *  \return \c true iff the processor is congested
+     */
+    virtual bool congested() const { return false; }
+
+    /**
+     *  \brief  Wait till not congested
+     *
+     *  Called by blocking downloads on backpressure.
+     *
+     *  \param  timeout  Max. wait time
+     *
+     *  \return \c true iff the processor isn't congested
+     */
+    virtual bool wait_ready(std::chrono::milliseconds timeout) const { return true; }
+
     virtual ~online_data_processor() {}
 
 };  // end of class online_data_processor
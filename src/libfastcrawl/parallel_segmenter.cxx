@@ -0,0 +1,199 @@
+/**
+ *  \file
+ *  \brief  Parallel HTML segmenter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "parallel_segmenter.hxx"
+#include "html_segmenter.hxx"
+
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+
+
+namespace fastcrawl {
+
+/** Found reference */
+struct segmenter_reference {
+    std::string element;    /**< Element name    */
+    std::string attribute;  /**< Attribute name  */
+    std::string value;      /**< Attribute value */
+    size_t      line;       /**< Value line      */
+    size_t      column;     /**< Value column    */
+
+};  // end of struct segmenter_reference
+
+
+/** Chunk segmenter sink (collects the references) */
+struct segmenter_sink {
+    std::vector<segmenter_reference> * refs;  /**< Found references */
+
+    void operator () (
+        const std::string & element,
+        const std::string & attribute,
+        const std::string & value,
+        size_t              line,
+        size_t              column) const
+    {
+        refs->push_back(segmenter_reference{
+            element, attribute, value, line, column});
+    }
+
+};  // end of struct segmenter_sink
+
+
+/** Document chunk */
+struct segmenter_chunk {
+    using segmenter_t = html_segmenter<segmenter_sink>;
+
+    size_t                              doc;        /**< Document index     */
+    unsigned char *                     data;       /**< Chunk data         */
+    size_t                              size;       /**< Chunk size         */
+    std::unique_ptr<segmenter_t>        crawler;    /**< Chunk segmenter    */
+    std::vector<segmenter_reference>    refs;       /**< Found references   */
+
+    /** Segment (more) data by the chunk segmenter */
+    void segment(unsigned char * data_, size_t size_) {
+        // Relative positions (the chunk is in place when segmented)
+        if (!crawler) crawler.reset(new segmenter_t(segmenter_sink{&refs}));
+
+        (*crawler)(data_, size_);
+    }
+
+};  // end of struct segmenter_chunk
+
+
+void parallel_segmenter::operator () (
+    const std::vector<document> & docs,
+    const callback_t &            callback)
+{
+    // Split documents to chunks (each starting with '<')
+    std::vector<segmenter_chunk> chunks;
+    for (size_t d = 0; d < docs.size(); ++d) {
+        unsigned char * data = docs[d].data;
+        unsigned char * end  = data + docs[d].size;
+
+        while (data < end) {
+            unsigned char * next = end;
+            if ((size_t)(end - data) >= 2 * m_chunk_size) {
+                auto * lt = std::memchr(data + m_chunk_size, '<',
+                    end - data - m_chunk_size);
+
+                if (nullptr != lt) next = (unsigned char *)lt;
+            }
+
+            chunks.emplace_back();
+            chunks.back().doc  = d;
+            chunks.back().data = data;
+            chunks.back().size = next - data;
+
+            data = next;
+        }
+    }
+
+    m_chunks += chunks.size();
+
+    // Segment chunks in parallel (speculatively)
+    std::mutex              mutex;
+    std::condition_variable done_cond;
+    size_t                  remaining = chunks.size();
+
+    for (auto & chunk: chunks) {
+        auto segment = [&chunk, &mutex, &done_cond, &remaining]() {
+            chunk.segment(chunk.data, chunk.size);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (0 == --remaining) done_cond.notify_one();
+        };
+
+        if (!m_pool.run(segment)) segment();  // pool shut down
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cond.wait(lock, [&remaining]() { return 0 == remaining; });
+    }
+
+    // Check seams, fix positions & report references
+    size_t line   = 1;  // current document position (of chunk group start)
+    size_t column = 0;
+
+    auto report = [&callback, &line, &column](segmenter_chunk & group) {
+        for (auto & ref: group.refs)
+            callback(group.doc, ref.element, ref.attribute, ref.value,
+                line + ref.line - 1,
+                1 == ref.line ? column + ref.column : ref.column);
+
+        // Next chunk group position
+        if (1 == group.crawler->line())
+            column += group.crawler->column();
+        else {
+            line  += group.crawler->line() - 1;
+            column = group.crawler->column();
+        }
+    };
+
+    segmenter_chunk * group = nullptr;
+    for (auto & chunk: chunks) {
+        // Next document
+        if (nullptr == group || group->doc != chunk.doc) {
+            if (nullptr != group) report(*group);
+
+            line   = 1;
+            column = 0;
+            group  = &chunk;
+        }
+
+        // The speculative segmentation holds
+        else if (group->crawler->at_document_level()) {
+            report(*group);
+            group = &chunk;
+        }
+
+        // Seam fix-up: continue segmentation of the group
+        else {
+            group->segment(chunk.data, chunk.size);
+            ++m_fixups;
+        }
+    }
+
+    if (nullptr != group) report(*group);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,145 @@
+#ifndef fastcrawl__parallel_segmenter_hxx
+#define fastcrawl__parallel_segmenter_hxx
+
+/**
+ *  \file
+ *  \brief  Parallel HTML segmenter
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "work_stealing_pool.hxx"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Parallel HTML segmenter
+ *
+ *  Extracts content references from (whole, e.g. memory-mapped) HTML
+ *  documents using \ref html_segmenter instances on \ref work_stealing_pool
+ *  threads.
+ *
+ *  Large documents are split to chunks, each starting at a \c '<'
+ *  character; the chunks are segmented in parallel, speculatively
+ *  assuming that they start at the document level (outside of any tag).
+ *  At the seams, the assumption is checked: if the segmentation
+ *  of the previous chunk didn't end at the document level (e.g. the
+ *  \c '<' was within a comment or attribute value), the speculative
+ *  result is dropped and the chunk is segmented again, continuing from
+ *  the previous chunk state.
+ *  So, the result is always exactly the same as of serial segmentation.
+ *
+ *  Many (small) documents may be segmented at once, in parallel.
+ */
+class parallel_segmenter {
+    public:
+
+    /** Default chunk size */
+    static const size_t default_chunk_size = 1 << 20;
+
+    /** Document */
+    struct document {
+        unsigned char * data;   /**< Document data */
+        size_t          size;   /**< Document size */
+
+    };  // end of struct document
+
+    /**
+     *  \brief  Reference callback
+     *
+     *  Arguments: document index, element name, attribute name, attribute
+     *  value and value position (line, column).
+     */
+    using callback_t = std::function<void (
+        size_t, const std::string &, const std::string &, const std::string &,
+        size_t, size_t)>;
+
+    private:
+
+    work_stealing_pool & m_pool;        /**< Segmenting threads         */
+    const size_t         m_chunk_size;  /**< Chunk size                 */
+    size_t               m_chunks;      /**< Segmented chunks counter   */
+    size_t               m_fixups;      /**< Re-segmented chunks count  */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  pool        Segmenting threads
+     *  \param  chunk_size  Chunk size (approx., documents under twice
+     *                      the size aren't split)
+     */
+    parallel_segmenter(
+        work_stealing_pool & pool,
+        size_t               chunk_size = default_chunk_size)
+    :
+        m_pool(pool),
+        m_chunk_size(chunk_size ? chunk_size : 1),
+        m_chunks(0),
+        m_fixups(0)
+    {}
+
+    /**
+     *  \brief  Segment documents
+     *
+     *  The references are passed to the callback (from the calling thread)
+     *  in the order of documents and their positions in the documents.
+     *  Note that unlike \ref html_crawler, the segmenter doesn't filter
+     *  anything (fragment references, duplicates).
+     *
+     *  \param  docs      Documents
+     *  \param  callback  Reference callback
+     */
+    void operator () (const std::vector<document> & docs, const callback_t & callback);
+
+    /** Number of segmented chunks */
+    size_t chunks() const { return m_chunks; }
+
+    /** Number of chunks that had to be segmented again at seams */
+    size_t fixups() const { return m_fixups; }
+
+};  // end of class parallel_segmenter
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__parallel_segmenter_hxx
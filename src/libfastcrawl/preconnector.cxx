@@ -0,0 +1,184 @@
+/**
+ *  \file
+ *  \brief  Speculative host pre-resolution and preconnect
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "preconnector.hxx"
+#include "download.hxx"
+
+extern "C" {
+#include <curl/curl.h>
+}
+
+
+namespace fastcrawl {
+
+const unsigned preconnector::default_connect_timeout;
+
+
+preconnector::preconnector(void * share, mode_t mode, unsigned connect_timeout):
+    m_share(share),
+    m_mode(mode),
+    m_connect_timeout(connect_timeout),
+    m_multi(::curl_multi_init()),
+    m_active(0),
+    m_stats({0, 0, 0}),
+    m_stop(false)
+{
+    if (nullptr != m_multi) m_thread = std::thread(&preconnector::run, this);
+}
+
+
+void preconnector::warm(const uri & uri_) {
+    if (nullptr == m_multi || uri_.host.empty()) return;
+
+    const std::string scheme = uri_.scheme.empty() ? "http" : uri_.scheme;
+
+    std::string origin = scheme + "://" + uri_.host;
+    if (uri_.port) origin += ':' + std::to_string(uri_.port);
+
+    // DNS mode connects to the origin port without TLS (the DNS cache
+    // is keyed by host and port)
+    std::string target = origin;
+    if (DNS == m_mode && "http" != scheme) {
+        const unsigned port = uri_.port ? uri_.port : "https" == scheme ? 443 : 80;
+        target = "http://" + uri_.host + ':' + std::to_string(port);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_origins.insert(std::move(origin)).second) return;  // seen before
+
+        ++m_stats.origins;
+        ++m_active;
+        m_queue.push_back(std::move(target));
+    }
+
+    ::curl_multi_wakeup((CURLM *)m_multi);
+}
+
+
+void preconnector::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return 0 == m_active || m_stop; });
+}
+
+
+void preconnector::run() {
+    auto * multi = (CURLM *)m_multi;
+
+    std::unordered_set<CURL *> running;
+    std::vector<std::string>   queue;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) break;
+
+            queue.swap(m_queue);
+        }
+
+        // Start new preconnects
+        for (const auto & origin: queue) {
+            auto * curl = ::curl_easy_init();
+            if (nullptr == curl) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.failed;
+                if (0 == --m_active) m_idle.notify_all();
+                continue;
+            }
+
+            ::curl_easy_setopt(curl, CURLOPT_URL, origin.c_str());
+            ::curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+            if (nullptr != m_share)
+                ::curl_easy_setopt(curl, CURLOPT_SHARE, m_share);
+
+            // Handshake only, no request
+            ::curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
+            ::curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)m_connect_timeout);
+            ::curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS,        (long)m_connect_timeout);
+
+            ::curl_multi_add_handle(multi, curl);
+            running.insert(curl);
+        }
+        queue.clear();
+
+        int still_running = 0;
+        ::curl_multi_perform(multi, &still_running);
+
+        // Collect finished preconnects
+        download::collect(multi, [this, &running](void * curl, int result) {
+            ::curl_easy_cleanup((CURL *)curl);  // DNS & TLS session stay in the share
+            running.erase((CURL *)curl);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (CURLE_OK == result)
+                ++m_stats.warmed;
+            else
+                ++m_stats.failed;
+
+            if (0 == --m_active) m_idle.notify_all();
+        });
+
+        ::curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+
+    // Abort pending preconnects
+    for (auto * curl: running) {
+        ::curl_multi_remove_handle(multi, curl);
+        ::curl_easy_cleanup(curl);
+    }
+}
+
+
+preconnector::~preconnector() {
+    if (nullptr == m_multi) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_idle.notify_all();
+    ::curl_multi_wakeup((CURLM *)m_multi);
+    m_thread.join();
+
+    ::curl_multi_cleanup((CURLM *)m_multi);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,165 @@
+#ifndef fastcrawl__preconnector_hxx
+#define fastcrawl__preconnector_hxx
+
+/**
+ *  \file
+ *  \brief  Speculative host pre-resolution and preconnect
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "uri.hxx"
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Speculative host pre-resolution and preconnect
+ *
+ *  References are found while the crawled page is still being received,
+ *  yet their downloads only resolve the host name and connect once
+ *  a download thread picks the job up.
+ *  The preconnector starts that work for each newly seen origin
+ *  (scheme, host and port) as soon as it's discovered, asynchronously
+ *  (on its own thread, driving a cURL multi handle).
+ *
+ *  The results are kept in the cURL share handle of the downloads
+ *  (see \ref crawl_context), so the preconnector is useless without one:
+ *
+ *  * \ref DNS mode warms the DNS cache (by a plain TCP connect to the
+ *    origin port),
+ *  * \ref CONNECT mode does the full TCP (and TLS) handshake, so that
+ *    the TLS session is cached and the later TLS handshake is abbreviated.
+ *
+ *  No request is ever sent, so the origins see no speculative traffic
+ *  but the handshake.
+ *  The connection itself is dropped: cURL never reuses connect-only
+ *  connections, and a live connection can only be left in the shared
+ *  connection cache by a request.
+ *  The handshakes are bounded by a short connect timeout, so that
+ *  unreachable origins don't hold \ref wait for long.
+ */
+class preconnector {
+    public:
+
+    /** Preconnect mode */
+    enum mode_t {
+        DNS = 0,    /**< Name resolution (TCP connect) only */
+        CONNECT,    /**< TCP and TLS handshake              */
+    };
+
+    /** Default connect timeout [ms] */
+    static const unsigned default_connect_timeout = 3000;
+
+    /** Preconnect statistics */
+    struct stats_t {
+        size_t origins;     /**< Origins seen             */
+        size_t warmed;      /**< Successful preconnects   */
+        size_t failed;      /**< Failed preconnects       */
+    };  // end of struct stats_t
+
+    private:
+
+    void * const                    m_share;        /**< cURL share handle      */
+    const mode_t                    m_mode;         /**< Preconnect mode        */
+    const unsigned                  m_connect_timeout;  /**< Connect timeout [ms] */
+    void *                          m_multi;        /**< cURL multi handle      */
+    std::unordered_set<std::string> m_origins;      /**< Origins seen           */
+    std::vector<std::string>        m_queue;        /**< Origins to warm up     */
+    size_t                          m_active;       /**< Preconnects in progress */
+    stats_t                         m_stats;        /**< Statistics             */
+    bool                            m_stop;         /**< Stop flag              */
+    mutable std::mutex              m_mutex;        /**< Mutex                  */
+    std::condition_variable         m_idle;         /**< No preconnect pending  */
+    std::thread                     m_thread;       /**< Preconnect thread      */
+
+    /** Preconnect thread routine */
+    void run();
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  share            cURL share handle (of the downloads)
+     *  \param  mode             Preconnect mode
+     *  \param  connect_timeout  Connect timeout [ms]
+     */
+    preconnector(
+        void *   share,
+        mode_t   mode            = DNS,
+        unsigned connect_timeout = default_connect_timeout);
+
+    preconnector(const preconnector & ) = delete;
+    preconnector & operator = (const preconnector & ) = delete;
+
+    /** Preconnect mode */
+    mode_t mode() const { return m_mode; }
+
+    /**
+     *  \brief  Warm up the content URI origin
+     *
+     *  Origins seen before are ignored, so the call is cheap.
+     *
+     *  \param  uri_  Absolute content URI
+     */
+    void warm(const uri & uri_);
+
+    /** Wait till there are no pending preconnects */
+    void wait();
+
+    /** Statistics */
+    stats_t stats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    /** Destructor (aborts pending preconnects) */
+    ~preconnector();
+
+};  // end of class preconnector
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__preconnector_hxx
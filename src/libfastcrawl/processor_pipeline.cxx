@@ -0,0 +1,144 @@
+/**
+ *  \file
+ *  \brief  Runtime-composed online data processor pipeline
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "processor_pipeline.hxx"
+#include "multi_hash.hxx"
+#include "content_size.hxx"
+#include "simhash.hxx"
+
+#include <sstream>
+#include <stdexcept>
+
+
+namespace fastcrawl {
+
+/** Library processors registry */
+static processor_registry library_processors() {
+    processor_registry registry;
+
+    registry.add_digest("adler32", content_digests::ADLER32);
+    registry.add_digest("crc32c",  content_digests::CRC32C);
+    registry.add_digest("xxh3",    content_digests::XXH3);
+    registry.add_digest("sha256",  content_digests::SHA256);
+
+    registry.add("size", [](processor_pipeline & pipeline, uri_record & record) {
+        pipeline.emplace<content_size>(record.size);
+    });
+
+    registry.add("simhash", [](processor_pipeline & pipeline, uri_record & record) {
+        pipeline.emplace<simhash>(record.fingerprint);
+    });
+
+    return registry;
+}
+
+
+processor_registry & processor_registry::global() {
+    static processor_registry registry = library_processors();
+    return registry;
+}
+
+
+const processor_registry::entry & processor_registry::find(
+    const std::string & name) const
+{
+    const auto entry = m_entries.find(name);
+    if (m_entries.end() == entry)
+        throw std::invalid_argument("unknown data processor: " + name);
+
+    return entry->second;
+}
+
+
+std::vector<std::string> processor_registry::names() const {
+    std::vector<std::string> names;
+    for (auto & entry: m_entries)
+        names.push_back(entry.first);
+
+    return names;
+}
+
+
+pipeline_builder::pipeline_builder(
+    const std::string &        list,
+    const processor_registry & registry)
+:
+    m_digests(0)
+{
+    std::stringstream list_ss(list);
+    std::string name;
+    while (std::getline(list_ss, name, ','))
+        add(name, registry);
+}
+
+
+void pipeline_builder::add(
+    const std::string &        name,
+    const processor_registry & registry)
+{
+    const auto & entry = registry.find(name);
+
+    if (entry.digest) add_digests(entry.digest);
+    else              m_factories.push_back(entry.factory);
+}
+
+
+void pipeline_builder::add_digests(unsigned algorithms) {
+    if (0 == algorithms) return;  // no empty digests stage
+
+    if (!m_digests) m_factories.push_back(processor_registry::factory_t());
+
+    m_digests |= algorithms;
+}
+
+
+void pipeline_builder::build(
+    processor_pipeline & pipeline,
+    uri_record &         record) const
+{
+    for (auto & factory: m_factories) {
+        if (factory)
+            factory(pipeline, record);
+        else
+            pipeline.emplace<multi_hash>(m_digests, record.digests);
+    }
+}
+
+}  // end of namespace fastcrawl
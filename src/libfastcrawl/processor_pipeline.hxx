@@ -0,0 +1,325 @@
+#ifndef fastcrawl__processor_pipeline_hxx
+#define fastcrawl__processor_pipeline_hxx
+
+/**
+ *  \file
+ *  \brief  Runtime-composed online data processor pipeline
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+#include "uri_record.hxx"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <chrono>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Runtime-composed online data processor pipeline
+ *
+ *  Unlike \ref compound_data_processor, the pipeline is assembled
+ *  at runtime.
+ *  The stages are kept in a flat array of (processor, function pointer)
+ *  pairs; the function pointers call the concrete processor types'
+ *  \c operator() directly (i.e. not via virtual dispatch).
+ *  So, per-chunk overhead is one indirect call per stage, same as
+ *  of the compile-time composition.
+ *
+ *  The stages are destroyed in reverse order of addition (just like
+ *  \ref compound_data_processor members), i.e. they assign their results
+ *  when the pipeline is destroyed.
+ *
+ *  The pipeline is congested while any stage is; only the stages
+ *  implementing backpressure (overriding \ref congested) are checked.
+ */
+class processor_pipeline: public online_data_processor {
+    private:
+
+    /** Pipeline stage */
+    struct stage {
+        void * processor;                                   /**< Processor    */
+        void (* process)(void *, unsigned char *, size_t);  /**< Processing   */
+        void (* type)(void *, const std::string &);         /**< Content type */
+        void (* destroy)(void *);                           /**< Destructor   */
+
+    };  // end of struct stage
+
+    std::vector<stage>                   m_stages;      /**< Pipeline stages  */
+    std::vector<online_data_processor *> m_throttling;  /**< Backpressure ones */
+
+    /** Processor implements backpressure */
+    template <class Proc>
+    using throttling = std::integral_constant<bool, !std::is_same<
+        decltype(&Proc::congested),
+        bool (online_data_processor::*)() const>::value>;
+
+    /** Stage processing function */
+    template <class Proc>
+    static void process(void * proc, unsigned char * data, size_t size) {
+        static_cast<Proc *>(proc)->Proc::operator () (data, size);
+    }
+
+    /** Stage content type notification function */
+    template <class Proc>
+    static void type(void * proc, const std::string & type) {
+        static_cast<Proc *>(proc)->content_type(type);
+    }
+
+    /** Stage destruction function */
+    template <class Proc>
+    static void destroy(void * proc) {
+        delete static_cast<Proc *>(proc);
+    }
+
+    public:
+
+    processor_pipeline() {}
+
+    processor_pipeline(const processor_pipeline & ) = delete;
+    processor_pipeline & operator = (const processor_pipeline & ) = delete;
+
+    /**
+     *  \brief  Append stage
+     *
+     *  \tparam  Proc  Online data processor type
+     *  \param   args  Processor constructor arguments
+     */
+    template <class Proc, class... Args>
+    void emplace(Args &&... args) {
+        m_stages.reserve(m_stages.size() + 1);  // don't leak on failure
+
+        auto * proc = new Proc(std::forward<Args>(args)...);
+        m_stages.push_back(stage{proc, &process<Proc>, &type<Proc>, &destroy<Proc>});
+
+        if (throttling<Proc>::value) m_throttling.push_back(proc);
+    }
+
+    /** Number of stages */
+    size_t size() const { return m_stages.size(); }
+
+    /** Implements \ref online_data_processor::operator() */
+    void operator () (unsigned char * data, size_t size) {
+        for (auto & stage: m_stages)
+            stage.process(stage.processor, data, size);
+    }
+
+    /** Implements \ref online_data_processor::congested */
+    bool congested() const {
+        for (auto * proc: m_throttling)
+            if (proc->congested()) return true;
+
+        return false;
+    }
+
+    /** Implements \ref online_data_processor::wait_ready */
+    bool wait_ready(std::chrono::milliseconds timeout) const {
+        for (auto * proc: m_throttling)
+            if (proc->congested() && !proc->wait_ready(timeout)) return false;
+
+        return true;
+    }
+
+    /** Implements \ref online_data_processor::content_type */
+    void content_type(const std::string & type) {
+        for (auto & stage: m_stages)
+            stage.type(stage.processor, type);
+    }
+
+    /** Destructor (destroys stages in reverse order) */
+    ~processor_pipeline() {
+        for (auto stage = m_stages.rbegin(); stage != m_stages.rend(); ++stage)
+            stage->destroy(stage->processor);
+    }
+
+};  // end of class processor_pipeline
+
+
+/**
+ *  \brief  Online data processor registry
+ *
+ *  Maps processor names to factories that append the processor
+ *  to a \ref processor_pipeline (storing results to a \ref uri_record).
+ *
+ *  Digest processors are registered with their \ref content_digests
+ *  algorithm; pipelines built by \ref pipeline_builder compute all
+ *  the digests by a single \ref multi_hash stage.
+ *
+ *  The global registry contains the library processors:
+ *  \c adler32, \c crc32c, \c xxh3, \c sha256, \c size and \c simhash.
+ *  More may be registered at startup (the registry isn't thread-safe).
+ */
+class processor_registry {
+    public:
+
+    /** Processor factory */
+    using factory_t = std::function<void (processor_pipeline &, uri_record &)>;
+
+    /** Registry entry */
+    struct entry {
+        unsigned  digest;   /**< Digest algorithm (or 0)                 */
+        factory_t factory;  /**< Factory (unused for digest processors)  */
+
+    };  // end of struct entry
+
+    private:
+
+    std::map<std::string, entry> m_entries;  /**< Registered processors */
+
+    public:
+
+    /** Global registry */
+    static processor_registry & global();
+
+    /**
+     *  \brief  Register processor
+     *
+     *  \param  name     Processor name
+     *  \param  factory  Processor factory
+     */
+    void add(const std::string & name, factory_t factory) {
+        m_entries[name] = entry{0, factory};
+    }
+
+    /**
+     *  \brief  Register digest processor
+     *
+     *  \param  name       Processor name
+     *  \param  algorithm  Digest algorithm (see \ref content_digests)
+     */
+    void add_digest(const std::string & name, unsigned algorithm) {
+        m_entries[name] = entry{algorithm, factory_t()};
+    }
+
+    /**
+     *  \brief  Look processor up
+     *
+     *  \param  name  Processor name
+     *
+     *  \return Registry entry
+     *
+     *  \throw  std::invalid_argument if the processor isn't registered
+     */
+    const entry & find(const std::string & name) const;
+
+    /** Registered processor names */
+    std::vector<std::string> names() const;
+
+};  // end of class processor_registry
+
+
+/**
+ *  \brief  Processor pipeline builder
+ *
+ *  Resolves processor names (at configuration time) and builds
+ *  the pipelines (for each download).
+ */
+class pipeline_builder {
+    private:
+
+    /**
+     *  Stage factories; the digests stage (\ref multi_hash) is represented
+     *  by an empty factory.
+     */
+    std::vector<processor_registry::factory_t> m_factories;
+
+    unsigned m_digests;  /**< Digest algorithms (computed in one stage) */
+
+    public:
+
+    /** Empty pipeline builder */
+    pipeline_builder(): m_digests(0) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  list      Comma-separated processor names
+     *  \param  registry  Processor registry
+     *
+     *  \throw  std::invalid_argument on unknown processor name
+     */
+    pipeline_builder(
+        const std::string &        list,
+        const processor_registry & registry = processor_registry::global());
+
+    /**
+     *  \brief  Append processor
+     *
+     *  \param  name      Processor name
+     *  \param  registry  Processor registry
+     *
+     *  \throw  std::invalid_argument on unknown processor name
+     */
+    void add(
+        const std::string &        name,
+        const processor_registry & registry = processor_registry::global());
+
+    /**
+     *  \brief  Append processor (unregistered)
+     *
+     *  \param  factory  Processor factory
+     */
+    void add(processor_registry::factory_t factory) {
+        m_factories.push_back(factory);
+    }
+
+    /** Add digest algorithms (see \ref content_digests) */
+    void add_digests(unsigned algorithms);
+
+    /** Digest algorithms */
+    unsigned digests() const { return m_digests; }
+
+    /**
+     *  \brief  Build pipeline
+     *
+     *  \param  pipeline  Pipeline (stages are appended)
+     *  \param  record    Download record (for the processors' results)
+     */
+    void build(processor_pipeline & pipeline, uri_record & record) const;
+
+};  // end of class pipeline_builder
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__processor_pipeline_hxx
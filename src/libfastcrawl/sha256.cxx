@@ -0,0 +1,190 @@
+/**
+ *  \file
+ *  \brief  SHA-256 online digest
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sha256.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace fastcrawl {
+
+/** Round constants */
+static const uint32_t k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+
+inline static uint32_t rotr(uint32_t x, int r) {
+    return (x >> r) | (x << (32 - r));
+}
+
+/** Big-endian 32b read */
+inline static uint32_t read32be(const unsigned char * p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16
+        | (uint32_t)p[2] <<  8 | (uint32_t)p[3];
+}
+
+
+sha256::context::context():
+    m_state{
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+    m_buffered(0),
+    m_total(0)
+{}
+
+
+void sha256::context::transform(const unsigned char * data, size_t cnt) {
+    for (; cnt; --cnt, data += 64) {
+        uint32_t w[64];
+
+        for (int i = 0; i < 16; ++i)
+            w[i] = read32be(data + 4 * i);
+
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 =
+                rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 =
+                rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t s1  = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const uint32_t ch  = (e & f) ^ (~e & g);
+            const uint32_t t1  = h + s1 + ch + k[i] + w[i];
+            const uint32_t s0  = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t t2  = s0 + maj;
+
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        m_state[0] += a; m_state[1] += b; m_state[2] += c; m_state[3] += d;
+        m_state[4] += e; m_state[5] += f; m_state[6] += g; m_state[7] += h;
+    }
+}
+
+
+void sha256::context::update(const unsigned char * data, size_t size) {
+    m_total += size;
+
+    // Complete buffered block
+    if (m_buffered) {
+        const size_t fill = std::min(size, sizeof(m_buffer) - m_buffered);
+        std::memcpy(m_buffer + m_buffered, data, fill);
+        m_buffered += fill;
+        data += fill;
+        size -= fill;
+
+        if (sizeof(m_buffer) > m_buffered) return;
+
+        transform(m_buffer, 1);
+        m_buffered = 0;
+    }
+
+    // Full blocks
+    transform(data, size / 64);
+    data += size & ~(size_t)63;
+    size &= 63;
+
+    // Buffer the rest
+    std::memcpy(m_buffer, data, size);
+    m_buffered = size;
+}
+
+
+sha256::digest_t sha256::context::digest() const {
+    context ctx(*this);
+
+    // Padding
+    unsigned char pad[72] = { 0x80 };
+    const size_t pad_len = (m_buffered < 56 ? 56 : 120) - m_buffered;
+
+    const uint64_t bits = m_total * 8;
+    for (int i = 0; i < 8; ++i)
+        pad[pad_len + i] = (unsigned char)(bits >> (56 - 8 * i));
+
+    ctx.update(pad, pad_len + 8);
+
+    digest_t result;
+    for (int i = 0; i < 8; ++i) {
+        result[4 * i]     = (uint8_t)(ctx.m_state[i] >> 24);
+        result[4 * i + 1] = (uint8_t)(ctx.m_state[i] >> 16);
+        result[4 * i + 2] = (uint8_t)(ctx.m_state[i] >>  8);
+        result[4 * i + 3] = (uint8_t)(ctx.m_state[i]);
+    }
+
+    return result;
+}
+
+
+void sha256::operator () (unsigned char * data, size_t size) {
+    m_context.update(data, size);
+}
+
+
+std::string sha256::hex(const sha256::digest_t & digest) {
+    static const char hex_digit[] = "0123456789abcdef";
+
+    std::string str;
+    str.reserve(2 * digest.size());
+    for (auto byte: digest) {
+        str += hex_digit[byte >> 4];
+        str += hex_digit[byte & 0xf];
+    }
+
+    return str;
+}
+
+}  // end of namespace fastcrawl
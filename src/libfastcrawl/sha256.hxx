@@ -0,0 +1,117 @@
+#ifndef fastcrawl__sha256_hxx
+#define fastcrawl__sha256_hxx
+
+/**
+ *  \file
+ *  \brief  SHA-256 online digest
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Online data digest based on SHA-256 algorithm
+ *
+ *  See FIPS PUB 180-4
+ *  (https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf).
+ */
+class sha256: public online_data_processor {
+    public:
+
+    using digest_t = std::array<uint8_t, 32>;  /**< Digest type */
+
+    /**
+     *  \brief  Streaming digest context
+     *
+     *  Data may be added in chunks of arbitrary sizes.
+     */
+    class context {
+        private:
+
+        uint32_t      m_state[8];       /**< Hash state          */
+        unsigned char m_buffer[64];     /**< Block buffer        */
+        size_t        m_buffered;       /**< Bytes in buffer     */
+        uint64_t      m_total;          /**< Total data length   */
+
+        public:
+
+        context();
+
+        /** Add data */
+        void update(const unsigned char * data, size_t size);
+
+        /** Digest of the data so far (the context may be updated further) */
+        digest_t digest() const;
+
+        private:
+
+        /** Process \c cnt 64B blocks */
+        void transform(const unsigned char * data, size_t cnt);
+
+    };  // end of class context
+
+    private:
+
+    context    m_context;   /**< Digest context */
+    digest_t & m_result;    /**< Final result   */
+
+    public:
+
+    /** Constructor, takes reference to the result */
+    sha256(digest_t & result): m_result(result) {}
+
+    void operator () (unsigned char * data, size_t size);
+
+    /** Destructor assigns the result */
+    ~sha256() { m_result = m_context.digest(); }
+
+    /** Digest hexadecimal representation */
+    static std::string hex(const digest_t & digest);
+
+};  // end of class sha256
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__sha256_hxx
@@ -0,0 +1,407 @@
+/**
+ *  \file
+ *  \brief  Shard-per-core crawl runtime
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shard_runtime.hxx"
+#include "html_crawler.hxx"
+
+extern "C" {
+#include <curl/curl.h>
+#include <pthread.h>
+#include <sched.h>
+}
+
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+
+
+namespace fastcrawl {
+
+/** Running transfer */
+struct shard_runtime::transfer {
+    download            dl;         /**< Download                     */
+    download::transfer  xfer;       /**< Transfer                     */
+    processor_pipeline  pipeline;   /**< Data processors              */
+    const std::string * key;        /**< Record key (content only)    */
+    uri_record *        record;     /**< Record (content only)        */
+
+    transfer(
+        const uri &         target,
+        const std::string & filename,
+        const std::string * key_,
+        uri_record *        record_)
+    :
+        dl(target, filename),
+        key(key_),
+        record(record_)
+    {}
+
+};  // end of struct transfer
+
+
+/** Crawled page processor (the crawler, paused on the task limit) */
+class shard_runtime::page_processor: public online_data_processor {
+    private:
+
+    online_data_processor & m_crawler;      /**< Page crawler          */
+    shard_runtime &         m_runtime;      /**< Runtime               */
+    mutable bool            m_congested;    /**< Last congestion state */
+
+    public:
+
+    page_processor(online_data_processor & crawler, shard_runtime & runtime):
+        m_crawler(crawler),
+        m_runtime(runtime),
+        m_congested(false)
+    {}
+
+    void operator () (unsigned char * data, size_t size) {
+        m_crawler(data, size);
+    }
+
+    void content_type(const std::string & type) {
+        m_crawler.content_type(type);
+    }
+
+    /** Called by the page shard only (see shard::run) */
+    bool congested() const {
+        const bool congested =
+            m_runtime.m_pending.load() >= m_runtime.m_queue_limit;
+
+        if (congested && !m_congested) ++m_runtime.m_throttled;
+        m_congested = congested;
+
+        return congested;
+    }
+
+};  // end of class page_processor
+
+
+/** CPUs available to the process */
+static std::vector<int> available_cpus() {
+    std::vector<int> cpus;
+
+#ifdef __linux__
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (0 == ::sched_getaffinity(0, sizeof(set), &set))
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+#endif
+
+    return cpus;
+}
+
+
+shard_runtime::shard::shard(shard_runtime & runtime_, size_t index_, int cpu):
+    runtime(runtime_),
+    index(index_),
+    multi(::curl_multi_init()),
+    running(0),
+    page(nullptr),
+    stats({cpu, 0, 0, 0, 0}),
+    sleeping(false)
+{
+    if (nullptr == multi)
+        throw std::runtime_error("shard_runtime: failed to create cURL multi handle");
+
+    // Transfers over the limit wait for a connection (and reuse it)
+    ::curl_multi_setopt((CURLM *)multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+        (long)max_host_connections);
+}
+
+
+void shard_runtime::shard::run() {
+#ifdef __linux__
+    if (stats.cpu >= 0) {
+        ::cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(stats.cpu, &set);
+
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    auto * m = (CURLM *)multi;
+
+    for (task t; ; ) {
+        while (inbox.pop(t)) start(t);
+
+        if (running) {
+            int still_running;
+            ::curl_multi_perform(m, &still_running);
+
+            complete();
+        }
+
+        // Page download paused on the task limit (see task_done)
+        if (page) download::resume(page->xfer);
+
+        if (!running && inbox.empty() && runtime.m_stop.load()) break;
+
+        // Producers wake the shard up (see push)
+        sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (inbox.empty()) ::curl_multi_poll(m, nullptr, 0, 1000, nullptr);
+
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+
+void shard_runtime::shard::start(task & t) {
+    const std::string * uri_str = nullptr;
+    uri_record *        record  = nullptr;
+
+    // Content (the page isn't recorded)
+    if (nullptr == t.page) {
+        const auto iter_new = records.emplace(t.target, uri_record());
+        if (!iter_new.second) {  // repeated reference
+            ++stats.duplicates;
+            runtime.task_done();
+            return;
+        }
+
+        uri_str = &iter_new.first->first;
+        record  = &iter_new.first->second;
+
+        std::snprintf(record->filename, uri_record::filename_size, "%s",
+            t.filename.c_str());
+
+        ++stats.downloads;
+    }
+
+    auto * xfer = new transfer(t.target, t.filename, uri_str, record);
+    xfer->dl.verbose_log(runtime.verbose_log());
+    xfer->dl.policy(record ? &runtime.m_policy : &runtime.m_page_policy);
+
+    online_data_processor * processor = t.page;
+    if (nullptr == record)
+        page = xfer;
+    else {
+        runtime.m_pipeline.build(xfer->pipeline, *record);
+        processor = &xfer->pipeline;
+    }
+
+    if (!xfer->dl.prepare(xfer->xfer, processor)) {
+        finish(xfer, false);
+        return;
+    }
+
+    ::curl_easy_setopt(xfer->xfer.handle(), CURLOPT_PRIVATE, xfer);
+    ::curl_multi_add_handle((CURLM *)multi, xfer->xfer.handle());
+    ++running;
+}
+
+
+void shard_runtime::shard::complete() {
+    running -= download::collect(multi, [this](void * curl, int result) {
+        transfer * xfer = nullptr;
+        ::curl_easy_getinfo((CURL *)curl, CURLINFO_PRIVATE, &xfer);
+
+        finish(xfer, xfer->dl.finish(xfer->xfer, result));
+    });
+}
+
+
+void shard_runtime::shard::finish(transfer * xfer, bool success) {
+    const std::string * uri_str = xfer->key;
+    uri_record *        record  = xfer->record;
+
+    const skip_reason skipped = xfer->xfer.skipped();
+
+    if (record)
+        download::timing(xfer->xfer, record->timing);
+    else {
+        runtime.m_page_ok = success;
+        page = nullptr;
+    }
+
+    delete xfer;  // closes the file, processors store their results
+
+    if (record) {
+        record->success = success;
+        record->skipped = skipped;
+        if      (skipped)  ++stats.skipped;
+        else if (!success) ++stats.failed;
+
+        if (runtime.m_on_completion) runtime.m_on_completion(*uri_str, *record);
+    }
+
+    runtime.task_done();
+}
+
+
+void shard_runtime::shard::push(task && t) {
+    inbox.push(std::move(t));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Only the first producer wakes the sleeping shard
+    if (sleeping.exchange(false)) ::curl_multi_wakeup((CURLM *)multi);
+}
+
+
+void shard_runtime::shard::wake() {
+    ::curl_multi_wakeup((CURLM *)multi);
+}
+
+
+shard_runtime::shard::~shard() {
+    ::curl_multi_cleanup((CURLM *)multi);
+}
+
+
+shard_runtime::shard_runtime(size_t shards, bool pin):
+    m_pipeline("adler32,size"),
+    m_stop(false),
+    m_pending(0),
+    m_queue_limit(SIZE_MAX),
+    m_page_shard(0),
+    m_throttled(0),
+    m_page_ok(false)
+{
+    const auto cpus = available_cpus();
+
+    if (0 == shards)
+        shards = cpus.empty()
+            ? std::max<size_t>(1, std::thread::hardware_concurrency())
+            : cpus.size();
+
+    m_shards.reserve(shards);
+    for (size_t i = 0; i < shards; ++i)
+        m_shards.emplace_back(new shard(*this, i,
+            pin && !cpus.empty() ? cpus[i % cpus.size()] : -1));
+
+    // All the shards must exist before any task is routed
+    for (auto & s: m_shards)
+        s->thread = std::thread(&shard::run, s.get());
+}
+
+
+size_t shard_runtime::shard_of(const std::string & host) const {
+    return std::hash<std::string>()(host) % m_shards.size();
+}
+
+
+void shard_runtime::route(task && t) {
+    m_pending.fetch_add(1);
+    m_shards[shard_of(t.target.host)]->push(std::move(t));
+}
+
+
+void shard_runtime::task_done() {
+    const size_t pending = m_pending.fetch_sub(1);
+
+    // Below the limit again, the page shard resumes the page download
+    if (m_queue_limit == pending) m_shards[m_page_shard]->wake();
+
+    if (1 != pending) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done.notify_all();
+}
+
+
+bool shard_runtime::crawl(const uri & page, const std::string & filename) {
+    // Segmenter only (the crawler has no download threads)
+    html_crawler   crawler(page, 0);
+    page_processor page_proc(crawler, *this);
+
+    crawler.on_reference([this, &crawler](
+        const std::string & ,
+        const std::string & ,
+        const std::string & value,
+        size_t              line,
+        size_t              column)
+    {
+        if (value.empty() || '#' == value[0]) return;  // local fragment
+
+        char content_filename[uri_record::filename_size];
+        std::snprintf(content_filename, sizeof(content_filename),
+            "./%08zu_%08zu", line, column);
+
+        route(task(crawler.resolve(value), content_filename));
+    });
+
+    // The page shard segments the page (and hands the references over)
+    m_page_ok    = false;
+    m_page_shard = shard_of(page.host);
+    route(task(page, std::string(filename), &page_proc));
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return 0 == m_pending.load(); });
+
+    return m_page_ok;
+}
+
+
+void shard_runtime::timings(timing_report & report) const {
+    for (auto & s: m_shards)
+        for (auto & uri_record: s->records) {
+            const auto & rec = uri_record.second;
+            if (rec.timing.valid())
+                report.add(uri::parse(uri_record.first).host, rec.timing);
+        }
+}
+
+
+std::vector<shard_runtime::shard_stats> shard_runtime::stats() const {
+    std::vector<shard_stats> stats;
+    stats.reserve(m_shards.size());
+
+    for (auto & s: m_shards) stats.push_back(s->stats);
+
+    return stats;
+}
+
+
+shard_runtime::~shard_runtime() {
+    m_stop.store(true);
+
+    for (auto & s: m_shards) {
+        ::curl_multi_wakeup((CURLM *)s->multi);
+        s->thread.join();
+    }
+}
+
+}  // end of namespace fastcrawl
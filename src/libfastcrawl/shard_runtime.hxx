@@ -0,0 +1,285 @@
+#ifndef fastcrawl__shard_runtime_hxx
+#define fastcrawl__shard_runtime_hxx
+
+/**
+ *  \file
+ *  \brief  Shard-per-core crawl runtime
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "download.hxx"
+#include "download_policy.hxx"
+#include "processor_pipeline.hxx"
+#include "completion_queue.hxx"
+#include "timing_report.hxx"
+#include "mpsc_queue.hxx"
+#include "uri_record.hxx"
+#include "uri.hxx"
+#include "logger.hxx"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Shard-per-core crawl runtime
+ *
+ *  Alternative to the \ref html_crawler download thread pool: the crawl
+ *  runs on a fixed set of shards, one per CPU (each pinned to its CPU).
+ *  A shard is a thread running its own download event loop (cURL multi
+ *  interface, so it has its own connection cache) and it owns a slice
+ *  of the URI space: the content URIs whose host hashes to the shard.
+ *  The shard keeps the download records of its URIs (so there's no
+ *  shared URI set, repeated references are dropped by the owner).
+ *
+ *  The crawled page is downloaded (and segmented) by its host shard;
+ *  the references found are handed off to their owner shards through
+ *  lock-free MPSC queues (see \ref mpsc_queue), that's the only
+ *  cross-shard communication.
+ *
+ *  The downloads are plain transfers (with the policy timeouts, but no
+ *  retries nor hedging, see \ref download_governor); the data processors
+ *  and completion callback are executed by the shard threads.
+ *
+ *  The shard inboxes are unbounded; instead, the page download is paused
+ *  while the pending download tasks reach the limit (see \ref queue_limit),
+ *  just like the \ref html_crawler one on its job queue limit.
+ */
+class shard_runtime: public logger {
+    public:
+
+    /** Max. parallel connections to a host (per shard) */
+    static const size_t max_host_connections = 8;
+
+    /** Shard statistics (see \ref stats) */
+    struct shard_stats {
+        int    cpu;         /**< CPU the shard is pinned to (or -1)  */
+        size_t downloads;   /**< Content downloads                   */
+        size_t failed;      /**< Failed content downloads            */
+        size_t skipped;     /**< Skipped content downloads           */
+        size_t duplicates;  /**< Repeated references dropped         */
+    };  // end of struct shard_stats
+
+    private:
+
+    /** Download task (handed off to the URI owner shard) */
+    struct task {
+        uri                     target;     /**< Absolute URI             */
+        std::string             filename;   /**< Storage file name        */
+        online_data_processor * page;       /**< Page crawler (page only) */
+
+        task(): page(nullptr) {}
+
+        task(
+            const uri &             target_,
+            std::string &&          filename_,
+            online_data_processor * page_ = nullptr)
+        :
+            target(target_),
+            filename(std::move(filename_)),
+            page(page_)
+        {}
+
+    };  // end of struct task
+
+    struct transfer;  // running transfer (see the implementation)
+
+    class page_processor;  // crawled page processor (see the implementation)
+
+    /** Shard */
+    struct shard {
+        /** Download records (of the shard URIs) */
+        using records_t = std::unordered_map<std::string, uri_record>;
+
+        shard_runtime &     runtime;    /**< Runtime                         */
+        const size_t        index;      /**< Shard index                     */
+        void *              multi;      /**< cURL multi handle               */
+        size_t              running;    /**< Running transfers               */
+        transfer *          page;       /**< Page transfer (if any)          */
+        records_t           records;    /**< Download records                */
+        shard_stats         stats;      /**< Statistics                      */
+        char                pad[64];    /**< False sharing guard             */
+        mpsc_queue<task>    inbox;      /**< Download tasks                  */
+        std::atomic<bool>   sleeping;   /**< Waiting for tasks or transfers  */
+        std::thread         thread;     /**< Shard thread                    */
+
+        shard(shard_runtime & runtime_, size_t index_, int cpu);
+
+        /** Shard thread routine */
+        void run();
+
+        /** Start download task */
+        void start(task & t);
+
+        /** Process finished transfers */
+        void complete();
+
+        /** Release finished (or failed to start) transfer */
+        void finish(transfer * xfer, bool success);
+
+        /** Hand a task over to the shard (any thread) */
+        void push(task && t);
+
+        /** Wake the shard up (any thread) */
+        void wake();
+
+        ~shard();
+
+    };  // end of struct shard
+
+    std::vector<std::unique_ptr<shard> > m_shards;        /**< Shards               */
+    pipeline_builder                     m_pipeline;      /**< Data processors      */
+    download_policy                      m_policy;        /**< Download timeouts    */
+    download_policy                      m_page_policy;   /**< Page download policy */
+    completion_callback_t                m_on_completion; /**< Completion callback  */
+    std::atomic<bool>                    m_stop;          /**< Stop flag            */
+    std::atomic<size_t>                  m_pending;       /**< Unfinished tasks     */
+    size_t                               m_queue_limit;   /**< Unfinished tasks max */
+    size_t                               m_page_shard;    /**< Crawled page shard   */
+    size_t                               m_throttled;     /**< Page download pauses */
+    bool                                 m_page_ok;       /**< Page download status */
+    std::mutex                           m_mutex;         /**< Crawl end mutex      */
+    std::condition_variable              m_done;          /**< Crawl end            */
+
+    /** Hand download task to its owner shard */
+    void route(task && t);
+
+    /** Task finished */
+    void task_done();
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Starts the shard threads.
+     *
+     *  \param  shards  Number of shards (0 means one per available CPU)
+     *  \param  pin     Pin the shards to CPUs
+     */
+    shard_runtime(size_t shards = 0, bool pin = true);
+
+    shard_runtime(const shard_runtime & ) = delete;
+    shard_runtime & operator = (const shard_runtime & ) = delete;
+
+    /** Number of shards */
+    size_t size() const { return m_shards.size(); }
+
+    /**
+     *  \brief  Owner shard of host
+     *
+     *  \param  host  Host
+     *
+     *  \return Shard index
+     */
+    size_t shard_of(const std::string & host) const;
+
+    /** Set download data processors (before crawl; default: Adler32, size) */
+    void pipeline(const pipeline_builder & builder) { m_pipeline = builder; }
+
+    /**
+     *  \brief  Set download task limit (before crawl)
+     *
+     *  The page download is paused while the unfinished download tasks
+     *  (queued in the shard inboxes or running) reach the limit.
+     *
+     *  \param  limit  Max. number of unfinished tasks (\c SIZE_MAX means
+     *                 no limit)
+     */
+    void queue_limit(size_t limit) { m_queue_limit = limit ? limit : 1; }
+
+    /** Page download pauses on the task limit (not during crawl) */
+    size_t throttled() const { return m_throttled; }
+
+    /** Set download policy (timeouts and compression; before crawl) */
+    void policy(const download_policy & policy) {
+        m_policy      = policy;
+        m_page_policy = policy.page();
+    }
+
+    /**
+     *  \brief  Set download completion callback (before crawl)
+     *
+     *  The callback is called from the shard threads (concurrently).
+     *
+     *  \param  callback  Completion callback
+     */
+    void on_completion(completion_callback_t callback) {
+        m_on_completion = callback;
+    }
+
+    /**
+     *  \brief  Crawl page
+     *
+     *  Downloads the page and the content it references (content URIs
+     *  downloaded by a previous crawl aren't downloaded again).
+     *  Returns when all the downloads are done.
+     *
+     *  \param  page      Page URI
+     *  \param  filename  Page storage file name
+     *
+     *  \return \c true iff the page was downloaded
+     */
+    bool crawl(const uri & page, const std::string & filename = "./index.html");
+
+    /**
+     *  \brief  Add transfer timings to report (not during crawl)
+     *
+     *  \param  report  Timing report
+     */
+    void timings(timing_report & report) const;
+
+    /** Shard statistics (not during crawl) */
+    std::vector<shard_stats> stats() const;
+
+    /** Destructor (stops the shards) */
+    ~shard_runtime();
+
+};  // end of class shard_runtime
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__shard_runtime_hxx
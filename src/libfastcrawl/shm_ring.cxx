@@ -0,0 +1,369 @@
+/**
+ *  \file
+ *  \brief  Shared memory record ring
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shm_ring.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+#include <thread>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+
+namespace fastcrawl {
+
+/** Ring header (see the layout) */
+struct shm_ring::header {
+    char                  magic[8];     /**< Magic              */
+    uint32_t              version;      /**< Layout version     */
+    uint32_t              header_size;  /**< Header size        */
+    uint64_t              capacity;     /**< Data area capacity */
+    char                  pad0[40];     /**< Padding            */
+    std::atomic<uint64_t> head;         /**< Write position     */
+    char                  pad1[56];     /**< Padding            */
+    std::atomic<uint64_t> tail;         /**< Read position      */
+    char                  pad2[56];     /**< Padding            */
+    std::atomic<uint32_t> closed;       /**< Producer done      */
+    std::atomic<uint32_t> consumer;     /**< Consumer PID       */
+
+};  // end of struct shm_ring::header
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "lock-free 64-bit atomics required");
+
+static const char     shm_magic[8]    = { 'F', 'C', 'S', 'H', 'M', 'R', 'G', '1' };
+static const uint32_t shm_version     = 1;
+static const size_t   shm_header_size = 4096;
+static const size_t   record_header   = 16;
+
+
+/** Record size in ring (incl. header and padding) */
+inline static size_t record_size(size_t payload) {
+    return (record_header + payload + 7) & ~(size_t)7;
+}
+
+
+/**
+ *  \brief  Wait step (spin, then sleep up to 1 ms)
+ *
+ *  \param  step  Wait step counter
+ */
+static void backoff(unsigned & step) {
+    if (step < 64)
+        std::this_thread::yield();
+    else
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(1 << std::min(step - 64, 10u)));
+
+    ++step;
+}
+
+
+void shm_ring::map(int fd, size_t size) {
+    void * addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == addr) {
+        const int err = errno;
+        ::close(fd);
+        throw std::runtime_error("failed to map " + m_name + ": " +
+            std::strerror(err));
+    }
+
+    ::close(fd);  // the mapping keeps the object
+
+    m_header = (header *)addr;
+    m_data   = (unsigned char *)addr + shm_header_size;
+}
+
+
+shm_ring::shm_ring(
+    const std::string &       name,
+    size_t                    capacity,
+    std::chrono::milliseconds timeout)
+:
+    m_name(name),
+    m_owner(true),
+    m_header(nullptr),
+    m_data(nullptr),
+    m_capacity(((capacity ? capacity : default_capacity) + 7) & ~(size_t)7),
+    m_timeout(timeout),
+    m_stalls(0),
+    m_drops(0),
+    m_read(0)
+{
+    ::shm_unlink(m_name.c_str());  // stale object
+
+    const int fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw std::runtime_error("failed to create " + m_name + ": " +
+            std::strerror(errno));
+
+    if (::ftruncate(fd, shm_header_size + m_capacity)) {
+        const int err = errno;
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        throw std::runtime_error("failed to size " + m_name + ": " +
+            std::strerror(err));
+    }
+
+    try {
+        map(fd, shm_header_size + m_capacity);
+    }
+    catch (...) {
+        ::shm_unlink(m_name.c_str());
+        throw;
+    }
+
+    // Header (the object is zero-filled)
+    m_header->version     = shm_version;
+    m_header->header_size = shm_header_size;
+    m_header->capacity    = m_capacity;
+    m_header->head.store(0, std::memory_order_relaxed);
+    m_header->tail.store(0, std::memory_order_relaxed);
+    m_header->closed.store(0, std::memory_order_relaxed);
+    m_header->consumer.store(0, std::memory_order_relaxed);
+
+    // Magic last, the ring is valid
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, shm_magic, sizeof(shm_magic));
+}
+
+
+shm_ring::shm_ring(const std::string & name):
+    m_name(name),
+    m_owner(false),
+    m_header(nullptr),
+    m_data(nullptr),
+    m_capacity(0),
+    m_timeout(0),
+    m_stalls(0),
+    m_drops(0),
+    m_read(0)
+{
+    const int fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw std::runtime_error("failed to open " + m_name + ": " +
+            std::strerror(errno));
+
+    struct ::stat st;
+    if (::fstat(fd, &st) || (size_t)st.st_size < shm_header_size) {
+        ::close(fd);
+        throw std::runtime_error(m_name + " is not a ring");
+    }
+
+    map(fd, st.st_size);
+
+    if (std::memcmp(m_header->magic, shm_magic, sizeof(shm_magic)) ||
+        shm_version != m_header->version ||
+        shm_header_size + m_header->capacity != (size_t)st.st_size)
+    {
+        ::munmap(m_header, st.st_size);
+        throw std::runtime_error(m_name + " is not a ring");
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    m_capacity = m_header->capacity;
+    m_read     = m_header->tail.load(std::memory_order_acquire);
+
+    m_header->consumer.store(::getpid(), std::memory_order_release);
+}
+
+
+bool shm_ring::consumer_alive() const {
+    const ::pid_t pid = m_header->consumer.load(std::memory_order_acquire);
+    if (0 == pid) return false;
+
+    // Crashed consumer doesn't detach
+    return 0 == ::kill(pid, 0) || ESRCH != errno;
+}
+
+
+bool shm_ring::write(
+    record_type  type,
+    uint64_t     stream,
+    const void * data1,
+    size_t       size1,
+    const void * data2,
+    size_t       size2)
+{
+    if (size1 + size2 > max_payload())
+        throw std::length_error("shm_ring: record payload too large");
+
+    const size_t size = record_size(size1 + size2);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    uint64_t head;
+    size_t   pad;
+
+    // Wait for space (backpressure)
+    std::chrono::steady_clock::time_point deadline;
+    unsigned step = 0;
+    for (;;) {
+        head = m_header->head.load(std::memory_order_relaxed);
+
+        // Records don't wrap around
+        const size_t to_end = m_capacity - head % m_capacity;
+        pad = to_end < size ? to_end : 0;
+
+        if (m_capacity - (head - m_header->tail.load(std::memory_order_acquire))
+            >= pad + size) break;
+
+        if (!consumer_alive()) {  // nobody would ever free space
+            ++m_drops;
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (!step) {
+            ++m_stalls;
+            deadline = now + m_timeout;
+        }
+        else if (m_timeout.count() && now >= deadline) {
+            ++m_drops;
+            return false;
+        }
+
+        // Other producers may proceed meanwhile
+        lock.unlock();
+        backoff(step);
+        lock.lock();
+    }
+
+    auto put_header = [this](uint64_t pos, uint32_t type_, uint32_t size_, uint64_t stream_) {
+        unsigned char * rec = m_data + pos % m_capacity;
+        std::memcpy(rec,     &type_,   4);
+        std::memcpy(rec + 4, &size_,   4);
+        std::memcpy(rec + 8, &stream_, 8);
+    };
+
+    if (pad >= record_header)
+        put_header(head, PAD, pad - record_header, 0);
+
+    const uint64_t pos = head + pad;
+    put_header(pos, type, size1 + size2, stream);
+
+    unsigned char * payload = m_data + pos % m_capacity + record_header;
+    if (size1) std::memcpy(payload,         data1, size1);
+    if (size2) std::memcpy(payload + size1, data2, size2);
+
+    m_header->head.store(pos + size, std::memory_order_release);
+    return true;
+}
+
+
+void shm_ring::close() {
+    m_header->closed.store(1, std::memory_order_release);
+}
+
+
+bool shm_ring::read(record & rec, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    unsigned   step     = 0;
+
+    for (;;) {
+        const uint64_t head = m_header->head.load(std::memory_order_acquire);
+
+        if (m_read == head) {
+            if (m_header->closed.load(std::memory_order_acquire)) {
+                // Closed after the last write, re-check
+                if (head == m_header->head.load(std::memory_order_acquire))
+                    return false;
+
+                continue;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+
+            backoff(step);
+            continue;
+        }
+
+        const size_t to_end = m_capacity - m_read % m_capacity;
+        if (to_end < record_header) {  // skipped end of data area
+            m_read += to_end;
+            continue;
+        }
+
+        const unsigned char * hdr = m_data + m_read % m_capacity;
+        std::memcpy(&rec.type,   hdr,     4);
+        std::memcpy(&rec.size,   hdr + 4, 4);
+        std::memcpy(&rec.stream, hdr + 8, 8);
+        rec.data = hdr + record_header;
+
+        m_read += record_size(rec.size);
+
+        if (PAD != rec.type) return true;
+    }
+}
+
+
+void shm_ring::release() {
+    m_header->tail.store(m_read, std::memory_order_release);
+}
+
+
+bool shm_ring::done() const {
+    return m_header->closed.load(std::memory_order_acquire) &&
+        m_read == m_header->head.load(std::memory_order_acquire);
+}
+
+
+shm_ring::~shm_ring() {
+    if (m_owner && m_header) close();
+
+    // Detach consumer
+    if (!m_owner && m_header) {
+        uint32_t pid = ::getpid();
+        m_header->consumer.compare_exchange_strong(pid, 0);
+    }
+
+    if (m_header) ::munmap(m_header, shm_header_size + m_capacity);
+    if (m_owner)  ::shm_unlink(m_name.c_str());
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,268 @@
+#ifndef fastcrawl__shm_ring_hxx
+#define fastcrawl__shm_ring_hxx
+
+/**
+ *  \file
+ *  \brief  Shared memory record ring
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Shared memory record ring
+ *
+ *  Single-consumer ring buffer of records in a POSIX shared memory object
+ *  (see \c shm_open), for passing downloaded content to other processes
+ *  without copies or disk round-trips.
+ *  The crawler process creates the ring (producer side, thread-safe);
+ *  a consumer process attaches to it by name and reads the records
+ *  in place (zero-copy).
+ *
+ *  Flow control: the producer waits while the ring is full, i.e.
+ *  a slow consumer backpressures the producer; nothing is lost.
+ *  The consumer process registers itself in the ring header; records
+ *  that don't fit are only dropped (and counted) when no consumer
+ *  is attached (none yet, detached or dead), or, if the producer opts
+ *  in by setting a timeout, when the consumer doesn't free space in time.
+ *
+ *  Layout (host byte order, offsets in bytes):
+ *  \code
+ *      Header (4096 B):
+ *      0    char[8]   magic "FCSHMRG1"
+ *      8    uint32    layout version (1)
+ *      12   uint32    header size (4096, data area offset)
+ *      16   uint64    data area capacity (multiple of 8)
+ *      64   uint64    head: write position (bytes written, ever)
+ *      128  uint64    tail: read position (bytes consumed, ever)
+ *      192  uint32    closed: non-zero when the producer is done
+ *      196  uint32    consumer: attached consumer PID (0 if none)
+ *
+ *      Data area: records at head/tail position modulo capacity
+ *      Record header (16 B):
+ *      0    uint32    type (see record_type)
+ *      4    uint32    payload size
+ *      8    uint64    stream ID
+ *      16   ...       payload (padded to 8 B)
+ *  \endcode
+ *
+ *  Positions grow monotonically; head, tail and closed are accessed
+ *  atomically (the producer publishes the head with release semantics,
+ *  the consumer the tail).
+ *  Records never wrap around the data area end: if a record doesn't fit,
+ *  a \c PAD record fills the rest of the area (less than 16 B left are
+ *  just skipped).
+ *
+ *  Record payloads:
+ *  - \c CHUNK: a content data chunk of the stream
+ *  - \c END: none; the stream (one download attempt) is over
+ *  - \c COMPLETION: \c uint64 content size, \c uint32 Adler32 checksum,
+ *    \c uint32 success flag and the URI (the rest of the payload);
+ *    stream ID is the content stream (0 if none)
+ */
+class shm_ring {
+    public:
+
+    /** Record types */
+    enum record_type {
+        PAD        = 0,  /**< Padding (to be skipped)  */
+        CHUNK      = 1,  /**< Content data chunk       */
+        END        = 2,  /**< End of stream            */
+        COMPLETION = 3,  /**< Download completion      */
+    };  // end of enum record_type
+
+    /** Record (as read by the consumer) */
+    struct record {
+        uint32_t              type;    /**< Record type (see record_type) */
+        uint32_t              size;    /**< Payload size                  */
+        uint64_t              stream;  /**< Stream ID                     */
+        const unsigned char * data;    /**< Payload (in the ring)         */
+
+    };  // end of struct record
+
+    /** Default data area capacity */
+    static const size_t default_capacity = 64 << 20;
+
+    private:
+
+    struct header;  // see layout
+
+    const std::string               m_name;      /**< Shared memory object name      */
+    const bool                      m_owner;     /**< Producer (owner) side          */
+    header *                        m_header;    /**< Mapped header                  */
+    unsigned char *                 m_data;      /**< Mapped data area               */
+    size_t                          m_capacity;  /**< Data area capacity             */
+    const std::chrono::milliseconds m_timeout;   /**< Max. wait for consumer (or 0)  */
+    std::mutex                      m_mutex;     /**< Producers mutex                */
+    std::atomic<size_t>             m_stalls;    /**< Producer waits for consumer    */
+    std::atomic<size_t>             m_drops;     /**< Records dropped                */
+    uint64_t                        m_read;      /**< Consumer: next record position */
+
+    /** Map the object */
+    void map(int fd, size_t size);
+
+    /** Consumer process is attached and alive */
+    bool consumer_alive() const;
+
+    public:
+
+    /** Max. payload size of a record */
+    size_t max_payload() const { return m_capacity / 4; }
+
+    /**
+     *  \brief  Constructor (producer side)
+     *
+     *  Creates the shared memory object (replacing a stale one).
+     *  It's removed when the producer is destroyed (the consumer keeps
+     *  its mapping).
+     *
+     *  \param  name      Shared memory object name (e.g. \c /fcrawl)
+     *  \param  capacity  Data area capacity
+     *  \param  timeout   Max. time to wait for the consumer to free space
+     *                    (0 means unbounded; records are only dropped
+     *                    if there's no live consumer)
+     *
+     *  \throw  std::runtime_error if the object can't be created
+     */
+    shm_ring(
+        const std::string &       name,
+        size_t                    capacity,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     *  \brief  Constructor (consumer side)
+     *
+     *  Attaches to existing ring and registers the process as its
+     *  (only) consumer.
+     *
+     *  \param  name  Shared memory object name
+     *
+     *  \throw  std::runtime_error if the object can't be mapped
+     *          or isn't a ring
+     */
+    shm_ring(const std::string & name);
+
+    shm_ring(const shm_ring & ) = delete;
+    shm_ring & operator = (const shm_ring & ) = delete;
+
+    /** Shared memory object name */
+    const std::string & name() const { return m_name; }
+
+    /** Data area capacity */
+    size_t capacity() const { return m_capacity; }
+
+    /**
+     *  \brief  Write record (producer)
+     *
+     *  The payload is concatenated from 2 parts.
+     *  Waits while there's not enough space in the ring (with the producers
+     *  mutex released, other producers may write meanwhile).
+     *  The record is dropped (see \ref drops) if there's no live consumer
+     *  or the timeout (if set) expires.
+     *
+     *  \param  type    Record type
+     *  \param  stream  Stream ID
+     *  \param  data1   Payload part 1
+     *  \param  size1   Payload part 1 size
+     *  \param  data2   Payload part 2
+     *  \param  size2   Payload part 2 size
+     *
+     *  \return \c true iff the record was written
+     *
+     *  \throw  std::length_error if the total payload size exceeds
+     *          \ref max_payload
+     */
+    bool write(
+        record_type  type,
+        uint64_t     stream,
+        const void * data1 = nullptr,
+        size_t       size1 = 0,
+        const void * data2 = nullptr,
+        size_t       size2 = 0);
+
+    /** Number of times the producer waited for the consumer */
+    size_t stalls() const { return m_stalls; }
+
+    /** Number of records dropped (no consumer or timeout) */
+    size_t drops() const { return m_drops; }
+
+    /** A consumer is attached (producer) */
+    bool attached() const { return consumer_alive(); }
+
+    /** Mark the ring closed (producer) */
+    void close();
+
+    /**
+     *  \brief  Read next record (consumer)
+     *
+     *  The record payload stays valid in the ring until \ref release
+     *  is called.
+     *
+     *  \param  rec      Record
+     *  \param  timeout  Max. time to wait for a record
+     *
+     *  \return \c true iff a record was read
+     */
+    bool read(record & rec, std::chrono::milliseconds timeout);
+
+    /** Release records read so far (consumer) */
+    void release();
+
+    /** The producer is done and all the records were read (consumer) */
+    bool done() const;
+
+    /**
+     *  \brief  Destructor
+     *
+     *  Unmaps the ring; the producer closes the ring and removes
+     *  the object, the consumer detaches.
+     */
+    ~shm_ring();
+
+};  // end of class shm_ring
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__shm_ring_hxx
@@ -0,0 +1,85 @@
+/**
+ *  \file
+ *  \brief  Shared memory content sink
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shm_sink.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace fastcrawl {
+
+void shm_sink::stream::operator () (unsigned char * data, size_t size) {
+    const size_t max = m_sink.m_ring.max_payload();
+
+    while (size && !m_dropped) {
+        const size_t len = std::min(size, max);
+        m_dropped = !m_sink.m_ring.write(shm_ring::CHUNK, m_id, data, len);
+
+        data += len; size -= len;
+    }
+}
+
+
+void shm_sink::add_to(processor_registry & registry, const std::string & name) {
+    registry.add(name, [this](processor_pipeline & pipeline, uri_record & record) {
+        pipeline.emplace<stream>(*this, record);
+    });
+}
+
+
+void shm_sink::completion(const std::string & uri_str, const uri_record & record) {
+    // size, adler32, success, URI
+    unsigned char fields[16];
+    const uint64_t size    = record.size;
+    const uint32_t adler32 = record.digests.adler32;
+    const uint32_t success = record.success;
+
+    std::memcpy(fields,      &size,    8);
+    std::memcpy(fields + 8,  &adler32, 4);
+    std::memcpy(fields + 12, &success, 4);
+
+    const size_t uri_len = std::min(uri_str.size(), m_ring.max_payload() - sizeof(fields));
+
+    m_ring.write(shm_ring::COMPLETION, record.stream,
+        fields, sizeof(fields), uri_str.data(), uri_len);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,179 @@
+#ifndef fastcrawl__shm_sink_hxx
+#define fastcrawl__shm_sink_hxx
+
+/**
+ *  \file
+ *  \brief  Shared memory content sink
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shm_ring.hxx"
+#include "online_data_processor.hxx"
+#include "processor_pipeline.hxx"
+#include "uri_record.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Shared memory content sink
+ *
+ *  Publishes downloaded content and download completions to consumer
+ *  processes via \ref shm_ring (see the ring layout there).
+ *
+ *  Each download attempt (retries and hedged requests included) is
+ *  a stream of \c CHUNK records, terminated by an \c END record;
+ *  the stream ID is stored in the download record (\ref uri_record::stream).
+ *  The \c COMPLETION record refers to the stream that holds the content
+ *  (the other streams of the URI are to be discarded by the consumer).
+ *
+ *  The streams are produced by the \c shm data processor (see \ref add_to);
+ *  completions are published by \ref completion (e.g. from the crawler
+ *  completion callback).
+ *  A slow consumer backpressures the downloads (see \ref shm_ring::write).
+ *  Records are only dropped if there's no live consumer (or, if set,
+ *  the ring timeout expires).
+ *  If a chunk is dropped, the rest of the stream is dropped, too, so
+ *  the consumer gets a prefix of the content (shorter than the completion
+ *  content size) or nothing; END and COMPLETION records may be dropped
+ *  as well.
+ */
+class shm_sink {
+    public:
+
+    /** Content stream (online data processor) */
+    class stream: public online_data_processor {
+        private:
+
+        shm_sink &     m_sink;     /**< Sink                 */
+        const uint64_t m_id;       /**< Stream ID            */
+        bool           m_dropped;  /**< A chunk was dropped  */
+
+        public:
+
+        /**
+         *  \brief  Constructor
+         *
+         *  \param  sink    Sink
+         *  \param  record  Download record (gets the stream ID)
+         */
+        stream(shm_sink & sink, uri_record & record):
+            m_sink(sink),
+            m_id(++sink.m_streams),
+            m_dropped(false)
+        {
+            record.stream = m_id;
+        }
+
+        /** Implements \ref online_data_processor::operator() */
+        void operator () (unsigned char * data, size_t size);
+
+        /** Destructor (ends the stream) */
+        ~stream() { m_sink.m_ring.write(shm_ring::END, m_id); }
+
+    };  // end of class stream
+
+    private:
+
+    shm_ring              m_ring;     /**< Ring                */
+    std::atomic<uint64_t> m_streams;  /**< Stream ID generator */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  name      Shared memory object name (e.g. \c /fcrawl)
+     *  \param  capacity  Ring capacity
+     *  \param  timeout   Max. time to wait for the consumer (0 means
+     *                    unbounded)
+     *
+     *  \throw  std::runtime_error if the ring can't be created
+     */
+    shm_sink(
+        const std::string &       name,
+        size_t                    capacity = shm_ring::default_capacity,
+        std::chrono::milliseconds timeout  = std::chrono::milliseconds(0))
+    :
+        m_ring(name, capacity, timeout),
+        m_streams(0)
+    {}
+
+    /** Ring */
+    const shm_ring & ring() const { return m_ring; }
+
+    /**
+     *  \brief  Register the \c shm data processor
+     *
+     *  The processor publishes the content (add it to the pipeline,
+     *  see \ref pipeline_builder).
+     *  Add the Adler32 digest to the pipeline, too; the completion
+     *  checksum is taken from the download record.
+     *  The sink must outlive the downloads.
+     *
+     *  \param  registry  Processor registry
+     *  \param  name      Processor name
+     */
+    void add_to(
+        processor_registry & registry = processor_registry::global(),
+        const std::string &  name     = "shm");
+
+    /**
+     *  \brief  Publish download completion
+     *
+     *  Thread-safe.
+     *  The Adler32 checksum is 0 unless the digest was computed
+     *  (see \ref content_digests::ADLER32).
+     *
+     *  \param  uri_str  Content URI
+     *  \param  record   Download record
+     */
+    void completion(const std::string & uri_str, const uri_record & record);
+
+    /** Close the ring (no more records) */
+    void close() { m_ring.close(); }
+
+};  // end of class shm_sink
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__shm_sink_hxx
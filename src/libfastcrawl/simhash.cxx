@@ -0,0 +1,137 @@
+/**
+ *  \file
+ *  \brief  SimHash content fingerprint
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simhash.hxx"
+
+
+namespace fastcrawl {
+
+/** FNV-1a offset basis */
+static const uint64_t fnv_basis = 0xcbf29ce484222325ull;
+
+/** FNV-1a prime */
+static const uint64_t fnv_prime = 0x100000001b3ull;
+
+
+/** 64-bit mixer (SplitMix64 finaliser), spreads feature hash bits */
+static inline uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+
+/** Feature votes on fingerprint bits */
+static inline void vote(int32_t * votes, uint64_t feature) {
+    for (unsigned i = 0; i < simhash::bits; ++i)
+        votes[i] += (int32_t)((feature >> i) & 1) * 2 - 1;
+}
+
+
+/** Word character check (ASCII alphanumeric or non-ASCII) */
+static inline bool word_char(unsigned char c) {
+    return (unsigned char)((c | 0x20) - 'a') < 26 ||
+        (unsigned char)(c - '0') < 10 || c >= 0x80;
+}
+
+
+simhash::simhash(uint64_t & result):
+    m_word(fnv_basis),
+    m_prev(0),
+    m_in_word(false),
+    m_in_tag(false),
+    m_result(result)
+{
+    for (auto & vote: m_votes) vote = 0;
+}
+
+
+void simhash::word() {
+    vote(m_votes, mix(m_prev * fnv_prime + m_word));
+
+    m_prev    = m_word;
+    m_word    = fnv_basis;
+    m_in_word = false;
+}
+
+
+void simhash::operator () (unsigned char * data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        const unsigned char c = data[i];
+
+        if (m_in_tag) {
+            m_in_tag = '>' != c;
+            continue;
+        }
+
+        if (word_char(c)) {
+            // Letters are case-folded
+            const unsigned char fc = (unsigned char)((c | 0x20) - 'a') < 26
+                ? c | 0x20 : c;
+
+            m_word    = (m_word ^ fc) * fnv_prime;
+            m_in_word = true;
+        }
+        else {
+            if (m_in_word) word();
+            m_in_tag = '<' == c;
+        }
+    }
+}
+
+
+uint64_t simhash::fingerprint() const {
+    int32_t votes[bits];
+    for (unsigned i = 0; i < bits; ++i) votes[i] = m_votes[i];
+
+    // Pending word
+    if (m_in_word) vote(votes, mix(m_prev * fnv_prime + m_word));
+
+    uint64_t fp = 0;
+    for (unsigned i = 0; i < bits; ++i)
+        if (votes[i] > 0) fp |= (uint64_t)1 << i;
+
+    return fp;
+}
+
+
+simhash::~simhash() { m_result = fingerprint(); }
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,109 @@
+#ifndef fastcrawl__simhash_hxx
+#define fastcrawl__simhash_hxx
+
+/**
+ *  \file
+ *  \brief  SimHash content fingerprint
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  SimHash content fingerprint
+ *
+ *  The data processor computes 64-bit SimHash (Charikar) of the content
+ *  online.
+ *  The content features are word bigrams; words are runs of ASCII
+ *  alphanumeric characters (case-insensitive) and non-ASCII bytes.
+ *  Markup (anything between \c '<' and \c '>') is skipped; otherwise,
+ *  the tags repeated all over the page (same in all pages of a site)
+ *  would outvote the text.
+ *  Each feature hash votes on every fingerprint bit; the fingerprint bit
+ *  is set iff the majority of the votes is positive.
+ *
+ *  Similar documents have fingerprints of small Hamming distance
+ *  (see \ref distance and \ref fingerprint_index); the fingerprint
+ *  doesn't depend on how the content is split to chunks.
+ */
+class simhash: public online_data_processor {
+    public:
+
+    /** Fingerprint size [bit] */
+    static const unsigned bits = 64;
+
+    private:
+
+    int32_t    m_votes[bits];   /**< Bit votes                  */
+    uint64_t   m_word;          /**< Current word hash          */
+    uint64_t   m_prev;          /**< Previous word hash         */
+    bool       m_in_word;       /**< Within a word              */
+    bool       m_in_tag;        /**< Within markup               */
+    uint64_t & m_result;        /**< Final result               */
+
+    /** Word finished (its bigram with the previous word votes) */
+    void word();
+
+    public:
+
+    /** Constructor, takes reference to the result */
+    simhash(uint64_t & result);
+
+    void operator () (unsigned char * data, size_t size);
+
+    /** Fingerprint (of the content processed so far) */
+    uint64_t fingerprint() const;
+
+    /** Hamming distance of fingerprints */
+    static unsigned distance(uint64_t fp1, uint64_t fp2) {
+        return __builtin_popcountll(fp1 ^ fp2);
+    }
+
+    /** Destructor makes the result assignment */
+    ~simhash();
+
+};  // end of class simhash
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__simhash_hxx
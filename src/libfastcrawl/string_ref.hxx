@@ -0,0 +1,112 @@
+#ifndef fastcrawl__string_ref_hxx
+#define fastcrawl__string_ref_hxx
+
+/**
+ *  \file
+ *  \brief  String reference
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "xxh3.hxx"
+
+#include <string>
+#include <iostream>
+#include <cstring>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  String reference
+ *
+ *  Non-owning reference to a character sequence (e.g. a string interned
+ *  in an \ref arena); cheap to copy and compare.
+ */
+class string_ref {
+    private:
+
+    const char * m_data;  /**< Characters */
+    size_t       m_size;  /**< Size       */
+
+    public:
+
+    /** Hash function (XXH3) */
+    struct hash {
+        size_t operator () (const string_ref & str) const {
+            return (size_t)xxh3::hash(
+                (const unsigned char *)str.m_data, str.m_size);
+        }
+
+    };  // end of struct hash
+
+    string_ref(): m_data(""), m_size(0) {}
+
+    string_ref(const char * data, size_t size): m_data(data), m_size(size) {}
+
+    /** Reference to \c std::string (mustn't outlive it) */
+    string_ref(const std::string & str): m_data(str.data()), m_size(str.size()) {}
+
+    const char * data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+
+    bool empty() const { return 0 == m_size; }
+
+    char operator [] (size_t i) const { return m_data[i]; }
+
+    /** Copy to string */
+    std::string str() const { return std::string(m_data, m_size); }
+
+    bool operator == (const string_ref & arg) const {
+        return m_size == arg.m_size &&
+            0 == std::memcmp(m_data, arg.m_data, m_size);
+    }
+
+    bool operator != (const string_ref & arg) const { return !(*this == arg); }
+
+};  // end of class string_ref
+
+
+/** String reference serialisation */
+inline std::ostream & operator << (std::ostream & out, const string_ref & str) {
+    return out.write(str.data(), str.size());
+}
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__string_ref_hxx
@@ -41,60 +41,143 @@
 #include "thread_pool.hxx"
 #include "utility.hxx"
 
+#include <algorithm>
+#include <functional>
+
 
 namespace fastcrawl {
 
+constexpr std::chrono::milliseconds thread_pool::default_idle_timeout;
+
+/** Pool of the current thread (if it's a pool thread) */
+static thread_local const thread_pool * t_pool = nullptr;
+
+
+void thread_pool::job_queue::grow() {
+    std::vector<queued_job> slots(2 * m_slots.size());
+    for (size_t i = 0; i < m_size; ++i)
+        slots[i] = std::move(m_slots[(m_head + i) & mask()]);
+
+    m_slots.swap(slots);
+    m_head = 0;
+}
+
+
+thread_pool::thread_pool(size_t tmin, size_t tmax):
+    m_tmin(tmin),
+    m_tmax(tmax),
+    m_queue_limit(SIZE_MAX),
+    m_drain_waiters(0),
+    m_drain_jobs(0),
+    m_idle_timeout(default_idle_timeout),
+    m_tstarting(0),
+    m_tbusy(0),
+    m_tidle(0),
+    m_retire(0),
+    m_shutdown(false),
+    m_stats()
+{
+    start_thread(m_tmin);
+}
+
+
 size_t thread_pool::size(size_t thread_cnt) {
-    std::lock_guard<std::mutex> thread_list_lock(m_thread_list_mutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    // Start missing threads
     const size_t thread_list_size = m_thread_list.size();
-    if (thread_list_size < thread_cnt)
+
+    // Start missing threads
+    if (thread_list_size < thread_cnt) {
+        m_retire = 0;
         start_thread_impl(thread_cnt - thread_list_size);
+    }
+
+    // Retire surplus threads
+    else {
+        m_retire = thread_list_size - thread_cnt;
+        m_job_ready.notify_all();
+    }
 
     return m_thread_list.size();
 }
 
 
-bool thread_pool::run(thread_pool::job_t job) {
-    size_t tbusy;
+thread_pool::stats_t thread_pool::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stats_t stats = m_stats;
+    stats.size   = m_thread_list.size();
+    stats.busy   = m_tbusy;
+    stats.queued = m_job_queue.size();
+
+    return stats;
+}
+
 
-    {
-        std::lock_guard<std::mutex> job_queue_lock(m_job_queue_mutex);
+bool thread_pool::wait_drained(duration timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
 
-        if (m_shutdown) return false;  // no more jobs accepted
+    if (m_job_queue.size() < m_queue_limit) return true;
 
-        // Push job to job queue
-        m_job_queue.push(job);
-        m_job_ready.notify_one();
+    // A job mustn't wait if all the busy threads do (nobody would drain)
+    const bool job = this == t_pool;
+    auto stalled = [this, job]() { return job && m_drain_jobs >= m_tbusy; };
 
-        tbusy = m_tbusy;
+    ++m_stats.throttled;
+    ++m_drain_waiters;
+    if (job) {
+        ++m_drain_jobs;
+        m_drained.notify_all();  // the waiting jobs may be stalled now
     }
 
-    // Check if another tread should be started
-    std::lock_guard<std::mutex> thread_list_lock(m_thread_list_mutex);
-    if (m_thread_list.size() == tbusy) start_thread_impl();
+    m_drained.wait_for(lock, timeout, [this, &stalled]() {
+        return m_job_queue.size() <= m_queue_limit / 2 || m_shutdown || stalled();
+    });
+
+    const bool ready = m_job_queue.size() < m_queue_limit || stalled();
+
+    --m_drain_waiters;
+    if (job) --m_drain_jobs;
+
+    return ready;
+}
+
+
+bool thread_pool::run(thread_pool::job_t job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_shutdown) return false;  // no more jobs accepted
+
+    join_retired();
+
+    // Push job to job queue
+    m_job_queue.push(std::move(job), clock_t::now());
+    m_job_ready.notify_one();
+
+    spawn_if_needed();
 
     return true;
 }
 
 
 void thread_pool::shutdown() {
-    {
-        std::lock_guard<std::mutex> job_queue_lock(m_job_queue_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
 
-        if (m_shutdown) return;  // already down
+    if (m_shutdown) return;  // already down
 
-        // Signalise shutdown to threads
-        m_shutdown = true;
-        m_job_ready.notify_all();
-    }
+    // Signalise shutdown to threads
+    m_shutdown = true;
+    m_job_ready.notify_all();
+    m_drained.notify_all();
 
-    // Join threads
-    std::lock_guard<std::mutex> thread_list_lock(m_thread_list_mutex);
+    // Join threads (the list isn't modified after shutdown)
+    lock.unlock();
 
     for (auto & thread: m_thread_list)
         thread.join();
+
+    lock.lock();
+    join_retired();
 }
 
 
@@ -110,34 +193,114 @@ size_t thread_pool::start_thread_impl(size_t tcnt) {
         m_thread_list.emplace_back(
             std::bind(&thread_pool::routine, this));
 
+    m_tstarting     += tcnt;
+    m_stats.spawned += tcnt;
+    m_stats.peak = std::max(m_stats.peak, m_thread_list.size());
+
     return tcnt;
 }
 
 
+void thread_pool::spawn_if_needed() {
+    if (m_tstarting) return;  // the starting thread will check the backlog
+
+    if (m_job_queue.size() > m_tidle) start_thread_impl();
+}
+
+
+void thread_pool::join_retired() {
+    for (auto & thread: m_retired_list)
+        thread.join();
+
+    m_retired_list.clear();
+}
+
+
+thread_pool::thread_list_t thread_pool::retire() {
+    const auto id = std::this_thread::get_id();
+    const auto thread = std::find_if(m_thread_list.begin(), m_thread_list.end(),
+        [id](const std::thread & thread) { return thread.get_id() == id; });
+
+    // The thread can't join itself; it will be joined by the next
+    // retiring thread (or run, or shutdown)
+    thread_list_t retired;
+    retired.swap(m_retired_list);
+    m_retired_list.splice(m_retired_list.end(), m_thread_list, thread);
+
+    if (m_retire) --m_retire;  // surplus thread gone (retired on idleness)
+    ++m_stats.retired;
+
+    return retired;
+}
+
+
 void thread_pool::routine() {
-    std::unique_lock<std::mutex> job_queue_lock(m_job_queue_mutex);
+    t_pool = this;
 
-    while (!m_shutdown) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    --m_tstarting;
+
+    thread_list_t retired;  // to be joined when retiring
+
+    for (;;) {
         // Execute queued jobs
         while (m_job_queue.size()) {
-            auto job = m_job_queue.front();
+            auto job = std::move(m_job_queue.front().j);
+
+            const duration wait = clock_t::now() - m_job_queue.front().queued;
             m_job_queue.pop();
 
+            // Queue drained enough for the throttled producers
+            if (m_drain_waiters && m_job_queue.size() <= m_queue_limit / 2)
+                m_drained.notify_all();
+
+            m_stats.queue_wait += wait;
+            m_stats.queue_wait_max = std::max(m_stats.queue_wait_max, wait);
+
+            // Backlog remains, the pool may grow
+            if (!m_shutdown) spawn_if_needed();
+
             ++m_tbusy;
-            job_queue_lock.unlock();
+            lock.unlock();
 
-            run_at_eos(([this, &job_queue_lock]() {
-                job_queue_lock.lock();
+            run_at_eos(([this, &lock]() {
+                lock.lock();
                 --m_tbusy;
+                ++m_stats.executed;
             }));
 
             job();  // run job
         }
 
-        if (m_shutdown) break;  // shutdown was signalised while executing jobs
+        // Queued jobs are all executed before the thread ends
+        if (m_shutdown) break;
+
+        // Retire on request
+        if (m_retire) {
+            retired = retire();
+            break;
+        }
 
-        m_job_ready.wait(job_queue_lock);  // wait for job
+        // Wait for job
+        ++m_tidle;
+        const auto status = m_job_ready.wait_for(lock, m_idle_timeout);
+        --m_tidle;
+
+        // Retire if idle for too long
+        if (std::cv_status::timeout == status &&
+            m_job_queue.empty() && !m_shutdown &&
+            m_thread_list.size() > m_tmin)
+        {
+            retired = retire();
+            break;
+        }
     }
+
+    // Join the threads retired before (they're done with the pool)
+    lock.unlock();
+    for (auto & thread: retired)
+        thread.join();
 }
 
 }  // end of namespace fastcrawl
@@ -41,51 +41,160 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <queue>
+#include "job.hxx"
+
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
-#include <functional>
+#include <chrono>
 #include <list>
+#include <utility>
 #include <cstdint>
 
 
 namespace fastcrawl {
 
 /**
- *  \brief  Simple thread pool with automatic thread addition
+ *  \brief  Elastic thread pool
  *
  *  The pool keeps ready threads that execute jobs from a queue.
- *  The jobs are \c std::function objects without arguments and return value.
+ *  The jobs are move-only callables without arguments and return value
+ *  (see \ref job).
  *  The pool size (i.e. number of pooled threads) may be limited to avoid
  *  excessive thread creation.
  *
  *  When a new job is being pushed to the job queue, thread availability
  *  is checked.
- *  If all threads are currently busy, another thread is started pro-actively
- *  unless thread limit is reached.
+ *  If there are more queued jobs than idle threads, another thread is
+ *  started pro-actively unless thread limit is reached.
+ *  To damp spawn storms (e.g. a burst of jobs), only one thread is being
+ *  started at a time; the new thread checks whether the backlog persists
+ *  (after it took its job) and only then starts another one.
+ *  So, the pool doesn't overshoot when the backlog clears quickly.
+ *
+ *  Threads over \c tmin that stay idle for the idle timeout are retired
+ *  (see \ref idle_timeout), so that the pool shrinks back after a burst.
+ *  A retiring thread joins the threads retired before it, so at most
+ *  one retired thread (the last one) awaits joining at any time.
+ *  Idle retirements count towards the surplus threads requested
+ *  to retire by \ref size.
+ *
+ *  The job queue may be limited (see \ref queue_limit).
+ *  The limit doesn't cause \ref run to block or refuse jobs; instead,
+ *  job producers are expected to check \ref saturated and throttle
+ *  (e.g. pause the download being crawled) until the queue drains
+ *  (see \ref wait_drained).
+ *  The producers may be the pool jobs themselves (e.g. stylesheet
+ *  downloads); a job doesn't wait if all the busy threads wait
+ *  for the queue to drain (nobody would drain it).
  */
 class thread_pool {
     public:
 
-    using job_t = std::function<void ()>;  /**< Thread job type */
+    using job_t    = job;                           /**< Thread job type */
+    using clock_t  = std::chrono::steady_clock;     /**< Pool clock      */
+    using duration = clock_t::duration;             /**< Time duration   */
+
+    /** Default idle timeout */
+    static constexpr std::chrono::milliseconds default_idle_timeout{10000};
+
+    /** Thread pool counters */
+    struct stats_t {
+        size_t   size;              /**< Current number of threads   */
+        size_t   busy;              /**< Busy threads                */
+        size_t   queued;            /**< Queued jobs                 */
+        size_t   peak;              /**< Max. number of threads      */
+        size_t   spawned;           /**< Started threads (total)     */
+        size_t   retired;           /**< Retired threads (total)     */
+        size_t   executed;          /**< Executed jobs (total)       */
+        duration queue_wait;        /**< Total job queue wait time   */
+        duration queue_wait_max;    /**< Max. job queue wait time    */
+        size_t   throttled;         /**< Waits for queue to drain    */
+
+    };  // end of struct stats_t
 
     private:
 
+    /** Queued job */
+    struct queued_job {
+        job_t               j;          /**< The job       */
+        clock_t::time_point queued;     /**< Queueing time */
+
+    };  // end of struct queued_job
+
+    /**
+     *  \brief  Job queue
+     *
+     *  Ring buffer, grows by doubling; unlike \c std::queue (over
+     *  \c std::deque), it doesn't allocate memory in steady state.
+     */
+    class job_queue {
+        private:
+
+        std::vector<queued_job> m_slots;    /**< Slots (power of 2) */
+        size_t                  m_head;     /**< Queue head         */
+        size_t                  m_size;     /**< Queue size         */
+
+        /** Slot index mask */
+        size_t mask() const { return m_slots.size() - 1; }
+
+        /** Double the capacity */
+        void grow();
+
+        public:
+
+        job_queue(): m_slots(64), m_head(0), m_size(0) {}
+
+        size_t size() const { return m_size; }
+
+        bool empty() const { return 0 == m_size; }
+
+        /** Queue head */
+        queued_job & front() { return m_slots[m_head]; }
+
+        /** Push job */
+        void push(job_t && j, clock_t::time_point queued) {
+            if (m_slots.size() == m_size) grow();
+
+            queued_job & slot = m_slots[(m_head + m_size) & mask()];
+            slot.j      = std::move(j);
+            slot.queued = queued;
+            ++m_size;
+        }
+
+        /** Pop queue head */
+        void pop() {
+            m_slots[m_head].j.reset();
+            m_head = (m_head + 1) & mask();
+            --m_size;
+        }
+
+    };  // end of class job_queue
+
     using thread_list_t = std::list<std::thread>;   /**< Thread list type */
-    using job_queue_t   = std::queue<job_t>;        /**< Job queue type   */
+    using job_queue_t   = job_queue;                /**< Job queue type   */
 
-    const size_t                    m_tmin;         /**< Pre-started threads */
-    const size_t                    m_tmax;         /**< Thread limit        */
-    size_t                          m_tbusy;        /**< Busy threads count  */
-    bool                            m_shutdown;     /**< Pool shutdown flag  */
-    thread_list_t                   m_thread_list;  /**< Pooled threads list */
-    job_queue_t                     m_job_queue;    /**< Job queue           */
+    const size_t            m_tmin;             /**< Pre-started threads     */
+    const size_t            m_tmax;             /**< Thread limit            */
+    size_t                  m_queue_limit;      /**< Job queue limit         */
+    size_t                  m_drain_waiters;    /**< Waiting for queue drain */
+    size_t                  m_drain_jobs;       /**< Jobs of those waiting   */
+    duration                m_idle_timeout;     /**< Idle thread timeout     */
+    size_t                  m_tstarting;        /**< Starting threads count  */
+    size_t                  m_tbusy;            /**< Busy threads count      */
+    size_t                  m_tidle;            /**< Idle threads count      */
+    size_t                  m_retire;           /**< Threads to be retired   */
+    bool                    m_shutdown;         /**< Pool shutdown flag      */
+    thread_list_t           m_thread_list;      /**< Pooled threads list     */
+    thread_list_t           m_retired_list;     /**< Retired threads to join */
+    job_queue_t             m_job_queue;        /**< Job queue               */
+    stats_t                 m_stats;            /**< Counters                */
 
     // MT sync
-    mutable std::mutex              m_thread_list_mutex;
-    mutable std::mutex              m_job_queue_mutex;
-    mutable std::condition_variable m_job_ready;
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_job_ready;
+    std::condition_variable m_drained;
 
     public:
 
@@ -93,35 +202,89 @@ class thread_pool {
      *  \brief  Constructor
      *
      *  \param  tmin  Number of threads available in the pool from the start
+     *                (these are never retired for idleness)
      *  \param  tmax  Max. amount of threads in the pool
      */
     thread_pool(
         size_t tmin,
-        size_t tmax = SIZE_MAX)
-    :
-        m_tmin(tmin),
-        m_tmax(tmax),
-        m_tbusy(0),
-        m_shutdown(false)
-    {
-        start_thread(m_tmin);
-    }
+        size_t tmax = SIZE_MAX);
 
     /** Thread pool size (amount of threads) getter */
     size_t size() const {
-        std::lock_guard<std::mutex> thread_list_lock(m_thread_list_mutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         return m_thread_list.size();
     }
 
-    /** Thread pool size (amount of threads) setter */
-    size_t size(size_t);
+    /**
+     *  \brief  Thread pool size (amount of threads) setter
+     *
+     *  Starts missing threads or asks surplus threads to retire
+     *  (busy threads retire after they finish their job).
+     *
+     *  \param  tcnt  Required number of threads
+     *
+     *  \return Number of threads (before the surplus threads retire)
+     */
+    size_t size(size_t tcnt);
 
     /** Number of currently busy treads */
     size_t busy() const {
-        std::lock_guard<std::mutex> job_queue_lock(m_job_queue_mutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         return m_tbusy;
     }
 
+    /** Idle thread timeout getter */
+    duration idle_timeout() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle_timeout;
+    }
+
+    /** Idle thread timeout setter */
+    void idle_timeout(duration timeout) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle_timeout = timeout;
+    }
+
+    /** Job queue limit getter */
+    size_t queue_limit() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue_limit;
+    }
+
+    /**
+     *  \brief  Job queue limit setter
+     *
+     *  \param  limit  Max. number of queued jobs (\c SIZE_MAX means no limit)
+     */
+    void queue_limit(size_t limit) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue_limit = limit ? limit : 1;
+    }
+
+    /** Job queue reached the limit (producers should throttle) */
+    bool saturated() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_job_queue.size() >= m_queue_limit;
+    }
+
+    /**
+     *  \brief  Wait till the job queue drains
+     *
+     *  Waits till the queue is drained to half the limit (so that
+     *  the producer doesn't oscillate at the limit) or for \c timeout.
+     *  If called from a pool job, the wait also ends when all the busy
+     *  threads wait (then the queue may exceed the limit).
+     *
+     *  \param  timeout  Max. wait time
+     *
+     *  \return \c true iff the queue isn't saturated (or the job
+     *          may not wait)
+     */
+    bool wait_drained(duration timeout);
+
+    /** Thread pool counters */
+    stats_t stats() const;
+
     /**
      *  \brief  Start another \c tcnt threads
      *
@@ -134,7 +297,7 @@ class thread_pool {
      *  \return Number of started threads
      */
     size_t start_thread(size_t tcnt = 1) {
-        std::lock_guard<std::mutex> thread_list_lock(m_thread_list_mutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         return start_thread_impl(tcnt);
     }
 
@@ -162,6 +325,19 @@ class thread_pool {
     /** Implements \ref start_thread (no locking) */
     size_t start_thread_impl(size_t tcnt = 1);
 
+    /** Start another thread if the queue backlog requires it (no locking) */
+    void spawn_if_needed();
+
+    /** Join retired threads (no locking) */
+    void join_retired();
+
+    /**
+     *  \brief  Retire current thread (no locking)
+     *
+     *  \return Threads retired before (to be joined by the caller)
+     */
+    thread_list_t retire();
+
     /** Pooled thread routine */
     void routine();
 
@@ -0,0 +1,192 @@
+/**
+ *  \file
+ *  \brief  Transfer timing report
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timing_report.hxx"
+#include "json.hxx"
+
+#include <iomanip>
+#include <algorithm>
+
+
+namespace fastcrawl {
+
+const char * timing_report::phase_name(unsigned ph) {
+    static const char * const names[PHASES] = {
+        "dns", "connect", "tls", "ttfb", "transfer", "total",
+    };
+
+    return ph < PHASES ? names[ph] : "unknown";
+}
+
+
+/** Time difference (cURL time points aren't necessarily monotonic) */
+inline static uint64_t diff(uint64_t end, uint64_t begin) {
+    return end > begin ? end - begin : 0;
+}
+
+
+/** Add timing to statistics */
+static void add_timing(timing_report::stats & st, const transfer_timing & t) {
+    const uint64_t connected = t.appconnect ? t.appconnect : t.connect;
+
+    st.phases[timing_report::DNS].record(t.namelookup);
+    st.phases[timing_report::CONNECT].record(diff(t.connect, t.namelookup));
+
+    if (t.appconnect)
+        st.phases[timing_report::TLS].record(diff(t.appconnect, t.connect));
+
+    st.phases[timing_report::TTFB].record(
+        diff(t.starttransfer, std::max(t.pretransfer, connected)));
+    st.phases[timing_report::TRANSFER].record(diff(t.total, t.starttransfer));
+    st.phases[timing_report::TOTAL].record(t.total);
+
+    st.speed.record(t.speed);
+}
+
+
+void timing_report::add(const std::string & host, const transfer_timing & timing) {
+    if (!timing.valid()) return;
+
+    add_timing(m_all, timing);
+    add_timing(m_hosts[host], timing);
+}
+
+
+/** Write statistics text table rows */
+static void text_rows(
+    std::ostream &               out,
+    const std::string &          title,
+    const timing_report::stats & st)
+{
+    out << title << " (" << st.transfers() << " transfers, mean speed "
+        << (uint64_t)st.speed.mean() << " B/s):" << std::endl;
+
+    for (unsigned ph = 0; ph < timing_report::PHASES; ++ph) {
+        const auto & hist = st.phases[ph];
+        if (!hist.count()) continue;
+
+        out << "    " << std::left << std::setw(10)
+            << timing_report::phase_name(ph) << std::right;
+
+        for (double p: { 50.0, 90.0, 99.0 })
+            out << std::setw(12) << hist.percentile(p) / 1000.0;
+
+        out << std::setw(12) << hist.max() / 1000.0 << std::endl;
+    }
+}
+
+
+void timing_report::text(std::ostream & out) const {
+    const auto out_flags = out.flags();
+    const auto out_precision = out.precision();
+    const auto out_fill = out.fill(' ');
+
+    out << std::fixed << std::setprecision(3)
+        << "Transfer timing [ms]:" << std::endl
+        << "    " << std::left << std::setw(10) << "phase" << std::right
+        << std::setw(12) << "p50"
+        << std::setw(12) << "p90"
+        << std::setw(12) << "p99"
+        << std::setw(12) << "max" << std::endl;
+
+    text_rows(out, "All hosts", m_all);
+
+    for (auto & host: m_hosts)
+        text_rows(out, "Host " + host.first, host.second);
+
+    out.flags(out_flags);
+    out.precision(out_precision);
+    out.fill(out_fill);
+}
+
+
+/** Write histogram as JSON object */
+static void json_histogram(std::ostream & out, const latency_histogram & hist) {
+    out << "{\"count\":" << hist.count()
+        << ",\"min\":"   << hist.min()
+        << ",\"mean\":"  << (uint64_t)hist.mean()
+        << ",\"p50\":"   << hist.percentile(50)
+        << ",\"p90\":"   << hist.percentile(90)
+        << ",\"p99\":"   << hist.percentile(99)
+        << ",\"max\":"   << hist.max()
+        << '}';
+}
+
+
+/** Write statistics as JSON object */
+static void json_stats(std::ostream & out, const timing_report::stats & st) {
+    out << "{\"transfers\":" << st.transfers()
+        << ",\"speed\":";
+    json_histogram(out, st.speed);
+
+    out << ",\"phases\":{";
+    for (unsigned ph = 0; ph < timing_report::PHASES; ++ph) {
+        if (ph) out << ',';
+        json_string(out, timing_report::phase_name(ph));
+        out << ':';
+        json_histogram(out, st.phases[ph]);
+    }
+    out << "}}";
+}
+
+
+void timing_report::json(std::ostream & out) const {
+    const auto out_flags = out.flags();
+    out << std::dec;
+
+    out << "{\"unit\":\"us\",\"all\":";
+    json_stats(out, m_all);
+
+    out << ",\"hosts\":{";
+    bool first = true;
+    for (auto & host: m_hosts) {
+        if (!first) out << ',';
+        first = false;
+
+        json_string(out, host.first);
+        out << ':';
+        json_stats(out, host.second);
+    }
+    out << "}}" << std::endl;
+
+    out.flags(out_flags);
+}
+
+}  // end of namespace fastcrawl
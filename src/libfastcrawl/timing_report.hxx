@@ -0,0 +1,132 @@
+#ifndef fastcrawl__timing_report_hxx
+#define fastcrawl__timing_report_hxx
+
+/**
+ *  \file
+ *  \brief  Transfer timing report
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "latency_histogram.hxx"
+#include "transfer_timing.hxx"
+
+#include <string>
+#include <map>
+#include <iostream>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Transfer timing report
+ *
+ *  Aggregates \ref transfer_timing of downloads to latency histograms
+ *  (see \ref latency_histogram) per transfer phase, overall and per host.
+ *  The phases are:
+ *  - \c dns:      name resolution
+ *  - \c connect:  TCP connection establishment
+ *  - \c tls:      TLS handshake (TLS transfers only)
+ *  - \c ttfb:     request sent to first response byte (time to first byte)
+ *  - \c transfer: response content transfer
+ *  - \c total:    the whole transfer
+ *
+ *  The report may be written as text (a table of percentiles)
+ *  or as JSON (for machine processing).
+ */
+class timing_report {
+    public:
+
+    /** Transfer phases */
+    enum phase {
+        DNS = 0,
+        CONNECT,
+        TLS,
+        TTFB,
+        TRANSFER,
+        TOTAL,
+
+        PHASES  /**< Number of phases */
+    };
+
+    /** Phase name */
+    static const char * phase_name(unsigned ph);
+
+    /** Timing statistics */
+    struct stats {
+        latency_histogram phases[PHASES];  /**< Phase latencies [us]    */
+        latency_histogram speed;           /**< Download speeds [B/s]   */
+
+        /** Number of transfers */
+        uint64_t transfers() const { return phases[TOTAL].count(); }
+
+    };  // end of struct stats
+
+    private:
+
+    stats                        m_all;    /**< Overall statistics  */
+    std::map<std::string, stats> m_hosts;  /**< Per-host statistics */
+
+    public:
+
+    /**
+     *  \brief  Add transfer timing
+     *
+     *  Unknown timings (see \ref transfer_timing::valid) are ignored.
+     *
+     *  \param  host    Host
+     *  \param  timing  Transfer timing
+     */
+    void add(const std::string & host, const transfer_timing & timing);
+
+    /** Overall statistics */
+    const stats & all() const { return m_all; }
+
+    /** Per-host statistics */
+    const std::map<std::string, stats> & hosts() const { return m_hosts; }
+
+    /** Write text report (times in milliseconds) */
+    void text(std::ostream & out) const;
+
+    /** Write JSON report (times in microseconds) */
+    void json(std::ostream & out) const;
+
+};  // end of class timing_report
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__timing_report_hxx
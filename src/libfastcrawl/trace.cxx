@@ -0,0 +1,198 @@
+/**
+ *  \file
+ *  \brief  Chrome trace-event timeline
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "trace.hxx"
+#include "json.hxx"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <cstdio>
+
+
+namespace fastcrawl {
+
+std::atomic<bool>     trace::s_enabled(false);
+std::atomic<uint64_t> trace::s_next_id(1);
+
+
+/** Per-thread event buffer */
+struct trace_buffer {
+    uint32_t                  tid;      /**< Trace thread ID            */
+    std::vector<trace::event> events;   /**< Events                     */
+    std::string               details;  /**< Event details (copies)     */
+    std::mutex                mutex;    /**< Buffer mutex (vs. readers) */
+
+    trace_buffer(uint32_t tid_): tid(tid_) { events.reserve(4096); }
+
+};  // end of struct trace_buffer
+
+
+/** Registry of the per-thread buffers */
+struct trace_registry {
+    std::mutex                                 mutex;    /**< Registry mutex */
+    std::vector<std::unique_ptr<trace_buffer>> buffers;  /**< Buffers        */
+
+    /** Registry instance */
+    static trace_registry & instance() {
+        static trace_registry registry;
+        return registry;
+    }
+
+    /** Register new buffer */
+    trace_buffer * add() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        buffers.emplace_back(new trace_buffer(buffers.size() + 1));
+        return buffers.back().get();
+    }
+
+};  // end of struct trace_registry
+
+
+static thread_local trace_buffer * t_buffer = nullptr;  /**< Thread buffer */
+
+
+void trace::record(const event & ev) {
+    if (nullptr == t_buffer) t_buffer = trace_registry::instance().add();
+
+    std::lock_guard<std::mutex> lock(t_buffer->mutex);
+
+    t_buffer->events.push_back(ev);
+
+    // Copy the detail (the pointer is resolved when dumped)
+    if (ev.detail) {
+        auto & stored = t_buffer->events.back();
+        stored.detail_off = (uint32_t)t_buffer->details.size();
+        t_buffer->details.append(ev.detail, ev.detail_len);
+    }
+}
+
+
+size_t trace::size() {
+    auto & registry = trace_registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    size_t size = 0;
+    for (auto & buffer: registry.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        size += buffer->events.size();
+    }
+
+    return size;
+}
+
+
+void trace::clear() {
+    auto & registry = trace_registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (auto & buffer: registry.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->details.clear();
+    }
+}
+
+
+void trace::dump(std::ostream & out) {
+    auto & registry = trace_registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // The buffers stay locked till dumped (so the origin holds)
+    std::vector<std::unique_lock<std::mutex> > buffer_locks;
+    for (auto & buffer: registry.buffers)
+        buffer_locks.emplace_back(buffer->mutex);
+
+    int64_t origin = std::numeric_limits<int64_t>::max();
+    for (auto & buffer: registry.buffers)
+        for (auto & ev: buffer->events)
+            if (ev.ts < origin) origin = ev.ts;
+
+    const auto out_flags = out.flags();
+    out << std::dec << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (auto & buffer: registry.buffers) {
+        if (buffer->events.empty()) continue;
+
+        if (!first) out << ',';
+        first = false;
+
+        out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << buffer->tid << ",\"args\":{\"name\":\"thread "
+            << buffer->tid << "\"}}";
+
+        for (auto & ev: buffer->events) {
+            char ts[32];
+            std::snprintf(ts, sizeof(ts), "%.3f", (ev.ts - origin) / 1000.0);
+
+            char id[24];
+            std::snprintf(id, sizeof(id), "0x%llx", (unsigned long long)ev.id);
+
+            out << ",\n{\"name\":";
+            json_string(out, ev.name);
+            out << ",\"cat\":\"fastcrawl\",\"ph\":\"" << ev.ph
+                << "\",\"ts\":" << ts
+                << ",\"pid\":1,\"tid\":" << buffer->tid;
+
+            if (ASYNC_BEGIN == ev.ph || ASYNC_END == ev.ph)
+                out << ",\"id\":\"" << id << '"';
+
+            if (INSTANT == ev.ph)
+                out << ",\"s\":\"t\"";
+
+            out << ",\"args\":{\"id\":\"" << id << '"';
+            if (ev.detail) {
+                out << ",\"uri\":";
+                json_string(out, buffer->details.data() + ev.detail_off,
+                    ev.detail_len);
+            }
+            out << "}}";
+        }
+    }
+
+    out << "\n]}" << std::endl;
+    out.flags(out_flags);
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,182 @@
+#ifndef fastcrawl__trace_hxx
+#define fastcrawl__trace_hxx
+
+/**
+ *  \file
+ *  \brief  Chrome trace-event timeline
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Crawl activity tracing
+ *
+ *  Opt-in recording of timeline events, exported in Chrome trace-event
+ *  JSON format (viewable in Perfetto or \c chrome://tracing).
+ *
+ *  Each thread records the events to its own buffer; the buffer lock
+ *  is only contended by \ref dump, \ref size and \ref clear (so they
+ *  may be called while the crawl is running).
+ *  The buffers outlive their threads, so events of retired pool threads
+ *  are kept.
+ *  Event details are copied to the buffer, so they may be released
+ *  right after the event is recorded.
+ *
+ *  When tracing is disabled, the cost of a trace point is a relaxed
+ *  atomic flag load (see \ref enabled); trace points should check it
+ *  before gathering the event data:
+ *  \code
+ *      if (trace::enabled()) trace::instant("found", id);
+ *  \endcode
+ *
+ *  See https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ */
+class trace {
+    public:
+
+    /** Event phases (as in the trace-event format) */
+    enum phase {
+        BEGIN       = 'B',  /**< Thread span begin  */
+        END         = 'E',  /**< Thread span end    */
+        INSTANT     = 'i',  /**< Instant event      */
+        ASYNC_BEGIN = 'b',  /**< Async span begin   */
+        ASYNC_END   = 'e',  /**< Async span end     */
+    };
+
+    /** Trace event */
+    struct event {
+        int64_t      ts;            /**< Timestamp [ns] (see \ref now)  */
+        const char * name;          /**< Name (static string)           */
+        uint64_t     id;            /**< Event subject ID               */
+        const char * detail;        /**< Detail string (or \c nullptr)  */
+        uint32_t     detail_len;    /**< Detail string length           */
+        uint32_t     detail_off;    /**< Detail copy offset (in buffer) */
+        char         ph;            /**< Phase (see \ref phase)         */
+
+    };  // end of struct event
+
+    private:
+
+    static std::atomic<bool>     s_enabled;  /**< Tracing enabled    */
+    static std::atomic<uint64_t> s_next_id;  /**< Next unique ID     */
+
+    /** Record event (to the current thread buffer) */
+    static void record(const event & ev);
+
+    public:
+
+    /** Tracing is enabled */
+    static bool enabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /** Enable/disable tracing */
+    static void enable(bool enable = true) {
+        s_enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    /**
+     *  \brief  Unique event subject ID
+     *
+     *  Async spans of different subjects must have different IDs
+     *  (for the whole trace, i.e. across crawlers); the IDs are taken
+     *  from a process-wide counter.
+     */
+    static uint64_t unique_id() {
+        return s_next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Current timestamp [ns] */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     *  \brief  Record event
+     *
+     *  \param  ph          Phase
+     *  \param  name        Event name (must be a static string)
+     *  \param  id          Event subject ID (async spans are matched by it)
+     *  \param  ts          Timestamp (see \ref now)
+     *  \param  detail      Detail string (copied)
+     *  \param  detail_len  Detail string length
+     */
+    static void record(
+        phase        ph,
+        const char * name,
+        uint64_t     id,
+        int64_t      ts         = now(),
+        const char * detail     = nullptr,
+        size_t       detail_len = 0)
+    {
+        record(event{ts, name, id, detail, (uint32_t)detail_len, 0, (char)ph});
+    }
+
+    /** Record instant event */
+    static void instant(const char * name, uint64_t id, int64_t ts = now()) {
+        record(INSTANT, name, id, ts);
+    }
+
+    /** Number of recorded events */
+    static size_t size();
+
+    /** Discard recorded events */
+    static void clear();
+
+    /**
+     *  \brief  Write the recorded events as Chrome trace-event JSON
+     *
+     *  The timestamps are relative to the first recorded event.
+     *
+     *  \param  out  Output stream
+     */
+    static void dump(std::ostream & out);
+
+};  // end of class trace
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__trace_hxx
@@ -0,0 +1,84 @@
+#ifndef fastcrawl__transfer_timing_hxx
+#define fastcrawl__transfer_timing_hxx
+
+/**
+ *  \file
+ *  \brief  Transfer timing breakdown
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Transfer timing breakdown
+ *
+ *  As reported by cURL; the time points are in microseconds
+ *  from the transfer start (i.e. they're cumulative).
+ *  All zero if the timing is unknown (e.g. no transfer took place).
+ *
+ *  See https://curl.se/libcurl/c/curl_easy_getinfo.html#TIMES
+ */
+struct transfer_timing {
+    uint64_t namelookup;     /**< Name resolved                       */
+    uint64_t connect;        /**< Connected (TCP)                     */
+    uint64_t appconnect;     /**< TLS handshake done (0 if not TLS)   */
+    uint64_t pretransfer;    /**< About to send the request           */
+    uint64_t starttransfer;  /**< First response byte received        */
+    uint64_t total;          /**< Transfer finished                   */
+    uint64_t speed;          /**< Average download speed [B/s]        */
+
+    transfer_timing():
+        namelookup(0),
+        connect(0),
+        appconnect(0),
+        pretransfer(0),
+        starttransfer(0),
+        total(0),
+        speed(0)
+    {}
+
+    /** Timing is known */
+    bool valid() const { return 0 != total; }
+
+};  // end of struct transfer_timing
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__transfer_timing_hxx
@@ -42,6 +42,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include <cassert>
 
 
@@ -96,6 +97,63 @@ uri uri::parse(const std::string & uri_) {
 }
 
 
+/** Remove last path segment (and its \c '/') from output */
+static void pop_segment(std::string & output) {
+    const size_t slash = output.rfind('/');
+    output.erase(std::string::npos == slash ? 0 : slash);
+}
+
+
+std::string uri::remove_dot_segments(const std::string & path) {
+    std::string output;
+    output.reserve(path.size());
+
+    const size_t size = path.size();
+    for (size_t pos = 0; pos < size; ) {
+        // A: "../" or "./" prefix
+        if (0 == path.compare(pos, 3, "../"))
+            pos += 3;
+        else if (0 == path.compare(pos, 2, "./"))
+            pos += 2;
+
+        // B: "/./" or "/." (complete segment)
+        else if (0 == path.compare(pos, 3, "/./"))
+            pos += 2;
+        else if (0 == path.compare(pos, std::string::npos, "/.")) {
+            output += '/';
+            pos = size;
+        }
+
+        // C: "/../" or "/.." (complete segment)
+        else if (0 == path.compare(pos, 4, "/../")) {
+            pop_segment(output);
+            pos += 3;
+        }
+        else if (0 == path.compare(pos, std::string::npos, "/..")) {
+            pop_segment(output);
+            output += '/';
+            pos = size;
+        }
+
+        // D: "." or ".."
+        else if (0 == path.compare(pos, std::string::npos, ".") ||
+                 0 == path.compare(pos, std::string::npos, ".."))
+        {
+            pos = size;
+        }
+
+        // E: move the first segment (with its leading '/', if any)
+        else {
+            const size_t end = std::min(path.find('/', pos + 1), size);
+            output.append(path, pos, end - pos);
+            pos = end;
+        }
+    }
+
+    return output;
+}
+
+
 bool uri::operator == (const uri & arg) const {
     return
         scheme   == arg.scheme      &&
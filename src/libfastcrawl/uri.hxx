@@ -101,6 +101,18 @@ class uri {
     /** Constructs URI from string */
     static uri parse(const std::string & uri_);
 
+    /**
+     *  \brief  Remove dot segments from path
+     *
+     *  Resolves \c "." and \c ".." path segments as per RFC 3986,
+     *  section 5.2.4 (\c ".." segments above the root are dropped).
+     *
+     *  \param  path  Path (without query and fragment)
+     *
+     *  \return Path without dot segments
+     */
+    static std::string remove_dot_segments(const std::string & path);
+
     /** URI equality comparison */
     bool operator == (const uri & arg) const;
 
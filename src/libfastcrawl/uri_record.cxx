@@ -0,0 +1,86 @@
+/**
+ *  \file
+ *  \brief  Content download record
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "uri_record.hxx"
+
+#include <iomanip>
+
+
+namespace fastcrawl {
+
+std::ostream & operator << (std::ostream & out, const uri_record & rec) {
+    const auto cout_flags = out.flags();
+    const auto & digests = rec.digests;
+
+    out << rec.filename
+        << " size: " << std::dec << rec.size;
+
+    if (digests.algorithms & content_digests::ADLER32)
+        out << ", Adler32 checksum: "
+            << std::hex << std::setw(8) << std::setfill('0')
+            << digests.adler32;
+
+    if (digests.algorithms & content_digests::CRC32C)
+        out << ", CRC32C: "
+            << std::hex << std::setw(8) << std::setfill('0')
+            << digests.crc32c;
+
+    if (digests.algorithms & content_digests::XXH3)
+        out << ", XXH3: "
+            << std::hex << std::setw(16) << std::setfill('0')
+            << digests.xxh3;
+
+    if (digests.algorithms & content_digests::SHA256)
+        out << ", SHA-256: " << sha256::hex(digests.sha256);
+
+    if (rec.fingerprint)
+        out << ", SimHash: "
+            << std::hex << std::setw(16) << std::setfill('0')
+            << rec.fingerprint;
+
+    if (rec.skipped)
+        out << ", skipped: " << skip_reason_str(rec.skipped);
+
+    out.flags(cout_flags);
+
+    return out;
+}
+
+}  // end of namespace fastcrawl
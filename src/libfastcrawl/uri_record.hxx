@@ -0,0 +1,88 @@
+#ifndef fastcrawl__uri_record_hxx
+#define fastcrawl__uri_record_hxx
+
+/**
+ *  \file
+ *  \brief  Content download record
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "multi_hash.hxx"
+#include "transfer_timing.hxx"
+#include "download_policy.hxx"
+
+#include <string>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace fastcrawl {
+
+/** Content download record */
+struct uri_record {
+    /** Max. file name length (incl. terminating zero) */
+    static const size_t filename_size = 48;
+
+    char            filename[filename_size];    /**< Content storage file name */
+    content_digests digests;                    /**< Content digests           */
+    transfer_timing timing;                     /**< Transfer timing           */
+    size_t          size;                       /**< Content size              */
+    uint64_t        fingerprint;                /**< Content SimHash (or 0)    */
+    bool            success;                    /**< Content download status   */
+    uint64_t        stream;                     /**< Content stream (shm_sink) */
+    skip_reason     skipped;                    /**< Content skipped (why)     */
+
+    uri_record():
+        size(0),
+        fingerprint(0),
+        success(false),
+        stream(0),
+        skipped(NOT_SKIPPED)
+    {
+        filename[0] = '\0';
+    }
+
+};  // end of struct uri_record
+
+
+/** Download record serialisation */
+std::ostream & operator << (std::ostream & out, const uri_record & rec);
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__uri_record_hxx
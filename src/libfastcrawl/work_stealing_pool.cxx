@@ -0,0 +1,339 @@
+/**
+ *  \file
+ *  \brief  Work-stealing thread pool
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "work_stealing_pool.hxx"
+
+
+namespace fastcrawl {
+
+thread_local work_stealing_pool::worker * work_stealing_pool::s_worker = nullptr;
+
+
+bool work_stealing_pool::deque::push(job & j) {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed);
+    const int64_t t = m_top.load(std::memory_order_acquire);
+
+    if (b - t > m_mask) return false;  // full
+
+    slot & s = m_slots[b & m_mask];
+    if (s.full.load(std::memory_order_acquire))
+        return false;  // a thief is still moving the previous job out
+
+    s.j = std::move(j);
+    s.full.store(true, std::memory_order_relaxed);
+    m_bottom.store(b + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+bool work_stealing_pool::deque::pop(job & j) {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(b, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t t = m_top.load(std::memory_order_relaxed);
+    if (t > b) {  // empty
+        m_bottom.store(b + 1, std::memory_order_release);
+        return false;
+    }
+
+    // Last job, race thieves for it
+    if (t == b) {
+        const bool won = m_top.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+
+        m_bottom.store(b + 1, std::memory_order_release);
+
+        if (!won) return false;
+    }
+
+    take(m_slots[b & m_mask], j);
+    return true;
+}
+
+
+bool work_stealing_pool::deque::steal(job & j) {
+    int64_t t = m_top.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const int64_t b = m_bottom.load(std::memory_order_acquire);
+    if (t >= b) return false;  // empty
+
+    if (!m_top.compare_exchange_strong(t, t + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return false;  // lost the race
+    }
+
+    take(m_slots[t & m_mask], j);
+    return true;
+}
+
+
+work_stealing_pool::queue::queue(size_t capacity):
+    m_cells(new cell[capacity]),
+    m_mask(capacity - 1),
+    m_enqueue_pos(0),
+    m_dequeue_pos(0)
+{
+    for (size_t i = 0; i < capacity; ++i)
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+}
+
+
+bool work_stealing_pool::queue::push(job & j) {
+    size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell & c = m_cells[pos & m_mask];
+
+        const size_t seq = c.seq.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (0 == diff) {  // cell free, claim it
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+            {
+                c.j = std::move(j);
+                c.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) return false;  // full
+        else pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    }
+}
+
+
+bool work_stealing_pool::queue::pop(job & j) {
+    size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell & c = m_cells[pos & m_mask];
+
+        const size_t seq = c.seq.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (0 == diff) {  // cell full, claim it
+            if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+            {
+                j = std::move(c.j);
+                c.seq.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) return false;  // empty
+        else pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    }
+}
+
+
+work_stealing_pool::work_stealing_pool(size_t tcnt):
+    m_queue(queue_capacity),
+    m_overflow_size(0),
+    m_shutdown(false),
+    m_submitting(0),
+    m_sleepers(0)
+{
+    if (0 == tcnt) tcnt = std::thread::hardware_concurrency();
+    if (0 == tcnt) tcnt = 1;
+
+    // Create all workers before any starts stealing
+    for (size_t i = 0; i < tcnt; ++i)
+        m_workers.emplace_back(new worker(this, i));
+
+    for (auto & w: m_workers)
+        w->thread = std::thread(&work_stealing_pool::routine, this, std::ref(*w));
+}
+
+
+size_t work_stealing_pool::steals() const {
+    size_t steals = 0;
+    for (auto & w: m_workers)
+        steals += w->steals.load(std::memory_order_relaxed);
+
+    return steals;
+}
+
+
+bool work_stealing_pool::run(job j) {
+    // Job submitted by own worker
+    if (s_worker && this == s_worker->pool) {
+        if (!s_worker->jobs.push(j) && !m_queue.push(j)) {
+            std::lock_guard<std::mutex> overflow_lock(m_overflow_mutex);
+            m_overflow.push_back(std::move(j));
+            ++m_overflow_size;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_relaxed)) wakeup();
+
+        return true;
+    }
+
+    // Job submitted by external thread
+    ++m_submitting;
+
+    if (m_shutdown.load()) {
+        --m_submitting;
+        wakeup(true);  // workers may wait for the submission to finish
+
+        return false;  // no more jobs accepted
+    }
+
+    if (!m_queue.push(j)) {
+        std::lock_guard<std::mutex> overflow_lock(m_overflow_mutex);
+        m_overflow.push_back(std::move(j));
+        ++m_overflow_size;
+    }
+
+    --m_submitting;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_relaxed)) wakeup();
+
+    return true;
+}
+
+
+void work_stealing_pool::shutdown() {
+    if (m_shutdown.exchange(true)) return;  // already down
+
+    wakeup(true);
+
+    for (auto & w: m_workers)
+        w->thread.join();
+}
+
+
+void work_stealing_pool::wakeup(bool all) {
+    std::lock_guard<std::mutex> sleep_lock(m_sleep_mutex);
+
+    if (all) m_wakeup.notify_all();
+    else     m_wakeup.notify_one();
+}
+
+
+bool work_stealing_pool::has_work() const {
+    if (!m_queue.empty() || m_overflow_size.load()) return true;
+
+    for (auto & w: m_workers)
+        if (!w->jobs.empty()) return true;
+
+    return false;
+}
+
+
+bool work_stealing_pool::find_job(worker & w, job & j) {
+    if (w.jobs.pop(j) || m_queue.pop(j)) return true;
+
+    if (m_overflow_size.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> overflow_lock(m_overflow_mutex);
+
+        if (!m_overflow.empty()) {
+            j = std::move(m_overflow.front());
+            m_overflow.pop_front();
+            --m_overflow_size;
+
+            return true;
+        }
+    }
+
+    // Steal (start at random victim)
+    const size_t wcnt = m_workers.size();
+
+    w.rng ^= w.rng << 13;
+    w.rng ^= w.rng >> 7;
+    w.rng ^= w.rng << 17;
+
+    const size_t start = w.rng % wcnt;
+    for (size_t i = 0; i < wcnt; ++i) {
+        worker & victim = *m_workers[(start + i) % wcnt];
+
+        if (&victim != &w && victim.jobs.steal(j)) {
+            w.steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void work_stealing_pool::routine(worker & w) {
+    s_worker = &w;
+
+    job j;
+    for (;;) {
+        // Spin a little before going idle (jobs tend to come in bursts)
+        bool found = false;
+        for (int i = 0; i < 64 && !(found = find_job(w, j)); ++i)
+            std::this_thread::yield();
+
+        if (found) {
+            j();
+            j.reset();
+            continue;
+        }
+
+        // Go idle
+        std::unique_lock<std::mutex> sleep_lock(m_sleep_mutex);
+
+        ++m_sleepers;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!has_work()) {
+            if (m_shutdown.load() && 0 == m_submitting.load()) {
+                --m_sleepers;
+                break;  // all done
+            }
+
+            m_wakeup.wait(sleep_lock);
+        }
+
+        --m_sleepers;
+    }
+
+    s_worker = nullptr;
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,314 @@
+#ifndef fastcrawl__work_stealing_pool_hxx
+#define fastcrawl__work_stealing_pool_hxx
+
+/**
+ *  \file
+ *  \brief  Work-stealing thread pool
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "job.hxx"
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Work-stealing thread pool
+ *
+ *  Fixed-size thread pool for high job rates.
+ *
+ *  Each worker has its own bounded job deque (Chase-Lev); jobs submitted
+ *  by a worker (i.e. from within a job) are pushed to the worker's deque
+ *  bottom and the worker takes them from there (LIFO, cache-friendly).
+ *  Jobs submitted by other threads are pushed to a lock-free bounded
+ *  injection queue (spilling to a locked overflow queue when full).
+ *  Idle workers steal jobs from the other workers' deque tops.
+ *
+ *  So, unlike \ref thread_pool, job submission and pickup take no lock
+ *  on the fast path; workers only block (on a condition) when there's
+ *  no job to be found anywhere.
+ *
+ *  The jobs are move-only (see \ref job); callables that fit
+ *  the job's in-place storage are never allocated.
+ */
+class work_stealing_pool {
+    public:
+
+    static const size_t deque_capacity = 1024;  /**< Worker deque capacity    */
+    static const size_t queue_capacity = 4096;  /**< Injection queue capacity */
+
+    private:
+
+    /**
+     *  \brief  Worker job deque
+     *
+     *  Bounded Chase-Lev deque.
+     *  The owner pushes and pops at the bottom, thieves steal from the top.
+     *  Since jobs aren't trivially copyable, they are moved out of the slot
+     *  only after the slot was claimed (by the top CAS); the slot's \c full
+     *  flag keeps the owner from overwriting a claimed slot until the thief
+     *  is done with it.
+     */
+    class deque {
+        private:
+
+        /** Deque slot */
+        struct slot {
+            std::atomic<bool> full;  /**< Slot holds a job */
+            job               j;     /**< The job          */
+
+            slot(): full(false) {}
+
+        };  // end of struct slot
+
+        std::unique_ptr<slot[]> m_slots;    /**< Slots (ring buffer) */
+        const int64_t           m_mask;     /**< Index mask          */
+        std::atomic<int64_t>    m_top;      /**< Top (steal end)     */
+        char                    m_pad[64];  /**< False sharing guard */
+        std::atomic<int64_t>    m_bottom;   /**< Bottom (owner end)  */
+
+        /** Move job out of (claimed) slot */
+        static void take(slot & s, job & j) {
+            j = std::move(s.j);
+            s.full.store(false, std::memory_order_release);
+        }
+
+        public:
+
+        /** Constructor (capacity must be power of 2) */
+        deque(size_t capacity):
+            m_slots(new slot[capacity]),
+            m_mask(capacity - 1),
+            m_top(0),
+            m_bottom(0)
+        {}
+
+        /**
+         *  \brief  Push job (owner only)
+         *
+         *  \param  j  Job (moved from on success)
+         *
+         *  \return \c true iff the job was pushed (deque not full)
+         */
+        bool push(job & j);
+
+        /**
+         *  \brief  Pop job (owner only)
+         *
+         *  \param  j  Popped job
+         *
+         *  \return \c true iff a job was popped
+         */
+        bool pop(job & j);
+
+        /**
+         *  \brief  Steal job (any thread)
+         *
+         *  \param  j  Stolen job
+         *
+         *  \return \c true iff a job was stolen
+         */
+        bool steal(job & j);
+
+        /** Deque seems empty (approximate) */
+        bool empty() const {
+            return m_top.load() >= m_bottom.load();
+        }
+
+    };  // end of class deque
+
+    /**
+     *  \brief  Injection queue
+     *
+     *  Bounded lock-free MPMC queue (D. Vyukov's algorithm).
+     */
+    class queue {
+        private:
+
+        /** Queue cell */
+        struct cell {
+            std::atomic<size_t> seq;  /**< Sequence number */
+            job                 j;    /**< The job         */
+
+        };  // end of struct cell
+
+        std::unique_ptr<cell[]> m_cells;        /**< Cells (ring buffer)  */
+        const size_t            m_mask;         /**< Index mask           */
+        char                    m_pad1[64];     /**< False sharing guard  */
+        std::atomic<size_t>     m_enqueue_pos;  /**< Enqueue position     */
+        char                    m_pad2[64];     /**< False sharing guard  */
+        std::atomic<size_t>     m_dequeue_pos;  /**< Dequeue position     */
+
+        public:
+
+        /** Constructor (capacity must be power of 2) */
+        queue(size_t capacity);
+
+        /**
+         *  \brief  Enqueue job
+         *
+         *  \param  j  Job (moved from on success)
+         *
+         *  \return \c true iff the job was enqueued (queue not full)
+         */
+        bool push(job & j);
+
+        /**
+         *  \brief  Dequeue job
+         *
+         *  \param  j  Dequeued job
+         *
+         *  \return \c true iff a job was dequeued
+         */
+        bool pop(job & j);
+
+        /** Queue seems empty (approximate) */
+        bool empty() const {
+            return m_enqueue_pos.load() == m_dequeue_pos.load();
+        }
+
+    };  // end of class queue
+
+    /** Worker */
+    struct worker {
+        work_stealing_pool *    pool;       /**< Owner pool             */
+        const size_t            index;      /**< Worker index           */
+        deque                   jobs;       /**< Job deque              */
+        uint64_t                rng;        /**< Victim selection PRNG  */
+        std::atomic<size_t>     steals;     /**< Stolen jobs counter    */
+        std::thread             thread;     /**< Worker thread          */
+        char                    pad[64];    /**< False sharing guard    */
+
+        worker(work_stealing_pool * pool_, size_t index_):
+            pool(pool_),
+            index(index_),
+            jobs(deque_capacity),
+            rng(0x9e3779b97f4a7c15ull * (index_ + 1)),
+            steals(0)
+        {}
+
+    };  // end of struct worker
+
+    /** Current thread's worker (if it's a pool worker) */
+    static thread_local worker * s_worker;
+
+    std::vector<std::unique_ptr<worker> > m_workers;  /**< Workers */
+
+    queue                   m_queue;            /**< Injection queue          */
+    std::deque<job>         m_overflow;         /**< Injection queue overflow */
+    std::atomic<size_t>     m_overflow_size;    /**< Overflow queue size      */
+    std::mutex              m_overflow_mutex;   /**< Overflow queue mutex     */
+
+    std::atomic<bool>       m_shutdown;         /**< Pool shutdown flag       */
+    std::atomic<size_t>     m_submitting;       /**< Submissions in progress  */
+    std::atomic<size_t>     m_sleepers;         /**< Idle workers count       */
+    std::mutex              m_sleep_mutex;      /**< Idle workers mutex       */
+    std::condition_variable m_wakeup;           /**< Idle workers wakeup      */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Starts the worker threads.
+     *
+     *  \param  tcnt  Number of worker threads (0 means hardware concurrency)
+     */
+    work_stealing_pool(size_t tcnt = 0);
+
+    work_stealing_pool(const work_stealing_pool & ) = delete;
+    work_stealing_pool & operator = (const work_stealing_pool & ) = delete;
+
+    /** Thread pool size (amount of threads) getter */
+    size_t size() const { return m_workers.size(); }
+
+    /** Number of jobs stolen by workers (so far) */
+    size_t steals() const;
+
+    /**
+     *  \brief  Run \c job
+     *
+     *  Jobs submitted from within another job of the pool are always
+     *  accepted (even during shutdown) so that the queued work may finish.
+     *
+     *  \param  j  Job
+     *
+     *  \return \c true iff the job was queued
+     */
+    bool run(job j);
+
+    /**
+     *  \brief  Thread pool shudown
+     *
+     *  The pool won't accept any new jobs (see \ref run).
+     *  The function will block until all jobs that were already queued
+     *  before the call (and jobs these submit) are executed.
+     */
+    void shutdown();
+
+    /** Destructor (shuts the pool down, see \ref shutdown). */
+    ~work_stealing_pool() { shutdown(); }
+
+    private:
+
+    /** Wake idle workers up (if any) */
+    void wakeup(bool all = false);
+
+    /** There's work to be done (approximate) */
+    bool has_work() const;
+
+    /** Find job for worker (own deque, injection queue, then steal) */
+    bool find_job(worker & w, job & j);
+
+    /** Worker thread routine */
+    void routine(worker & w);
+
+};  // end of class work_stealing_pool
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__work_stealing_pool_hxx
@@ -0,0 +1,349 @@
+/**
+ *  \file
+ *  \brief  XXH3 online hash
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "xxh3.hxx"
+
+#include <cstring>
+
+
+namespace fastcrawl {
+
+// Primes
+static const uint64_t prime32_1 = 0x9e3779b1u;
+static const uint64_t prime32_2 = 0x85ebca77u;
+static const uint64_t prime32_3 = 0xc2b2ae3du;
+static const uint64_t prime64_1 = 0x9e3779b185ebca87ull;
+static const uint64_t prime64_2 = 0xc2b2ae3d27d4eb4full;
+static const uint64_t prime64_3 = 0x165667b19e3779f9ull;
+static const uint64_t prime64_4 = 0x85ebca77c2b2ae63ull;
+static const uint64_t prime64_5 = 0x27d4eb2f165667c5ull;
+static const uint64_t prime_mx1 = 0x165667919e3779f9ull;
+static const uint64_t prime_mx2 = 0x9fb21c651e98df25ull;
+
+// Layout
+static const size_t stripe_len        = 64;
+static const size_t secret_size       = 192;
+static const size_t stripes_per_block = (secret_size - stripe_len) / 8;
+static const size_t secret_limit      = secret_size - stripe_len;
+
+/** Default secret */
+static const unsigned char secret[secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+
+/** Little-endian 32b read */
+inline static uint32_t read32(const unsigned char * p) {
+    return (uint32_t)p[0]       | (uint32_t)p[1] <<  8
+        | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/** Little-endian 64b read */
+inline static uint64_t read64(const unsigned char * p) {
+    return (uint64_t)read32(p) | (uint64_t)read32(p + 4) << 32;
+}
+
+inline static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline static uint64_t swap64(uint64_t x) { return __builtin_bswap64(x); }
+
+/** 64x64 -> 128 bit multiplication, folded to 64 bits */
+inline static uint64_t mul128_fold64(uint64_t lhs, uint64_t rhs) {
+    const unsigned __int128 product = (unsigned __int128)lhs * rhs;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+inline static uint64_t xxh64_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline static uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= prime_mx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline static uint64_t rrmxmx(uint64_t h, uint64_t len) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= prime_mx2;
+    return h ^ (h >> 28);
+}
+
+inline static uint64_t mix16(const unsigned char * in, const unsigned char * sec) {
+    return mul128_fold64(read64(in) ^ read64(sec), read64(in + 8) ^ read64(sec + 8));
+}
+
+
+/** Hash of data up to 240 bytes */
+static uint64_t hash_short(const unsigned char * in, size_t len) {
+    if (len > 128) {
+        uint64_t acc = len * prime64_1;
+        for (size_t i = 0; i < 8; ++i)
+            acc += mix16(in + 16 * i, secret + 16 * i);
+
+        acc = avalanche(acc);
+
+        const size_t rounds = len / 16;
+        for (size_t i = 8; i < rounds; ++i)
+            acc += mix16(in + 16 * i, secret + 16 * (i - 8) + 3);
+
+        acc += mix16(in + len - 16, secret + 136 - 17);
+        return avalanche(acc);
+    }
+
+    if (len > 16) {
+        uint64_t acc = len * prime64_1;
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) {
+                    acc += mix16(in + 48,       secret + 96);
+                    acc += mix16(in + len - 64, secret + 112);
+                }
+                acc += mix16(in + 32,       secret + 64);
+                acc += mix16(in + len - 48, secret + 80);
+            }
+            acc += mix16(in + 16,       secret + 32);
+            acc += mix16(in + len - 32, secret + 48);
+        }
+        acc += mix16(in,            secret);
+        acc += mix16(in + len - 16, secret + 16);
+        return avalanche(acc);
+    }
+
+    if (len > 8) {
+        const uint64_t lo = read64(in) ^ (read64(secret + 24) ^ read64(secret + 32));
+        const uint64_t hi = read64(in + len - 8)
+            ^ (read64(secret + 40) ^ read64(secret + 48));
+
+        return avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+    }
+
+    if (len >= 4) {
+        const uint64_t in1 = read32(in);
+        const uint64_t in2 = read32(in + len - 4);
+        const uint64_t in64 = in2 + (in1 << 32);
+
+        return rrmxmx(in64 ^ (read64(secret + 8) ^ read64(secret + 16)), len);
+    }
+
+    if (len) {
+        const uint32_t combined =
+            ((uint32_t)in[0] << 16) | ((uint32_t)in[len >> 1] << 24)
+            | (uint32_t)in[len - 1] | ((uint32_t)len << 8);
+
+        return xxh64_avalanche(combined
+            ^ (uint64_t)(read32(secret) ^ read32(secret + 4)));
+    }
+
+    return xxh64_avalanche(read64(secret + 56) ^ read64(secret + 64));
+}
+
+
+/** Accumulate one stripe */
+inline static void accumulate512(
+    uint64_t *            acc,
+    const unsigned char * in,
+    const unsigned char * sec)
+{
+    for (size_t i = 0; i < 8; ++i) {
+        const uint64_t val = read64(in + 8 * i);
+        const uint64_t key = val ^ read64(sec + 8 * i);
+
+        acc[i ^ 1] += val;
+        acc[i]     += (key & 0xffffffffu) * (key >> 32);
+    }
+}
+
+/** Accumulate \c cnt stripes */
+inline static void accumulate(
+    uint64_t *            acc,
+    const unsigned char * in,
+    const unsigned char * sec,
+    size_t                cnt)
+{
+    for (size_t i = 0; i < cnt; ++i)
+        accumulate512(acc, in + i * stripe_len, sec + i * 8);
+}
+
+/** Scramble accumulators (at end of block) */
+inline static void scramble(uint64_t * acc, const unsigned char * sec) {
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(sec + 8 * i);
+        a *= prime32_1;
+        acc[i] = a;
+    }
+}
+
+
+xxh3::context::context():
+    m_acc{
+        prime32_3, prime64_1, prime64_2, prime64_3,
+        prime64_4, prime32_2, prime64_5, prime32_1},
+    m_buffered(0),
+    m_stripes(0),
+    m_total(0)
+{}
+
+
+void xxh3::context::consume(const unsigned char * data, size_t cnt) {
+    if (stripes_per_block - m_stripes <= cnt) {
+        const size_t to_block_end = stripes_per_block - m_stripes;
+
+        accumulate(m_acc, data, secret + m_stripes * 8, to_block_end);
+        scramble(m_acc, secret + secret_limit);
+
+        m_stripes = cnt - to_block_end;
+        accumulate(m_acc, data + to_block_end * stripe_len, secret, m_stripes);
+    }
+    else {
+        accumulate(m_acc, data, secret + m_stripes * 8, cnt);
+        m_stripes += cnt;
+    }
+}
+
+
+void xxh3::context::update(const unsigned char * data, size_t size) {
+    static const size_t buffer_size = sizeof(m_buffer);
+    static const size_t buffer_stripes = buffer_size / stripe_len;
+
+    m_total += size;
+
+    // Fits in the buffer (note that at least 1 byte is always kept)
+    if (m_buffered + size <= buffer_size) {
+        std::memcpy(m_buffer + m_buffered, data, size);
+        m_buffered += size;
+        return;
+    }
+
+    // Complete & consume the buffer
+    if (m_buffered) {
+        const size_t fill = buffer_size - m_buffered;
+        std::memcpy(m_buffer + m_buffered, data, fill);
+        data += fill;
+        size -= fill;
+
+        consume(m_buffer, buffer_stripes);
+        std::memcpy(m_last, m_buffer + buffer_size - stripe_len, stripe_len);
+        m_buffered = 0;
+    }
+
+    // Consume input directly
+    if (size > buffer_size) {
+        do {
+            consume(data, buffer_stripes);
+            data += buffer_size;
+            size -= buffer_size;
+        } while (size > buffer_size);
+
+        std::memcpy(m_last, data - stripe_len, stripe_len);
+    }
+
+    std::memcpy(m_buffer, data, size);
+    m_buffered = size;
+}
+
+
+uint64_t xxh3::context::digest() const {
+    if (m_total <= 240) return hash_short(m_buffer, m_total);
+
+    context ctx(*this);
+    unsigned char last_stripe[stripe_len];
+    const unsigned char * last = last_stripe;
+
+    if (m_buffered >= stripe_len) {
+        ctx.consume(m_buffer, (m_buffered - 1) / stripe_len);
+        last = m_buffer + m_buffered - stripe_len;
+    }
+    else {
+        const size_t catchup = stripe_len - m_buffered;
+        std::memcpy(last_stripe, m_last + stripe_len - catchup, catchup);
+        std::memcpy(last_stripe + catchup, m_buffer, m_buffered);
+    }
+
+    accumulate512(ctx.m_acc, last, secret + secret_limit - 7);
+
+    // Merge accumulators
+    uint64_t result = m_total * prime64_1;
+    for (size_t i = 0; i < 4; ++i)
+        result += mul128_fold64(
+            ctx.m_acc[2 * i]     ^ read64(secret + 11 + 16 * i),
+            ctx.m_acc[2 * i + 1] ^ read64(secret + 11 + 16 * i + 8));
+
+    return avalanche(result);
+}
+
+
+void xxh3::operator () (unsigned char * data, size_t size) {
+    m_context.update(data, size);
+}
+
+
+uint64_t xxh3::hash(const unsigned char * data, size_t size) {
+    if (size <= 240) return hash_short(data, size);
+
+    context ctx;
+    ctx.update(data, size);
+    return ctx.digest();
+}
+
+}  // end of namespace fastcrawl
@@ -0,0 +1,117 @@
+#ifndef fastcrawl__xxh3_hxx
+#define fastcrawl__xxh3_hxx
+
+/**
+ *  \file
+ *  \brief  XXH3 online hash
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "online_data_processor.hxx"
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace fastcrawl {
+
+/**
+ *  \brief  Online data hash based on XXH3 (64 bit) algorithm
+ *
+ *  Portable implementation of XXH3 64-bit hash (default secret, no seed).
+ *  The results are compatible with the reference \c XXH3_64bits.
+ *
+ *  See https://github.com/Cyan4973/xxHash
+ */
+class xxh3: public online_data_processor {
+    public:
+
+    /**
+     *  \brief  Streaming hash context
+     *
+     *  Data may be added in chunks of arbitrary sizes.
+     */
+    class context {
+        private:
+
+        uint64_t      m_acc[8];         /**< Accumulators                  */
+        unsigned char m_buffer[256];    /**< Input buffer                  */
+        unsigned char m_last[64];       /**< Last stripe consumed          */
+        size_t        m_buffered;       /**< Bytes in buffer               */
+        size_t        m_stripes;        /**< Stripes consumed in block     */
+        uint64_t      m_total;          /**< Total data length             */
+
+        public:
+
+        context();
+
+        /** Add data */
+        void update(const unsigned char * data, size_t size);
+
+        /** Hash of the data so far (the context may be updated further) */
+        uint64_t digest() const;
+
+        private:
+
+        /** Consume \c cnt stripes of \c data (more data must follow) */
+        void consume(const unsigned char * data, size_t cnt);
+
+    };  // end of class context
+
+    private:
+
+    context    m_context;   /**< Hash context */
+    uint64_t & m_result;    /**< Final result */
+
+    public:
+
+    /** Constructor, takes reference to the result */
+    xxh3(uint64_t & result): m_result(result) {}
+
+    void operator () (unsigned char * data, size_t size);
+
+    /** Destructor assigns the result */
+    ~xxh3() { m_result = m_context.digest(); }
+
+    /** One-shot hash */
+    static uint64_t hash(const unsigned char * data, size_t size);
+
+};  // end of class xxh3
+
+}  // end of namespace fastcrawl
+
+#endif  // end of #ifndef fastcrawl__xxh3_hxx
@@ -0,0 +1,281 @@
+/**
+ *  \file
+ *  \brief  Asynchronous download unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/async.hxx"
+#include "libfastcrawl/download_loop.hxx"
+#include "libfastcrawl/online_data_processor.hxx"
+#include "libfastcrawl/content_size.hxx"
+#include "libfastcrawl/uri.hxx"
+#include "libfastcrawl/thread_pool.hxx"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+
+extern "C" {
+#include <unistd.h>
+}
+
+
+/** Content collector */
+class collector: public fastcrawl::online_data_processor {
+    private:
+
+    std::string & m_content;  /**< Content */
+
+    public:
+
+    collector(std::string & content): m_content(content) {}
+
+    void operator () (unsigned char * data, size_t size) {
+        m_content.append((const char *)data, size);
+    }
+
+};  // end of class collector
+
+
+/** Asynchronous download unit test */
+class async_test {
+    private:
+
+    static const size_t pages    = 200;  /**< Crawled pages          */
+    static const size_t children = 10;   /**< Children per page      */
+
+    std::string m_dir;  /**< Test data directory */
+
+    /** file:// URI of a test file */
+    fastcrawl::uri file_uri(const std::string & name) const {
+        return fastcrawl::uri("file", "", "", "", 0, m_dir + "/" + name, "", "");
+    }
+
+    /**
+     *  \brief  Crawl page: fetch the page, then fetch its children
+     *
+     *  \param  loop    Download loop
+     *  \param  page    Page number
+     *  \param  result  Total size of the children
+     *  \param  done    Crawled pages counter
+     */
+    fastcrawl::task<void> crawl(
+        fastcrawl::download_loop & loop,
+        size_t                     page,
+        size_t &                   result,
+        std::atomic<size_t> &      done) const
+    {
+        std::string content;
+        collector   collect(content);
+
+        const std::string page_name = "page_" + std::to_string(page);
+        if (!co_await fastcrawl::download_async(loop,
+            file_uri(page_name), m_dir + "/out_" + page_name, collect))
+        {
+            co_return;
+        }
+
+        result = co_await fetch_children(loop, page_name, content);
+        ++done;
+    }
+
+    /** Fetch children listed in page content (sequentially) */
+    fastcrawl::task<size_t> fetch_children(
+        fastcrawl::download_loop & loop,
+        const std::string &        page_name,
+        const std::string &        content) const
+    {
+        size_t total = 0;
+
+        std::stringstream content_ss(content);
+        std::string child;
+        while (std::getline(content_ss, child)) {
+            size_t size;
+            {
+                fastcrawl::content_size proc(size);
+                if (!co_await fastcrawl::download_async(loop,
+                    file_uri(child), m_dir + "/out_" + page_name + child, proc))
+                {
+                    co_return 0;
+                }
+            }
+
+            total += size;
+        }
+
+        co_return total;
+    }
+
+    public:
+
+    async_test() {
+        char dir[] = "/tmp/fastcrawl_ut_async_XXXXXX";
+        if (nullptr == ::mkdtemp(dir))
+            throw std::runtime_error("failed to create test directory");
+
+        m_dir = dir;
+
+        // Pages list their children; child i has i + 1 bytes
+        for (size_t i = 0; i < children; ++i)
+            std::ofstream(m_dir + "/child_" + std::to_string(i))
+                << std::string(i + 1, 'x');
+
+        for (size_t page = 0; page < pages; ++page) {
+            std::ofstream page_file(m_dir + "/page_" + std::to_string(page));
+            for (size_t i = 0; i < children; ++i)
+                page_file << "child_" << i << std::endl;
+        }
+    }
+
+    /** Execute asynchronous download unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        fastcrawl::download_loop loop;
+        std::vector<size_t>      results(pages, 0);
+        std::atomic<size_t>      done(0);
+
+        // Thousands of downloads on a single thread
+        for (size_t page = 0; page < pages; ++page)
+            fastcrawl::spawn(crawl(loop, page, results[page], done));
+
+        loop.stop();  // finish all the downloads
+        loop.run();
+
+        ++test_cnt;
+        if (pages != done) {
+            std::cerr
+                << "Crawled pages: " << done << " FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        const size_t expected = children * (children + 1) / 2;
+        for (size_t page = 0; page < pages; ++page) {
+            ++test_cnt;
+            if (expected != results[page]) {
+                std::cerr
+                    << "Page " << page << " children size " << results[page]
+                    << " FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Resumption by a thread pool
+        ++test_cnt;
+        {
+            fastcrawl::download_loop loop;
+            fastcrawl::thread_pool   pool(1, 1);
+            loop.start();
+
+            std::atomic<bool> ok(false);
+            fastcrawl::spawn([](
+                fastcrawl::download_loop & loop,
+                fastcrawl::thread_pool &   pool,
+                fastcrawl::uri             uri,
+                std::atomic<bool> &        ok) -> fastcrawl::task<void>
+            {
+                std::string content;
+                collector   collect(content);
+                if (co_await fastcrawl::download_async(
+                    loop, uri, uri.path + ".out", collect))
+                {
+                    co_await fastcrawl::resume_on(pool);
+                    ok = content.size() == children * 8;  // "child_N\n"
+                }
+            }(loop, pool, file_uri("page_0"), ok));
+
+            loop.stop();
+            pool.shutdown();
+
+            if (!ok) {
+                std::cerr << "Resumption by thread pool FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "Async download UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+    /** Remove test data */
+    ~async_test() {
+        const std::string cmd = "rm -rf '" + m_dir + "'";
+        if (0 != std::system(cmd.c_str()))
+            std::cerr << "Failed to remove " << m_dir << std::endl;
+    }
+
+};  // end of class async_test
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const async_test async_ut;
+    return async_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
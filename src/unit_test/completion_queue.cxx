@@ -0,0 +1,156 @@
+/**
+ *  \file
+ *  \brief  Download completion queue unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/completion_queue.hxx"
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <string>
+
+
+/** Completion queue unit test */
+class completion_queue_test {
+    private:
+
+    static const size_t producers = 4;      /**< Producer threads         */
+    static const size_t completions = 1000; /**< Completions per producer */
+
+    public:
+
+    /** Execute completion queue unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        fastcrawl::completion_queue queue;
+        auto callback = queue.callback();
+
+        // Consumer (runs concurrently with producers)
+        std::vector<size_t> sizes(producers * completions, 0);
+        size_t popped = 0;
+        std::thread consumer([&queue, &sizes, &popped]() {
+            fastcrawl::completion c;
+            while (queue.pop(c)) {
+                sizes[std::stoul(c.uri)] = c.record.size;
+                ++popped;
+            }
+        });
+
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p)
+            threads.emplace_back([&callback, p]() {
+                for (size_t i = 0; i < completions; ++i) {
+                    const size_t id = p * completions + i;
+
+                    fastcrawl::uri_record record;
+                    record.size = id + 1;
+                    callback(std::to_string(id), record);
+                }
+            });
+
+        for (auto & thread: threads) thread.join();
+
+        queue.close();
+        consumer.join();
+
+        ++test_cnt;
+        if (producers * completions != popped) {
+            std::cerr << "Completions count FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        for (size_t id = 0; id < sizes.size(); ++id)
+            if (id + 1 != sizes[id]) {
+                std::cerr << "Completion " << id << " FAILED" << std::endl;
+                ++fail_cnt;
+                break;
+            }
+
+        // Closed & empty queue
+        fastcrawl::completion c;
+        ++test_cnt;
+        if (queue.pop(c) || queue.try_pop(c) || !queue.closed()) {
+            std::cerr << "Closed queue FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Completion queue UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class completion_queue_test
+
+static const completion_queue_test completion_queue_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return completion_queue_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,707 @@
+/**
+ *  \file
+ *  \brief  End-to-end crawl unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark/http_server.hxx"
+
+#include "libfastcrawl/html_crawler.hxx"
+#include "libfastcrawl/batch_crawler.hxx"
+#include "libfastcrawl/crawl_context.hxx"
+#include "libfastcrawl/download.hxx"
+#include "libfastcrawl/download_policy.hxx"
+#include "libfastcrawl/processor_pipeline.hxx"
+#include "libfastcrawl/metrics.hxx"
+#include "libfastcrawl/uri.hxx"
+
+extern "C" {
+#include <dirent.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <map>
+#include <stdexcept>
+#include <cstdlib>
+
+
+/** End-to-end crawl unit test */
+class crawl_test {
+    private:
+
+    /** Remove all files in directory (recursively) */
+    static void clean_dir(const std::string & path = ".") {
+        auto * dir = ::opendir(path.c_str());
+        if (nullptr == dir) return;
+
+        while (auto * entry = ::readdir(dir)) {
+            const std::string name = entry->d_name;
+
+            if (DT_REG == entry->d_type)
+                ::unlink((path + '/' + name).c_str());
+
+            else if (DT_DIR == entry->d_type && "." != name && ".." != name) {
+                clean_dir(path + '/' + name);
+                ::rmdir((path + '/' + name).c_str());
+            }
+        }
+
+        ::closedir(dir);
+    }
+
+    /**
+     *  \brief  Crawl the server page
+     *
+     *  \param  conf         Server configuration
+     *  \param  queue_limit  Download queue limit (the page download
+     *                       must be throttled if set)
+     *  \param  compression  Transfer compression (the server must
+     *                       compress if set)
+     *
+     *  \return Number of failures
+     */
+    static size_t crawl(
+        const fastcrawl::http_server::config &       conf,
+        size_t                                       queue_limit = SIZE_MAX,
+        fastcrawl::download_policy::compression_t    compression =
+            fastcrawl::download_policy::IDENTITY)
+    {
+        fastcrawl::download_policy policy;
+        policy.compression = compression;
+
+        auto & metrics = fastcrawl::metrics::global();
+        const auto values_before = metrics.values();
+
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        // Relative references get the server scheme, host and port
+        const auto uri = fastcrawl::uri::parse(server.base_uri() + "index.html");
+
+        std::mutex                      mutex;
+        std::map<std::string, size_t>   sizes;
+
+        fastcrawl::html_crawler html_crawler(uri, SIZE_MAX == queue_limit ? SIZE_MAX : 4);
+        html_crawler.queue_limit(queue_limit);
+        html_crawler.policy(policy);
+        html_crawler.on_completion([&mutex, &sizes](
+            const std::string &           uri,
+            const fastcrawl::uri_record & record)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sizes[uri] = record.success ? record.size : SIZE_MAX;
+        });
+
+        const auto page_policy = policy.page();
+
+        fastcrawl::download download(uri, "./index.html");
+        download.policy(&page_policy);
+        size_t fail_cnt = download(html_crawler) ? 0 : 1;
+        html_crawler.wait();
+
+        // The page or stylesheet download (or both) is throttled
+        const auto throttled = html_crawler.download_pool_stats().throttled;
+        if (SIZE_MAX != queue_limit && !throttled) {
+            std::cerr << "Reference downloads not throttled" << std::endl;
+            ++fail_cnt;
+        }
+
+        // The stylesheet and its references (resolved by the crawler)
+        const size_t references = conf.references +
+            (conf.css_references ? conf.css_references + 1 : 0);
+
+        if (references != sizes.size()) {
+            std::cerr
+                << "References: " << sizes.size()
+                << " instead of " << references
+                << std::endl;
+
+            ++fail_cnt;
+        }
+
+        if (conf.css_references) {
+            const auto iter = sizes.find("/style");
+            if (sizes.end() == iter || server.stylesheet().size() != iter->second) {
+                std::cerr << "Stylesheet download FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        for (size_t i = conf.references; i < references - 1; ++i) {
+            const auto iter = sizes.find(server.base_uri() + "obj/" + std::to_string(i));
+            if (sizes.end() == iter || server.object_size(i) != iter->second) {
+                std::cerr << "Stylesheet object " << i << " download FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Encoded content is smaller (the server content compresses well)
+        const bool encoded = fastcrawl::download_policy::ENCODED == compression;
+
+        for (size_t i = 0; i < conf.references; ++i) {
+            const auto iter = sizes.find("/obj/" + std::to_string(i));
+            const size_t size = server.object_size(i);
+
+            if (sizes.end() == iter || (encoded
+                ? SIZE_MAX == iter->second || (size >= 1024 && size <= iter->second)
+                : size != iter->second))
+            {
+                std::cerr << "Object " << i << " download FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Compressed transfer is smaller than the content received
+        // (in the encoded mode, only the page is decoded)
+        const auto values_after = metrics.values();
+        const auto received =
+            values_after.bytes_received - values_before.bytes_received;
+        const auto transferred =
+            values_after.bytes_transferred - values_before.bytes_transferred;
+
+        const bool transfer_ok =
+            fastcrawl::download_policy::IDENTITY == compression
+                ? transferred == received :
+            fastcrawl::download_policy::DECODE == compression
+                ? transferred * 2 < received
+                : transferred < received;
+
+        if (!transfer_ok) {
+            std::cerr
+                << "Transferred " << transferred << " B, received "
+                << received << " B" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        clean_dir();
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Crawl the server page with content admission
+     *
+     *  Skipped content must not be stored (nor retried) and the rest
+     *  must be downloaded intact.
+     *  Also, an error response is skipped if required.
+     *
+     *  \param  conf    Server configuration
+     *  \param  policy  Download policy (setting admission)
+     *
+     *  \return Number of failures
+     */
+    static size_t admission_crawl(
+        const fastcrawl::http_server::config & conf,
+        const fastcrawl::download_policy &     policy)
+    {
+        auto & metrics = fastcrawl::metrics::global();
+        const auto values_before = metrics.values();
+
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        const auto uri = fastcrawl::uri::parse(server.base_uri() + "index.html");
+
+        std::mutex                            mutex;
+        std::map<std::string, fastcrawl::uri_record> records;
+
+        fastcrawl::html_crawler html_crawler(uri);
+        html_crawler.policy(policy);
+        html_crawler.on_completion([&mutex, &records](
+            const std::string &           uri,
+            const fastcrawl::uri_record & record)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            records[uri] = record;
+        });
+
+        // The page itself is always admitted
+        const auto page_policy = policy.page();
+
+        fastcrawl::download download(uri, "./index.html");
+        download.policy(&page_policy);
+        size_t fail_cnt = download(html_crawler) ? 0 : 1;
+        html_crawler.wait();
+
+        const bool type_ok = policy.accepted("application/octet-stream");
+
+        size_t skipped = 0;
+        for (size_t i = 0; i < conf.references; ++i) {
+            const auto iter = records.find("/obj/" + std::to_string(i));
+            if (records.end() == iter) {
+                std::cerr << "Object " << i << " not crawled" << std::endl;
+                ++fail_cnt;
+                continue;
+            }
+
+            const auto & record = iter->second;
+            const size_t size   = server.object_size(i);
+
+            // Decoded size is only known as the content is received
+            const bool known_length = !conf.chunked &&
+                !(conf.gzip && fastcrawl::download_policy::DECODE == policy.compression);
+
+            const fastcrawl::skip_reason reason =
+                !type_ok ? fastcrawl::SKIP_TYPE :
+                policy.max_size && size > policy.max_size
+                    ? (known_length ? fastcrawl::SKIP_LENGTH : fastcrawl::SKIP_SIZE)
+                    : fastcrawl::NOT_SKIPPED;
+
+            const bool stored = 0 == ::access(record.filename, F_OK);
+
+            if (reason != record.skipped || record.success == !!reason ||
+                stored == !!reason || (!reason && size != record.size))
+            {
+                std::cerr
+                    << "Object " << i << " (" << size << " B): " << record
+                    << ", expected " << fastcrawl::skip_reason_str(reason)
+                    << std::endl;
+
+                ++fail_cnt;
+            }
+
+            if (reason) ++skipped;
+        }
+
+        // Size limit is meant to skip some of the objects
+        if (type_ok && policy.max_size && (0 == skipped || conf.references == skipped)) {
+            std::cerr << "Objects skipped: " << skipped << std::endl;
+            ++fail_cnt;
+        }
+
+        const auto sum = html_crawler.summary();
+        if (skipped != sum.skipped || sum.failed) {
+            std::cerr
+                << "Summary: " << sum.skipped << " skipped, " << sum.failed
+                << " failed, expected " << skipped << " skipped" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        // Error response
+        fastcrawl::download missing(
+            fastcrawl::uri::parse(server.base_uri() + "missing"), "./missing");
+        missing.policy(&policy);
+
+        fastcrawl::processor_pipeline dproc;
+        fastcrawl::transfer_timing    timing;
+        fastcrawl::skip_reason        reason;
+
+        const bool missing_ok = missing(dproc, timing, reason);
+        if (policy.skip_errors ? missing_ok || fastcrawl::SKIP_STATUS != reason ||
+            0 == ::access("./missing", F_OK) : !missing_ok)
+        {
+            std::cerr
+                << "Error response: " << (missing_ok ? "stored" : "not stored")
+                << " (" << fastcrawl::skip_reason_str(reason) << ")"
+                << std::endl;
+
+            ++fail_cnt;
+        }
+        if (policy.skip_errors) ++skipped;
+
+        const auto values_after = metrics.values();
+        if (skipped != values_after.skipped - values_before.skipped ||
+            values_after.retries != values_before.retries)
+        {
+            std::cerr
+                << "Metrics: "
+                << values_after.skipped - values_before.skipped << " skipped, "
+                << values_after.retries - values_before.retries << " retries"
+                << std::endl;
+
+            ++fail_cnt;
+        }
+
+        clean_dir();
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Batch crawl of the server page (as multiple seeds)
+     *
+     *  The seeds are the page (twice) and the page alias (so all
+     *  the references of the other seed are shared).
+     *  If near-duplicate pages are detected, the page alias isn't crawled
+     *  at all (either of the seeds, they're crawled concurrently).
+     *
+     *  \param  conf             Server configuration
+     *  \param  near_duplicates  Detect near-duplicate pages
+     *
+     *  \return Number of failures
+     */
+    static size_t batch_crawl(
+        const fastcrawl::http_server::config & conf,
+        bool                                   near_duplicates = false)
+    {
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        std::stringstream seeds;
+        seeds
+            << server.base_uri() << "index.html" << std::endl
+            << "# comment" << std::endl
+            << std::endl
+            << server.base_uri() << std::endl
+            << server.base_uri() << "index.html" << std::endl;
+
+        fastcrawl::crawl_context context(8);
+        if (near_duplicates) context.near_duplicates(3);
+        fastcrawl::batch_crawler batch(context, 2);
+
+        std::vector<fastcrawl::batch_crawler::seed_report> reports;
+        const size_t seed_cnt = batch(seeds,
+            [&reports](const fastcrawl::batch_crawler::seed_report & report) {
+                reports.push_back(report);
+            });
+
+        size_t fail_cnt = 0;
+        if (3 != seed_cnt || 3 != reports.size()) {
+            std::cerr
+                << "Seeds: " << seed_cnt << " (" << reports.size()
+                << " reports) instead of 3" << std::endl;
+
+            return ++fail_cnt;
+        }
+
+        // Each reference is downloaded once (by either of the seeds)
+        size_t downloaded = 0;
+        size_t duplicates = 0;
+        size_t similar    = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            const auto & report = reports[i];
+
+            if (i + 1 != report.index || !report.success || report.duplicate) {
+                std::cerr << "Seed " << report.seed << " FAILED" << std::endl;
+                ++fail_cnt;
+            }
+
+            if (report.near_duplicate) {
+                ++similar;
+
+                if (report.summary.references || report.fingerprint !=
+                    reports[1 - i].fingerprint)
+                {
+                    std::cerr
+                        << "Near-duplicate seed " << report.seed << ": "
+                        << report.summary.references << " references"
+                        << std::endl;
+
+                    ++fail_cnt;
+                }
+
+                continue;
+            }
+
+            if (conf.references != report.summary.references + report.summary.duplicates) {
+                std::cerr
+                    << "Seed " << report.seed << ": "
+                    << report.summary.references << " + "
+                    << report.summary.duplicates << " shared references"
+                    << " instead of " << conf.references << std::endl;
+
+                ++fail_cnt;
+            }
+
+            downloaded += report.summary.downloaded;
+            duplicates += report.summary.duplicates;
+        }
+
+        if ((near_duplicates ? 1 : 0) != similar) {
+            std::cerr << "Near-duplicate seeds: " << similar << std::endl;
+            ++fail_cnt;
+        }
+
+        if (conf.references != downloaded ||
+            (near_duplicates ? 0 : conf.references) != duplicates)
+        {
+            std::cerr
+                << "Downloaded " << downloaded << ", shared " << duplicates
+                << " instead of " << conf.references << std::endl;
+
+            ++fail_cnt;
+        }
+
+        if (!reports[2].duplicate) {
+            std::cerr << "Repeated seed not detected" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (conf.references != batch.timings().all().transfers()) {
+            std::cerr
+                << "Timing report: " << batch.timings().all().transfers()
+                << " transfers instead of " << conf.references << std::endl;
+
+            ++fail_cnt;
+        }
+
+        clean_dir();
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Content storage directory test
+     *
+     *  Directory paths that don't fit in content file names are rejected.
+     *
+     *  \return Number of failures
+     */
+    static size_t storage_directory() {
+        fastcrawl::html_crawler html_crawler(
+            fastcrawl::uri::parse("http://www.example.com/"));
+
+        const std::string dir(fastcrawl::html_crawler::directory_max, 'd');
+        html_crawler.directory(dir);
+
+        bool thrown = false;
+        try {
+            html_crawler.directory(dir + "d");
+        }
+        catch (const std::length_error & ) {
+            thrown = true;
+        }
+
+        return thrown && dir == html_crawler.directory() ? 0 : 1;
+    }
+
+    public:
+
+    /** Execute end-to-end crawl unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (storage_directory()) {
+            std::cerr << "Storage directory FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        fastcrawl::http_server::config conf;
+        conf.references   = 64;
+        conf.object_size  = 4096;
+        conf.distribution = fastcrawl::http_server::LOGNORMAL;
+
+        ++test_cnt;
+        if (crawl(conf)) {
+            std::cerr << "Plain crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        conf.chunked       = true;
+        conf.latency_ms    = 2;
+        conf.trickle_ratio = 0.1;
+        conf.trickle_rate  = 1 << 20;
+
+        ++test_cnt;
+        if (crawl(conf)) {
+            std::cerr << "Chunked & trickled crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Many references (the page is received in many chunks)
+        auto farm_conf = conf;
+        farm_conf.references    = 2000;
+        farm_conf.object_size   = 256;
+        farm_conf.latency_ms    = 0;
+        farm_conf.trickle_ratio = 0;
+
+        ++test_cnt;
+        if (crawl(farm_conf, 16)) {
+            std::cerr << "Throttled crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Compressed transfers (decoded and kept encoded)
+        auto gzip_conf = conf;
+        gzip_conf.gzip = true;
+
+        ++test_cnt;
+        if (crawl(gzip_conf, SIZE_MAX, fastcrawl::download_policy::DECODE)) {
+            std::cerr << "Compressed crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (crawl(gzip_conf, SIZE_MAX, fastcrawl::download_policy::ENCODED)) {
+            std::cerr << "Compressed (encoded) crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Server compression isn't used unless accepted
+        ++test_cnt;
+        if (crawl(gzip_conf)) {
+            std::cerr << "Uncompressed crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Stylesheet references (fonts, images...)
+        auto css_conf = conf;
+        css_conf.css_references = 20;
+
+        ++test_cnt;
+        if (crawl(css_conf)) {
+            std::cerr << "Stylesheet crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Stylesheet references are throttled, too (the page has just
+        // the stylesheet, so it's never throttled itself)
+        auto css_only_conf = css_conf;
+        css_only_conf.references     = 0;
+        css_only_conf.css_references = 2000;
+
+        ++test_cnt;
+        if (crawl(css_only_conf, 4)) {
+            std::cerr << "Throttled stylesheet crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Content admission (by type, declared and actual size, status)
+        fastcrawl::download_policy admission;
+        admission.accept_types = "text/, image/";
+        admission.skip_errors  = true;
+
+        ++test_cnt;
+        if (admission_crawl(conf, admission)) {
+            std::cerr << "Type admission crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        admission.accept_types = "text/, Application/Octet";
+        admission.max_size     = 4096;
+
+        auto plain_conf = conf;
+        plain_conf.chunked = false;
+
+        ++test_cnt;
+        if (admission_crawl(plain_conf, admission)) {
+            std::cerr << "Length admission crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (admission_crawl(conf, admission)) {
+            std::cerr << "Size admission crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // The size limit applies to decoded content (the objects compress
+        // well, so the larger ones have Content-Length over the limit, too)
+        auto plain_gzip_conf = plain_conf;
+        plain_gzip_conf.gzip         = true;
+        plain_gzip_conf.object_size  = 256;
+        plain_gzip_conf.distribution = fastcrawl::http_server::UNIFORM;
+        admission.compression = fastcrawl::download_policy::DECODE;
+        admission.max_size    = 96;
+
+        ++test_cnt;
+        if (admission_crawl(plain_gzip_conf, admission)) {
+            std::cerr << "Decoded size admission crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (batch_crawl(conf)) {
+            std::cerr << "Batch crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (batch_crawl(conf, true)) {
+            std::cerr << "Batch crawl (near-duplicates) FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Crawl UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class crawl_test
+
+static const crawl_test crawl_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    // Work in a temporary directory
+    char dir[] = "/tmp/ut_crawl.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    const bool ok = crawl_ut();
+
+    ::rmdir(dir);
+
+    return ok ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,238 @@
+/**
+ *  \file
+ *  \brief  CSS segmenter unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "libfastcrawl/css_segmenter.hxx"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+
+/** CSS segmenter unit test */
+class css_segmenter_test {
+    private:
+
+    /** Segmenter output ("rule value" strings) */
+    using references = std::vector<std::string>;
+
+    /** Collecting segmenter sink */
+    struct collecting_sink {
+        references * refs;  /**< Output */
+
+        void operator () (const char * rule, const std::string & value) const {
+            refs->push_back(std::string(rule) + ' ' + value);
+        }
+
+    };  // end of struct collecting_sink
+
+    /** Test case */
+    struct test_case {
+        const char * css;   /**< Stylesheet                  */
+        references   refs;  /**< Expected references         */
+
+    };  // end of struct test_case
+
+    /**
+     *  \brief  Segment stylesheet
+     *
+     *  \param  css     Stylesheet
+     *  \param  splits  Chunk boundaries (ascending)
+     *
+     *  \return Segmenter output
+     */
+    static references segment(
+        const std::string &         css,
+        const std::vector<size_t> & splits)
+    {
+        references refs;
+        fastcrawl::css_segmenter<collecting_sink> segmenter(collecting_sink{&refs});
+
+        std::vector<unsigned char> data(css.begin(), css.end());
+
+        size_t offset = 0;
+        for (size_t split: splits) {
+            segmenter(data.data() + offset, split - offset);
+            offset = split;
+        }
+        segmenter(data.data() + offset, data.size() - offset);
+
+        return refs;
+    }
+
+    /** Print references */
+    static void print(std::ostream & out, const references & refs) {
+        for (auto & ref: refs) out << "    \"" << ref << '"' << std::endl;
+    }
+
+    /**
+     *  \brief  Check test case
+     *
+     *  The stylesheet is segmented in one chunk, in two chunks (split
+     *  at every position) and byte by byte.
+     *
+     *  \param  tc  Test case
+     *
+     *  \return Number of failures
+     */
+    static size_t check(const test_case & tc) {
+        const std::string css = tc.css;
+        size_t fail_cnt = 0;
+
+        auto verify = [&tc, &fail_cnt](
+            const references & refs,
+            const std::string & how)
+        {
+            if (refs == tc.refs) return;
+
+            std::cerr
+                << "Stylesheet \"" << tc.css << "\" segmented " << how
+                << " FAILED; got:" << std::endl;
+            print(std::cerr, refs);
+            std::cerr << "expected:" << std::endl;
+            print(std::cerr, tc.refs);
+
+            ++fail_cnt;
+        };
+
+        verify(segment(css, {}), "in one chunk");
+
+        for (size_t split = 1; split < css.size() && !fail_cnt; ++split)
+            verify(segment(css, {split}),
+                "in two chunks (at " + std::to_string(split) + ")");
+
+        std::vector<size_t> bytes;
+        for (size_t split = 1; split < css.size(); ++split)
+            bytes.push_back(split);
+
+        verify(segment(css, bytes), "byte by byte");
+
+        return fail_cnt;
+    }
+
+    public:
+
+    /** Execute CSS segmenter unit test */
+    bool operator () () const {
+        static const std::string overlong(
+            fastcrawl::css_segmenter<collecting_sink>::max_value + 1, 'x');
+
+        const test_case test_cases[] = {
+            { "", {} },
+            { "body { color: red; }", {} },
+            { "a { background: url(/img/a.png) }",
+              { "url /img/a.png" } },
+            { "a{background:URL( \"/img/b.png\" )}b{src:url('c.woff')}",
+              { "url /img/b.png", "url c.woff" } },
+            { "@import \"base.css\";\n@IMPORT url(print.css) print;",
+              { "@import base.css", "@import print.css" } },
+            { "@import /* comment */ 'x.css';",
+              { "@import x.css" } },
+            { "/* url(/commented) */ a { content: \"url(/quoted)\" }",
+              {} },
+            { "a { background: url(/a\\ b.png) url(\"/c\\\".png\") }",
+              { "url /a b.png", "url /c\".png" } },
+            { "a { x: menu(/no) curl(/no) -url(/no) url() url(  ) }",
+              {} },
+            { "a { x: url(/bad path) url(/ok) url(\"/bad\" x) url(/ok2 ) }",
+              { "url /ok", "url /ok2" } },
+            { "@media print { @charset \"utf-8\"; a { b: url(/p.png) } }",
+              { "url /p.png" } },
+            { "a { content: \"unterminated\n b: url(/after) }",
+              { "url /after" } },
+            { "a { b: url(data:image/png;base64,iVBOR) }",
+              { "url data:image/png;base64,iVBOR" } },
+        };
+
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        for (auto & tc: test_cases) {
+            ++test_cnt;
+            if (check(tc)) ++fail_cnt;
+        }
+
+        // Overlong references are dropped
+        ++test_cnt;
+        const std::string css = "a { b: url(" + overlong + ") c: url(/next) }";
+        if (check(test_case{css.c_str(), { "url /next" }})) ++fail_cnt;
+
+        std::cerr
+            << "CSS segmenter UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class css_segmenter_test
+
+static const css_segmenter_test css_segmenter_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return css_segmenter_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
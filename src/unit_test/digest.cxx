@@ -0,0 +1,276 @@
+/**
+ *  \file
+ *  \brief  Content digests unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/crc32c.hxx"
+#include "libfastcrawl/xxh3.hxx"
+#include "libfastcrawl/sha256.hxx"
+#include "libfastcrawl/multi_hash.hxx"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <list>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+
+/** Content digests unit test */
+class digest_test {
+    private:
+
+    /** Test case */
+    struct test_case {
+        const size_t        size;       /**< Data size (see \ref data) */
+        const uint32_t      crc32c;     /**< Expected CRC32C           */
+        const uint64_t      xxh3;       /**< Expected XXH3             */
+        const std::string   sha256;     /**< Expected SHA-256 (hex)    */
+
+        test_case(
+            size_t              size_,
+            uint32_t            crc32c_,
+            uint64_t            xxh3_,
+            const std::string & sha256_)
+        :
+            size(size_),
+            crc32c(crc32c_),
+            xxh3(xxh3_),
+            sha256(sha256_)
+        {}
+
+    };  // end of struct test_case
+
+    std::list<test_case> m_test_cases;  /**< Test cases */
+
+    /** Test data of given size */
+    static std::vector<unsigned char> data(size_t size) {
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < size; ++i)
+            data[i] = (unsigned char)(i * 7 + i / 13);
+
+        return data;
+    }
+
+    public:
+
+    /** Create digest unit test cases (reference values by xxhash & hashlib) */
+    digest_test() {
+        m_test_cases.emplace_back(0, 0x00000000, 0x2d06800538d394c2,
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        m_test_cases.emplace_back(1, 0x527d5351, 0xc44bdff4074eecdb,
+            "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d");
+        m_test_cases.emplace_back(3, 0xb671d518, 0xc3489259e968ad9e,
+            "b361d0f9a938a2bb4fbdc9c21dc5a859788041b0040919d8a811c1888184f4df");
+        m_test_cases.emplace_back(4, 0xede36e57, 0xd3d60c1519014e89,
+            "6e14590861815ebebb76e8ca460621bd0f60ea4f1550edbf32e664d30d7a04fd");
+        m_test_cases.emplace_back(8, 0xa7fe3fce, 0xb88dee77f6bf6980,
+            "5fd8b294c3f896aa97b3479e20d5b807414731a70d06a97edfbc83e4d575f45c");
+        m_test_cases.emplace_back(9, 0x871525f3, 0x03688dcad730d826,
+            "3852a0902c04a73392272f20d9a311e0fce5886b3bb2215ec83e5bf5d6307064");
+        m_test_cases.emplace_back(16, 0xc02522a4, 0x907976bb290db9e8,
+            "72b4176c0fb32558470831054a17b991ee40777e9c9e971127b374cfcfce822e");
+        m_test_cases.emplace_back(17, 0xb49f83c4, 0xac1710d495aa0dbd,
+            "9c55dfa2679958d795eb839659a5e4c030f052bd0785c03a6f1b443de452d8de");
+        m_test_cases.emplace_back(128, 0x8e4218d4, 0xe872377f5593aa83,
+            "6f3e874d4b47c5544dcfce1849da7ff530f13662db3db83be5abe7a15951edb2");
+        m_test_cases.emplace_back(129, 0xbcfe8749, 0x9b55151daa76e2cf,
+            "5e6bad3276ebaa75ea1fb42349b79a5f13136507dc22a2098309871f4f000639");
+        m_test_cases.emplace_back(240, 0xd469db86, 0x28067121726fa14e,
+            "f8befc4513a30ff7d87f5f7a573f8bec3b9081ce01ac7d0a354fb432a2e51542");
+        m_test_cases.emplace_back(241, 0xb58e234b, 0x26e9e1d1ee797db1,
+            "b14f18347cb39580072ad3646d591d9b1159282e80327b82ee7e76308b8de2cd");
+        m_test_cases.emplace_back(256, 0x6235092f, 0x4919681d0579cded,
+            "553d4fa5a372cc38de6cb0296ebfb2851d2d099a5728f03296a858c8b6e1001a");
+        m_test_cases.emplace_back(257, 0x2fbfe039, 0xac51506968fe057f,
+            "b7159b76af54418ee625684f8a5b984fd77733e9691d8955bdb9cf399f7fedf6");
+        m_test_cases.emplace_back(1024, 0x629e97cd, 0x26898b5f48a4fda8,
+            "1d347ba0545fff2707dee769ca9766948e057ed2ecb05034924ddabec9549884");
+        m_test_cases.emplace_back(1025, 0xc3b9054a, 0x929f393174c68e11,
+            "28a431990fb220039ad39f935152960b23fe67b26a0042cbe0a2b85ea04653b5");
+        m_test_cases.emplace_back(2048, 0x206fcf19, 0xfc8a3d83d69fd599,
+            "8249c0096e8f94a211ee7fa063ac91fd89ba69ddfb5c8c36a20a1b96a8cd4390");
+        m_test_cases.emplace_back(5000, 0xe8892b9a, 0xe0969ae2b59aafcc,
+            "64b7e2e3bef0e587fac4705f5b78ad0aeabea7822852f6f13ef9efac2243aa55");
+        m_test_cases.emplace_back(65536, 0x76ff4cda, 0xa5e84a3bc1bde95f,
+            "718e9c2acbff27f66370285c86b0cc246e18bfaa349282dfdf0c40df522d24c1");
+    }
+
+    /** Execute content digests unit test */
+    bool operator () () const {
+        static const size_t chunk_sizes[] = { 1, 7, 64, 255, 256, 4096, 100000 };
+
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        std::cerr
+            << "CRC32C implementation: "
+            << (fastcrawl::crc32c::hardware() ? "hardware" : "software")
+            << std::endl;
+
+        for (auto & test_case: m_test_cases) {
+            auto data = digest_test::data(test_case.size);
+
+            for (auto chunk_size: chunk_sizes) {
+                ++test_cnt;
+
+                uint32_t                      crc32c;
+                uint64_t                      xxh3;
+                fastcrawl::sha256::digest_t   sha256;
+                fastcrawl::content_digests    digests;
+
+                // Separate processors & fused processor, chunked
+                {
+                    fastcrawl::crc32c     crc32c_proc(crc32c);
+                    fastcrawl::xxh3       xxh3_proc(xxh3);
+                    fastcrawl::sha256     sha256_proc(sha256);
+                    fastcrawl::multi_hash multi_hash_proc(
+                        fastcrawl::content_digests::CRC32C |
+                        fastcrawl::content_digests::XXH3   |
+                        fastcrawl::content_digests::SHA256,
+                        digests, 100);
+
+                    for (size_t off = 0; off < data.size(); off += chunk_size) {
+                        const size_t size = std::min(chunk_size, data.size() - off);
+
+                        crc32c_proc    (data.data() + off, size);
+                        xxh3_proc      (data.data() + off, size);
+                        sha256_proc    (data.data() + off, size);
+                        multi_hash_proc(data.data() + off, size);
+                    }
+                }
+
+                const bool ok =
+                    test_case.crc32c == crc32c                          &&
+                    test_case.xxh3   == xxh3                            &&
+                    test_case.sha256 == fastcrawl::sha256::hex(sha256)  &&
+                    test_case.crc32c == digests.crc32c                  &&
+                    test_case.xxh3   == digests.xxh3                    &&
+                    sha256           == digests.sha256                  &&
+                    test_case.xxh3   == fastcrawl::xxh3::hash(data.data(), data.size());
+
+                if (!ok) {
+                    std::cerr
+                        << "Digests of " << test_case.size
+                        << " B in " << chunk_size << " B chunks FAILED" << std::endl
+                        << std::hex << std::setfill('0')
+                        << "\texpected: " << std::setw(8) << test_case.crc32c
+                        << ' ' << std::setw(16) << test_case.xxh3
+                        << ' ' << test_case.sha256 << std::endl
+                        << "\tgot     : " << std::setw(8) << crc32c
+                        << ' ' << std::setw(16) << xxh3
+                        << ' ' << fastcrawl::sha256::hex(sha256) << std::endl
+                        << "\tfused   : " << std::setw(8) << digests.crc32c
+                        << ' ' << std::setw(16) << digests.xxh3
+                        << ' ' << fastcrawl::sha256::hex(digests.sha256)
+                        << std::dec << std::endl;
+
+                    ++fail_cnt;
+                }
+            }
+        }
+
+        ++test_cnt;
+        if (0xe3069283 != fastcrawl::crc32c::update(0,
+            (const unsigned char *)"123456789", 9))
+        {
+            std::cerr << "CRC32C check value FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        {
+            fastcrawl::content_digests digests;
+            bool thrown = false;
+            try {
+                fastcrawl::multi_hash multi_hash_proc(
+                    fastcrawl::content_digests::ADLER32, digests, 0);
+            }
+            catch (const std::invalid_argument & ) {
+                thrown = true;
+            }
+
+            if (!thrown) {
+                std::cerr << "Zero block size FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "Digests UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class digest_test
+
+static const digest_test digest_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return digest_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,216 @@
+/**
+ *  \file
+ *  \brief  Discovery allocations unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/html_crawler.hxx"
+#include "libfastcrawl/crawl_context.hxx"
+
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+
+
+/** Allocations counter */
+static std::atomic<size_t> alloc_cnt(0);
+
+
+void * operator new (size_t size) {
+    ++alloc_cnt;
+
+    void * ptr = std::malloc(size ? size : 1);
+    if (nullptr == ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new [] (size_t size) { return operator new (size); }
+
+void operator delete (void * ptr) noexcept { std::free(ptr); }
+
+void operator delete [] (void * ptr) noexcept { std::free(ptr); }
+
+void operator delete (void * ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete [] (void * ptr, size_t) noexcept { std::free(ptr); }
+
+
+/**
+ *  \brief  Discovery allocations unit test
+ *
+ *  Crawls a page with many links (in discovery-only mode) and checks
+ *  that the discovery doesn't allocate memory per found reference
+ *  (by crawler with own download threads and by crawler using
+ *  a crawl context without URI claims, like the single-page CLI crawl).
+ */
+class discovery_alloc_test {
+    private:
+
+    static const size_t links = 100000;  /**< Number of links on page */
+
+    std::string m_page;  /**< Crawled page */
+
+    public:
+
+    discovery_alloc_test() {
+        m_page = "<html><head><title>Links</title></head><body>\n";
+
+        char link[128];
+        for (size_t i = 0; i < links; ++i) {
+            std::snprintf(link, sizeof(link),
+                "<p><a href=\"http://www.example.com/some/path/page-%06zu.html\">"
+                "link</a></p>\n", i);
+
+            m_page += link;
+        }
+
+        m_page += "</body></html>\n";
+    }
+
+    /**
+     *  \brief  Crawl the page, check allocations
+     *
+     *  \param  crawler  Crawler (discovery-only)
+     *  \param  mode     Crawler mode (for the log)
+     *
+     *  \return Number of failures
+     */
+    size_t crawl(fastcrawl::html_crawler & crawler, const char * mode) const {
+        size_t fail_cnt = 0;
+
+        std::string page(m_page);
+        crawler.dry_run(true);
+
+        const size_t alloc_start = alloc_cnt;
+
+        // Feed the page in chunks (like cURL does)
+        const size_t chunk_size = 16 << 10;
+        for (size_t off = 0; off < page.size(); off += chunk_size)
+            crawler((unsigned char *)&page[off],
+                std::min(chunk_size, page.size() - off));
+
+        crawler.wait();
+
+        const size_t allocs = alloc_cnt - alloc_start;
+        const double allocs_per_ref = (double)allocs / links;
+
+        std::cerr
+            << mode << ": found " << crawler.references() << " references, "
+            << allocs << " allocations ("
+            << allocs_per_ref << " per reference)"
+            << std::endl;
+
+        if (links != crawler.references()) {
+            std::cerr << "References count FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (allocs_per_ref > 0.01) {
+            std::cerr << "Allocations per reference FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /** Execute discovery allocations unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        {
+            fastcrawl::html_crawler crawler("www.example.com", 4);
+
+            ++test_cnt;
+            if (crawl(crawler, "Own threads")) ++fail_cnt;
+        }
+
+        {
+            fastcrawl::crawl_context context(4);
+            context.claims(false);
+
+            fastcrawl::html_crawler crawler(context,
+                fastcrawl::uri::parse("http://www.example.com/"));
+
+            ++test_cnt;
+            if (crawl(crawler, "Context")) ++fail_cnt;
+        }
+
+        std::cerr
+            << "Discovery allocations UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class discovery_alloc_test
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const discovery_alloc_test discovery_alloc_ut;
+    return discovery_alloc_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
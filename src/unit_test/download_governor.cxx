@@ -0,0 +1,427 @@
+/**
+ *  \file
+ *  \brief  Download governor unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark/http_server.hxx"
+
+#include "libfastcrawl/download_governor.hxx"
+#include "libfastcrawl/processor_pipeline.hxx"
+#include "libfastcrawl/metrics.hxx"
+#include "libfastcrawl/uri_record.hxx"
+#include "libfastcrawl/uri.hxx"
+
+extern "C" {
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+
+
+/** Download governor unit test */
+class download_governor_test {
+    private:
+
+    using clock_t = std::chrono::steady_clock;
+
+    /** Circuit breaker test */
+    static size_t breaker() {
+        fastcrawl::download_policy policy;
+        policy.breaker_threshold = 3;
+        policy.breaker_cooldown  = 50;
+
+        fastcrawl::download_governor governor(policy);
+        size_t fail_cnt = 0;
+
+        // Failures in row open the circuit
+        for (unsigned i = 0; i < policy.breaker_threshold; ++i) {
+            if (!governor.admit("down")) {
+                std::cerr << "Circuit open too early" << std::endl;
+                ++fail_cnt;
+            }
+            governor.report("down", false);
+        }
+
+        if (governor.admit("down")) {
+            std::cerr << "Circuit not open" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (!governor.admit("up")) {
+            std::cerr << "Other host circuit open" << std::endl;
+            ++fail_cnt;
+        }
+        governor.report("up", true);
+
+        // After cooldown, a single trial is admitted
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+        if (!governor.admit("down")) {
+            std::cerr << "Trial download not admitted" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (governor.admit("down")) {
+            std::cerr << "Concurrent trial download admitted" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Failed trial re-opens the circuit
+        governor.report("down", false);
+        if (governor.admit("down")) {
+            std::cerr << "Circuit not re-opened" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Successful trial closes it
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        if (governor.admit("down")) governor.report("down", true);
+
+        for (unsigned i = 0; i < policy.breaker_threshold; ++i) {
+            if (!governor.admit("down")) {
+                std::cerr << "Circuit not closed" << std::endl;
+                ++fail_cnt;
+                break;
+            }
+        }
+
+        return fail_cnt;
+    }
+
+    /** Backoff and hedge delay test */
+    static size_t delays() {
+        fastcrawl::download_policy policy;
+        policy.backoff          = 100;
+        policy.backoff_max      = 1000;
+        policy.hedge_percentile = 90;
+        policy.hedge_min        = 5;
+        policy.hedge_samples    = 20;
+
+        fastcrawl::download_governor governor(policy);
+        size_t fail_cnt = 0;
+
+        for (unsigned attempt = 0; attempt < 8; ++attempt) {
+            const uint64_t cap = std::min<uint64_t>(100 << attempt, 1000);
+
+            for (size_t i = 0; i < 100; ++i) {
+                const uint64_t backoff = governor.backoff(attempt).count();
+                if (backoff < cap / 2 || backoff > cap) {
+                    std::cerr
+                        << "Attempt " << attempt << " backoff " << backoff
+                        << " ms out of [" << cap / 2 << ", " << cap << "]"
+                        << std::endl;
+
+                    ++fail_cnt;
+                    break;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < policy.hedge_samples - 1; ++i)
+            governor.latency(1000);
+
+        if (governor.hedge_delay()) {
+            std::cerr << "Hedge delay set with too few samples" << std::endl;
+            ++fail_cnt;
+        }
+
+        governor.latency(1000);
+        if (policy.hedge_min * 1000 != governor.hedge_delay()) {
+            std::cerr
+                << "Hedge delay " << governor.hedge_delay()
+                << " us instead of the minimum" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        for (size_t i = 0; i < 100; ++i) governor.latency(100000);
+        if (governor.hedge_delay() < 90000) {
+            std::cerr
+                << "Hedge delay " << governor.hedge_delay()
+                << " us doesn't follow the latency" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Download the server objects
+     *
+     *  \param  server    Server
+     *  \param  governor  Download governor
+     *  \param  count     Number of objects
+     *  \param  pipeline  Data processors (must compute size)
+     *
+     *  \return Number of successful downloads
+     */
+    static size_t fetch(
+        const fastcrawl::http_server &      server,
+        fastcrawl::download_governor &      governor,
+        size_t                              count,
+        const fastcrawl::pipeline_builder & pipeline =
+            fastcrawl::pipeline_builder("size"))
+    {
+        size_t ok_cnt = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto uri = fastcrawl::uri::parse(
+                server.base_uri() + "obj/" + std::to_string(i));
+
+            fastcrawl::uri_record record;
+            std::snprintf(record.filename, sizeof(record.filename), "%zu", i);
+
+            if (!governor.fetch(uri, record, pipeline)) continue;
+
+            if (server.object_size(i) != record.size) {
+                std::cerr
+                    << "Object " << i << ": size " << record.size
+                    << " instead of " << server.object_size(i) << std::endl;
+
+                continue;
+            }
+
+            ++ok_cnt;
+        }
+
+        return ok_cnt;
+    }
+
+    /** Timeouts and retries test */
+    static size_t timeouts() {
+        fastcrawl::http_server::config conf;
+        conf.object_size   = 65536;
+        conf.trickle_ratio = 1;
+        conf.trickle_rate  = 1024;  // ~1 minute per object
+
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        fastcrawl::download_policy policy;
+        policy.timeout = 200;
+        policy.retries = 1;
+        policy.backoff = 10;
+
+        fastcrawl::download_governor governor(policy);
+        auto & stats = fastcrawl::metrics::global();
+        const auto retries = stats.retries.value();
+        size_t fail_cnt = 0;
+
+        const auto start = clock_t::now();
+        if (fetch(server, governor, 1)) {
+            std::cerr << "Trickled download didn't time out" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (clock_t::now() - start > std::chrono::seconds(5)) {
+            std::cerr << "Trickled download timed out too late" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (retries + policy.retries != stats.retries.value()) {
+            std::cerr
+                << "Retries: " << stats.retries.value() - retries
+                << " instead of " << policy.retries << std::endl;
+
+            ++fail_cnt;
+        }
+
+        ::unlink("0");
+
+        return fail_cnt;
+    }
+
+    /** Hedged requests test */
+    static size_t hedging() {
+        fastcrawl::http_server::config conf;
+        conf.references   = 8;
+        conf.object_size  = 4096;
+        conf.distribution = fastcrawl::http_server::LOGNORMAL;
+        conf.latency_ms   = 20;
+
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        fastcrawl::download_policy policy;
+        policy.hedge_percentile = 50;
+        policy.hedge_min        = 1;
+        policy.hedge_samples    = 1;
+
+        // Observed latencies are way below the server latency,
+        // so each download is hedged
+        fastcrawl::download_governor governor(policy);
+        governor.latency(100);
+
+        auto & stats = fastcrawl::metrics::global();
+        const auto hedged = stats.hedged.value();
+        size_t fail_cnt = 0;
+
+        // Processors only process the winner's content
+        size_t pipelines = 0;
+        fastcrawl::pipeline_builder pipeline("size");
+        pipeline.add([&pipelines](
+            fastcrawl::processor_pipeline & ,
+            fastcrawl::uri_record &         )
+        {
+            ++pipelines;
+        });
+
+        const size_t ok_cnt = fetch(server, governor, conf.references, pipeline);
+        if (conf.references != ok_cnt) {
+            std::cerr
+                << "Hedged downloads: " << ok_cnt << " successful"
+                << " instead of " << conf.references << std::endl;
+
+            ++fail_cnt;
+        }
+
+        if (stats.hedged.value() == hedged) {
+            std::cerr << "No download hedged" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (conf.references != pipelines) {
+            std::cerr
+                << "Hedged downloads: " << pipelines << " pipelines built"
+                << " instead of " << conf.references << std::endl;
+
+            ++fail_cnt;
+        }
+
+        for (size_t i = 0; i < conf.references; ++i) {
+            const auto filename = std::to_string(i);
+
+            if (0 == ::access((filename + '~').c_str(), F_OK)) {
+                std::cerr << "Hedge file " << filename << "~ left" << std::endl;
+                ++fail_cnt;
+            }
+
+            ::unlink(filename.c_str());
+            ::unlink((filename + '~').c_str());
+        }
+
+        return fail_cnt;
+    }
+
+    public:
+
+    /** Execute download governor unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (breaker()) {
+            std::cerr << "Circuit breaker test FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (delays()) {
+            std::cerr << "Backoff & hedge delay test FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (timeouts()) {
+            std::cerr << "Timeout test FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (hedging()) {
+            std::cerr << "Hedging test FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Download governor UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class download_governor_test
+
+static const download_governor_test download_governor_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    // Work in a temporary directory
+    char dir[] = "/tmp/ut_download_governor.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    const bool ok = download_governor_ut();
+
+    ::rmdir(dir);
+
+    return ok ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,218 @@
+/**
+ *  \file
+ *  \brief  Latency histogram unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/latency_histogram.hxx"
+#include "libfastcrawl/timing_report.hxx"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+
+/** Latency histogram & timing report unit test */
+class latency_histogram_test {
+    private:
+
+    static const size_t samples = 100000;  /**< Sample values count */
+
+    /** Max. relative error of histogram values */
+    static double max_error() {
+        return std::ldexp(1.0, 1 - (int)fastcrawl::latency_histogram::precision);
+    }
+
+    /** Check percentile against exact value */
+    static bool check(
+        const fastcrawl::latency_histogram & hist,
+        const std::vector<uint64_t> &        sorted,
+        double                               percentile)
+    {
+        size_t rank = (size_t)std::ceil(percentile / 100 * sorted.size());
+        rank = std::max<size_t>(1, std::min(rank, sorted.size()));
+
+        const uint64_t exact = sorted[rank - 1];
+        const uint64_t value = hist.percentile(percentile);
+
+        if (value < exact || value - exact > exact * max_error()) {
+            std::cerr
+                << "p" << percentile << ": " << value
+                << " (exact " << exact << ") FAILED"
+                << std::endl;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    public:
+
+    /** Execute latency histogram unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        // Empty histogram
+        fastcrawl::latency_histogram empty;
+        ++test_cnt;
+        if (0 != empty.count() || 0 != empty.percentile(50) || 0 != empty.max()) {
+            std::cerr << "Empty histogram FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Log-normal latencies (us), recorded in 2 merged halves
+        std::mt19937_64 rng(33);
+        std::lognormal_distribution<double> dist(8.0, 1.5);
+
+        std::vector<uint64_t> values;
+        fastcrawl::latency_histogram hist, hist2;
+        for (size_t i = 0; i < samples; ++i) {
+            const uint64_t value = (uint64_t)dist(rng);
+            values.push_back(value);
+            (i % 2 ? hist2 : hist).record(value);
+        }
+        hist.merge(hist2);
+        std::sort(values.begin(), values.end());
+
+        ++test_cnt;
+        if (samples != hist.count() ||
+            values.front() != hist.min() ||
+            values.back()  != hist.max())
+        {
+            std::cerr << "Histogram counters FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        for (double p: { 0.0, 1.0, 50.0, 90.0, 99.0, 99.9, 100.0 }) {
+            ++test_cnt;
+            if (!check(hist, values, p)) ++fail_cnt;
+        }
+
+        // Small values are exact, huge ones don't overflow
+        fastcrawl::latency_histogram edge;
+        edge.record(7);
+        edge.record(UINT64_MAX);
+        ++test_cnt;
+        if (7 != edge.percentile(50) || UINT64_MAX != edge.percentile(100)) {
+            std::cerr << "Histogram edge values FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Timing report
+        fastcrawl::timing_report report;
+        for (unsigned i = 1; i <= 10; ++i) {
+            fastcrawl::transfer_timing t;
+            t.namelookup    = 10 * i;
+            t.connect       = 20 * i;
+            t.pretransfer   = 20 * i;
+            t.starttransfer = 100 * i;
+            t.total         = 200 * i;
+            t.speed         = 1000;
+
+            report.add(i % 2 ? "a.example" : "b\"example", t);
+        }
+        report.add("c.example", fastcrawl::transfer_timing());  // ignored
+
+        const auto & all = report.all();
+        ++test_cnt;
+        if (10 != all.transfers() ||
+            0  != all.phases[fastcrawl::timing_report::TLS].count() ||
+            100 != all.phases[fastcrawl::timing_report::TRANSFER].min() ||
+            800 != all.phases[fastcrawl::timing_report::TTFB].max() ||
+            2 != report.hosts().size())
+        {
+            std::cerr << "Timing report aggregation FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::stringstream json;
+        report.json(json);
+        ++test_cnt;
+        if (std::string::npos == json.str().find("\"b\\\"example\":{\"transfers\":5") ||
+            std::string::npos == json.str().find("\"ttfb\":{\"count\":10"))
+        {
+            std::cerr << "Timing report JSON FAILED: " << json.str() << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Latency histogram UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class latency_histogram_test
+
+static const latency_histogram_test latency_histogram_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return latency_histogram_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,280 @@
+/**
+ *  \file
+ *  \brief  Asynchronous logging unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/logger.hxx"
+
+extern "C" {
+#include <unistd.h>
+#include <fcntl.h>
+}
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include <cstdlib>
+
+
+/** Asynchronous logging unit test */
+class logger_test: public fastcrawl::logger {
+    private:
+
+    /** Logged line (parsed) */
+    struct line {
+        char        level;  /**< Level (E or V) */
+        std::string text;   /**< Message        */
+    };  // end of struct line
+
+    /**
+     *  \brief  Capture log output
+     *
+     *  Redirects \c stderr to a temporary file while \c fn runs,
+     *  flushes the log and parses the lines.
+     *
+     *  \param  fn  Logging code
+     *
+     *  \return Logged lines
+     */
+    template <class Fn>
+    static std::vector<line> capture(Fn fn) {
+        char path[] = "/tmp/ut_logger.XXXXXX";
+        const int fd = ::mkstemp(path);
+        if (fd < 0) throw std::runtime_error("failed to create log file");
+
+        const int stderr_fd = ::dup(2);
+        ::dup2(fd, 2);
+        ::close(fd);
+
+        fn();
+        fastcrawl::log_flush();
+
+        ::dup2(stderr_fd, 2);
+        ::close(stderr_fd);
+
+        std::vector<line> lines;
+        std::ifstream log(path);
+        for (std::string l; std::getline(log, l); ) {
+            // HH:MM:SS.uuuuuu T<n> <level> <text>
+            std::istringstream fields(l);
+            std::string time, thread;
+            char level;
+            fields >> time >> thread >> level;
+            fields.get();  // space
+
+            std::string text;
+            std::getline(fields, text);
+            lines.push_back(line{level, text});
+        }
+
+        ::unlink(path);
+        return lines;
+    }
+
+    /** Log a record while building another one */
+    static const char * nested() {
+        LOG << "inner";
+        return "outer";
+    }
+
+    /**
+     *  \brief  Concurrent logging test
+     *
+     *  All the records must get logged, each thread's in order.
+     *
+     *  \param  threads  Number of logging threads
+     *  \param  records  Records per thread
+     *
+     *  \return Number of failures
+     */
+    static size_t concurrent(size_t threads, size_t records) {
+        const auto lines = capture([threads, records]() {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t)
+                workers.emplace_back([t, records]() {
+                    for (size_t i = 0; i < records; ++i)
+                        LOG << "record " << t << ' ' << i << std::endl;
+                });
+
+            for (auto & worker: workers) worker.join();
+        });
+
+        std::vector<size_t> next(threads, 0);
+        size_t fail_cnt = 0;
+
+        for (const auto & l: lines) {
+            std::istringstream fields(l.text);
+            std::string word;
+            size_t t = threads, i;
+            fields >> word >> t >> i;
+
+            if ('E' != l.level || "record" != word || t >= threads) {
+                if (!fail_cnt++)
+                    std::cerr << "Unexpected line: " << l.text << std::endl;
+                continue;
+            }
+
+            if (next[t]++ != i && !fail_cnt++)
+                std::cerr
+                    << "Thread " << t << " record " << i << " out of order"
+                    << std::endl;
+        }
+
+        for (size_t t = 0; t < threads; ++t)
+            if (next[t] != records) {
+                std::cerr
+                    << "Thread " << t << ": " << next[t] << " records logged, "
+                    << records << " expected" << std::endl;
+                ++fail_cnt;
+            }
+
+        return fail_cnt;
+    }
+
+    /** Verbose level test */
+    size_t verbose() {
+        size_t fail_cnt = 0;
+
+        m_vlog = false;
+        auto lines = capture([this]() { VLOG << "hidden" << std::endl; });
+        if (!lines.empty()) {
+            std::cerr << "Verbose record logged while disabled" << std::endl;
+            ++fail_cnt;
+        }
+
+        m_vlog = true;
+        lines = capture([this]() { VLOG << "shown " << 42 << std::endl; });
+        if (1 != lines.size() || 'V' != lines[0].level ||
+            "shown 42" != lines[0].text)
+        {
+            std::cerr << "Verbose record not logged properly" << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /** Nested record test */
+    static size_t nesting() {
+        const auto lines = capture([]() {
+            LOG << std::hex << 255 << ' ' << nested();
+            LOG << 255;  // format flags are reset
+        });
+
+        if (3 != lines.size() ||
+            "inner"      != lines[0].text ||
+            "ff outer"   != lines[1].text ||
+            "255"        != lines[2].text)
+        {
+            std::cerr << "Nested records not logged properly" << std::endl;
+            for (const auto & l: lines) std::cerr << "    " << l.text << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    public:
+
+    bool operator () () {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (concurrent(4, 20000)) {
+            std::cerr << "Concurrent logging FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (verbose()) {
+            std::cerr << "Verbose logging FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (nesting()) {
+            std::cerr << "Nested logging FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Logger UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class logger_test
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    logger_test logger_ut;
+
+    return logger_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,231 @@
+/**
+ *  \file
+ *  \brief  Crawl metrics unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/metrics.hxx"
+#include "libfastcrawl/metrics_reporter.hxx"
+#include "libfastcrawl/metrics_server.hxx"
+
+extern "C" {
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <string>
+#include <cstring>
+
+
+/** Metrics unit test */
+class metrics_test {
+    private:
+
+    static const size_t threads = 4;        /**< Updating threads   */
+    static const size_t updates = 100000;   /**< Updates per thread */
+
+    /** HTTP GET request to local port */
+    static std::string get(uint16_t port, const std::string & path) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return std::string();
+
+        struct ::sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        std::string response;
+        if (0 == ::connect(fd, (struct ::sockaddr *)&addr, sizeof(addr))) {
+            const std::string request =
+                "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+            if (::send(fd, request.data(), request.size(), 0) > 0) {
+                char buffer[1024];
+                ssize_t len;
+                while ((len = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+                    response.append(buffer, len);
+            }
+        }
+
+        ::close(fd);
+        return response;
+    }
+
+    public:
+
+    /** Execute metrics unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        fastcrawl::metrics metrics;
+
+        // Concurrent updates
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&metrics]() {
+                for (size_t i = 0; i < updates; ++i) {
+                    metrics.in_flight.add();
+                    metrics.bytes_received.add(10);
+                    metrics.completed.add();
+                    metrics.in_flight.sub();
+                }
+            });
+
+        for (auto & worker: workers) worker.join();
+
+        const auto values = metrics.values();
+        ++test_cnt;
+        if (threads * updates * 10 != values.bytes_received ||
+            threads * updates      != values.completed ||
+            0 != values.in_flight)
+        {
+            std::cerr << "Concurrent updates FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Prometheus format
+        std::stringstream prom;
+        fastcrawl::metrics::prometheus(prom, values);
+        ++test_cnt;
+        if (std::string::npos == prom.str().find(
+                "# TYPE fastcrawl_downloads_completed_total counter\n"
+                "fastcrawl_downloads_completed_total 400000\n"))
+        {
+            std::cerr << "Prometheus format FAILED:\n" << prom.str() << std::endl;
+            ++fail_cnt;
+        }
+
+        // Stats line
+        auto prev = values;
+        prev.bytes_received -= 2048;
+        std::stringstream line;
+        fastcrawl::metrics_reporter::line(line, values, prev, 2.0, 10.0);
+        ++test_cnt;
+        if (std::string::npos == line.str().find("Stats 10.0 s: received 3.8 MiB (1.0 KiB/s)")) {
+            std::cerr << "Stats line FAILED: " << line.str() << std::endl;
+            ++fail_cnt;
+        }
+
+        // Periodic reporting
+        std::stringstream report;
+        {
+            fastcrawl::metrics_reporter reporter(
+                std::chrono::milliseconds(10), report,
+                fastcrawl::metrics_reporter::sampler_t(), metrics);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        ++test_cnt;
+        if (std::string::npos == report.str().find("Stats ")) {
+            std::cerr << "Periodic reporting FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // HTTP endpoint
+        size_t sampled = 0;
+        {
+            fastcrawl::metrics_server server(0, [&metrics, &sampled]() {
+                metrics.queue_depth.set(42);
+                ++sampled;
+            }, metrics);
+
+            const auto response = get(server.port(), "/metrics");
+            ++test_cnt;
+            if (0 != response.compare(0, 15, "HTTP/1.1 200 OK") ||
+                std::string::npos == response.find("\nfastcrawl_download_queue_depth 42\n") ||
+                1 != sampled)
+            {
+                std::cerr << "Metrics endpoint FAILED:\n" << response << std::endl;
+                ++fail_cnt;
+            }
+
+            ++test_cnt;
+            if (0 != get(server.port(), "/nonsense").compare(0, 12, "HTTP/1.1 404")) {
+                std::cerr << "Metrics endpoint 404 FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "Metrics UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class metrics_test
+
+static const metrics_test metrics_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return metrics_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,251 @@
+/**
+ *  \file
+ *  \brief  Parallel HTML segmenter unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/parallel_segmenter.hxx"
+#include "libfastcrawl/html_crawler.hxx"
+#include "libfastcrawl/mapped_file.hxx"
+
+extern "C" {
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <tuple>
+#include <random>
+#include <cstdlib>
+
+
+/** Parallel segmenter unit test */
+class parallel_segmenter_test {
+    private:
+
+    /** Found reference: document, element, attribute, value, line, column */
+    using reference = std::tuple<
+        size_t, std::string, std::string, std::string, size_t, size_t>;
+
+    using references = std::vector<reference>;  /**< Segmenter output */
+
+    /** Random document (with '<' within comments and attribute values) */
+    static std::string document(std::mt19937 & rng, size_t items) {
+        static const char * const parts[] = {
+            "<a href=\"/a\">link</a>\n",
+            "<img src='/img.png' alt=\"a < b\">",
+            "<!-- <img src=\"/commented.png\"> -->\n",
+            "<script src=\"/s.js\"></script>",
+            "<div class=\"x\">text\r\n</div>",
+            "<iframe\n  src=\"/frame\"\n></iframe>",
+            "<img alt='<img src=\"/fake\">' src=\"/real\">",
+            "<!DOCTYPE html>\n",
+            "plain < text > with & stuff\n",
+            "<a href=unquoted>",
+            "<p title=\"multi\nline <a href='/in-attr'>\">",
+        };
+
+        std::string doc;
+        for (size_t i = 0; i < items; ++i)
+            doc += parts[rng() % (sizeof(parts) / sizeof(parts[0]))];
+
+        return doc;
+    }
+
+    /** Serial segmentation */
+    static void serial(
+        std::vector<std::string> & docs,
+        references &               refs)
+    {
+        for (size_t d = 0; d < docs.size(); ++d) {
+            fastcrawl::html_crawler crawler(std::string(), 0);
+            crawler.on_reference([&refs, d](
+                const std::string & element,
+                const std::string & attribute,
+                const std::string & value,
+                size_t              line,
+                size_t              column)
+            {
+                refs.emplace_back(d, element, attribute, value, line, column);
+            });
+
+            crawler((unsigned char *)&docs[d][0], docs[d].size());
+        }
+    }
+
+    /** Parallel segmentation */
+    static void parallel(
+        fastcrawl::parallel_segmenter & segmenter,
+        std::vector<std::string> &      docs,
+        references &                    refs)
+    {
+        std::vector<fastcrawl::parallel_segmenter::document> pdocs;
+        for (auto & doc: docs)
+            pdocs.push_back({(unsigned char *)&doc[0], doc.size()});
+
+        segmenter(pdocs, [&refs](
+            size_t              doc,
+            const std::string & element,
+            const std::string & attribute,
+            const std::string & value,
+            size_t              line,
+            size_t              column)
+        {
+            refs.emplace_back(doc, element, attribute, value, line, column);
+        });
+    }
+
+    public:
+
+    /** Execute parallel segmenter unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        std::mt19937 rng(38);
+        fastcrawl::work_stealing_pool pool(4);
+
+        // Documents of various sizes (incl. empty)
+        std::vector<std::string> docs;
+        docs.push_back(std::string());
+        for (size_t items: { 1, 10, 100, 1000, 5000 })
+            docs.push_back(document(rng, items));
+
+        references expected;
+        serial(docs, expected);
+
+        for (size_t chunk_size: { 1, 7, 64, 1000, 65536 }) {
+            fastcrawl::parallel_segmenter segmenter(pool, chunk_size);
+
+            references refs;
+            parallel(segmenter, docs, refs);
+
+            ++test_cnt;
+            if (refs != expected) {
+                std::cerr
+                    << "Chunk size " << chunk_size << " FAILED: "
+                    << refs.size() << " references instead of "
+                    << expected.size() << std::endl;
+
+                for (size_t i = 0; i < std::min(refs.size(), expected.size()); ++i)
+                    if (refs[i] != expected[i]) {
+                        std::cerr
+                            << "First difference at " << i << ": "
+                            << std::get<3>(refs[i]) << " at "
+                            << std::get<4>(refs[i]) << ':' << std::get<5>(refs[i])
+                            << " instead of " << std::get<3>(expected[i]) << " at "
+                            << std::get<4>(expected[i]) << ':' << std::get<5>(expected[i])
+                            << std::endl;
+                        break;
+                    }
+
+                ++fail_cnt;
+            }
+
+            // Documents with '<' in comments & values must need fix-ups
+            ++test_cnt;
+            if (chunk_size <= 64 && !segmenter.fixups()) {
+                std::cerr << "Chunk size " << chunk_size << " no fix-ups FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Memory-mapped file
+        char filename[] = "/tmp/ut_parallel_segmenter.XXXXXX";
+        const int fd = ::mkstemp(filename);
+        ++test_cnt;
+        if (fd < 0) {
+            std::cerr << "Temp. file creation FAILED" << std::endl;
+            ++fail_cnt;
+        }
+        else {
+            ::close(fd);
+            std::ofstream(filename) << docs.back();
+
+            fastcrawl::mapped_file file(filename);
+            if (docs.back() != std::string((const char *)file.data(), file.size())) {
+                std::cerr << "Memory-mapped file FAILED" << std::endl;
+                ++fail_cnt;
+            }
+
+            ::unlink(filename);
+        }
+
+        std::cerr
+            << "Parallel segmenter UT (" << expected.size() << " references): "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class parallel_segmenter_test
+
+static const parallel_segmenter_test parallel_segmenter_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return parallel_segmenter_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
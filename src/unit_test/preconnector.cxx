@@ -0,0 +1,274 @@
+/**
+ *  \file
+ *  \brief  Speculative preconnect unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark/http_server.hxx"
+
+#include "libfastcrawl/crawl_context.hxx"
+#include "libfastcrawl/preconnector.hxx"
+#include "libfastcrawl/download.hxx"
+#include "libfastcrawl/content_size.hxx"
+#include "libfastcrawl/transfer_timing.hxx"
+#include "libfastcrawl/uri.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+
+/** Preconnect unit test */
+class preconnector_test {
+    private:
+
+    /**
+     *  \brief  Preconnect test
+     *
+     *  \param  mode  Preconnect mode
+     *
+     *  \return Number of failures
+     */
+    static size_t preconnect(fastcrawl::preconnector::mode_t mode) {
+        fastcrawl::http_server::config conf;
+        conf.references = 4;
+
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        fastcrawl::crawl_context context;
+        if (!context.preconnect(mode)) {
+            std::cerr << "Preconnect not available" << std::endl;
+            return 1;
+        }
+
+        size_t fail_cnt = 0;
+
+        // Each origin is warmed up once
+        for (size_t i = 0; i < conf.references; ++i)
+            context.warm_up(fastcrawl::uri::parse(
+                server.base_uri() + "obj/" + std::to_string(i)));
+
+        // Nobody listens there
+        context.warm_up(fastcrawl::uri::parse("http://127.0.0.1:1/obj/0"));
+
+        context.preconnect()->wait();
+
+        const auto stats = context.preconnect()->stats();
+        if (2 != stats.origins || 1 != stats.warmed || 1 != stats.failed) {
+            std::cerr
+                << "Preconnect: " << stats.origins << " origins, "
+                << stats.warmed << " warmed, " << stats.failed << " failed"
+                << " instead of 2, 1, 1" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        // Nothing but handshakes
+        if (0 != server.requests()) {
+            std::cerr
+                << "Preconnect sent " << server.requests() << " requests"
+                << std::endl;
+
+            ++fail_cnt;
+        }
+
+        // The download uses the warm DNS cache (the connection isn't reused)
+        const auto uri = fastcrawl::uri::parse(server.base_uri() + "obj/0");
+        fastcrawl::download download(uri, "./obj");
+        download.share(context.share());
+
+        size_t                     size = 0;
+        fastcrawl::transfer_timing timing;
+        {
+            fastcrawl::content_size size_proc(size);
+            if (!download(size_proc, timing)) {
+                std::cerr << "Download FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        if (server.object_size(0) != size) {
+            std::cerr
+                << "Object size " << size << " instead of "
+                << server.object_size(0) << std::endl;
+
+            ++fail_cnt;
+        }
+
+
+        ::unlink("./obj");
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Unreachable origin test
+     *
+     *  TLS handshake with an origin that never answers (a listening
+     *  socket nobody serves) is cut off by the connect timeout, it doesn't
+     *  hold \ref fastcrawl::preconnector::wait.
+     *
+     *  \return Number of failures
+     */
+    static size_t unreachable() {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        ::socklen_t addr_len = sizeof(addr);
+        if (fd < 0 || ::bind(fd, (::sockaddr *)&addr, sizeof(addr)) ||
+            ::listen(fd, 4) || ::getsockname(fd, (::sockaddr *)&addr, &addr_len))
+        {
+            throw std::runtime_error("failed to create listening socket");
+        }
+
+        fastcrawl::crawl_context context;
+        fastcrawl::preconnector  preconnector(
+            context.share(), fastcrawl::preconnector::CONNECT, 100);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        preconnector.warm(fastcrawl::uri::parse(
+            "https://127.0.0.1:" + std::to_string(ntohs(addr.sin_port)) + "/obj/0"));
+        preconnector.wait();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto stats   = preconnector.stats();
+
+        ::close(fd);
+
+        if (1 != stats.failed || elapsed > std::chrono::seconds(2)) {
+            std::cerr
+                << "Unreachable origin: " << stats.failed << " failed in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+                << " ms" << std::endl;
+
+            return 1;
+        }
+
+        return 0;
+    }
+
+    public:
+
+    /** Execute preconnect unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (preconnect(fastcrawl::preconnector::DNS)) {
+            std::cerr << "DNS preconnect FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (preconnect(fastcrawl::preconnector::CONNECT)) {
+            std::cerr << "Connection preconnect FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (unreachable()) {
+            std::cerr << "Unreachable origin preconnect FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Preconnector UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class preconnector_test
+
+static const preconnector_test preconnector_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    // Work in a temporary directory
+    char dir[] = "/tmp/ut_preconnector.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    const bool ok = preconnector_ut();
+
+    ::rmdir(dir);
+
+    return ok ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,246 @@
+/**
+ *  \file
+ *  \brief  Data processor pipeline unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/online_data_processor.hxx"
+#include "libfastcrawl/processor_pipeline.hxx"
+#include "libfastcrawl/content_size.hxx"
+#include "libfastcrawl/adler32.hxx"
+#include "libfastcrawl/crc32c.hxx"
+#include "libfastcrawl/xxh3.hxx"
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+
+/** Stage order recorder */
+class order_recorder: public fastcrawl::online_data_processor {
+    private:
+
+    const char      m_id;       /**< Stage ID          */
+    std::string &   m_order;    /**< Destruction order */
+
+    public:
+
+    order_recorder(char id, std::string & order): m_id(id), m_order(order) {}
+
+    void operator () (unsigned char * data, size_t size) {}
+
+    ~order_recorder() { m_order += m_id; }
+
+};  // end of class order_recorder
+
+
+/** Processor pipeline unit test */
+class pipeline_test {
+    private:
+
+    mutable size_t m_test_cnt;  /**< Test count    */
+    mutable size_t m_fail_cnt;  /**< Failure count */
+
+    /** Check condition */
+    void check(bool cond, const std::string & what) const {
+        ++m_test_cnt;
+        if (cond) return;
+
+        std::cerr << what << " FAILED" << std::endl;
+        ++m_fail_cnt;
+    }
+
+    /** Feed data to processor in chunks */
+    static void feed(
+        fastcrawl::online_data_processor & proc,
+        std::vector<unsigned char> &       data,
+        size_t                             chunk_size)
+    {
+        for (size_t off = 0; off < data.size(); off += chunk_size)
+            proc(data.data() + off, std::min(chunk_size, data.size() - off));
+    }
+
+    /** Pipeline results must match compile-time composition */
+    void test_results(std::vector<unsigned char> & data) const {
+        uint32_t adler32, crc32c;
+        uint64_t xxh3;
+        size_t   size;
+        fastcrawl::uri_record record;
+
+        {
+            auto compound = fastcrawl::data_processor(
+                fastcrawl::adler32(adler32),
+                fastcrawl::crc32c(crc32c),
+                fastcrawl::xxh3(xxh3),
+                fastcrawl::content_size(size));
+
+            fastcrawl::processor_pipeline pipeline;
+            fastcrawl::pipeline_builder("adler32,crc32c,size,xxh3")
+                .build(pipeline, record);
+
+            // Digests are computed by single stage
+            check(2 == pipeline.size(), "Digests fusing");
+
+            // No algorithms, no stage
+            fastcrawl::processor_pipeline empty;
+            fastcrawl::pipeline_builder none;
+            none.add_digests(0);
+            none.build(empty, record);
+            check(0 == empty.size(), "No empty digests stage");
+
+            feed(compound, data, 1000);
+            feed(pipeline, data, 1000);
+        }
+
+        const unsigned digests =
+            fastcrawl::content_digests::ADLER32 |
+            fastcrawl::content_digests::CRC32C  |
+            fastcrawl::content_digests::XXH3;
+
+        check(data.size() == size,                  "Compound size");
+        check(record.size == size,                  "Pipeline size");
+        check(record.digests.algorithms == digests, "Pipeline digests");
+        check(record.digests.adler32 == adler32,    "Pipeline Adler32");
+        check(record.digests.crc32c  == crc32c,     "Pipeline CRC32C");
+        check(record.digests.xxh3    == xxh3,       "Pipeline XXH3");
+    }
+
+    /** Custom processors & stage order */
+    void test_custom() const {
+        fastcrawl::processor_registry registry;
+        std::string order;
+
+        registry.add("a", [&order](
+            fastcrawl::processor_pipeline & pipeline,
+            fastcrawl::uri_record &         record)
+        {
+            pipeline.emplace<order_recorder>('a', order);
+        });
+
+        registry.add("b", [&order](
+            fastcrawl::processor_pipeline & pipeline,
+            fastcrawl::uri_record &         record)
+        {
+            pipeline.emplace<order_recorder>('b', order);
+        });
+
+        fastcrawl::uri_record record;
+        {
+            fastcrawl::processor_pipeline pipeline;
+            fastcrawl::pipeline_builder("a,b,a", registry)
+                .build(pipeline, record);
+
+            check(3 == pipeline.size(), "Custom pipeline size");
+        }
+
+        // Stages are destroyed in reverse order
+        check("aba" == order, "Stages destruction order");
+
+        check(2 == registry.names().size(), "Registry names");
+    }
+
+    /** Unknown processor */
+    void test_unknown() const {
+        bool thrown = false;
+        try {
+            fastcrawl::pipeline_builder("size,nonesuch");
+        }
+        catch (const std::invalid_argument & ex) {
+            thrown = true;
+        }
+
+        check(thrown, "Unknown processor rejection");
+    }
+
+    public:
+
+    pipeline_test(): m_test_cnt(0), m_fail_cnt(0) {}
+
+    /** Execute processor pipeline unit test */
+    bool operator () () const {
+        std::vector<unsigned char> data(100000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = (unsigned char)(i * 7 + i / 13);
+
+        test_results(data);
+        test_custom();
+        test_unknown();
+
+        std::cerr
+            << "Processor pipeline UT: "
+            << m_fail_cnt << "/" << m_test_cnt << " failed"
+            << std::endl;
+
+        return 0 == m_fail_cnt;
+    }
+
+};  // end of class pipeline_test
+
+static const pipeline_test pipeline_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return pipeline_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
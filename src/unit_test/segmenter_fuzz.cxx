@@ -0,0 +1,367 @@
+/**
+ *  \file
+ *  \brief  HTML segmenter chunk-boundary differential fuzzing
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/html_crawler.hxx"
+#include "libfastcrawl/html_segmenter.hxx"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <tuple>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+
+
+/** HTML segmenter chunk-boundary differential fuzzing */
+class segmenter_fuzz_test {
+    private:
+
+    /** Segmenter output item: element, attribute, value, line, column */
+    using reference = std::tuple<std::string, std::string, std::string, size_t, size_t>;
+
+    using references = std::vector<reference>;  /**< Segmenter output */
+
+    const size_t m_docs;  /**< Number of fuzzed documents */
+
+    /** Pick random item */
+    template <typename T, size_t N>
+    static const T & pick(std::mt19937 & rng, const T (& items)[N]) {
+        return items[rng() % N];
+    }
+
+    /** Random attribute value */
+    static std::string value(std::mt19937 & rng) {
+        static const char * const parts[] = {
+            "/img/a.png", "http://example.com/x?y=1&z=2", "#anchor", "a b",
+            "/", ">", "=", "'", "\"", "--", "<", "\n", "\t", "x", "",
+        };
+
+        std::string val;
+        for (size_t n = rng() % 4; n; --n) val += pick(rng, parts);
+
+        return val;
+    }
+
+    /** Random tag */
+    static std::string tag(std::mt19937 & rng) {
+        static const char * const names[] = {
+            "a", "img", "script", "iframe", "div", "p", "link",
+            "A", "IMG", "Script", "my-elem", "x:y", "",
+        };
+        static const char * const attrs[] = {
+            "href", "src", "alt", "class", "SRC", "Href", "data-src", "async",
+        };
+        static const char * const spaces[] = { " ", "  ", "\n", "\t", "\r\n" };
+
+        std::string str = "<";
+        if (0 == rng() % 5) str += '/';
+        str += pick(rng, names);
+
+        for (size_t n = rng() % 4; n; --n) {
+            str += pick(rng, spaces);
+            str += pick(rng, attrs);
+
+            switch (rng() % 5) {
+                case 0:  // no value
+                    break;
+
+                case 1:  // unquoted value
+                    str += "=x" + std::to_string(rng() % 100);
+                    break;
+
+                case 2: {  // value with separated assignment
+                    const char q = rng() % 2 ? '"' : '\'';
+                    std::string val = value(rng);
+                    for (auto & ch: val) if (q == ch) ch = '_';
+                    str += std::string(" = ") + q + val + q;
+                    break;
+                }
+
+                default: {  // quoted value
+                    const char q = rng() % 2 ? '"' : '\'';
+                    std::string val = value(rng);
+                    for (auto & ch: val) if (q == ch) ch = '_';
+                    str += std::string("=") + q + val + q;
+                    break;
+                }
+            }
+        }
+
+        if (0 == rng() % 4) str += " /";
+        if (rng() % 8) str += '>';  // unterminated sometimes
+
+        return str;
+    }
+
+    /** Random document */
+    static std::string document(std::mt19937 & rng) {
+        static const char * const misc[] = {
+            "<!DOCTYPE html>", "<?xml version=\"1.0\"?>", "<!-- comment -->",
+            "<!-- <a href=\"/commented\"> -->", "<!---->", "<!-- - -- --->",
+            "<!--x--", "-->", "text", " ", "\n", "\r\n", "&amp;", "a > b",
+            "<", ">", "!", "-", "/", "=", "\"", "'",
+        };
+
+        std::string doc;
+        for (size_t n = rng() % 64; n; --n)
+            doc += rng() % 2 ? tag(rng) : pick(rng, misc);
+
+        return doc;
+    }
+
+    /**
+     *  \brief  Segment document
+     *
+     *  \param  doc     Document
+     *  \param  splits  Chunk boundaries (ascending)
+     *
+     *  \return Segmenter output
+     */
+    static references segment(
+        const std::string &         doc,
+        const std::vector<size_t> & splits)
+    {
+        references refs;
+
+        fastcrawl::html_crawler crawler("localhost", 1);
+        crawler.on_reference([&refs](
+            const std::string & element,
+            const std::string & attribute,
+            const std::string & value,
+            size_t              line,
+            size_t              column)
+        {
+            refs.emplace_back(element, attribute, value, line, column);
+        });
+
+        std::vector<unsigned char> data(doc.begin(), doc.end());
+
+        size_t offset = 0;
+        for (size_t split: splits) {
+            crawler(data.data() + offset, split - offset);
+            offset = split;
+        }
+        crawler(data.data() + offset, data.size() - offset);
+
+        return refs;
+    }
+
+    /** Collecting segmenter sink */
+    struct collecting_sink {
+        references * refs;  /**< Segmenter output */
+
+        void operator () (
+            const std::string & element,
+            const std::string & attribute,
+            const std::string & value,
+            size_t              line,
+            size_t              column) const
+        {
+            refs->emplace_back(element, attribute, value, line, column);
+        }
+
+    };  // end of struct collecting_sink
+
+    /**
+     *  \brief  Segment document by stripped-down segmenter
+     *
+     *  No positions, links only (see \ref fastcrawl::html_link_rules).
+     *
+     *  \param  doc    Document
+     *  \param  chunk  Chunk size
+     *
+     *  \return Segmenter output
+     */
+    static references segment_links(const std::string & doc, size_t chunk) {
+        references refs;
+
+        fastcrawl::html_segmenter<collecting_sink,
+            fastcrawl::no_position, fastcrawl::html_link_rules>
+            segmenter(collecting_sink{&refs});
+
+        std::vector<unsigned char> data(doc.begin(), doc.end());
+        for (size_t offset = 0; offset < data.size(); offset += chunk)
+            segmenter(data.data() + offset, std::min(chunk, data.size() - offset));
+
+        return refs;
+    }
+
+    /** Default segmenter output as of \ref segment_links */
+    static references links(const references & refs) {
+        references links;
+        for (auto & ref: refs)
+            if ("a" == std::get<0>(ref))
+                links.emplace_back(std::get<0>(ref), std::get<1>(ref),
+                    std::get<2>(ref), 0, 0);
+
+        return links;
+    }
+
+    /** Serialise output */
+    static std::string str(const references & refs) {
+        std::stringstream ss;
+        for (auto & ref: refs)
+            ss  << "    " << std::get<0>(ref) << ' ' << std::get<1>(ref)
+                << " \"" << std::get<2>(ref) << "\" at "
+                << std::get<3>(ref) << ':' << std::get<4>(ref) << std::endl;
+
+        return ss.str();
+    }
+
+    public:
+
+    /** Constructor */
+    segmenter_fuzz_test(size_t docs): m_docs(docs) {}
+
+    /** Execute the fuzzing */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        std::mt19937 rng(37);
+        size_t refs_cnt = 0;
+
+        for (size_t i = 0; i < m_docs; ++i) {
+            const std::string doc = document(rng);
+            const auto expected = segment(doc, std::vector<size_t>());
+            refs_cnt += expected.size();
+
+            // Fixed chunk sizes and random splits
+            std::vector<std::vector<size_t> > splittings;
+            for (size_t chunk: { 1, 2, 3, 7, 64 }) {
+                std::vector<size_t> splits;
+                for (size_t split = chunk; split < doc.size(); split += chunk)
+                    splits.push_back(split);
+
+                splittings.push_back(splits);
+            }
+
+            for (size_t r = 0; r < 3 && !doc.empty(); ++r) {
+                std::vector<size_t> splits;
+                for (size_t split = rng() % doc.size(); split < doc.size();
+                     split += 1 + rng() % 16)
+                {
+                    splits.push_back(split);
+                }
+
+                splittings.push_back(splits);
+            }
+
+            for (auto & splits: splittings) {
+                ++test_cnt;
+
+                const auto refs = segment(doc, splits);
+                if (refs != expected) {
+                    std::cerr
+                        << "Chunk split FAILED for document:" << std::endl
+                        << doc << std::endl
+                        << "split at:";
+
+                    for (size_t split: splits) std::cerr << ' ' << split;
+
+                    std::cerr
+                        << std::endl
+                        << "expected:" << std::endl << str(expected)
+                        << "got:" << std::endl << str(refs);
+
+                    ++fail_cnt;
+                    break;  // one report per document
+                }
+            }
+
+            // Policy-specialised segmenter must agree
+            ++test_cnt;
+            const auto expected_links = links(expected);
+            const auto refs = segment_links(doc, 1 + rng() % 16);
+            if (refs != expected_links) {
+                std::cerr
+                    << "Links-only segmenter FAILED for document:" << std::endl
+                    << doc << std::endl
+                    << "expected:" << std::endl << str(expected_links)
+                    << "got:" << std::endl << str(refs);
+
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "Segmenter fuzz UT (" << m_docs << " documents, "
+            << refs_cnt << " references): "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class segmenter_fuzz_test
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    const size_t docs = argc > 1 ? ::atoi(argv[1]) : 2000;
+
+    return segmenter_fuzz_test(docs)() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
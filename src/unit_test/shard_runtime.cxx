@@ -0,0 +1,318 @@
+/**
+ *  \file
+ *  \brief  Shard-per-core crawl runtime unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark/http_server.hxx"
+
+#include "libfastcrawl/shard_runtime.hxx"
+#include "libfastcrawl/mpsc_queue.hxx"
+#include "libfastcrawl/uri.hxx"
+
+extern "C" {
+#include <dirent.h>
+#include <unistd.h>
+}
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <cstdlib>
+
+
+/** Shard-per-core runtime unit test */
+class shard_runtime_test {
+    private:
+
+    /** Remove all files in current directory */
+    static void clean_cwd() {
+        auto * dir = ::opendir(".");
+        if (nullptr == dir) return;
+
+        while (auto * entry = ::readdir(dir))
+            if (DT_REG == entry->d_type) ::unlink(entry->d_name);
+
+        ::closedir(dir);
+    }
+
+    /**
+     *  \brief  MPSC queue test
+     *
+     *  Each producer pushes an increasing sequence; the consumer must get
+     *  all the items, each producer's in order.
+     *
+     *  \param  producers  Number of producers
+     *  \param  items      Items per producer
+     *
+     *  \return Number of failures
+     */
+    static size_t mpsc(size_t producers, size_t items) {
+        fastcrawl::mpsc_queue<std::pair<size_t, size_t> > queue;
+
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p)
+            threads.emplace_back([&queue, p, items]() {
+                for (size_t i = 0; i < items; ++i)
+                    queue.push(std::make_pair(p, i));
+            });
+
+        std::vector<size_t> next(producers, 0);
+        size_t fail_cnt = 0;
+
+        for (size_t popped = 0; popped < producers * items; ) {
+            std::pair<size_t, size_t> item;
+            if (!queue.pop(item)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (next[item.first]++ != item.second && !fail_cnt++)
+                std::cerr
+                    << "Producer " << item.first << " item " << item.second
+                    << " out of order" << std::endl;
+
+            ++popped;
+        }
+
+        for (auto & t: threads) t.join();
+
+        if (!queue.empty()) {
+            std::cerr << "Queue not empty" << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Sharded crawl of multi-host server page
+     *
+     *  \param  conf         Server configuration
+     *  \param  shards       Number of shards
+     *  \param  queue_limit  Download task limit
+     *
+     *  \return Number of failures
+     */
+    static size_t crawl(
+        const fastcrawl::http_server::config & conf,
+        size_t                                 shards,
+        size_t                                 queue_limit = SIZE_MAX)
+    {
+        fastcrawl::http_server server(conf);
+        server.start();
+
+        fastcrawl::shard_runtime runtime(shards);
+        runtime.queue_limit(queue_limit);
+
+        std::mutex                    mutex;
+        std::map<std::string, size_t> sizes;
+        runtime.on_completion([&mutex, &sizes](
+            const std::string &           uri,
+            const fastcrawl::uri_record & record)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sizes[uri] = record.success ? record.size : SIZE_MAX;
+        });
+
+        size_t fail_cnt = 0;
+
+        if (shards != runtime.size()) {
+            std::cerr
+                << "Shards: " << runtime.size() << " instead of " << shards
+                << std::endl;
+
+            ++fail_cnt;
+        }
+
+        const auto page = fastcrawl::uri::parse(server.base_uri() + "index.html");
+        if (!runtime.crawl(page)) {
+            std::cerr << "Page download FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (SIZE_MAX != queue_limit && !runtime.throttled()) {
+            std::cerr << "Page download not throttled" << std::endl;
+            ++fail_cnt;
+        }
+
+        for (size_t i = 0; i < conf.references; ++i) {
+            const auto uri =
+                server.base_uri(i % conf.hosts) + "obj/" + std::to_string(i);
+
+            const auto iter = sizes.find(uri);
+            if (sizes.end() == iter || server.object_size(i) != iter->second) {
+                std::cerr << uri << " download FAILED" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Each host's content is downloaded by the host shard
+        const auto stats = runtime.stats();
+        for (size_t s = 0; s < stats.size(); ++s) {
+            size_t downloads = 0;
+            for (size_t i = 0; i < conf.references; ++i) {
+                const auto uri = fastcrawl::uri::parse(server.base_uri(i % conf.hosts));
+                if (s == runtime.shard_of(uri.host)) ++downloads;
+            }
+
+            if (downloads != stats[s].downloads || stats[s].failed) {
+                std::cerr
+                    << "Shard " << s << ": " << stats[s].downloads
+                    << " downloads (" << stats[s].failed << " failed)"
+                    << " instead of " << downloads << std::endl;
+
+                ++fail_cnt;
+            }
+        }
+
+        // Second crawl of the page only finds duplicates
+        sizes.clear();
+        runtime.crawl(page);
+
+        size_t duplicates = 0;
+        for (const auto & s: runtime.stats()) duplicates += s.duplicates;
+
+        if (!sizes.empty() || conf.references != duplicates) {
+            std::cerr
+                << "Repeated crawl: " << sizes.size() << " downloads, "
+                << duplicates << " duplicates" << std::endl;
+
+            ++fail_cnt;
+        }
+
+        clean_cwd();
+
+        return fail_cnt;
+    }
+
+    public:
+
+    /** Execute shard runtime unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (mpsc(4, 100000)) {
+            std::cerr << "MPSC queue test FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        fastcrawl::http_server::config conf;
+        conf.references   = 200;
+        conf.object_size  = 2048;
+        conf.distribution = fastcrawl::http_server::LOGNORMAL;
+        conf.hosts        = 5;
+
+        ++test_cnt;
+        if (crawl(conf, 3)) {
+            std::cerr << "Sharded crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        conf.hosts = 1;
+
+        ++test_cnt;
+        if (crawl(conf, 1)) {
+            std::cerr << "Single shard crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // The page download waits for the tasks (the inboxes are bounded)
+        conf.hosts = 3;
+
+        ++test_cnt;
+        if (crawl(conf, 2, 8)) {
+            std::cerr << "Throttled sharded crawl FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Shard runtime UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class shard_runtime_test
+
+static const shard_runtime_test shard_runtime_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    // Work in a temporary directory
+    char dir[] = "/tmp/ut_shard_runtime.XXXXXX";
+    if (nullptr == ::mkdtemp(dir) || ::chdir(dir))
+        throw std::runtime_error("failed to create working directory");
+
+    const bool ok = shard_runtime_ut();
+
+    ::rmdir(dir);
+
+    return ok ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,446 @@
+/**
+ *  \file
+ *  \brief  Shared memory ring unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/shm_ring.hxx"
+#include "libfastcrawl/shm_sink.hxx"
+#include "libfastcrawl/processor_pipeline.hxx"
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+#include <zlib.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+
+/** Shared memory ring unit test */
+class shm_ring_test {
+    private:
+
+    const std::string m_name;  /**< Test shared memory object name */
+
+    /** Chunk payload byte (stream, index) */
+    static unsigned char byte(uint64_t stream, size_t i) {
+        return (unsigned char)(stream * 31 + i * 7);
+    }
+
+    /**
+     *  \brief  Consumer (child process)
+     *
+     *  Reads records slowly and checks their content.
+     *
+     *  \param  records  Expected number of records
+     *  \param  seed     Record sizes generator seed
+     *
+     *  \return Number of failures
+     */
+    size_t consume(size_t records, unsigned seed) const {
+        fastcrawl::shm_ring ring(m_name);
+        std::mt19937 rng(seed);
+
+        size_t fail_cnt = 0;
+        size_t cnt      = 0;
+        fastcrawl::shm_ring::record rec;
+
+        while (ring.read(rec, std::chrono::milliseconds(5000))) {
+            const size_t size = rng() % (ring.max_payload() + 1);
+
+            if (fastcrawl::shm_ring::CHUNK != rec.type || cnt != rec.stream ||
+                size != rec.size)
+            {
+                if (!fail_cnt++)
+                    std::cerr
+                        << "Record " << cnt << ": type " << rec.type
+                        << ", stream " << rec.stream << ", size " << rec.size
+                        << " (" << size << " expected)" << std::endl;
+            }
+            else {
+                for (size_t i = 0; i < rec.size; ++i)
+                    if (byte(rec.stream, i) != rec.data[i]) {
+                        if (!fail_cnt++)
+                            std::cerr
+                                << "Record " << cnt << " data corrupt"
+                                << std::endl;
+                        break;
+                    }
+            }
+
+            ring.release();
+            ++cnt;
+
+            // Slow consumer
+            if (0 == cnt % 64)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (!ring.done() || records != cnt) {
+            std::cerr
+                << cnt << " records read, " << records << " expected"
+                << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Cross-process ring test
+     *
+     *  The ring is small, so it wraps around many times and the producer
+     *  must wait for the (slow) consumer.
+     *
+     *  \param  records  Number of records
+     *
+     *  \return Number of failures
+     */
+    size_t cross_process(size_t records) const {
+        const unsigned seed = 17;
+
+        fastcrawl::shm_ring ring(m_name, 4096);
+
+        const ::pid_t pid = ::fork();
+        if (pid < 0) throw std::runtime_error("fork failed");
+
+        if (0 == pid) {
+            try {
+                ::_exit(consume(records, seed) ? 1 : 0);
+            }
+            catch (const std::exception & ex) {
+                std::cerr << "Consumer: " << ex.what() << std::endl;
+                ::_exit(2);
+            }
+        }
+
+        // Records are dropped until the consumer attaches
+        while (!ring.attached())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::mt19937 rng(seed);
+        std::vector<unsigned char> data(ring.max_payload());
+
+        for (size_t i = 0; i < records; ++i) {
+            const size_t size = rng() % (ring.max_payload() + 1);
+            for (size_t j = 0; j < size; ++j) data[j] = byte(i, j);
+
+            // Split payload (the parts must be concatenated)
+            ring.write(fastcrawl::shm_ring::CHUNK, i,
+                data.data(), size / 3, data.data() + size / 3, size - size / 3);
+        }
+
+        ring.close();
+
+        int status;
+        ::waitpid(pid, &status, 0);
+
+        size_t fail_cnt = 0;
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            std::cerr << "Consumer failed" << std::endl;
+            ++fail_cnt;
+        }
+
+        if (0 == ring.stalls() || ring.drops()) {
+            std::cerr
+                << "Producer waited " << ring.stalls() << " times, dropped "
+                << ring.drops() << " records" << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Content sink test
+     *
+     *  Content is published by the \c shm processor, then the completion.
+     *
+     *  \return Number of failures
+     */
+    size_t sink() const {
+        fastcrawl::shm_sink sink(m_name, 1 << 16);
+
+        fastcrawl::processor_registry registry = fastcrawl::processor_registry::global();
+        sink.add_to(registry);
+
+        const fastcrawl::pipeline_builder builder("adler32,size,shm", registry);
+
+        std::string content;
+        for (size_t i = 0; i < 100000; ++i) content += (char)('a' + i % 26);
+
+        const std::string uri = "http://example.com/content";
+        fastcrawl::uri_record record;
+
+        // Consumer (reads in place, the ring is smaller than the content)
+        fastcrawl::shm_ring ring(m_name);
+        std::string received;
+        size_t fail_cnt = 0;
+
+        std::thread producer([&]() {
+            {
+                fastcrawl::processor_pipeline pipeline;
+                builder.build(pipeline, record);
+
+                for (size_t off = 0; off < content.size(); off += 4096)
+                    pipeline((unsigned char *)&content[off],
+                        std::min<size_t>(4096, content.size() - off));
+            }
+            record.success = true;
+
+            sink.completion(uri, record);
+            sink.close();
+        });
+
+        fastcrawl::shm_ring::record rec;
+        bool ended = false, completed = false;
+        while (ring.read(rec, std::chrono::milliseconds(5000))) {
+            switch (rec.type) {
+                case fastcrawl::shm_ring::CHUNK:
+                    received.append((const char *)rec.data, rec.size);
+                    break;
+
+                case fastcrawl::shm_ring::END:
+                    ended = record.stream == rec.stream;
+                    break;
+
+                case fastcrawl::shm_ring::COMPLETION: {
+                    uint64_t size;
+                    uint32_t adler32, success;
+                    std::memcpy(&size,    rec.data,      8);
+                    std::memcpy(&adler32, rec.data + 8,  4);
+                    std::memcpy(&success, rec.data + 12, 4);
+                    const std::string uri_str((const char *)rec.data + 16, rec.size - 16);
+
+                    completed =
+                        record.stream == rec.stream &&
+                        content.size() == size && success && uri == uri_str &&
+                        ::adler32(::adler32(0, nullptr, 0),
+                            (const unsigned char *)content.data(),
+                            content.size()) == adler32;
+                    break;
+                }
+            }
+
+            ring.release();
+        }
+
+        producer.join();
+
+        if (content != received) {
+            std::cerr
+                << "Content mismatch (" << received.size() << " B received)"
+                << std::endl;
+            ++fail_cnt;
+        }
+
+        if (!ended || !completed) {
+            std::cerr
+                << "Stream " << (ended ? "" : "not ") << "ended, "
+                << (completed ? "" : "no or wrong ") << "completion"
+                << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /**
+     *  \brief  Overrun test
+     *
+     *  The producer never waits for a detached consumer (records that
+     *  don't fit are dropped); a live consumer that doesn't read makes
+     *  the producer drop records only if the (opt-in) timeout is set.
+     *  Oversized records are rejected.
+     *
+     *  \return Number of failures
+     */
+    size_t overrun() const {
+        size_t fail_cnt = 0;
+
+        // No consumer
+        {
+            fastcrawl::shm_ring ring(m_name, 4096);
+            const std::vector<unsigned char> data(ring.max_payload() + 1);
+
+            bool thrown = false;
+            try {
+                ring.write(fastcrawl::shm_ring::CHUNK, 0, data.data(), data.size());
+            }
+            catch (const std::length_error & ) {
+                thrown = true;
+            }
+
+            if (!thrown) {
+                std::cerr << "Oversized record accepted" << std::endl;
+                ++fail_cnt;
+            }
+
+            // Attached, then detached
+            { fastcrawl::shm_ring consumer(m_name); }
+
+            size_t written = 0;
+            for (size_t i = 0; i < 100; ++i)
+                written += ring.write(fastcrawl::shm_ring::CHUNK, i,
+                    data.data(), ring.max_payload());
+
+            if (ring.attached() || 0 == written ||
+                100 != written + ring.drops() || ring.stalls())
+            {
+                std::cerr
+                    << "No consumer: " << written << " written, " << ring.drops()
+                    << " dropped, " << ring.stalls() << " waits" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Live consumer, producer timeout
+        {
+            fastcrawl::shm_ring ring(m_name, 4096, std::chrono::milliseconds(20));
+            fastcrawl::shm_ring consumer(m_name);
+            const std::vector<unsigned char> data(ring.max_payload());
+
+            size_t written = 0;
+            for (size_t i = 0; i < 10; ++i)
+                written += ring.write(fastcrawl::shm_ring::CHUNK, i,
+                    data.data(), data.size());
+
+            if (!ring.attached() || 0 == written ||
+                10 != written + ring.drops() || ring.drops() != ring.stalls())
+            {
+                std::cerr
+                    << "Timeout: " << written << " written, " << ring.drops()
+                    << " dropped, " << ring.stalls() << " waits" << std::endl;
+                ++fail_cnt;
+            }
+
+            // The consumer catches up, records are written again
+            fastcrawl::shm_ring::record rec;
+            size_t read = 0;
+            while (consumer.read(rec, std::chrono::milliseconds(0))) ++read;
+            consumer.release();
+
+            if (written != read ||
+                !ring.write(fastcrawl::shm_ring::CHUNK, 10, data.data(), 100))
+            {
+                std::cerr << "Timeout: ring not recovered" << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        return fail_cnt;
+    }
+
+    public:
+
+    shm_ring_test(): m_name("/fastcrawl_ut_shm_" + std::to_string(::getpid())) {}
+
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (cross_process(20000)) {
+            std::cerr << "Cross-process ring FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (overrun()) {
+            std::cerr << "Ring overrun FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        ++test_cnt;
+        if (sink()) {
+            std::cerr << "Shared memory sink FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::cerr
+            << "Shared memory ring UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class shm_ring_test
+
+static const shm_ring_test shm_ring_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return shm_ring_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
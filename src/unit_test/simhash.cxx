@@ -0,0 +1,264 @@
+/**
+ *  \file
+ *  \brief  SimHash & near-duplicate index unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/simhash.hxx"
+#include "libfastcrawl/fingerprint_index.hxx"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+
+/** SimHash & fingerprint index unit test */
+class simhash_test {
+    private:
+
+    /** Generated page (markup and random words) */
+    static std::string page(uint64_t seed, size_t words) {
+        static const char * vocabulary[] = {
+            "crawl", "page", "content", "link", "image", "script", "style",
+            "Lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "elit",
+            "sed", "do", "eiusmod", "tempor", "incididunt", "labore", "magna",
+            "aliqua", "enim", "minim", "veniam", "quis", "nostrud", "ullamco",
+        };
+
+        std::mt19937_64 rng(seed);
+        std::string text = "<html><head><title>Page</title></head><body>\n";
+
+        for (size_t i = 0; i < words; ++i) {
+            if (0 == i % 12) text += "<p class=\"para\">";
+
+            text += vocabulary[rng() % (sizeof(vocabulary) / sizeof(*vocabulary))];
+            text += std::to_string(rng() % 100);
+            text += 11 == i % 12 ? "</p>\n" : " ";
+        }
+
+        return text + "</body></html>\n";
+    }
+
+    /** Fingerprint of data fed in chunks (at most \c chunk bytes each) */
+    static uint64_t fingerprint(std::string data, size_t chunk) {
+        uint64_t fp = 0;
+        {
+            fastcrawl::simhash simhash(fp);
+
+            auto * bytes = (unsigned char *)&data[0];
+            for (size_t offset = 0; offset < data.size(); offset += chunk)
+                simhash(bytes + offset, std::min(chunk, data.size() - offset));
+        }
+
+        return fp;
+    }
+
+    /** Fingerprint test */
+    static size_t test_fingerprint() {
+        size_t fail_cnt = 0;
+
+        const auto doc = page(1, 5000);
+        const auto fp  = fingerprint(doc, doc.size());
+
+        // Chunking doesn't matter
+        for (size_t chunk: { 1, 7, 4096 }) {
+            if (fp != fingerprint(doc, chunk)) {
+                std::cerr << "Fingerprint differs for chunk " << chunk << std::endl;
+                ++fail_cnt;
+            }
+        }
+
+        // Neither does letter case
+        std::string upper = doc;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        if (fp != fingerprint(upper, upper.size())) {
+            std::cerr << "Fingerprint is case-sensitive" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Small change (session parameter in a link), near-duplicate
+        auto variant = doc;
+        variant.insert(variant.find("<p "),
+            "<a href=\"/list?page=2&amp;sid=8f3a2c\">next</a>");
+
+        const auto distance = fastcrawl::simhash::distance(fp,
+            fingerprint(variant, 1000));
+
+        if (distance > 3) {
+            std::cerr << "Near-duplicate distance " << distance << std::endl;
+            ++fail_cnt;
+        }
+
+        // Different pages
+        const auto other = fastcrawl::simhash::distance(fp,
+            fingerprint(page(2, 5000), 1000));
+
+        if (other < 12) {
+            std::cerr << "Different pages distance " << other << std::endl;
+            ++fail_cnt;
+        }
+
+        return fail_cnt;
+    }
+
+    /** Fingerprint index test (against brute force search) */
+    static size_t test_index(unsigned max_distance) {
+        size_t fail_cnt = 0;
+
+        std::mt19937_64 rng(max_distance);
+        fastcrawl::fingerprint_index index(max_distance);
+        std::vector<uint64_t> fps;
+
+        // Random fingerprints (near-duplicates are refused)
+        for (size_t i = 0; i < 5000; ++i) {
+            const uint64_t fp = rng();
+
+            const bool near = std::any_of(fps.begin(), fps.end(),
+                [fp, max_distance](uint64_t other) {
+                    return fastcrawl::simhash::distance(fp, other) <= max_distance;
+                });
+
+            if (near == index.insert(fp)) {
+                std::cerr << "Insertion of " << fp << " FAILED" << std::endl;
+                ++fail_cnt;
+            }
+
+            if (!near) fps.push_back(fp);
+        }
+
+        if (fps.size() != index.size()) {
+            std::cerr
+                << "Index size " << index.size() << " instead of " << fps.size()
+                << std::endl;
+
+            ++fail_cnt;
+        }
+
+        // Perturbed fingerprints
+        for (size_t i = 0; i < 5000; ++i) {
+            uint64_t fp = fps[rng() % fps.size()];
+
+            const unsigned flips = rng() % (max_distance + 3);
+            for (unsigned j = 0; j < flips; ++j)
+                fp ^= (uint64_t)1 << (rng() % 64);
+
+            const bool near = std::any_of(fps.begin(), fps.end(),
+                [fp, max_distance](uint64_t other) {
+                    return fastcrawl::simhash::distance(fp, other) <= max_distance;
+                });
+
+            uint64_t match = 0;
+            if (near != index.find(fp, &match) ||
+                (near && fastcrawl::simhash::distance(fp, match) > max_distance))
+            {
+                std::cerr
+                    << "Query " << fp << " (distance " << max_distance
+                    << ") FAILED" << std::endl;
+
+                ++fail_cnt;
+            }
+        }
+
+        return fail_cnt;
+    }
+
+    public:
+
+    /** Execute SimHash unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        ++test_cnt;
+        if (test_fingerprint()) ++fail_cnt;
+
+        for (unsigned max_distance: { 0, 3, 7 }) {
+            ++test_cnt;
+            if (test_index(max_distance)) {
+                std::cerr
+                    << "Fingerprint index (distance " << max_distance
+                    << ") FAILED" << std::endl;
+
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "SimHash UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class simhash_test
+
+static const simhash_test simhash_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return simhash_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,288 @@
+/**
+ *  \file
+ *  \brief  Thread pools unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/job.hxx"
+#include "libfastcrawl/thread_pool.hxx"
+#include "libfastcrawl/work_stealing_pool.hxx"
+
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <array>
+#include <thread>
+#include <chrono>
+
+
+/** Live objects counter (checks job storage leaks) */
+struct counted {
+    static std::atomic<int> live;  /**< Live instances */
+
+    counted()                  { ++live; }
+    counted(const counted & )  { ++live; }
+    ~counted()                 { --live; }
+
+};  // end of struct counted
+
+std::atomic<int> counted::live(0);
+
+
+/** Thread pools unit test */
+class thread_pool_test {
+    private:
+
+    mutable size_t m_test_cnt;  /**< Test count    */
+    mutable size_t m_fail_cnt;  /**< Failure count */
+
+    /** Check condition */
+    void check(bool cond, const std::string & what) const {
+        ++m_test_cnt;
+        if (cond) return;
+
+        std::cerr << what << " FAILED" << std::endl;
+        ++m_fail_cnt;
+    }
+
+    /** Move-only job */
+    void test_job() const {
+        int result = 0;
+
+        // In-place, move-only capture
+        {
+            std::unique_ptr<int> value(new int(5));
+            int * res = &result;
+            fastcrawl::job j([res, value = std::move(value)]() {
+                *res += *value;
+            });
+
+            fastcrawl::job j2(std::move(j));
+            check(!j && j2, "Job move");
+
+            j2();
+            check(5 == result, "In-place job");
+        }
+
+        // On heap
+        {
+            std::array<char, 2 * fastcrawl::job::capacity> big;
+            big.fill(1);
+
+            counted c;
+            fastcrawl::job j([&result, big, c]() { result += big[0]; });
+
+            fastcrawl::job j2;
+            j2 = std::move(j);
+            j2();
+            check(6 == result, "On-heap job");
+        }
+
+        check(0 == counted::live, "Job callable destruction");
+        check(64 == sizeof(fastcrawl::job), "Job size");
+    }
+
+    /**
+     *  \brief  Flat & nested jobs
+     *
+     *  \param  pool    Thread pool
+     *  \param  name    Thread pool name
+     *  \param  nested  Nested jobs are executed during shutdown
+     */
+    template <class Pool>
+    void test_pool(Pool & pool, const std::string & name, bool nested) const {
+        std::atomic<size_t> done(0);
+        std::atomic<size_t> nested_done(0);
+
+        for (size_t i = 0; i < 10000; ++i)
+            pool.run([&pool, &done, &nested_done]() {
+                pool.run([&nested_done]() { ++nested_done; });
+                ++done;
+            });
+
+        // All queued jobs are executed before shutdown returns
+        pool.shutdown();
+        check(10000 == done, name + " jobs execution");
+        check(!nested || 10000 == nested_done, name + " nested jobs execution");
+
+        check(!pool.run([]() {}), name + " run after shutdown");
+    }
+
+    /** Elastic thread pool */
+    void test_elastic() const {
+        using std::chrono::milliseconds;
+
+        fastcrawl::thread_pool pool(1, 8);
+        pool.idle_timeout(milliseconds(50));
+
+        // Burst of blocking jobs grows the pool
+        for (size_t i = 0; i < 16; ++i)
+            pool.run([]() { std::this_thread::sleep_for(milliseconds(20)); });
+
+        std::this_thread::sleep_for(milliseconds(100));
+        auto stats = pool.stats();
+        check(1 < stats.peak && stats.peak <= 8,        "Pool growth");
+        check(stats.spawned == stats.peak,              "Spawned threads count");
+        check(stats.queue_wait_max > milliseconds(0),   "Queue wait time");
+
+        // Idle threads retire down to tmin
+        std::this_thread::sleep_for(milliseconds(300));
+        stats = pool.stats();
+        check(16 == stats.executed,                     "Executed jobs count");
+        check(1 == stats.size,                          "Idle threads retirement");
+        check(stats.retired == stats.spawned - 1,       "Retired threads count");
+
+        // Explicit shrinking
+        pool.idle_timeout(milliseconds(10000));
+        pool.size(4);
+        check(4 == pool.size(), "Pool explicit growth");
+
+        pool.size(2);  // surplus threads retire asynchronously
+        for (size_t i = 0; i < 100 && 2 != pool.size(); ++i)
+            std::this_thread::sleep_for(milliseconds(10));
+
+        check(2 == pool.size(), "Pool explicit shrinking");
+    }
+
+    /** Job queue limit */
+    void test_queue_limit() const {
+        using std::chrono::milliseconds;
+
+        fastcrawl::thread_pool pool(1, 1);
+        pool.queue_limit(8);
+
+        std::atomic<bool>   blocked(true);
+        std::atomic<size_t> done(0);
+
+        pool.run([&blocked]() {
+            while (blocked) std::this_thread::sleep_for(milliseconds(1));
+        });
+
+        std::this_thread::sleep_for(milliseconds(20));  // the job is taken
+        for (size_t i = 0; i < 8; ++i) {
+            check(!pool.saturated(), "Queue under limit");
+            pool.run([&done]() { ++done; });
+        }
+
+        check(pool.saturated(),                     "Saturated queue");
+        check(!pool.wait_drained(milliseconds(10)), "Drain wait timeout");
+        check(1 == pool.stats().throttled,          "Throttled count");
+
+        blocked = false;
+        check(pool.wait_drained(milliseconds(1000)), "Drain wait");
+        check(!pool.saturated(),                     "Drained queue");
+
+        pool.shutdown();
+        check(8 == done, "Jobs over limit execution");
+
+        // A job producing jobs doesn't wait if nobody would drain the queue
+        fastcrawl::thread_pool job_pool(1, 1);
+        job_pool.queue_limit(2);
+
+        std::atomic<bool> ready(false);
+        job_pool.run([&job_pool, &ready]() {
+            for (size_t i = 0; i < 2; ++i) job_pool.run([]() {});
+
+            const auto start = std::chrono::steady_clock::now();
+            ready = job_pool.wait_drained(milliseconds(5000)) &&
+                std::chrono::steady_clock::now() - start < milliseconds(1000);
+        });
+
+        job_pool.shutdown();
+        check(ready, "Job drain wait (no free thread)");
+    }
+
+    public:
+
+    thread_pool_test(): m_test_cnt(0), m_fail_cnt(0) {}
+
+    /** Execute thread pools unit test */
+    bool operator () () const {
+        test_job();
+        test_elastic();
+        test_queue_limit();
+
+        for (size_t threads = 1; threads <= 8; threads *= 2) {
+            fastcrawl::thread_pool tp(threads, threads);
+            test_pool(tp, "thread_pool", false);
+
+            fastcrawl::work_stealing_pool wsp(threads);
+            test_pool(wsp, "work_stealing_pool", true);
+        }
+
+        std::cerr
+            << "Thread pools UT: "
+            << m_fail_cnt << "/" << m_test_cnt << " failed"
+            << std::endl;
+
+        return 0 == m_fail_cnt;
+    }
+
+};  // end of class thread_pool_test
+
+static const thread_pool_test thread_pool_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return thread_pool_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
@@ -0,0 +1,216 @@
+/**
+ *  \file
+ *  \brief  Tracing unit test
+ *
+ *  \date   2026/10/18
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2026, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libfastcrawl/trace.hxx"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <string>
+
+
+/** Tracing unit test */
+class trace_test {
+    private:
+
+    static const size_t threads = 4;    /**< Tracing threads    */
+    static const size_t spans   = 1000; /**< Spans per thread   */
+
+    /** Count substring occurences */
+    static size_t count(const std::string & str, const std::string & sub) {
+        size_t cnt = 0;
+        for (size_t pos = str.find(sub); std::string::npos != pos; pos = str.find(sub, pos + 1))
+            ++cnt;
+
+        return cnt;
+    }
+
+    public:
+
+    /** Execute tracing unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        using fastcrawl::trace;
+
+        static const char uri[] = "http://example.com/\"quoted\"";
+
+        auto work = [](size_t t) {
+            for (size_t i = 0; i < spans; ++i) {
+                if (!trace::enabled()) continue;
+
+                const uint64_t id = t * spans + i;
+                trace::record(trace::ASYNC_BEGIN, "queued", id, trace::now(),
+                    uri, sizeof(uri) - 1);
+                trace::record(trace::ASYNC_END, "queued", id);
+                trace::record(trace::BEGIN, "download", id);
+                trace::instant("first byte", id);
+                trace::record(trace::END, "download", id);
+            }
+        };
+
+        // Disabled tracing records nothing
+        work(0);
+        ++test_cnt;
+        if (trace::enabled() || 0 != trace::size()) {
+            std::cerr << "Disabled tracing FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Concurrent tracing (the buffers outlive the threads)
+        trace::enable();
+        std::vector<std::thread> tracers;
+        for (size_t t = 0; t < threads; ++t)
+            tracers.emplace_back(work, t);
+
+        for (auto & tracer: tracers) tracer.join();
+        trace::enable(false);
+
+        ++test_cnt;
+        if (threads * spans * 5 != trace::size()) {
+            std::cerr << "Recorded events count FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        std::stringstream json;
+        trace::dump(json);
+        const std::string str = json.str();
+
+        ++test_cnt;
+        if (0 != str.compare(0, 41, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{") ||
+            threads != count(str, "\"ph\":\"M\"") ||
+            threads * spans != count(str, "\"ph\":\"b\"") ||
+            threads * spans != count(str, "\"ph\":\"E\"") ||
+            threads * spans != count(str, "\"s\":\"t\"") ||
+            threads * spans != count(str, "\"uri\":\"http://example.com/\\\"quoted\\\"\"") ||
+            std::string::npos == str.find("\"id\":\"0xf9f\"") ||
+            std::string::npos == str.find("\"ts\":0.000,") ||
+            0 != str.compare(str.size() - 4, 4, "\n]}\n"))
+        {
+            std::cerr << "Trace JSON FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        trace::clear();
+        ++test_cnt;
+        if (0 != trace::size()) {
+            std::cerr << "Trace clear FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        // Details are copied (the detail may be released when recorded),
+        // dumping while the tracers run is safe
+        trace::enable();
+        tracers.clear();
+        for (size_t t = 0; t < threads; ++t)
+            tracers.emplace_back([t]() {
+                for (size_t i = 0; i < spans; ++i) {
+                    std::string detail = "http://example.com/" + std::to_string(i);
+                    trace::record(trace::INSTANT, "discovered", trace::unique_id(),
+                        trace::now(), detail.data(), detail.size());
+                    detail.assign(detail.size(), 'x');
+                }
+            });
+
+        for (size_t i = 0; i < 10; ++i) {
+            std::stringstream dump;
+            trace::dump(dump);
+        }
+
+        for (auto & tracer: tracers) tracer.join();
+        trace::enable(false);
+
+        std::stringstream details;
+        trace::dump(details);
+
+        ++test_cnt;
+        if (threads != count(details.str(), "\"uri\":\"http://example.com/0\"") ||
+            threads * spans != count(details.str(), "\"uri\":\"http://example.com/") ||
+            std::string::npos != details.str().find("xxx"))
+        {
+            std::cerr << "Trace details FAILED" << std::endl;
+            ++fail_cnt;
+        }
+
+        trace::clear();
+
+        std::cerr
+            << "Trace UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class trace_test
+
+static const trace_test trace_ut;
+
+
+// Actual main implementation
+static int main_impl(int argc, char * const argv[]) {
+    return trace_ut() ? 0 : 1;
+}
+
+
+// Exception safeness wrapper
+int main(int argc, char * const argv[]) {
+    try {
+        return main_impl(argc, argv);
+    }
+
+    // Unhandled standard exception
+    catch (const std::exception & ex) {
+        std::cerr
+            << "Stndard exception caught: " << ex.what()
+            << std::endl;
+    }
+
+    // Unhandled unknown exception
+    catch (...) {
+        std::cerr
+            << "Unknown exception caught"
+            << std::endl;
+    }
+
+    return 64;  // exception caught
+}
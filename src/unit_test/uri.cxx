@@ -42,6 +42,7 @@
 
 #include <iostream>
 #include <list>
+#include <utility>
 
 
 /** URI parser unit test */
@@ -126,9 +127,74 @@ class uri_parser_test {
 static const uri_parser_test uri_parser_ut;
 
 
+/** Dot segments removal unit test (RFC 3986, section 5.2.4) */
+class dot_segments_test {
+    private:
+
+    /** Test cases (path, expected result) */
+    std::list<std::pair<std::string, std::string> > m_test_cases;
+
+    public:
+
+    /** Create dot segments removal unit test cases */
+    dot_segments_test() {
+        m_test_cases.emplace_back("/a/b/c/./../../g",      "/a/g");
+        m_test_cases.emplace_back("mid/content=5/../6",    "mid/6");
+        m_test_cases.emplace_back("/css/../img/a.png",     "/img/a.png");
+        m_test_cases.emplace_back("/../img/./../obj/1",    "/obj/1");
+        m_test_cases.emplace_back("/b/c/../../../g",       "/g");
+        m_test_cases.emplace_back("/b/c/./g/.",            "/b/c/g/");
+        m_test_cases.emplace_back("/b/c/g/..",             "/b/c/");
+        m_test_cases.emplace_back("/b/c/g.././h",          "/b/c/g../h");
+        m_test_cases.emplace_back("/b/c/..g",              "/b/c/..g");
+        m_test_cases.emplace_back("../../x",               "x");
+        m_test_cases.emplace_back(".",                     "");
+        m_test_cases.emplace_back("/",                     "/");
+    }
+
+    /** Execute dot segments removal unit test */
+    bool operator () () const {
+        size_t test_cnt = 0;
+        size_t fail_cnt = 0;
+
+        for (auto & test_case: m_test_cases) {
+            ++test_cnt;
+
+            const auto path = fastcrawl::uri::remove_dot_segments(test_case.first);
+            if (path != test_case.second) {
+                std::cerr
+                    << "Dot segments removal failed for \"" << test_case.first << "\""
+                    << std::endl
+                    << "\texpected \"" << test_case.second << "\""
+                    << std::endl
+                    << "\tgot      \"" << path << "\""
+                    << std::endl;
+
+                ++fail_cnt;
+            }
+        }
+
+        std::cerr
+            << "Dot segments removal UT: "
+            << fail_cnt << "/" << test_cnt << " failed"
+            << std::endl;
+
+        return 0 == fail_cnt;
+    }
+
+};  // end of class dot_segments_test
+
+static const dot_segments_test dot_segments_ut;
+
+
 // Actual main implementation
 static int main_impl(int argc, char * const argv[]) {
-    return uri_parser_ut() ? 0 : 1;
+    size_t fail_cnt = 0;
+
+    if (!uri_parser_ut())   ++fail_cnt;
+    if (!dot_segments_ut()) ++fail_cnt;
+
+    return 0 == fail_cnt ? 0 : 1;
 }
 
 